@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+#include "epoch_dashboard/server/tearsheet_service.h"
+
+namespace epoch_tearsheet {
+
+struct ServerOptions {
+    std::string host = "127.0.0.1";
+    uint16_t port = 8080;
+    size_t io_threads = 1;       // Drogon event loops, only parse requests and write responses
+    size_t worker_threads = 4;   // Pool that runs providers, builders and serialization
+};
+
+/**
+ * Drogon front end for a TearSheetService. Handlers hand each request to a worker pool
+ * so slow providers never block the event loops. run() blocks until stop() is called;
+ * Drogon's application is a process-wide singleton, so only one server can run.
+ */
+class DashboardServer {
+public:
+    DashboardServer(std::shared_ptr<TearSheetService> service, ServerOptions options = {});
+    ~DashboardServer();
+
+    void run();
+    void stop();
+
+private:
+    class WorkerPool;
+
+    std::shared_ptr<TearSheetService> service_;
+    ServerOptions options_;
+    std::unique_ptr<WorkerPool> workers_;
+};
+
+} // namespace epoch_tearsheet
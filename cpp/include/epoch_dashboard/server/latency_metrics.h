@@ -0,0 +1,45 @@
+#pragma once
+
+#include <array>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <utility>
+
+namespace epoch_tearsheet {
+
+/**
+ * Request latency histograms per route plus response counts per route and status,
+ * rendered in the Prometheus text exposition format:
+ *
+ *   epoch_dashboard_request_duration_seconds_bucket{route="chart",le="0.005"} 12
+ *   epoch_dashboard_request_duration_seconds_sum{route="chart"} 0.031
+ *   epoch_dashboard_request_duration_seconds_count{route="chart"} 14
+ *   epoch_dashboard_responses_total{route="chart",code="200"} 13
+ */
+class LatencyMetrics {
+public:
+    static constexpr std::array<double, 12> kBucketsSeconds{
+        0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05, 0.1, 0.25, 0.5, 1.0, 2.5};
+
+    void observe(const std::string& route, int status, std::chrono::nanoseconds latency);
+
+    uint64_t count(const std::string& route) const;
+
+    std::string renderPrometheus() const;
+
+private:
+    struct Histogram {
+        std::array<uint64_t, kBucketsSeconds.size()> buckets{};  // Non-cumulative, rendered cumulatively
+        uint64_t count = 0;
+        double sum_seconds = 0.0;
+    };
+
+    mutable std::mutex mutex_;
+    std::map<std::string, Histogram> histograms_;
+    std::map<std::pair<std::string, int>, uint64_t> responses_;
+};
+
+} // namespace epoch_tearsheet
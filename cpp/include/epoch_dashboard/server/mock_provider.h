@@ -0,0 +1,33 @@
+#pragma once
+
+#include <cstdint>
+
+#include "epoch_dashboard/server/tearsheet_service.h"
+
+namespace epoch_frame {
+    class DataFrame;
+}
+
+namespace epoch_tearsheet {
+
+/**
+ * Deterministic synthetic strategy for local development and tests. A daily random walk
+ * for a strategy and its benchmark is turned into two lazily built categories:
+ *   Strategy: total return card and "equity" lines chart (protobuf data)
+ *   Risk:     "drawdown" area chart, series stored in the Arrow sidecar
+ */
+class MockTearSheetProvider final : public TearSheetProvider {
+public:
+    explicit MockTearSheetProvider(size_t days = 2520, uint64_t seed = 42);
+
+    FullDashboardBuilder load(const ArrowSidecarPtr& sidecar) const override;
+
+    // Timestamp (ms) index with strategy, benchmark and drawdown columns
+    epoch_frame::DataFrame makeDataFrame() const;
+
+private:
+    size_t days_;
+    uint64_t seed_;
+};
+
+} // namespace epoch_tearsheet
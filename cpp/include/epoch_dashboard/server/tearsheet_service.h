@@ -0,0 +1,109 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "epoch_dashboard/server/latency_metrics.h"
+#include "epoch_dashboard/tearsheet/arrow_sidecar.h"
+#include "epoch_dashboard/tearsheet/tearsheet_builder.h"
+
+namespace epoch_tearsheet {
+
+/**
+ * Source of one served tearsheet. load() reads the provider's DataFrames and describes
+ * the dashboard; registering categories with addCategoryFactory keeps single-category
+ * requests from building the rest. Series stored in `sidecar` are served as Arrow IPC.
+ * load() runs once per registration or invalidate() and may be called from any thread.
+ */
+class TearSheetProvider {
+public:
+    virtual ~TearSheetProvider() = default;
+    virtual FullDashboardBuilder load(const ArrowSidecarPtr& sidecar) const = 0;
+};
+
+using TearSheetProviderPtr = std::shared_ptr<const TearSheetProvider>;
+
+struct ServiceRequest {
+    std::string path;                          // URL-decoded path, e.g. /tearsheets/mock/categories/Risk
+    std::map<std::string, std::string> query;
+    std::string if_none_match;
+};
+
+struct ServiceResponse {
+    int status = 200;
+    std::string content_type;
+    std::string body;
+    std::string etag;                          // Quoted content hash, empty for errors and metrics
+};
+
+/**
+ * Transport-independent request handling behind the HTTP server:
+ *
+ *   GET /tearsheets                                        provider ids, text
+ *   GET /tearsheets/{id}                                   FullTearSheet, protobuf
+ *   GET /tearsheets/{id}/categories                        category names, text
+ *   GET /tearsheets/{id}/categories/{category}             TearSheet, protobuf
+ *   GET /tearsheets/{id}/categories/{category}/charts/{n}  Chart, protobuf
+ *   GET /tearsheets/{id}/charts/{chart_id}/arrow           sidecar series, Arrow IPC stream
+ *   GET /metrics                                           Prometheus text
+ *
+ * Chart routes accept `from` and `to` query parameters (inclusive x range, epoch ms for
+ * time series) that trim line, area and numeric line data or sidecar rows.
+ * Serialized responses without a range are memoized per provider until invalidate();
+ * ranged responses are rebuilt per request. A request whose If-None-Match matches the
+ * content hash gets 304 with an empty body.
+ */
+class TearSheetService {
+public:
+    static constexpr const char* kProtobufContentType = "application/x-protobuf";
+    static constexpr const char* kArrowContentType = "application/vnd.apache.arrow.stream";
+    static constexpr const char* kTextContentType = "text/plain; charset=utf-8";
+    static constexpr const char* kMetricsContentType = "text/plain; version=0.0.4";
+
+    // @throws std::runtime_error if id is empty or already registered, or provider is null
+    void registerProvider(const std::string& id, TearSheetProviderPtr provider);
+
+    // Drop the loaded dashboard and memoized responses; the next request reloads
+    void invalidate(const std::string& id);
+
+    std::vector<std::string> providerIds() const;
+
+    // Errors are reported as 4xx/5xx responses, never thrown
+    ServiceResponse handle(const ServiceRequest& request);
+
+    const LatencyMetrics& metrics() const { return metrics_; }
+
+    // Strong ETag: quoted 64-bit FNV-1a hash of the body in hex
+    static std::string etagFor(std::string_view body);
+
+    static bool etagMatches(std::string_view if_none_match, std::string_view etag);
+
+private:
+    struct Loaded {
+        std::mutex load_mutex;
+        std::optional<FullDashboardBuilder> dashboard;
+        ArrowSidecarPtr sidecar;
+
+        std::mutex responses_mutex;
+        std::map<std::string, ServiceResponse> responses;  // By path, unranged only
+    };
+
+    struct Registration {
+        TearSheetProviderPtr provider;
+        std::shared_ptr<Loaded> loaded;
+    };
+
+    std::shared_ptr<Loaded> load(const std::string& id) const;
+    ServiceResponse dispatch(const ServiceRequest& request, std::string& route) const;
+
+    mutable std::mutex registry_mutex_;
+    std::map<std::string, Registration> registry_;
+    LatencyMetrics metrics_;
+};
+
+} // namespace epoch_tearsheet
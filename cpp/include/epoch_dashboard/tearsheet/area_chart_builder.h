@@ -4,7 +4,9 @@
 #include <vector>
 
 #include "epoch_protos/chart_def.pb.h"
+#include "epoch_dashboard/tearsheet/arrow_sidecar.h"
 #include "epoch_dashboard/tearsheet/chart_builder_base.h"
+#include "epoch_dashboard/tearsheet/drawdown_period.h"
 #include "epoch_dashboard/tearsheet/validation_utils.h"
 
 namespace epoch_frame {
@@ -27,6 +29,30 @@ public:
     AreaChartBuilder& setStackType(epoch_proto::StackType stack_type);
     AreaChartBuilder& fromDataFrame(const epoch_frame::DataFrame& df, const std::vector<std::string>& y_cols);
 
+    /**
+     * Underwater area (wealth / running peak - 1) of a timestamp-indexed equity column,
+     * written point by point while the peak is tracked. The same pass records drawdown
+     * periods and keeps the options.top_n deepest; see drawdownPeriods. Null and NaN
+     * rows are skipped.
+     * @throws std::runtime_error on a missing or non-numeric column or non-positive equity
+     */
+    AreaChartBuilder& fromEquityCurve(const epoch_frame::DataFrame& df,
+                                      const std::string& equity_col,
+                                      const DrawdownOptions& options = {});
+    // As fromEquityCurve on wealth compounded from simple returns, starting at 1
+    AreaChartBuilder& fromReturns(const epoch_frame::DataFrame& df,
+                                  const std::string& returns_col,
+                                  const DrawdownOptions& options = {});
+
+    /**
+     * Deepest periods of the last fromEquityCurve/fromReturns call, deepest first; feed
+     * them to LinesChartBuilder::addDrawdownBands and TableBuilder::fromDrawdownPeriods
+     */
+    const std::vector<DrawdownPeriod>& drawdownPeriods() const { return drawdown_periods_; }
+
+    // fromDataFrame stores series in the sidecar under the chart id and adds data-less lines
+    AreaChartBuilder& setArrowSidecar(ArrowSidecarPtr sidecar);
+
     // Validation configuration
     AreaChartBuilder& setValidationOptions(const ValidationUtils::ValidationOptions& options);
     AreaChartBuilder& setAutoSort(bool auto_sort);
@@ -37,6 +63,12 @@ public:
 private:
     epoch_proto::AreaDef area_def_;
     ValidationUtils::ValidationOptions validation_options_;
+    ArrowSidecarPtr sidecar_;
+    std::vector<DrawdownPeriod> drawdown_periods_;
+
+    void fromDataFrameToSidecar(const epoch_frame::DataFrame& df, const std::vector<std::string>& y_cols);
+    void addUnderwater(const epoch_frame::DataFrame& df, const std::string& column, bool compound,
+                       const DrawdownOptions& options);
 };
 
 } // namespace epoch_tearsheet
\ No newline at end of file
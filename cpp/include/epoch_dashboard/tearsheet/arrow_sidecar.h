@@ -0,0 +1,82 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+
+namespace epoch_tearsheet {
+
+/**
+ * Columnar side channel for large series. Charts built in sidecar mode keep their
+ * metadata (titles, axes, line names and styles) in the proto with empty line data;
+ * the series are stored here as Arrow tables keyed by ChartDef.id and shipped as
+ * Arrow IPC streams that the frontend reads with tableFromIPC.
+ *
+ * Table layout: column "x" (int64 epoch ms for time series, float64 for numeric
+ * lines) followed by one float64 column per line, named after the line.
+ * Null y values are kept as nulls rather than dropped.
+ */
+class ArrowSidecar {
+public:
+    static constexpr const char* kXColumn = "x";
+
+    /**
+     * Register the series table for a chart
+     * @throws std::runtime_error if id is empty or already registered
+     */
+    void add(const std::string& id, std::shared_ptr<arrow::Table> table);
+
+    bool contains(const std::string& id) const;
+    std::shared_ptr<arrow::Table> get(const std::string& id) const;
+    std::vector<std::string> ids() const;
+    size_t size() const;
+
+    /**
+     * Serialize one chart's table as an Arrow IPC stream
+     * @throws std::runtime_error if id is unknown or serialization fails
+     */
+    std::shared_ptr<arrow::Buffer> toIPC(const std::string& id) const;
+
+    // Serialize any table, e.g. a row slice of a registered one, as an Arrow IPC stream
+    static std::shared_ptr<arrow::Buffer> serializeIPC(const std::shared_ptr<arrow::Table>& table);
+
+    /**
+     * Build a time-series table. Millisecond timestamp and int64 indexes are reused
+     * without copying, as are float64 y columns; other types are converted.
+     * @param index Timestamp, int64 or uint64 index array
+     * @param table Source columns
+     * @param y_cols Columns to include; missing columns are skipped
+     */
+    static std::shared_ptr<arrow::Table> makeTimeSeriesTable(const std::shared_ptr<arrow::Array>& index,
+                                                             const std::shared_ptr<arrow::Table>& table,
+                                                             const std::vector<std::string>& y_cols);
+
+    // Same as makeTimeSeriesTable with a float64 x column; float64 indexes are reused
+    static std::shared_ptr<arrow::Table> makeNumericSeriesTable(const std::shared_ptr<arrow::Array>& index,
+                                                                const std::shared_ptr<arrow::Table>& table,
+                                                                const std::vector<std::string>& y_cols);
+
+    /**
+     * Build a table for a data table widget. String and dictionary-of-string columns with
+     * at most `max_distinct_ratio` distinct values per row are interned into a single
+     * dictionary<int32, utf8> chunk, so the IPC stream carries each distinct string once
+     * plus an int32 code per row. Every other column is reused without copying.
+     * @param columns Columns to include, all of them when empty
+     * @throws std::runtime_error on a missing column
+     */
+    static std::shared_ptr<arrow::Table> makeDictionaryTable(const std::shared_ptr<arrow::Table>& table,
+                                                             const std::vector<std::string>& columns = {},
+                                                             double max_distinct_ratio = 0.5);
+
+private:
+    mutable std::mutex mutex_;
+    std::map<std::string, std::shared_ptr<arrow::Table>> tables_;
+};
+
+using ArrowSidecarPtr = std::shared_ptr<ArrowSidecar>;
+
+} // namespace epoch_tearsheet
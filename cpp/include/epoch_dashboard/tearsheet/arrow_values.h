@@ -0,0 +1,69 @@
+#pragma once
+
+#include <memory>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include <arrow/api.h>
+
+namespace epoch_tearsheet {
+
+/**
+ * Numeric value column of one batch, read through its raw buffer. Shared by the
+ * builders that aggregate Arrow batches (BarChartBuilder, PieChartBuilder).
+ */
+class NumericValues {
+public:
+    // @throws std::runtime_error naming `owner` if the column is not numeric
+    NumericValues(const std::shared_ptr<arrow::Array>& array, std::string_view owner) : array_(array) {
+        switch (array->type_id()) {
+            case arrow::Type::DOUBLE: read_ = &NumericValues::at<double>; break;
+            case arrow::Type::FLOAT: read_ = &NumericValues::at<float>; break;
+            case arrow::Type::INT64: read_ = &NumericValues::at<int64_t>; break;
+            case arrow::Type::INT32: read_ = &NumericValues::at<int32_t>; break;
+            case arrow::Type::UINT64: read_ = &NumericValues::at<uint64_t>; break;
+            case arrow::Type::UINT32: read_ = &NumericValues::at<uint32_t>; break;
+            default:
+                throw std::runtime_error(std::string(owner) + ": value column must be numeric, got " +
+                                         array->type()->ToString());
+        }
+    }
+
+    bool isValid(int64_t i) const { return array_->IsValid(i); }
+    double operator[](int64_t i) const { return (this->*read_)(i); }
+
+private:
+    template <typename T>
+    double at(int64_t i) const {
+        return static_cast<double>(array_->data()->GetValues<T>(1)[i]);
+    }
+
+    std::shared_ptr<arrow::Array> array_;
+    double (NumericValues::*read_)(int64_t) const = nullptr;
+};
+
+/**
+ * Calls visit with the raw index buffer of a dictionary array, typed by its index type
+ * (e.g. const int32_t*), so per-row loops run on plain integers.
+ * @throws std::runtime_error naming `owner` on an unsupported index type
+ */
+template <typename Visitor>
+void visitDictionaryIndices(const arrow::DictionaryArray& array, std::string_view owner, Visitor&& visit) {
+    const auto& data = *array.indices()->data();
+    switch (array.indices()->type_id()) {
+        case arrow::Type::INT8: return visit(data.GetValues<int8_t>(1));
+        case arrow::Type::INT16: return visit(data.GetValues<int16_t>(1));
+        case arrow::Type::INT32: return visit(data.GetValues<int32_t>(1));
+        case arrow::Type::INT64: return visit(data.GetValues<int64_t>(1));
+        case arrow::Type::UINT8: return visit(data.GetValues<uint8_t>(1));
+        case arrow::Type::UINT16: return visit(data.GetValues<uint16_t>(1));
+        case arrow::Type::UINT32: return visit(data.GetValues<uint32_t>(1));
+        case arrow::Type::UINT64: return visit(data.GetValues<uint64_t>(1));
+        default:
+            throw std::runtime_error(std::string(owner) + ": unsupported dictionary index type " +
+                                     array.indices()->type()->ToString());
+    }
+}
+
+} // namespace epoch_tearsheet
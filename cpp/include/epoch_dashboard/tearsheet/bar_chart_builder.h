@@ -14,6 +14,19 @@ namespace epoch_frame {
 
 namespace epoch_tearsheet {
 
+enum class BarAggregation {
+    Sum,
+    Mean,
+    Count,
+    Last
+};
+
+enum class BarSortOrder {
+    None,
+    Ascending,
+    Descending
+};
+
 class BarChartBuilder : public ChartBuilderBase<BarChartBuilder> {
 public:
     BarChartBuilder();
@@ -32,6 +45,23 @@ public:
     BarChartBuilder& fromSeries(const epoch_frame::Series& series);
     BarChartBuilder& fromDataFrame(const epoch_frame::DataFrame& df, const std::string& column);
 
+    /**
+     * Group rows by category_col and aggregate each value column into one BarData, with
+     * the groups as x-axis categories in order of first appearance, or ordered by the
+     * first value column when `sort` is set. Record batches are hash-aggregated in
+     * parallel and merged in row order. Null categories are skipped, Count counts non-null
+     * values, and Mean/Last of a group without values is 0. Aggregates are validated
+     * like addBarData: no NaN or infinite values, and no negatives on a stacked chart.
+     * @throws std::runtime_error on missing columns, a non-numeric value column, a
+     *         category column that is neither string nor dictionary of strings, or an
+     *         aggregate that fails validation
+     */
+    BarChartBuilder& fromDataFrame(const epoch_frame::DataFrame& df,
+                                   const std::string& category_col,
+                                   const std::vector<std::string>& value_cols,
+                                   BarAggregation agg,
+                                   BarSortOrder sort = BarSortOrder::None);
+
     epoch_proto::Chart build() const;
 
 private:
@@ -5,6 +5,7 @@
 
 #include "epoch_protos/chart_def.pb.h"
 #include "epoch_dashboard/tearsheet/chart_builder_base.h"
+#include "epoch_dashboard/tearsheet/quantile_sketch.h"
 
 namespace epoch_tearsheet {
 
@@ -19,6 +20,15 @@ public:
     BoxPlotChartBuilder& addOutlier(const epoch_proto::BoxPlotOutlier& outlier);
     BoxPlotChartBuilder& addDataPoint(const epoch_proto::BoxPlotDataPoint& point);
 
+    /**
+     * Next box from the sketch's quartiles, within its rank error. Whiskers end at the
+     * Tukey fences (q1 - whisker * IQR, q3 + whisker * IQR) clipped to the exact min and
+     * max, since a sketch cannot name the last value inside a fence; the min and max
+     * become this box's only outliers when they fall outside.
+     * @throws std::runtime_error if the sketch is empty
+     */
+    BoxPlotChartBuilder& addSketch(const QuantileSketch& sketch, double whisker = 1.5);
+
     epoch_proto::Chart build() const;
 
 private:
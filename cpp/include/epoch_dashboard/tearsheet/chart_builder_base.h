@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "epoch_protos/chart_def.pb.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
 
 namespace epoch_tearsheet {
 
@@ -14,6 +15,8 @@ protected:
         return static_cast<DerivedBuilder*>(this)->getChartDefImpl();
     }
 
+    const InstrumentationSinkPtr& instrumentationSink() const { return instrumentation_sink_; }
+
 public:
     DerivedBuilder& setTitle(const std::string& title) {
         getChartDef()->set_title(title);
@@ -67,6 +70,15 @@ public:
         }
         return static_cast<DerivedBuilder&>(*this);
     }
+
+    // Spans from this builder go to `sink`, e.g. its dashboard's, instead of the current sink
+    DerivedBuilder& setInstrumentationSink(InstrumentationSinkPtr sink) {
+        instrumentation_sink_ = std::move(sink);
+        return static_cast<DerivedBuilder&>(*this);
+    }
+
+private:
+    InstrumentationSinkPtr instrumentation_sink_;
 };
 
 } // namespace epoch_tearsheet
\ No newline at end of file
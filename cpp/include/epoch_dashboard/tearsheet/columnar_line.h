@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "epoch_protos/chart_def.pb.h"
+
+namespace epoch_tearsheet {
+
+/**
+ * Column-oriented line: parallel x/y vectors instead of one Point message per sample
+ */
+struct ColumnarLine {
+    std::string name;
+    std::optional<epoch_proto::DashStyle> dash_style;
+    std::optional<uint32_t> line_width;
+    std::vector<int64_t> x;
+    std::vector<double> y;
+
+    size_t size() const { return x.size(); }
+};
+
+struct ColumnarNumericLine {
+    std::string name;
+    std::optional<epoch_proto::DashStyle> dash_style;
+    std::optional<uint32_t> line_width;
+    std::vector<double> x;
+    std::vector<double> y;
+
+    size_t size() const { return x.size(); }
+};
+
+/**
+ * Protobuf wire encoding for columnar lines, decodable by any protobuf runtime with:
+ *
+ *   message ColumnarLine {
+ *     string name = 1;
+ *     repeated sint64 x = 2 [packed = true];   // delta-encoded, first value absolute
+ *     repeated double y = 3 [packed = true];
+ *     optional DashStyle dash_style = 4;
+ *     optional uint32 line_width = 5;
+ *   }
+ *
+ *   message ColumnarNumericLine {
+ *     string name = 1;
+ *     repeated double x = 2 [packed = true];
+ *     repeated double y = 3 [packed = true];
+ *     optional DashStyle dash_style = 4;
+ *     optional uint32 line_width = 5;
+ *   }
+ *
+ * Daily millisecond timestamps take ~4 bytes per delta instead of a nested Point
+ * with tags and a length prefix (~18 bytes per sample).
+ */
+class ColumnarLineCodec {
+public:
+    // @throws std::runtime_error if x and y lengths differ
+    static std::string encode(const ColumnarLine& line);
+    static std::string encode(const ColumnarNumericLine& line);
+
+    // @throws std::runtime_error on malformed input
+    static ColumnarLine decodeLine(std::string_view bytes);
+    static ColumnarNumericLine decodeNumericLine(std::string_view bytes);
+
+    // Compatibility converters for clients that only understand Point-based lines
+    static epoch_proto::Line toLegacy(const ColumnarLine& line);
+    static epoch_proto::NumericLine toLegacy(const ColumnarNumericLine& line);
+    static ColumnarLine fromLegacy(const epoch_proto::Line& line);
+    static ColumnarNumericLine fromLegacy(const epoch_proto::NumericLine& line);
+};
+
+} // namespace epoch_tearsheet
@@ -15,4 +15,10 @@
 #include "epoch_dashboard/tearsheet/boxplot_chart_builder.h"
 #include "epoch_dashboard/tearsheet/xrange_chart_builder.h"
 #include "epoch_dashboard/tearsheet/pie_chart_builder.h"
-#include "epoch_dashboard/tearsheet/tearsheet_builder.h"
\ No newline at end of file
+#include "epoch_dashboard/tearsheet/tearsheet_builder.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include "epoch_dashboard/tearsheet/payload_budget.h"
+#include "epoch_dashboard/tearsheet/framed_serializer.h"
+#include "epoch_dashboard/tearsheet/arrow_sidecar.h"
+#include "epoch_dashboard/tearsheet/columnar_line.h"
+#include "epoch_dashboard/tearsheet/streaming_writer.h"
\ No newline at end of file
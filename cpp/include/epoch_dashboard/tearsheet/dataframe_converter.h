@@ -6,6 +6,7 @@
 #include "epoch_protos/chart_def.pb.h"
 #include "epoch_protos/table_def.pb.h"
 #include "epoch_protos/common.pb.h"
+#include "epoch_dashboard/tearsheet/columnar_line.h"
 #include <arrow/api.h>
 
 namespace epoch_frame {
@@ -45,6 +46,13 @@ public:
                                                   const std::string& x_column,
                                                   const std::vector<std::string>& y_columns);
 
+    // One line per y column keyed by the frame index; rows with a null x or y are skipped
+    static std::vector<ColumnarLine> toColumnarLines(const epoch_frame::DataFrame& df,
+                                                     const std::vector<std::string>& y_columns);
+
+    static std::vector<ColumnarNumericLine> toColumnarNumericLines(const epoch_frame::DataFrame& df,
+                                                                   const std::vector<std::string>& y_columns);
+
     static epoch_proto::Array toArray(const epoch_frame::DataFrame& df,
                                      const std::string& column_name);
 
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+
+namespace epoch_tearsheet {
+
+/**
+ * One stretch below a running high of the wealth curve, from the last row at the high
+ * to the first row back at it. All times are epoch milliseconds.
+ */
+struct DrawdownPeriod {
+    int64_t peak_ms = 0;
+    int64_t trough_ms = 0;
+    std::optional<int64_t> recovery_ms;  // Unset while still underwater at the last row
+    int64_t end_ms = 0;                  // Recovery, or the last row if not recovered
+    double depth = 0.0;                  // Drawdown at the trough, < 0
+    size_t rows = 0;                     // Rows from the peak to end_ms
+};
+
+struct DrawdownOptions {
+    std::string name = "Drawdown";
+    size_t top_n = 5;  // Deepest periods kept, see AreaChartBuilder::drawdownPeriods
+};
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,62 @@
+#pragma once
+
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+
+namespace epoch_frame {
+    class DataFrame;
+}
+
+namespace epoch_tearsheet {
+
+/**
+ * SQL widgets over an in-memory DuckDB database. Registered Arrow tables are scanned
+ * in place through the Arrow C stream interface and results come back as Arrow record
+ * batches imported without copying, so queryDataFrame() output goes straight into
+ * TableBuilder, BarChartBuilder, PieChartBuilder or HeatMapChartBuilder::fromDataFrame.
+ *
+ *   engine.registerParquet("trades", "backtest/trades.parquet");
+ *   auto df = engine.queryDataFrame(
+ *       "SELECT sector, date_trunc('month', exit_time) AS month, sum(pnl) AS pnl "
+ *       "FROM trades GROUP BY ALL ORDER BY month");
+ *
+ * Every query runs on its own connection, so widgets can be queried concurrently.
+ * A registered Arrow table is exposed to each query as a one-shot stream and can be
+ * referenced once per query; use a Parquet view or a CTE for self-joins.
+ */
+class DuckDbQueryEngine {
+public:
+    // @throws std::runtime_error if the database cannot be opened
+    DuckDbQueryEngine();
+    ~DuckDbQueryEngine();
+
+    DuckDbQueryEngine(const DuckDbQueryEngine&) = delete;
+    DuckDbQueryEngine& operator=(const DuckDbQueryEngine&) = delete;
+
+    // Visible to queries as `name`; replaces a table registered under the same name
+    void registerTable(const std::string& name, std::shared_ptr<arrow::Table> table);
+
+    // Create a view `name` over read_parquet(path); DuckDB prunes columns and row groups
+    void registerParquet(const std::string& name, const std::string& path);
+
+    // @throws std::runtime_error with DuckDB's message if the query fails
+    std::shared_ptr<arrow::Table> query(const std::string& sql) const;
+    epoch_frame::DataFrame queryDataFrame(const std::string& sql) const;
+
+    // Run independent widget queries in parallel; results are in input order
+    std::vector<std::shared_ptr<arrow::Table>> queryAll(const std::vector<std::string>& sqls) const;
+
+private:
+    struct Database;
+
+    std::unique_ptr<Database> database_;
+    mutable std::mutex tables_mutex_;
+    std::map<std::string, std::shared_ptr<arrow::Table>> tables_;
+};
+
+} // namespace epoch_tearsheet
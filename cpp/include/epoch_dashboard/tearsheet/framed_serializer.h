@@ -0,0 +1,95 @@
+#pragma once
+
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "epoch_protos/tearsheet.pb.h"
+
+namespace epoch_tearsheet {
+
+/**
+ * Framed, zstd-compressed FullTearSheet container.
+ *
+ * Layout (little-endian):
+ *   magic "EPTF" | u16 version | u8 granularity | u8 reserved | u32 frame_count
+ *   frame_count x index entry:
+ *     u16 category_len | category | u8 kind | u32 chart_index | u64 offset | u64 compressed | u64 raw
+ *   frames, each an independent zstd frame; offsets are relative to the first frame
+ *
+ * A Category frame holds a serialized TearSheet. At Chart granularity a category is split
+ * into one Category frame (cards and tables) plus one Chart frame per chart.
+ */
+enum class FrameGranularity : uint8_t {
+    Category = 0,
+    Chart = 1
+};
+
+enum class FrameKind : uint8_t {
+    Category = 0,
+    Chart = 1
+};
+
+struct FramedWriteOptions {
+    int compression_level = 3;
+    FrameGranularity granularity = FrameGranularity::Category;
+};
+
+struct FrameIndexEntry {
+    std::string category;
+    FrameKind kind = FrameKind::Category;
+    uint32_t chart_index = 0;         // Position in TearSheet.charts for Chart frames
+    uint64_t offset = 0;
+    uint64_t compressed_size = 0;
+    uint64_t raw_size = 0;
+};
+
+class FramedTearSheetWriter {
+public:
+    /**
+     * Serialize and compress every frame in parallel, then write header, index and frames
+     * @return Total bytes written
+     * @throws std::runtime_error on compression or stream failure
+     */
+    static uint64_t write(const epoch_proto::FullTearSheet& full_tearsheet,
+                          std::ostream& out,
+                          const FramedWriteOptions& options = {});
+
+    static std::string writeToString(const epoch_proto::FullTearSheet& full_tearsheet,
+                                     const FramedWriteOptions& options = {});
+};
+
+/**
+ * Random-access reader over a seekable stream. Only the index is read up front;
+ * categories are decompressed on demand, one frame at a time.
+ */
+class FramedTearSheetReader {
+public:
+    // @throws std::runtime_error on a bad header or an index that does not fit the stream
+    explicit FramedTearSheetReader(std::istream& in);
+
+    const std::vector<FrameIndexEntry>& index() const { return index_; }
+    FrameGranularity granularity() const { return granularity_; }
+
+    // Category names in index order, without duplicates
+    std::vector<std::string> categories() const;
+    bool hasCategory(const std::string& category) const;
+
+    // @throws std::runtime_error if the category is missing or a frame is corrupt
+    epoch_proto::TearSheet readCategory(const std::string& category);
+    epoch_proto::FullTearSheet readAll();
+
+private:
+    std::string readFrame(const FrameIndexEntry& entry);
+
+    std::istream& in_;
+    std::streamoff data_start_ = 0;
+    std::streamoff stream_end_ = 0;
+    FrameGranularity granularity_ = FrameGranularity::Category;
+    std::vector<FrameIndexEntry> index_;
+    std::string compressed_buffer_;
+};
+
+} // namespace epoch_tearsheet
@@ -6,6 +6,10 @@
 #include "epoch_protos/chart_def.pb.h"
 #include "epoch_dashboard/tearsheet/chart_builder_base.h"
 
+namespace epoch_frame {
+    class DataFrame;
+}
+
 namespace epoch_tearsheet {
 
 class HeatMapChartBuilder : public ChartBuilderBase<HeatMapChartBuilder> {
@@ -19,6 +23,15 @@ public:
     HeatMapChartBuilder& addPoint(uint64_t x, uint64_t y, double value);
     HeatMapChartBuilder& addPoints(const std::vector<epoch_proto::HeatMapPoint>& points);
 
+    /**
+     * One point per row. Integer x/y columns are used as axis indexes; any other type
+     * becomes axis categories in order of first appearance. Rows with nulls are skipped.
+     */
+    HeatMapChartBuilder& fromDataFrame(const epoch_frame::DataFrame& df,
+                                       const std::string& x_col,
+                                       const std::string& y_col,
+                                       const std::string& value_col);
+
     epoch_proto::Chart build() const;
 
 private:
@@ -5,6 +5,7 @@
 
 #include "epoch_protos/chart_def.pb.h"
 #include "epoch_dashboard/tearsheet/chart_builder_base.h"
+#include "epoch_dashboard/tearsheet/quantile_sketch.h"
 #include "epoch_dashboard/tearsheet/validation_utils.h"
 
 namespace epoch_frame {
@@ -28,6 +29,15 @@ public:
     HistogramChartBuilder& fromSeries(const epoch_frame::Series& series, uint32_t bins = 30);
     HistogramChartBuilder& fromDataFrame(const epoch_frame::DataFrame& df, const std::string& column, uint32_t bins = 30);
 
+    /**
+     * Histogram of a distribution too large to ship: the data is sample_size evenly
+     * spaced quantiles of the sketch, each standing for count() / sample_size values, so
+     * bin heights follow the full distribution within the sketch's rank error. For
+     * equal-frequency bins use QuantileSketch::binEdges instead.
+     * @throws std::runtime_error if the sketch is empty or bins does not suit sample_size
+     */
+    HistogramChartBuilder& fromSketch(const QuantileSketch& sketch, uint32_t bins = 30, uint32_t sample_size = 1000);
+
     epoch_proto::Chart build() const;
 
 private:
@@ -0,0 +1,185 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+
+#include "epoch_protos/chart_def.pb.h"
+
+#ifndef EPOCH_DASHBOARD_INSTRUMENTATION
+#define EPOCH_DASHBOARD_INSTRUMENTATION 1
+#endif
+
+namespace epoch_tearsheet {
+
+enum class SpanPhase {
+    Conversion,   // DataFrame/Series -> proto conversion
+    Validation,   // Data integrity checks (monotonic, finite, stacked)
+    Build         // Proto assembly in build()
+};
+
+std::string_view toString(SpanPhase phase);
+
+/**
+ * A single timed unit of builder work reported to an InstrumentationSink
+ */
+struct BuildSpan {
+    std::string_view builder;             // Builder type, e.g. "LinesChartBuilder"
+    SpanPhase phase = SpanPhase::Build;
+    std::string chart_id;
+    std::string title;
+    int64_t rows_in = 0;                  // Source rows consumed
+    int64_t points_out = 0;               // Points/rows/values emitted
+    int64_t bytes_serialized = 0;         // Serialized size of the produced message, when known
+    int64_t allocations = 0;              // Allocations observed, requires an allocation counter
+    std::chrono::steady_clock::time_point start;
+    std::chrono::nanoseconds wall_time{0};
+    std::thread::id thread_id;
+};
+
+/**
+ * Receives spans from builders. Implementations must be thread-safe when
+ * builders run on multiple threads.
+ */
+class InstrumentationSink {
+public:
+    virtual ~InstrumentationSink() = default;
+    virtual void onSpan(const BuildSpan& span) = 0;
+};
+
+using InstrumentationSinkPtr = std::shared_ptr<InstrumentationSink>;
+
+class NullInstrumentationSink final : public InstrumentationSink {
+public:
+    void onSpan(const BuildSpan&) override {}
+};
+
+/**
+ * Writes spans as Chrome trace-event JSON ("X" complete events), loadable in
+ * Perfetto or chrome://tracing. The JSON array is closed by close() or on destruction.
+ */
+class ChromeTraceSink final : public InstrumentationSink {
+public:
+    explicit ChromeTraceSink(std::ostream& out);
+    explicit ChromeTraceSink(const std::string& path);
+    ~ChromeTraceSink() override;
+
+    void onSpan(const BuildSpan& span) override;
+    void close();
+
+private:
+    std::ofstream file_;
+    std::ostream& out_;
+    std::mutex mutex_;
+    std::chrono::steady_clock::time_point origin_;
+    std::unordered_map<std::thread::id, uint64_t> thread_ids_;
+    bool first_event_ = true;
+    bool closed_ = false;
+};
+
+/**
+ * Process-wide sink registration. Builders report to the innermost
+ * InstrumentationScope on the current thread, falling back to the global sink.
+ */
+class Instrumentation {
+public:
+    static void setGlobalSink(InstrumentationSinkPtr sink);
+    static InstrumentationSinkPtr globalSink();
+    static InstrumentationSinkPtr currentSink();
+
+    /**
+     * Register a monotonically increasing allocation counter (e.g. from a custom
+     * operator new or allocator statistics). Spans report the delta.
+     */
+    static void setAllocationCounter(std::function<uint64_t()> counter);
+    static uint64_t allocationCount();
+};
+
+/**
+ * Routes spans emitted on this thread to a specific sink for the scope lifetime
+ */
+class InstrumentationScope {
+public:
+    explicit InstrumentationScope(InstrumentationSinkPtr sink);
+    ~InstrumentationScope();
+
+    InstrumentationScope(const InstrumentationScope&) = delete;
+    InstrumentationScope& operator=(const InstrumentationScope&) = delete;
+
+private:
+    InstrumentationSinkPtr previous_;
+};
+
+#if EPOCH_DASHBOARD_INSTRUMENTATION
+
+/**
+ * RAII span: starts timing on construction and reports to the current sink on
+ * destruction. When no sink is registered, it does nothing beyond one lookup.
+ */
+class ScopedSpan {
+public:
+    ScopedSpan(std::string_view builder, SpanPhase phase);
+    // Reports to `sink` when it is set, otherwise to the current sink
+    ScopedSpan(std::string_view builder, SpanPhase phase, const InstrumentationSinkPtr& sink);
+    ~ScopedSpan();
+
+    ScopedSpan(const ScopedSpan&) = delete;
+    ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+    bool active() const { return sink_ != nullptr; }
+
+    // Chart id and title are read when the span closes, so setters called later still apply
+    ScopedSpan& describe(const epoch_proto::ChartDef& chart_def) {
+        chart_def_ = &chart_def;
+        return *this;
+    }
+    ScopedSpan& setTitle(std::string_view title) {
+        if (sink_) span_.title = title;
+        return *this;
+    }
+    ScopedSpan& setRowsIn(int64_t rows) {
+        span_.rows_in = rows;
+        return *this;
+    }
+    ScopedSpan& addPointsOut(int64_t points) {
+        span_.points_out += points;
+        return *this;
+    }
+    ScopedSpan& setBytesSerialized(int64_t bytes) {
+        span_.bytes_serialized = bytes;
+        return *this;
+    }
+
+private:
+    InstrumentationSinkPtr sink_;
+    const epoch_proto::ChartDef* chart_def_ = nullptr;
+    uint64_t allocations_at_start_ = 0;
+    BuildSpan span_;
+};
+
+#else
+
+class ScopedSpan {
+public:
+    constexpr ScopedSpan(std::string_view, SpanPhase) {}
+    ScopedSpan(std::string_view, SpanPhase, const InstrumentationSinkPtr&) {}
+
+    constexpr bool active() const { return false; }
+    constexpr ScopedSpan& describe(const epoch_proto::ChartDef&) { return *this; }
+    constexpr ScopedSpan& setTitle(std::string_view) { return *this; }
+    constexpr ScopedSpan& setRowsIn(int64_t) { return *this; }
+    constexpr ScopedSpan& addPointsOut(int64_t) { return *this; }
+    constexpr ScopedSpan& setBytesSerialized(int64_t) { return *this; }
+};
+
+#endif
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstdint>
+#include <ostream>
+#include <string>
+
+#include "epoch_protos/tearsheet.pb.h"
+
+namespace epoch_tearsheet {
+
+/**
+ * Protobuf canonical JSON for tearsheets without descriptor reflection. Each message
+ * has a hand-written visitor that emits the layout of MessageToJsonString with default
+ * options: lowerCamelCase names in field number order, 64-bit integers as strings,
+ * enums by name, unset optional and default-valued plain fields omitted, map keys
+ * sorted and non-finite doubles as "NaN"/"Infinity"/"-Infinity".
+ *
+ * Numbers are formatted with glaze's shortest round-trip conversions and appended to
+ * a single growing buffer. The output parses with JsonStringToMessage into an equal
+ * message, but a double may be spelled differently than protobuf would spell it
+ * (e.g. exponent notation). Visitors must be updated when the protos gain fields.
+ */
+class JsonSerializer {
+public:
+    static std::string toJson(const epoch_proto::FullTearSheet& tearsheet);
+    static std::string toJson(const epoch_proto::TearSheet& tearsheet);
+    static std::string toJson(const epoch_proto::Chart& chart);
+    static std::string toJson(const epoch_proto::Table& table);
+
+    /**
+     * Stream through a bounded buffer that is flushed to `out` whenever it fills,
+     * so the full document never has to be held in memory.
+     * @return Bytes written
+     * @throws std::runtime_error if the output stream reports an error
+     */
+    static uint64_t writeTo(const epoch_proto::FullTearSheet& tearsheet, std::ostream& out);
+
+    static constexpr size_t kFlushBytes = 1 << 20;
+};
+
+} // namespace epoch_tearsheet
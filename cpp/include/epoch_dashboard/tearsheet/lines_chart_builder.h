@@ -4,7 +4,9 @@
 #include <vector>
 
 #include "epoch_protos/chart_def.pb.h"
+#include "epoch_dashboard/tearsheet/arrow_sidecar.h"
 #include "epoch_dashboard/tearsheet/chart_builder_base.h"
+#include "epoch_dashboard/tearsheet/drawdown_period.h"
 #include "epoch_dashboard/tearsheet/validation_utils.h"
 
 namespace epoch_frame {
@@ -26,10 +28,15 @@ public:
     LinesChartBuilder& addStraightLine(const epoch_proto::StraightLineDef& line);
     LinesChartBuilder& addYPlotBand(const epoch_proto::Band& band);
     LinesChartBuilder& addXPlotBand(const epoch_proto::Band& band);
+    // One x band per period, from the peak to the recovery (or the last row)
+    LinesChartBuilder& addDrawdownBands(const std::vector<DrawdownPeriod>& periods);
     LinesChartBuilder& setOverlay(const epoch_proto::Line& overlay);
     LinesChartBuilder& setStacked(bool stacked);
     LinesChartBuilder& fromDataFrame(const epoch_frame::DataFrame& df, const std::vector<std::string>& y_cols);
 
+    // fromDataFrame stores series in the sidecar under the chart id and adds data-less lines
+    LinesChartBuilder& setArrowSidecar(ArrowSidecarPtr sidecar);
+
     // Validation configuration
     LinesChartBuilder& setValidationOptions(const ValidationUtils::ValidationOptions& options);
     LinesChartBuilder& setAutoSort(bool auto_sort);
@@ -41,6 +48,9 @@ public:
 private:
     epoch_proto::LinesDef lines_def_;
     ValidationUtils::ValidationOptions validation_options_;
+    ArrowSidecarPtr sidecar_;
+
+    void fromDataFrameToSidecar(const epoch_frame::DataFrame& df, const std::vector<std::string>& y_cols);
 
     void processDataFrameWithTimestampIndex(const epoch_frame::DataFrame& df,
                                             const std::vector<std::string>& y_cols,
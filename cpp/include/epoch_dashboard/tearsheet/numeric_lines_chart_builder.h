@@ -4,6 +4,7 @@
 #include <vector>
 
 #include "epoch_protos/chart_def.pb.h"
+#include "epoch_dashboard/tearsheet/arrow_sidecar.h"
 #include "epoch_dashboard/tearsheet/chart_builder_base.h"
 #include "epoch_dashboard/tearsheet/validation_utils.h"
 
@@ -30,6 +31,9 @@ public:
     NumericLinesChartBuilder& setStacked(bool stacked);
     NumericLinesChartBuilder& fromDataFrame(const epoch_frame::DataFrame& df, const std::vector<std::string>& y_cols);
 
+    // fromDataFrame stores series in the sidecar under the chart id and adds data-less lines
+    NumericLinesChartBuilder& setArrowSidecar(ArrowSidecarPtr sidecar);
+
     // Validation configuration
     NumericLinesChartBuilder& setValidationOptions(const ValidationUtils::ValidationOptions& options);
     NumericLinesChartBuilder& setAutoSort(bool auto_sort);
@@ -41,6 +45,9 @@ public:
 private:
     epoch_proto::NumericLinesDef numeric_lines_def_;
     ValidationUtils::ValidationOptions validation_options_;
+    ArrowSidecarPtr sidecar_;
+
+    void fromDataFrameToSidecar(const epoch_frame::DataFrame& df, const std::vector<std::string>& y_cols);
 
     template<typename IndexType>
     void processDataFrameWithNumericIndex(const epoch_frame::DataFrame& df,
@@ -0,0 +1,124 @@
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include <arrow/api.h>
+
+namespace epoch_frame {
+    class DataFrame;
+}
+
+namespace epoch_tearsheet {
+
+/**
+ * Bucketing rule for OHLCV bars. Boundaries are computed in exchange local time
+ * (UTC + utc_offset_ms) and anchored at the session open, so with a 09:30 open
+ * hourly bars start at 09:30, 10:30, ... and daily bars roll at 09:30 local time.
+ */
+struct ResampleSpec {
+    enum class Unit {
+        Fixed,   // duration_ms buckets, restarting at every session open
+        Day,
+        Week,    // Weeks start on Monday
+        Month
+    };
+
+    Unit unit = Unit::Fixed;
+    int64_t duration_ms = 60000;    // Fixed only
+    int64_t count = 1;              // Calendar units per bucket, e.g. 3 months
+    int64_t utc_offset_ms = 0;
+    int64_t session_open_ms = 0;    // Local time of day, e.g. 9.5 * 3600000
+
+    static ResampleSpec fixed(int64_t duration_ms);
+    static ResampleSpec calendar(Unit unit, int64_t count = 1);
+
+    /**
+     * Parse the frontend timeframe strings ("5m", "1H", "1D", "1W", "1M", "1Q", "1Y");
+     * same units as getMsPerBar in BackendPaddingUtils, but months, quarters and years
+     * are calendar buckets instead of 30/91/365 day approximations.
+     * @throws std::runtime_error on unrecognized strings
+     */
+    static ResampleSpec fromTimeframe(std::string_view timeframe);
+};
+
+/**
+ * Source columns. For ticks, point open/high/low/close at the price column.
+ * An empty volume name skips the volume column.
+ */
+struct OhlcvColumns {
+    std::string timestamp = "timestamp";
+    std::string open = "open";
+    std::string high = "high";
+    std::string low = "low";
+    std::string close = "close";
+    std::string volume = "volume";
+
+    static OhlcvColumns ticks(const std::string& price = "price", const std::string& volume = "volume");
+};
+
+/**
+ * Streaming OHLCV aggregation over time-sorted batches. Each batch is scanned once
+ * through its raw buffers; only the running bar and the output columns are kept, so
+ * input size is bounded by the caller's batch size, not the dataset.
+ *
+ * Output table: timestamp (ms, bucket start), open, high, low, close[, volume] as
+ * float64. Rows with a null in any used column are skipped.
+ */
+class OhlcvResampler {
+public:
+    explicit OhlcvResampler(ResampleSpec spec, OhlcvColumns columns = {});
+
+    /**
+     * Aggregate the next batch. The timestamp column may be any timestamp unit or int64
+     * epoch ms; price and volume columns float64 or int64.
+     * @throws std::runtime_error on missing columns, unsupported types or timestamps
+     *         earlier than previously seen ones
+     */
+    void update(const arrow::RecordBatch& batch);
+    void update(const arrow::Table& table);
+
+    // Close the running bar and return all bars; the resampler is reset
+    std::shared_ptr<arrow::Table> finish();
+
+    // Resample a frame whose index holds the timestamps
+    static std::shared_ptr<arrow::Table> resample(const epoch_frame::DataFrame& df, const ResampleSpec& spec,
+                                                  OhlcvColumns columns = {});
+
+    // Timestamp-indexed frame of a finish() table, ready for the chart builders
+    static epoch_frame::DataFrame toDataFrame(const std::shared_ptr<arrow::Table>& bars);
+
+    // Start of the bucket containing `timestamp_ms` under `spec`, in UTC ms
+    static int64_t bucketStart(int64_t timestamp_ms, const ResampleSpec& spec);
+
+private:
+    struct Bar {
+        int64_t start = 0;
+        int64_t end = 0;
+        double open = 0.0;
+        double high = 0.0;
+        double low = 0.0;
+        double close = 0.0;
+        double volume = 0.0;
+    };
+
+    void flush();
+
+    ResampleSpec spec_;
+    OhlcvColumns columns_;
+    bool has_bar_ = false;
+    Bar bar_;
+    int64_t last_timestamp_ = std::numeric_limits<int64_t>::min();
+
+    arrow::TimestampBuilder timestamps_{arrow::timestamp(arrow::TimeUnit::MILLI), arrow::default_memory_pool()};
+    arrow::DoubleBuilder open_;
+    arrow::DoubleBuilder high_;
+    arrow::DoubleBuilder low_;
+    arrow::DoubleBuilder close_;
+    arrow::DoubleBuilder volume_;
+};
+
+} // namespace epoch_tearsheet
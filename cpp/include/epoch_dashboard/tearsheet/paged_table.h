@@ -0,0 +1,103 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "epoch_protos/table_def.pb.h"
+#include "epoch_dashboard/tearsheet/table_filter.h"
+
+namespace arrow {
+    class Table;
+}
+
+namespace epoch_frame {
+    class DataFrame;
+}
+
+namespace epoch_tearsheet {
+
+enum class SortDirection {
+    Ascending,
+    Descending
+};
+
+struct TablePageQuery {
+    size_t page = 0;
+    size_t page_size = 100;
+    std::optional<std::string> sort_column;  // Row order when unset
+    SortDirection direction = SortDirection::Ascending;
+    std::optional<TableFilter> filter;       // Over any column of the frame, shown or not
+};
+
+/**
+ * Server-side pager over a large frame, e.g. a trade log. Every sortable column
+ * (numeric, boolean, temporal, string and dictionary of strings) gets an ascending
+ * row permutation once, argsorted in parallel over its raw values. A page then only
+ * converts its own rows to TableRow, so its cost does not grow with the frame.
+ *
+ * Ascending order is stable and puts nulls (and NaN) last. Descending order walks the
+ * permutation backwards, so ties come in reverse row order; nulls still come last.
+ *
+ * Filtered pages take their selection from TableFilterCache::shared(), keyed by this
+ * table's frame, so repeated filters are evaluated once. An unsorted filtered page
+ * slices the selection directly. A sorted one slices the sort index restricted to the
+ * selection, built once per (filter, sort column) and kept in a small per-table LRU.
+ */
+class PagedTable {
+public:
+    /**
+     * @param columns Columns to show, all of them when empty
+     * @throws std::runtime_error on a missing column or more than 2^32 - 1 rows
+     */
+    explicit PagedTable(const epoch_frame::DataFrame& df, const std::vector<std::string>& columns = {});
+
+    size_t rowCount() const { return row_count_; }
+    size_t rowCount(const TableFilter& filter) const;
+    size_t pageCount(size_t page_size, const std::optional<TableFilter>& filter = std::nullopt) const;
+    const std::vector<epoch_proto::ColumnDef>& columnDefs() const { return column_defs_; }
+    bool isSortable(const std::string& column) const { return sort_indexes_.contains(column); }
+
+    /**
+     * Frame row numbers of one page in display order; empty past the last page.
+     * @throws std::runtime_error if page_size is 0, the sort column has no index or the
+     *         filter cannot be evaluated
+     */
+    std::vector<uint32_t> pageRows(const TablePageQuery& query) const;
+
+    std::vector<epoch_proto::TableRow> page(const TablePageQuery& query) const;
+
+private:
+    struct SortIndex {
+        std::vector<uint32_t> order;  // Non-null rows ascending, then null rows
+        size_t valid = 0;
+    };
+
+    struct SortedSelection {
+        std::string key;  // Filter key and sort column
+        std::shared_ptr<const SortIndex> index;
+    };
+
+    static constexpr size_t kSortedSelectionCapacity = 16;
+
+    std::shared_ptr<const SortIndex> sortedSelection(const std::string& column,
+                                                     const SortIndex& index,
+                                                     const TableFilter& filter) const;
+
+    std::shared_ptr<arrow::Table> source_;
+    std::shared_ptr<arrow::Table> table_;
+    std::vector<epoch_proto::ColumnDef> column_defs_;
+    std::unordered_map<std::string, SortIndex> sort_indexes_;
+    size_t row_count_ = 0;
+
+    mutable std::mutex sorted_selections_mutex_;
+    mutable std::list<SortedSelection> sorted_selections_;  // Most recently used first
+    mutable std::unordered_map<std::string, std::list<SortedSelection>::iterator> sorted_lookup_;
+};
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include <arrow/api.h>
+
+#include "epoch_dashboard/tearsheet/columnar_line.h"
+
+namespace epoch_frame {
+    class DataFrame;
+}
+
+namespace parquet::arrow {
+    class FileReader;
+}
+
+namespace epoch_tearsheet {
+
+/**
+ * What a chart needs from a Parquet file: the index column, the columns the chart
+ * references, and an optional inclusive epoch-ms range on the index.
+ */
+struct ParquetScanOptions {
+    std::string index_column = "timestamp";
+    std::vector<std::string> columns;     // Empty reads every column
+    std::optional<int64_t> from_ms;
+    std::optional<int64_t> to_ms;
+};
+
+struct ParquetScanStats {
+    int row_groups_total = 0;
+    int row_groups_read = 0;      // Row groups whose index statistics overlap the range
+    int64_t rows_read = 0;
+    int64_t rows_emitted = 0;     // Rows left after the exact range filter
+};
+
+/**
+ * Parquet input for the chart builders. Only the footer is read on open; scans decode
+ * just the projected columns of the row groups whose index min/max statistics overlap
+ * [from_ms, to_ms], one row group at a time, and trim each batch to the exact range
+ * with TimeWindow. Row groups without statistics are always read.
+ *
+ * The index column must be sorted; timestamp (any unit) or int64 epoch ms.
+ * A source wraps one file reader, so scans on the same source must not overlap.
+ */
+class ParquetSource {
+public:
+    using BatchVisitor = std::function<void(const std::shared_ptr<arrow::RecordBatch>&)>;
+
+    // @throws std::runtime_error if the file cannot be opened or is not Parquet
+    explicit ParquetSource(const std::string& path);
+    ~ParquetSource();
+
+    ParquetSource(const ParquetSource&) = delete;
+    ParquetSource& operator=(const ParquetSource&) = delete;
+
+    std::shared_ptr<arrow::Schema> schema() const;
+    int numRowGroups() const;
+
+    // Row groups a scan with `options` would read
+    std::vector<int> selectRowGroups(const ParquetScanOptions& options) const;
+
+    /**
+     * Stream matching rows batch by batch; batches hold the index and projected columns.
+     * Memory is bounded by one row group.
+     * @throws std::runtime_error on unknown columns or read errors
+     */
+    ParquetScanStats scan(const ParquetScanOptions& options, const BatchVisitor& visit) const;
+
+    // Matching rows as a frame indexed by the index column, for any fromDataFrame builder
+    epoch_frame::DataFrame readDataFrame(const ParquetScanOptions& options) const;
+
+    /**
+     * Same as DataFrameFactory::toColumnarLines over readDataFrame(options), converted
+     * row group by row group so the full table is never assembled.
+     * Lines are named after `options.columns`.
+     */
+    std::vector<ColumnarLine> readColumnarLines(const ParquetScanOptions& options) const;
+
+private:
+    std::vector<int> columnIndexes(const ParquetScanOptions& options) const;
+
+    std::string path_;
+    std::unique_ptr<parquet::arrow::FileReader> reader_;
+    std::shared_ptr<arrow::Schema> schema_;
+};
+
+} // namespace epoch_tearsheet
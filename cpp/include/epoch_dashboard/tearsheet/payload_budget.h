@@ -0,0 +1,115 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "epoch_protos/tearsheet.pb.h"
+
+namespace epoch_tearsheet {
+
+/**
+ * Byte limits for a serialized FullTearSheet. Zero disables a limit.
+ */
+struct PayloadBudget {
+    size_t total_bytes = 0;           // Cap for the whole FullTearSheet
+    size_t per_widget_bytes = 0;      // Cap for any single chart or table
+    size_t min_line_points = 64;      // Lines are never downsampled below this
+    size_t min_histogram_values = 256;// Histograms keep at least max(this, bins_count) values
+    size_t min_table_rows = 10;       // Tables are never truncated below this
+};
+
+enum class DegradationKind {
+    DownsampleLines,   // LTTB over every line of a lines/area/numeric lines chart
+    PreBinHistogram,   // Raw values replaced by evenly spaced quantiles
+    TruncateTable      // Trailing rows dropped
+};
+
+std::string_view toString(DegradationKind kind);
+
+/**
+ * One widget changed by the budget enforcer
+ */
+struct BudgetAction {
+    std::string category;
+    std::string widget;               // Chart id, falling back to the title
+    DegradationKind kind = DegradationKind::DownsampleLines;
+    size_t items_before = 0;          // Points, values or rows
+    size_t items_after = 0;
+    size_t estimated_bytes_before = 0;
+    size_t estimated_bytes_after = 0;
+};
+
+struct BudgetReport {
+    size_t estimated_bytes_before = 0;
+    size_t estimated_bytes_after = 0;
+    std::vector<BudgetAction> actions;
+    bool within_budget = true;        // False when minimums prevented reaching the budget
+};
+
+/**
+ * Cheap serialized-size estimates from element counts and per-element wire cost.
+ * Accurate to within a few percent for numeric payloads without walking every field.
+ */
+class PayloadEstimator {
+public:
+    static size_t estimate(const epoch_proto::Chart& chart);
+    static size_t estimate(const epoch_proto::Table& table);
+    static size_t estimate(const epoch_proto::CardDef& card);
+    static size_t estimate(const epoch_proto::TearSheet& tearsheet);
+    static size_t estimate(const epoch_proto::FullTearSheet& full_tearsheet);
+
+    // One FullTearSheet.categories map entry, including key and framing
+    static size_t estimateCategory(const std::string& category, const epoch_proto::TearSheet& tearsheet);
+};
+
+/**
+ * Shrinks widgets until a FullTearSheet fits a PayloadBudget. Per-widget caps are
+ * applied first, then the total budget is met by degrading in priority order:
+ * downsample lines, pre-bin histograms, truncate tables.
+ */
+class PayloadBudgetEnforcer {
+public:
+    static BudgetReport apply(epoch_proto::FullTearSheet& full_tearsheet, const PayloadBudget& budget);
+
+    /**
+     * Largest-Triangle-Three-Buckets downsampling, keeps first and last points
+     * @param line Line to downsample (modified in place)
+     * @param target_points Number of points to keep
+     */
+    static void downsampleLine(epoch_proto::Line& line, size_t target_points);
+    static void downsampleLine(epoch_proto::NumericLine& line, size_t target_points);
+
+    /**
+     * Replace histogram values by target_values evenly spaced quantiles, which
+     * preserves the binned shape. Non-numeric values are dropped.
+     */
+    static void preBinHistogram(epoch_proto::HistogramDef& histogram, size_t target_values);
+
+    static void truncateTable(epoch_proto::Table& table, size_t target_rows);
+};
+
+/**
+ * PayloadBudgetEnforcer::apply for a sheet assembled one category at a time. Per-widget
+ * caps are applied as each category is added, the total budget once by finish().
+ * Added tearsheets must stay at the same address until finish(); a session is single-use.
+ */
+class PayloadBudgetSession {
+public:
+    explicit PayloadBudgetSession(const PayloadBudget& budget);
+
+    void addCategory(const std::string& category, epoch_proto::TearSheet& tearsheet);
+    BudgetReport finish();
+
+private:
+    PayloadBudget budget_;
+    BudgetReport report_;
+    std::vector<std::pair<std::string, epoch_proto::TearSheet*>> categories_;
+    std::vector<std::optional<size_t>> action_indices_;  // Per widget, charts then tables of each category
+};
+
+} // namespace epoch_tearsheet
@@ -14,6 +14,12 @@ namespace epoch_frame {
 
 namespace epoch_tearsheet {
 
+// Keep the `count` largest slices and fold the remainder into one slice
+struct PieTopN {
+    size_t count = 10;
+    std::string other_name = "Other";
+};
+
 class PieChartBuilder : public ChartBuilderBase<PieChartBuilder> {
 public:
     PieChartBuilder();
@@ -33,6 +39,22 @@ public:
                                     const PieSize& size,
                                     const std::optional<PieInnerSize>& inner_size = std::nullopt);
 
+    /**
+     * Sum value_col per distinct name_col and emit the top N slices, largest first,
+     * followed by the folded remainder if any. Dictionary-encoded names are summed
+     * per dictionary index and string names are hashed by view, so no per-row strings
+     * or scalars are built. Rows with a null name or value are skipped.
+     * @throws std::runtime_error on missing columns, a non-numeric value column, or a
+     *         name column that is neither string nor dictionary of strings
+     */
+    PieChartBuilder& fromDataFrame(const epoch_frame::DataFrame& df,
+                                    const std::string& name_col,
+                                    const std::string& value_col,
+                                    const std::string& series_name,
+                                    const PieSize& size,
+                                    const PieTopN& top_n,
+                                    const std::optional<PieInnerSize>& inner_size = std::nullopt);
+
     epoch_proto::Chart build() const;
 
 private:
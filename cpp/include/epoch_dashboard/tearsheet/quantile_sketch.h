@@ -0,0 +1,97 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <random>
+#include <span>
+#include <string>
+#include <vector>
+
+namespace arrow {
+    class ChunkedArray;
+}
+
+namespace epoch_frame {
+    class DataFrame;
+}
+
+namespace epoch_tearsheet {
+
+/**
+ * Mergeable KLL quantile sketch (Karnin, Lang and Liberty) for distributions too large
+ * to sort, e.g. every trade return of a universe. Items sit in a stack of compactors;
+ * level h holds items of weight 2^h with a capacity shrinking by 2/3 per level below
+ * the top. A full level is sorted and every other item, from a random offset, is
+ * promoted with double weight. Memory stays around 3k items however many are added.
+ *
+ * Error bound: a quantile's rank is off by at most eps * count() with high probability,
+ * where eps shrinks as O(1/k). For the default k = 200, eps is about 1.65% at 99%
+ * confidence (the bound the Apache DataSketches KLL sketch documents for the same k).
+ * The minimum and maximum are exact. Sketches merge without losing the bound, so a
+ * column is sketched per thread and the thread sketches merged; which rows each thread
+ * sees varies, so results can differ run to run within the bound.
+ */
+class QuantileSketch {
+public:
+    static constexpr uint32_t kDefaultK = 200;
+
+    // @throws std::runtime_error if k < 8
+    explicit QuantileSketch(uint32_t k = kDefaultK, uint64_t seed = 0x5eed);
+
+    /**
+     * Sketch of a numeric column, one sketch per worker thread over blocks of rows; null
+     * and NaN values are skipped
+     * @throws std::runtime_error on a non-numeric column
+     */
+    static QuantileSketch fromChunkedArray(const std::shared_ptr<arrow::ChunkedArray>& values,
+                                           uint32_t k = kDefaultK);
+    // @throws std::runtime_error on a missing or non-numeric column
+    static QuantileSketch fromDataFrame(const epoch_frame::DataFrame& df,
+                                        const std::string& column,
+                                        uint32_t k = kDefaultK);
+
+    void update(double value);  // NaN is ignored
+    // @throws std::runtime_error if the sketches have different k
+    void merge(const QuantileSketch& other);
+
+    uint32_t k() const { return k_; }
+    uint64_t count() const { return count_; }
+    bool empty() const { return count_ == 0; }
+    double min() const { return min_; }
+    double max() const { return max_; }
+    size_t retained() const { return retained_; }  // Items held across all levels
+
+    /**
+     * Smallest retained value whose weighted rank reaches q * count(); q = 0 and q = 1
+     * give the exact min and max
+     * @throws std::runtime_error if the sketch is empty or q is outside [0, 1]
+     */
+    double quantile(double q) const;
+    // Several quantiles over one sorted view of the sketch
+    std::vector<double> quantiles(std::span<const double> qs) const;
+
+    // bins + 1 equal-frequency bin edges, from min() to max()
+    std::vector<double> binEdges(uint32_t bins) const;
+
+private:
+    struct WeightedValue {
+        double value;
+        uint64_t weight;
+    };
+
+    size_t capacity(size_t level) const;
+    void addLevel();
+    void compress();
+    std::vector<WeightedValue> sortedView() const;
+
+    uint32_t k_;
+    uint64_t count_ = 0;
+    double min_;
+    double max_;
+    std::vector<std::vector<double>> levels_;
+    size_t retained_ = 0;
+    size_t max_retained_ = 0;  // Sum of the level capacities
+    std::mt19937_64 rng_;
+};
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+#include "epoch_protos/table_def.pb.h"
+
+namespace epoch_frame {
+    class DataFrame;
+}
+
+namespace epoch_tearsheet {
+
+struct ReturnsStatisticsOptions {
+    double periods_per_year = 252.0;
+    double risk_free_rate = 0.0;  // Annual, spread evenly over periods_per_year
+};
+
+/**
+ * Headline statistics of a periodic simple-returns series, computed in two passes over
+ * the buffer. The first pass fuses everything that streams: Neumaier-compensated sums
+ * of r and log1p(r) (compounding), Welford/Terriberry central moments up to the fourth,
+ * downside deviation, win/loss tallies and a running wealth peak for drawdowns. The
+ * second pass is a partial sort of a copy for the historical 95% VaR and CVaR.
+ *
+ * Skew and excess kurtosis use population moments; volatility uses the sample variance.
+ * Statistics without a defined value (e.g. Sharpe of a constant series) are NaN and
+ * become null card values. A return of exactly -100% wipes out wealth for good: total
+ * return, CAGR and max drawdown are then -1, and the drawdown lasts to the end.
+ */
+struct ReturnsStatistics {
+    size_t observations = 0;
+    double total_return = 0.0;
+    double cagr = 0.0;
+    double annual_volatility = 0.0;
+    double sharpe = 0.0;
+    double sortino = 0.0;
+    double calmar = 0.0;
+    double max_drawdown = 0.0;             // <= 0
+    size_t max_drawdown_duration = 0;      // Periods from a peak until it is regained (or the end)
+    double skew = 0.0;
+    double excess_kurtosis = 0.0;
+    double best = 0.0;
+    double worst = 0.0;
+    double hit_rate = 0.0;                 // Share of periods with r > 0
+    double average_win = 0.0;
+    double average_loss = 0.0;             // <= 0
+    double win_loss_ratio = 0.0;
+    double profit_factor = 0.0;
+    double value_at_risk_95 = 0.0;         // 5th percentile return
+    double conditional_value_at_risk_95 = 0.0;
+
+    // @throws std::runtime_error if returns is empty or periods_per_year is not positive
+    static ReturnsStatistics compute(std::span<const double> returns, const ReturnsStatisticsOptions& options = {});
+
+    /**
+     * Statistics of a numeric column; null and NaN rows are skipped
+     * @throws std::runtime_error on a missing or non-numeric column, or no valid rows
+     */
+    static ReturnsStatistics fromDataFrame(const epoch_frame::DataFrame& df,
+                                           const std::string& column,
+                                           const ReturnsStatisticsOptions& options = {});
+
+    /**
+     * Metric cards built with CardBuilder: rates and returns as TypePercent (in percent),
+     * ratios and moments as TypeDecimal, counts as TypeInteger. Cards are grouped as
+     * returns (0), risk (1), ratios (2), distribution (3) and win/loss (4).
+     */
+    epoch_proto::CardDef toCardDef(const std::string& category) const;
+};
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,83 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "epoch_dashboard/tearsheet/columnar_line.h"
+
+namespace epoch_frame {
+    class DataFrame;
+}
+
+namespace epoch_tearsheet {
+
+enum class RollingStat {
+    Mean,
+    StdDev,      // Sample standard deviation
+    Volatility,  // StdDev annualized by sqrt(periods_per_year)
+    Sharpe,      // Annualized mean excess return over StdDev
+    Min,
+    Max,
+    Beta         // cov(series, benchmark) / var(benchmark)
+};
+
+struct RollingRequest {
+    RollingStat stat;
+    size_t window;     // Observations, e.g. 21, 63, 126 or 252 trading days
+    std::string name;  // Defaults to e.g. "Rolling Sharpe (63)" when empty
+};
+
+struct RollingOptions {
+    double periods_per_year = 252.0;
+    double risk_free_rate = 0.0;  // Annual, spread evenly over periods_per_year
+};
+
+/**
+ * Rolling statistics of a timestamp-indexed series as columnar lines; chart them with
+ * LinesChartBuilder::addLine(ColumnarLineCodec::toLegacy(line)). Every request is
+ * served by one pass over the data: requests sharing a window share one kernel, and
+ * each kernel slides in O(1) per step.
+ * Mean and variance come from a sliding Welford update (add the new sample, remove the
+ * one leaving), beta from the matching co-moment against the benchmark, and min/max
+ * from monotonic deques of row numbers.
+ *
+ * A line starts at the first full window; points whose value is undefined (e.g. Sharpe
+ * or beta over a constant window) are left out.
+ */
+class RollingStatistics {
+public:
+    // @throws std::runtime_error if lengths differ or any value is not finite
+    RollingStatistics(std::vector<int64_t> x,
+                      std::vector<double> y,
+                      std::optional<std::vector<double>> benchmark = std::nullopt);
+
+    /**
+     * Series from a numeric column over the frame's timestamp or integer index (epoch ms).
+     * Rows where the column or the benchmark is null or NaN are dropped.
+     * @throws std::runtime_error on a missing or non-numeric column or an unsupported index
+     */
+    static RollingStatistics fromDataFrame(const epoch_frame::DataFrame& df,
+                                           const std::string& column,
+                                           const std::optional<std::string>& benchmark_column = std::nullopt);
+
+    size_t size() const { return x_.size(); }
+
+    /**
+     * One line per request, in request order
+     * @throws std::runtime_error on a zero window, a window below 2 for a dispersion
+     *         statistic, Beta without a benchmark or a non-positive periods_per_year
+     */
+    std::vector<ColumnarLine> compute(const std::vector<RollingRequest>& requests,
+                                      const RollingOptions& options = {}) const;
+
+    static std::string defaultName(RollingStat stat, size_t window);
+
+private:
+    std::vector<int64_t> x_;
+    std::vector<double> y_;
+    std::optional<std::vector<double>> benchmark_;
+};
+
+} // namespace epoch_tearsheet
@@ -7,6 +7,7 @@
 #include "epoch_protos/chart_def.pb.h"
 #include "epoch_protos/table_def.pb.h"
 #include "epoch_protos/common.pb.h"
+#include "epoch_dashboard/tearsheet/columnar_line.h"
 #include "epoch_dashboard/tearsheet/line_builder.h"
 
 namespace epoch_frame {
@@ -23,6 +24,11 @@ public:
                                    const std::string& name = "",
                                    const LineStyle& style = {});
 
+    // Same index handling as toLine, with y copied in bulk into a ColumnarLine
+    static ColumnarLine toColumnarLine(const epoch_frame::Series& series,
+                                       const std::string& name = "",
+                                       const LineStyle& style = {});
+
     static std::vector<epoch_proto::Point> toPoints(const epoch_frame::Series& y_series);
 
     static epoch_proto::TableRow toTableRow(const epoch_frame::Series& series, uint64_t index);
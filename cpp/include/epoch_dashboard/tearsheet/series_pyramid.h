@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "epoch_protos/chart_def.pb.h"
+#include "epoch_dashboard/tearsheet/columnar_line.h"
+
+namespace epoch_frame {
+    class DataFrame;
+}
+
+namespace epoch_tearsheet {
+
+/**
+ * Multi-resolution view of one time series for zoomable charts. Level k aggregates
+ * aligned blocks of 2^k samples (k = 1..kMaxLevel, i.e. 2x..1024x decimation) into
+ * their first, last, min and max samples. First and last are implicit from the block
+ * bounds, so a bucket stores only the sample indexes of its min and max; all levels
+ * live in one contiguous buffer built bottom-up, each level from the one below.
+ *
+ * query() picks the coarsest level that still has at least one bucket per pixel and
+ * emits each bucket's first/min/max/last (M4). Every extreme survives at sub-pixel
+ * resolution, so the chart looks like the raw data at O(pixel_width + log n) points
+ * regardless of the zoom level.
+ */
+class SeriesPyramid {
+public:
+    static constexpr size_t kMaxLevel = 10;
+
+    /**
+     * @param line Samples sorted by x; NaN y values never become a bucket's min or max
+     * @throws std::runtime_error if x and y lengths differ
+     */
+    explicit SeriesPyramid(ColumnarLine line);
+
+    // One pyramid per column, built from DataFrameFactory::toColumnarLines
+    static std::vector<SeriesPyramid> fromDataFrame(const epoch_frame::DataFrame& df,
+                                                    const std::vector<std::string>& y_cols);
+
+    /**
+     * Line for the inclusive x range [from_ms, to_ms] drawn `pixel_width` pixels wide.
+     * Ranges with at most 4 samples per pixel are returned at full resolution.
+     * @throws std::runtime_error if pixel_width is 0 or from_ms > to_ms
+     */
+    epoch_proto::Line query(int64_t from_ms, int64_t to_ms, size_t pixel_width) const;
+
+    // Level query() uses for `samples` samples in `pixel_width` pixels, 0 for raw data
+    static size_t levelFor(size_t samples, size_t pixel_width);
+
+    const std::string& name() const { return line_.name; }
+    size_t size() const { return line_.size(); }
+    size_t levels() const { return level_offsets_.size() - 1; }
+    size_t bucketCount(size_t level) const;
+
+private:
+    struct Bucket {
+        uint32_t min_index;
+        uint32_t max_index;
+    };
+
+    void build();
+    void appendBlock(epoch_proto::Line& line, size_t level, size_t position) const;
+
+    ColumnarLine line_;
+    std::vector<Bucket> buckets_;         // Levels 1..levels(), concatenated
+    std::vector<size_t> level_offsets_;   // Level k spans [level_offsets_[k - 1], level_offsets_[k])
+};
+
+} // namespace epoch_tearsheet
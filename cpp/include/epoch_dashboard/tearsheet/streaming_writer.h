@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream.h>
+
+#include "epoch_protos/tearsheet.pb.h"
+
+namespace epoch_tearsheet {
+
+/**
+ * Writes a FullTearSheet one category at a time. Each category is emitted as a
+ * `categories` map entry (field 1: key = 1, value = 2), so the concatenated output
+ * parses with FullTearSheet::ParseFromString while only the category being written
+ * has to be in memory.
+ *
+ * The output stream is borrowed and must outlive the writer.
+ */
+class StreamingTearSheetWriter {
+public:
+    explicit StreamingTearSheetWriter(google::protobuf::io::ZeroCopyOutputStream* output);
+    ~StreamingTearSheetWriter();
+
+    StreamingTearSheetWriter(const StreamingTearSheetWriter&) = delete;
+    StreamingTearSheetWriter& operator=(const StreamingTearSheetWriter&) = delete;
+
+    /**
+     * Serialize one category directly into the output stream
+     * @throws std::runtime_error if the category was already written, the writer is
+     *         finished, or the stream reports an error
+     */
+    void writeCategory(const std::string& category, const epoch_proto::TearSheet& tearsheet);
+
+    /**
+     * Flush buffered bytes to the underlying stream. Called by the destructor if needed,
+     * but only an explicit call reports stream errors.
+     * @return Total bytes written
+     * @throws std::runtime_error if the stream reports an error
+     */
+    uint64_t finish();
+
+    uint64_t bytesWritten() const;
+    size_t categoriesWritten() const { return written_.size(); }
+
+private:
+    std::unique_ptr<google::protobuf::io::CodedOutputStream> out_;
+    std::set<std::string> written_;
+    uint64_t bytes_written_ = 0;
+};
+
+} // namespace epoch_tearsheet
@@ -4,6 +4,10 @@
 #include <vector>
 
 #include "epoch_protos/table_def.pb.h"
+#include "epoch_dashboard/tearsheet/arrow_sidecar.h"
+#include "epoch_dashboard/tearsheet/drawdown_period.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include "epoch_dashboard/tearsheet/paged_table.h"
 
 namespace epoch_frame {
     class DataFrame;
@@ -21,13 +25,37 @@ public:
     TableBuilder& addColumns(const std::vector<epoch_proto::ColumnDef>& cols);
     TableBuilder& addRow(const epoch_proto::TableRow& row);
     TableBuilder& addRows(const std::vector<epoch_proto::TableRow>& rows);
+    // Spans from this builder go to `sink`, e.g. its dashboard's, instead of the current sink
+    TableBuilder& setInstrumentationSink(InstrumentationSinkPtr sink);
+
+    /**
+     * Columnar mode: fromDataFrame keeps only the column definitions in the proto and
+     * stores the rows in `sidecar` under `id` (Tables have no id field of their own),
+     * with low-cardinality string columns dictionary-encoded; see
+     * ArrowSidecar::makeDictionaryTable. The filtered fromDataFrame overload is unaffected.
+     */
+    TableBuilder& setArrowSidecar(ArrowSidecarPtr sidecar, std::string id, double max_distinct_ratio = 0.5);
     TableBuilder& fromDataFrame(const epoch_frame::DataFrame& df,
                                 const std::vector<std::string>& columns = {});
+    // Only rows matching `filter` are converted; selections come from TableFilterCache::shared()
+    TableBuilder& fromDataFrame(const epoch_frame::DataFrame& df,
+                                const TableFilter& filter,
+                                const std::vector<std::string>& columns = {});
+    // Columns of `paged` and the rows of one page; see PagedTable
+    TableBuilder& fromPage(const PagedTable& paged, const TablePageQuery& query);
+    // Rank, peak, trough, recovery (null if none), depth and calendar days per period
+    TableBuilder& fromDrawdownPeriods(const std::vector<DrawdownPeriod>& periods);
 
     epoch_proto::Table build() const;
 
 private:
+    const InstrumentationSinkPtr& instrumentationSink() const { return instrumentation_sink_; }
+
     epoch_proto::Table table_;
+    ArrowSidecarPtr sidecar_;
+    std::string sidecar_id_;
+    double max_distinct_ratio_ = 0.5;
+    InstrumentationSinkPtr instrumentation_sink_;
 };
 
 } // namespace epoch_tearsheet
\ No newline at end of file
@@ -0,0 +1,119 @@
+#pragma once
+
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <variant>
+#include <vector>
+
+namespace arrow {
+    class Schema;
+    class Table;
+    namespace compute {
+        class Expression;
+    }
+}
+
+namespace epoch_tearsheet {
+
+using FilterValue = std::variant<bool, int64_t, double, std::string>;
+
+/**
+ * Row predicate for server-side table filtering, e.g.
+ *
+ *   TableFilter::allOf({TableFilter::equal("side", "long"), TableFilter::less("pnl", 0.0)})
+ *
+ * A filter compiles to an Arrow compute expression (comparison kernels, is_in and
+ * Kleene and/or) that is evaluated batch by batch over the frame. A row matches only
+ * when the predicate is true; a null cell makes a comparison null, which never matches.
+ * key() is a canonical rendering of the predicate, used to cache selections.
+ */
+class TableFilter {
+public:
+    enum class Op {
+        Equal,
+        NotEqual,
+        Less,
+        LessEqual,
+        Greater,
+        GreaterEqual,
+        In,
+        And,
+        Or
+    };
+
+    static TableFilter equal(std::string column, FilterValue value);
+    static TableFilter notEqual(std::string column, FilterValue value);
+    static TableFilter less(std::string column, FilterValue value);
+    static TableFilter lessEqual(std::string column, FilterValue value);
+    static TableFilter greater(std::string column, FilterValue value);
+    static TableFilter greaterEqual(std::string column, FilterValue value);
+
+    // @throws std::runtime_error if `values` is empty or mixes value types
+    static TableFilter isIn(std::string column, std::vector<FilterValue> values);
+
+    // @throws std::runtime_error if `filters` is empty
+    static TableFilter allOf(std::vector<TableFilter> filters);
+    static TableFilter anyOf(std::vector<TableFilter> filters);
+
+    Op op() const { return op_; }
+    const std::string& key() const { return key_; }
+
+    /**
+     * Matching row numbers of `table`, ascending.
+     * @throws std::runtime_error on a missing column, a value the column cannot be
+     *         compared with, or more than 2^32 - 1 rows
+     */
+    std::vector<uint32_t> select(const std::shared_ptr<arrow::Table>& table) const;
+
+private:
+    TableFilter(Op op, std::string column, std::vector<FilterValue> values, std::vector<TableFilter> children);
+
+    arrow::compute::Expression expression(const arrow::Schema& schema) const;
+
+    Op op_;
+    std::string column_;
+    std::vector<FilterValue> values_;
+    std::vector<TableFilter> children_;
+    std::string key_;
+};
+
+/**
+ * LRU of filter selections keyed by (filter, frame). A frame is identified by its
+ * arrow::Table, which entries hold weakly: a freed table's entries expire instead of
+ * matching a later table allocated at the same address, and cached rows never keep
+ * a frame alive.
+ */
+class TableFilterCache {
+public:
+    explicit TableFilterCache(size_t capacity = 64);
+
+    std::shared_ptr<const std::vector<uint32_t>> select(const TableFilter& filter,
+                                                        const std::shared_ptr<arrow::Table>& table);
+
+    size_t size() const;
+    uint64_t hits() const;
+    uint64_t misses() const;
+
+    // Process-wide cache behind TableBuilder and PagedTable
+    static TableFilterCache& shared();
+
+private:
+    struct Entry {
+        std::string key;
+        std::weak_ptr<arrow::Table> table;
+        std::shared_ptr<const std::vector<uint32_t>> rows;
+    };
+
+    size_t capacity_;
+    mutable std::mutex mutex_;
+    std::list<Entry> entries_;  // Most recently used first
+    std::unordered_map<std::string, std::list<Entry>::iterator> lookup_;
+    uint64_t hits_ = 0;
+    uint64_t misses_ = 0;
+};
+
+} // namespace epoch_tearsheet
@@ -1,10 +1,18 @@
 #pragma once
 
+#include <functional>
+#include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 #include <map>
+#include <optional>
+#include <ostream>
 
 #include "epoch_protos/tearsheet.pb.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include "epoch_dashboard/tearsheet/payload_budget.h"
+#include "epoch_dashboard/tearsheet/streaming_writer.h"
 
 namespace epoch_tearsheet {
 
@@ -15,24 +23,95 @@ public:
     DashboardBuilder& addChart(const epoch_proto::Chart& chart);
     DashboardBuilder& addTable(const epoch_proto::Table& table);
 
+    /**
+     * Spans emitted while this dashboard builds go to this sink instead of the global one.
+     * Chart and table builders run before build(); pass them instrumentationSink() through
+     * their own setInstrumentationSink so their spans land here too.
+     */
+    DashboardBuilder& setInstrumentationSink(InstrumentationSinkPtr sink);
+    const InstrumentationSinkPtr& instrumentationSink() const { return instrumentation_sink_; }
+
     epoch_proto::TearSheet build() const;
 
 private:
     std::string category_;
+    InstrumentationSinkPtr instrumentation_sink_;
     std::vector<epoch_proto::CardDef> cards_;
     std::vector<epoch_proto::Chart> charts_;
     std::vector<epoch_proto::Table> tables_;
 };
 
+// Produces a category's dashboard when it is first needed
+using CategoryFactory = std::function<DashboardBuilder()>;
+
 class FullDashboardBuilder {
 public:
     FullDashboardBuilder& addCategory(const std::string& category, const epoch_proto::TearSheet& dashboard);
     FullDashboardBuilder& addCategoryBuilder(const std::string& category, const DashboardBuilder& builder);
 
+    /**
+     * Register a category that is only built when first requested, by buildCategory(),
+     * build() or writeTo(). The result is memoized; copies of this builder share it.
+     * Replaces any category with the same name.
+     */
+    FullDashboardBuilder& addCategoryFactory(const std::string& category, CategoryFactory factory);
+
+    // Names of all categories, eager and lazy, in sorted order; does not build anything
+    std::vector<std::string> categoryNames() const;
+    bool hasCategory(const std::string& category) const;
+
+    /**
+     * Build a single category, running its factory on first use. Safe to call
+     * concurrently; concurrent requests for the same category build it once.
+     * The payload budget is not applied to single categories.
+     * @throws std::runtime_error if the category is unknown
+     */
+    epoch_proto::TearSheet buildCategory(const std::string& category) const;
+
+    // Widgets are degraded at build() time until the estimated payload fits. Per-widget caps
+    // are applied to each category as it is built; the total budget once all are built.
+    FullDashboardBuilder& setPayloadBudget(const PayloadBudget& budget);
+
+    /**
+     * Estimated serialized size of the current categories, before any budget is applied.
+     * Lazy categories not built yet are left out unless `build_lazy` is set, which runs
+     * (and memoizes) their factories, i.e. the cost of build() itself.
+     */
+    size_t estimatePayloadBytes(bool build_lazy = false) const;
+
     epoch_proto::FullTearSheet build() const;
+    // Without a payload budget `report` is left empty, estimates included; see estimatePayloadBytes
+    epoch_proto::FullTearSheet build(BudgetReport& report) const;
+
+    /**
+     * Serialize straight to the output, one category map entry at a time, without
+     * assembling a FullTearSheet; the bytes parse with FullTearSheet::ParseFromString.
+     * With a payload budget the full sheet is built first so degradation stays global.
+     * @return Bytes written
+     * @throws std::runtime_error if the output reports an error
+     */
+    uint64_t writeTo(google::protobuf::io::ZeroCopyOutputStream* output) const;
+    uint64_t writeTo(std::ostream& out) const;
+    uint64_t writeToFileDescriptor(int fd) const;
 
 private:
+    struct LazyCategory {
+        CategoryFactory factory;
+        std::mutex mutex;
+        std::shared_ptr<const epoch_proto::TearSheet> built;
+
+        std::shared_ptr<const epoch_proto::TearSheet> resolve();
+        std::shared_ptr<const epoch_proto::TearSheet> cached();
+    };
+
+    using CategoryVisitor = std::function<void(const std::string&, const epoch_proto::TearSheet&)>;
+
+    // Visits categories in name order; lazy categories not yet built are memoized only if requested
+    void forEachCategory(const CategoryVisitor& visit, bool memoize) const;
+
     std::map<std::string, epoch_proto::TearSheet> categories_;
+    std::map<std::string, std::shared_ptr<LazyCategory>> lazy_categories_;
+    std::optional<PayloadBudget> budget_;
 };
 
 } // namespace epoch_tearsheet
\ No newline at end of file
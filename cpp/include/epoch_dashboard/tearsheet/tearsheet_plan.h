@@ -0,0 +1,81 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "epoch_dashboard/tearsheet/tearsheet_builder.h"
+#include "epoch_dashboard/tearsheet/tearsheet_spec.h"
+
+namespace epoch_frame {
+    class DataFrame;
+}
+
+namespace epoch_tearsheet {
+
+/**
+ * A TearsheetSpec compiled into slots and stages. Every frame column the spec reads
+ * is one read slot, and every distinct (op, input, window) derivation is one derived
+ * slot, however many names or widgets refer to it; unreferenced series are dropped.
+ * Derived slots are grouped into stages by dependency depth.
+ *
+ * execute() reads the columns, evaluates each stage, then builds all widgets. Work
+ * within a step runs in parallel. The plan is immutable, so a single compiled plan
+ * can be executed concurrently over many strategies' frames.
+ */
+class TearsheetPlan {
+public:
+    /**
+     * @throws std::runtime_error on duplicate or cyclic series names and on widgets
+     *         missing required columns
+     */
+    static TearsheetPlan compile(const TearsheetSpec& spec);
+
+    // Frame columns read by execute(), each once; pass as ParquetScanOptions::columns
+    std::vector<std::string> sourceColumns() const;
+
+    // Distinct derived series computed per execution
+    size_t derivedCount() const;
+
+    // Derived slots grouped by dependency depth; a stage only reads earlier slots
+    size_t stageCount() const { return stages_.size(); }
+
+    /**
+     * Build every category of the spec from one frame. The returned builder can take
+     * a payload budget or stream the categories with writeTo().
+     * @throws std::runtime_error if the frame lacks a source column or a derived
+     *         series' input is not numeric
+     */
+    FullDashboardBuilder execute(const epoch_frame::DataFrame& df) const;
+
+private:
+    // A frame column when `column` is set, otherwise a derivation of slot `input`
+    struct Slot {
+        std::string column;
+        std::string name;    // First name the slot was resolved under, for errors
+        DerivedOp op = DerivedOp::Returns;
+        size_t input = 0;
+        uint32_t window = 0;
+    };
+
+    struct Widget {
+        WidgetSpec spec;
+        std::string category;
+        std::vector<size_t> slots;    // Parallel to spec.inputs()
+    };
+
+    struct Category {
+        std::string name;
+        std::vector<size_t> widgets;
+    };
+
+    class Compiler;
+
+    std::vector<Slot> slots_;
+    std::vector<size_t> reads_;
+    std::vector<std::vector<size_t>> stages_;
+    std::vector<Widget> widgets_;
+    std::vector<Category> categories_;
+};
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,93 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace epoch_tearsheet {
+
+enum class WidgetKind {
+    Lines,
+    Area,
+    Bar,
+    Histogram,
+    Pie,
+    HeatMap,
+    Table
+};
+
+enum class DerivedOp {
+    Returns,             // Simple returns of a price or equity series; first row null
+    CumulativeReturns,   // Compounded returns series
+    Drawdown,            // Fraction below the running peak of an equity series
+    RollingMean          // Mean of the last `window` rows
+};
+
+// A series computed from another column or derived series, addressable by name
+struct DerivedSeriesSpec {
+    std::string name;
+    DerivedOp op = DerivedOp::Returns;
+    std::string source;
+    uint32_t window = 0;    // RollingMean only
+};
+
+/**
+ * One widget. `columns` feeds line, area and table widgets and holds the single
+ * column of bar and histogram widgets; pie widgets read `name` and `value`, heat
+ * maps `x`, `y` and `value`. Any column may name a derived series.
+ */
+struct WidgetSpec {
+    WidgetKind kind = WidgetKind::Lines;
+    std::string id;
+    std::string title;
+    std::string x_label;
+    std::string y_label;
+    std::vector<std::string> columns;
+    std::string x;
+    std::string y;
+    std::string name;
+    std::string value;
+    uint32_t bins = 30;    // Histogram only
+
+    // Every column the widget reads, in the order the builder receives them
+    std::vector<std::string> inputs() const;
+
+    // @throws std::runtime_error if a column the widget type needs is missing
+    void validate() const;
+};
+
+struct CategorySpec {
+    std::string name;
+    std::vector<WidgetSpec> widgets;
+};
+
+/**
+ * Declarative tearsheet layout:
+ *
+ *   series:
+ *     - {name: drawdown, op: drawdown, source: equity}
+ *     - {name: equity_ma, op: rolling_mean, source: equity, window: 20}
+ *   categories:
+ *     - name: Performance
+ *       widgets:
+ *         - {type: lines, id: equity, title: Equity, columns: [equity, equity_ma]}
+ *         - {type: area, title: Drawdown, columns: [drawdown]}
+ *         - {type: histogram, title: Returns, columns: [returns], bins: 50}
+ *
+ * Widget types: lines, area, bar, histogram, pie, heatmap, table. Series ops:
+ * returns, cumulative_returns, drawdown, rolling_mean. Compile with TearsheetPlan.
+ */
+struct TearsheetSpec {
+    std::vector<DerivedSeriesSpec> series;
+    std::vector<CategorySpec> categories;
+
+    // @throws std::runtime_error naming the offending node on malformed YAML or unknown keys
+    static TearsheetSpec fromYaml(const std::string& yaml);
+    static TearsheetSpec fromYamlFile(const std::string& path);
+};
+
+std::string_view toString(WidgetKind kind);
+std::string_view toString(DerivedOp op);
+
+} // namespace epoch_tearsheet
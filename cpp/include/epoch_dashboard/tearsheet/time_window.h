@@ -0,0 +1,62 @@
+#pragma once
+
+#include <cstdint>
+#include <memory>
+#include <optional>
+
+#include <arrow/api.h>
+
+namespace epoch_frame {
+    class DataFrame;
+}
+
+namespace epoch_tearsheet {
+
+/**
+ * Window request with the frontend's candle query parameters (from_ms, to_ms, pivot,
+ * pad_front, pad_back). All times are epoch milliseconds, pads are bar counts.
+ *
+ * Without a pivot the rows in [from_ms, to_ms] are extended by pad_front bars before
+ * and pad_back bars after. With a pivot the window starts pad_front bars before the
+ * first bar at or after the pivot and spans pad_back bars from it, clipped to
+ * [from_ms, to_ms], matching the mock server's slice(pivot - pad_front, pivot + pad_back).
+ */
+struct TimeWindowQuery {
+    std::optional<int64_t> from_ms;
+    std::optional<int64_t> to_ms;
+    std::optional<int64_t> pivot_ms;
+    int64_t pad_front = 0;
+    int64_t pad_back = 0;
+};
+
+// Half-open row range [offset, offset + length)
+struct RowRange {
+    int64_t offset = 0;
+    int64_t length = 0;
+
+    int64_t end() const { return offset + length; }
+    bool operator==(const RowRange&) const = default;
+};
+
+class TimeWindow {
+public:
+    /**
+     * Locate the window rows by binary search, O(log n). Query bounds are converted to
+     * the index unit instead of converting the index.
+     * @param index Sorted, null-free timestamp (any unit) array, or int64, uint64 or float64 epoch ms
+     * @throws std::runtime_error on unsupported index types, nulls, negative pads or from_ms > to_ms
+     */
+    static RowRange locate(const std::shared_ptr<arrow::Array>& index, const TimeWindowQuery& query);
+
+    /**
+     * Zero-copy row slice of a DataFrame sorted by its index, ready for any
+     * fromDataFrame builder (LinesChartBuilder, AreaChartBuilder, TableBuilder, ...)
+     */
+    static epoch_frame::DataFrame slice(const epoch_frame::DataFrame& df, const TimeWindowQuery& query);
+
+    // Zero-copy row slice of an ArrowSidecar table by its x column
+    static std::shared_ptr<arrow::Table> slice(const std::shared_ptr<arrow::Table>& table,
+                                               const TimeWindowQuery& query);
+};
+
+} // namespace epoch_tearsheet
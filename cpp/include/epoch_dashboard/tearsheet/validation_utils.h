@@ -1,5 +1,6 @@
 #pragma once
 
+#include <memory>
 #include <vector>
 #include <string>
 #include <stdexcept>
@@ -8,6 +9,10 @@
 #include <cmath>
 #include "epoch_protos/chart_def.pb.h"
 
+namespace arrow {
+    class Table;
+}
+
 namespace epoch_tearsheet {
 
 /**
@@ -85,6 +90,20 @@ public:
      */
     static void validateLineData(epoch_proto::Line& line, const ValidationOptions& options);
 
+    /**
+     * Validate a sidecar series table (x column, then one float64 column per line; see
+     * ArrowSidecar) with the same rules as validateLineData. Null y values are allowed,
+     * since the sidecar keeps them; non-null ones must be finite when check_finite is set.
+     * Unlike a line, an unsorted table is sorted unless strict_validation rejects it,
+     * because sidecar range queries binary-search x.
+     * @param table Series table
+     * @param options Validation options
+     * @return The table, sorted by x
+     * @throws std::runtime_error if validation fails and strict_validation is true
+     */
+    static std::shared_ptr<arrow::Table> validateSeriesTable(std::shared_ptr<arrow::Table> table,
+                                                             const ValidationOptions& options);
+
     /**
      * Validate multiple lines for consistency (e.g., for stacked charts)
      * @param lines Vector of lines to validate
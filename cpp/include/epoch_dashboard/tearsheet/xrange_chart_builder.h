@@ -1,5 +1,6 @@
 #pragma once
 
+#include <optional>
 #include <string>
 #include <vector>
 
@@ -7,6 +8,10 @@
 #include "epoch_dashboard/tearsheet/chart_builder_base.h"
 #include "epoch_dashboard/tearsheet/validation_utils.h"
 
+namespace epoch_frame {
+    class DataFrame;
+}
+
 namespace epoch_tearsheet {
 
 class XRangeChartBuilder : public ChartBuilderBase<XRangeChartBuilder> {
@@ -21,6 +26,23 @@ public:
     XRangeChartBuilder& addPoint(int64_t x, int64_t x2, uint64_t y, bool is_long = false);
     XRangeChartBuilder& addPoint(const epoch_proto::XRangePoint& point);
 
+    /**
+     * Replace the points and y categories with one interval per row. Entry and exit are
+     * timestamp or int64 millisecond columns and every row is checked for entry < exit
+     * before any point is added. With a lane column, string, dictionary and integer
+     * lanes become y categories in order of first appearance.
+     * Without one, intervals are packed into the minimum number of lanes ("Lane 1", ...)
+     * by interval partitioning in O(n log n); an interval may start where another ends.
+     * A null is_long value is treated as false.
+     * @throws std::runtime_error on missing columns, unsupported types, nulls in the
+     *         entry/exit/lane columns or an interval with entry >= exit
+     */
+    XRangeChartBuilder& fromDataFrame(const epoch_frame::DataFrame& df,
+                                      const std::string& entry_col,
+                                      const std::string& exit_col,
+                                      const std::optional<std::string>& lane_col = std::nullopt,
+                                      const std::optional<std::string>& is_long_col = std::nullopt);
+
     epoch_proto::Chart build() const;
 
 private:
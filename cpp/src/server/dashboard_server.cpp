@@ -0,0 +1,83 @@
+#include "epoch_dashboard/server/dashboard_server.h"
+#include <drogon/drogon.h>
+#include <trantor/utils/ConcurrentTaskQueue.h>
+#include <stdexcept>
+
+namespace epoch_tearsheet {
+
+class DashboardServer::WorkerPool {
+public:
+    explicit WorkerPool(size_t threads) : queue_(threads, "epoch_dashboard_worker") {}
+
+    void post(std::function<void()> task) { queue_.runTaskInQueue(std::move(task)); }
+
+private:
+    trantor::ConcurrentTaskQueue queue_;
+};
+
+namespace {
+
+ServiceRequest toServiceRequest(const drogon::HttpRequestPtr& request) {
+    ServiceRequest service_request;
+    service_request.path = request->path();
+    for (const auto& [key, value] : request->getParameters()) {
+        service_request.query.emplace(key, value);
+    }
+    service_request.if_none_match = request->getHeader("if-none-match");
+    return service_request;
+}
+
+drogon::HttpResponsePtr toHttpResponse(ServiceResponse&& response) {
+    auto http_response = drogon::HttpResponse::newHttpResponse();
+    http_response->setStatusCode(static_cast<drogon::HttpStatusCode>(response.status));
+    http_response->setContentTypeString(response.content_type);
+    if (!response.etag.empty()) {
+        http_response->addHeader("ETag", response.etag);
+        http_response->addHeader("Cache-Control", "no-cache");
+    }
+    http_response->setBody(std::move(response.body));
+    return http_response;
+}
+
+} // namespace
+
+DashboardServer::DashboardServer(std::shared_ptr<TearSheetService> service, ServerOptions options)
+    : service_(std::move(service)), options_(std::move(options)) {
+    if (!service_) {
+        throw std::runtime_error("DashboardServer: service is required");
+    }
+    if (options_.worker_threads == 0 || options_.io_threads == 0) {
+        throw std::runtime_error("DashboardServer: io_threads and worker_threads must be positive");
+    }
+    workers_ = std::make_unique<WorkerPool>(options_.worker_threads);
+}
+
+DashboardServer::~DashboardServer() = default;
+
+void DashboardServer::run() {
+    auto service = service_;
+    auto* workers = workers_.get();
+
+    // A single non-capturing pattern: routing lives in TearSheetService
+    drogon::app().registerHandlerViaRegex(
+        "/(?:tearsheets|metrics)(?:/.*)?",
+        [service, workers](const drogon::HttpRequestPtr& request,
+                           std::function<void(const drogon::HttpResponsePtr&)>&& callback) {
+            workers->post([service, request, callback = std::move(callback)] {
+                // Drogon accepts callbacks from any thread and writes on the request's loop
+                callback(toHttpResponse(service->handle(toServiceRequest(request))));
+            });
+        },
+        {drogon::Get});
+
+    drogon::app()
+        .addListener(options_.host, options_.port)
+        .setThreadNum(options_.io_threads)
+        .run();
+}
+
+void DashboardServer::stop() {
+    drogon::app().quit();
+}
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,61 @@
+#include "epoch_dashboard/server/latency_metrics.h"
+#include <algorithm>
+#include <sstream>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+constexpr const char* kDurationMetric = "epoch_dashboard_request_duration_seconds";
+constexpr const char* kResponsesMetric = "epoch_dashboard_responses_total";
+
+} // namespace
+
+void LatencyMetrics::observe(const std::string& route, int status, std::chrono::nanoseconds latency) {
+    const double seconds = std::chrono::duration<double>(latency).count();
+    const auto bucket = std::lower_bound(kBucketsSeconds.begin(), kBucketsSeconds.end(), seconds) -
+                        kBucketsSeconds.begin();
+
+    std::lock_guard lock(mutex_);
+    auto& histogram = histograms_[route];
+    if (bucket < static_cast<std::ptrdiff_t>(kBucketsSeconds.size())) {
+        ++histogram.buckets[static_cast<size_t>(bucket)];
+    }
+    ++histogram.count;
+    histogram.sum_seconds += seconds;
+    ++responses_[{route, status}];
+}
+
+uint64_t LatencyMetrics::count(const std::string& route) const {
+    std::lock_guard lock(mutex_);
+    auto it = histograms_.find(route);
+    return it == histograms_.end() ? 0 : it->second.count;
+}
+
+std::string LatencyMetrics::renderPrometheus() const {
+    std::ostringstream out;
+    std::lock_guard lock(mutex_);
+
+    out << "# HELP " << kDurationMetric << " Request latency by route\n";
+    out << "# TYPE " << kDurationMetric << " histogram\n";
+    for (const auto& [route, histogram] : histograms_) {
+        uint64_t cumulative = 0;
+        for (size_t i = 0; i < kBucketsSeconds.size(); ++i) {
+            cumulative += histogram.buckets[i];
+            out << kDurationMetric << "_bucket{route=\"" << route << "\",le=\"" << kBucketsSeconds[i] << "\"} "
+                << cumulative << '\n';
+        }
+        out << kDurationMetric << "_bucket{route=\"" << route << "\",le=\"+Inf\"} " << histogram.count << '\n';
+        out << kDurationMetric << "_sum{route=\"" << route << "\"} " << histogram.sum_seconds << '\n';
+        out << kDurationMetric << "_count{route=\"" << route << "\"} " << histogram.count << '\n';
+    }
+
+    out << "# HELP " << kResponsesMetric << " Responses by route and status code\n";
+    out << "# TYPE " << kResponsesMetric << " counter\n";
+    for (const auto& [key, total] : responses_) {
+        out << kResponsesMetric << "{route=\"" << key.first << "\",code=\"" << key.second << "\"} " << total << '\n';
+    }
+    return out.str();
+}
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,55 @@
+#include "epoch_dashboard/server/dashboard_server.h"
+#include "epoch_dashboard/server/mock_provider.h"
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+namespace {
+
+void usage(const char* program) {
+    std::cerr << "Usage: " << program << " [--host HOST] [--port PORT] [--io-threads N] [--workers N]\n"
+              << "Serves a synthetic tearsheet under /tearsheets/mock and metrics under /metrics\n";
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    epoch_tearsheet::ServerOptions options;
+
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        if (arg == "--help" || arg == "-h") {
+            usage(argv[0]);
+            return EXIT_SUCCESS;
+        }
+        if (i + 1 >= argc) {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+        const char* value = argv[++i];
+        if (arg == "--host") {
+            options.host = value;
+        } else if (arg == "--port") {
+            options.port = static_cast<uint16_t>(std::strtoul(value, nullptr, 10));
+        } else if (arg == "--io-threads") {
+            options.io_threads = std::strtoul(value, nullptr, 10);
+        } else if (arg == "--workers") {
+            options.worker_threads = std::strtoul(value, nullptr, 10);
+        } else {
+            usage(argv[0]);
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        auto service = std::make_shared<epoch_tearsheet::TearSheetService>();
+        service->registerProvider("mock", std::make_shared<epoch_tearsheet::MockTearSheetProvider>());
+
+        std::cout << "Serving on http://" << options.host << ":" << options.port << "/tearsheets/mock" << std::endl;
+        epoch_tearsheet::DashboardServer(service, options).run();
+    } catch (const std::exception& e) {
+        std::cerr << "epoch_dashboard_server: " << e.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+    return EXIT_SUCCESS;
+}
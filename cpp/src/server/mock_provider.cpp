@@ -0,0 +1,109 @@
+#include "epoch_dashboard/server/mock_provider.h"
+#include "epoch_dashboard/tearsheet/area_chart_builder.h"
+#include "epoch_dashboard/tearsheet/card_builder.h"
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include "epoch_dashboard/tearsheet/scalar_converter.h"
+#include <arrow/api.h>
+#include <epoch_frame/dataframe.h>
+#include <epoch_frame/factory/index_factory.h>
+#include <algorithm>
+#include <random>
+#include <stdexcept>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+constexpr int64_t kFirstDayMs = 1420156800000;  // 2015-01-02
+constexpr int64_t kDayMs = 86400000;
+
+template <typename Builder, typename T>
+std::shared_ptr<arrow::Array> finish(Builder& builder, const std::vector<T>& values) {
+    if (!builder.AppendValues(values).ok()) {
+        throw std::runtime_error("MockTearSheetProvider: failed to build column");
+    }
+    return builder.Finish().ValueOrDie();
+}
+
+} // namespace
+
+MockTearSheetProvider::MockTearSheetProvider(size_t days, uint64_t seed)
+    : days_(days), seed_(seed) {}
+
+epoch_frame::DataFrame MockTearSheetProvider::makeDataFrame() const {
+    std::mt19937_64 rng(seed_);
+    std::normal_distribution<double> strategy_returns(0.0004, 0.011);
+    std::normal_distribution<double> benchmark_returns(0.0003, 0.009);
+
+    std::vector<int64_t> timestamps(days_);
+    std::vector<double> strategy(days_);
+    std::vector<double> benchmark(days_);
+    std::vector<double> drawdown(days_);
+
+    double strategy_equity = 1.0;
+    double benchmark_equity = 1.0;
+    double peak = 1.0;
+    for (size_t i = 0; i < days_; ++i) {
+        strategy_equity *= 1.0 + strategy_returns(rng);
+        benchmark_equity *= 1.0 + benchmark_returns(rng);
+        peak = std::max(peak, strategy_equity);
+
+        timestamps[i] = kFirstDayMs + static_cast<int64_t>(i) * kDayMs;
+        strategy[i] = strategy_equity;
+        benchmark[i] = benchmark_equity;
+        drawdown[i] = strategy_equity / peak - 1.0;
+    }
+
+    arrow::TimestampBuilder timestamp_builder(arrow::timestamp(arrow::TimeUnit::MILLI), arrow::default_memory_pool());
+    arrow::DoubleBuilder strategy_builder;
+    arrow::DoubleBuilder benchmark_builder;
+    arrow::DoubleBuilder drawdown_builder;
+
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field("strategy", arrow::float64()),
+                       arrow::field("benchmark", arrow::float64()),
+                       arrow::field("drawdown", arrow::float64())}),
+        {finish(strategy_builder, strategy), finish(benchmark_builder, benchmark), finish(drawdown_builder, drawdown)});
+    auto index = epoch_frame::factory::index::make_index(finish(timestamp_builder, timestamps), std::nullopt, "date");
+    return epoch_frame::DataFrame(index, table);
+}
+
+FullDashboardBuilder MockTearSheetProvider::load(const ArrowSidecarPtr& sidecar) const {
+    auto df = std::make_shared<const epoch_frame::DataFrame>(makeDataFrame());
+
+    FullDashboardBuilder dashboard;
+    dashboard.addCategoryFactory("Strategy", [df] {
+        const auto strategy = df->table()->GetColumnByName("strategy");
+        const double total_return = strategy->length() == 0
+            ? 0.0
+            : std::static_pointer_cast<arrow::DoubleScalar>(strategy->GetScalar(strategy->length() - 1).ValueOrDie())->value - 1.0;
+
+        return DashboardBuilder()
+            .addCard(CardBuilder()
+                .setType(epoch_proto::WidgetCard)
+                .setCategory("Strategy")
+                .addCardData(CardDataBuilder()
+                    .setTitle("Total Return")
+                    .setValue(ScalarFactory::fromPercentValue(total_return * 100.0))
+                    .setType(epoch_proto::TypePercent)
+                    .build())
+                .build())
+            .addChart(LinesChartBuilder()
+                .setId("equity")
+                .setTitle("Equity Curve")
+                .fromDataFrame(*df, {"strategy", "benchmark"})
+                .build());
+    });
+    dashboard.addCategoryFactory("Risk", [df, sidecar] {
+        return DashboardBuilder()
+            .addChart(AreaChartBuilder()
+                .setId("drawdown")
+                .setTitle("Drawdown")
+                .setArrowSidecar(sidecar)
+                .fromDataFrame(*df, {"drawdown"})
+                .build());
+    });
+    return dashboard;
+}
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,398 @@
+#include "epoch_dashboard/server/tearsheet_service.h"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+struct XRange {
+    double from = -std::numeric_limits<double>::infinity();
+    double to = std::numeric_limits<double>::infinity();
+
+    bool bounded() const { return std::isfinite(from) || std::isfinite(to); }
+};
+
+class BadRequest : public std::runtime_error {
+public:
+    using std::runtime_error::runtime_error;
+};
+
+ServiceResponse errorResponse(int status, const std::string& message) {
+    ServiceResponse response;
+    response.status = status;
+    response.content_type = TearSheetService::kTextContentType;
+    response.body = message;
+    return response;
+}
+
+ServiceResponse contentResponse(std::string body, const char* content_type) {
+    ServiceResponse response;
+    response.content_type = content_type;
+    response.etag = TearSheetService::etagFor(body);
+    response.body = std::move(body);
+    return response;
+}
+
+ServiceResponse protobufResponse(const google::protobuf::MessageLite& message) {
+    return contentResponse(message.SerializeAsString(), TearSheetService::kProtobufContentType);
+}
+
+ServiceResponse textResponse(const std::vector<std::string>& lines) {
+    std::string body;
+    for (const auto& line : lines) {
+        body += line;
+        body += '\n';
+    }
+    return contentResponse(std::move(body), TearSheetService::kTextContentType);
+}
+
+std::vector<std::string> splitPath(std::string_view path) {
+    std::vector<std::string> segments;
+    size_t start = 0;
+    while (start <= path.size()) {
+        const size_t end = std::min(path.find('/', start), path.size());
+        if (end > start) {
+            segments.emplace_back(path.substr(start, end - start));
+        }
+        start = end + 1;
+    }
+    return segments;
+}
+
+double parseBound(const std::map<std::string, std::string>& query, const std::string& key, double fallback) {
+    auto it = query.find(key);
+    if (it == query.end() || it->second.empty()) {
+        return fallback;
+    }
+    double value = 0.0;
+    const auto* end = it->second.data() + it->second.size();
+    auto [ptr, ec] = std::from_chars(it->second.data(), end, value);
+    if (ec != std::errc{} || ptr != end) {
+        throw BadRequest("invalid '" + key + "' parameter: " + it->second);
+    }
+    return value;
+}
+
+XRange parseRange(const ServiceRequest& request) {
+    XRange range;
+    range.from = parseBound(request.query, "from", range.from);
+    range.to = parseBound(request.query, "to", range.to);
+    if (range.from > range.to) {
+        throw BadRequest("'from' must not be greater than 'to'");
+    }
+    return range;
+}
+
+// Line data is sorted by x after validation, so the range is located by binary search
+template <typename LineT>
+void sliceLine(LineT& line, const XRange& range) {
+    auto& data = *line.mutable_data();
+    auto begin = std::lower_bound(data.begin(), data.end(), range.from,
+                                  [](const auto& point, double x) { return static_cast<double>(point.x()) < x; });
+    auto end = std::upper_bound(begin, data.end(), range.to,
+                                [](double x, const auto& point) { return x < static_cast<double>(point.x()); });
+    const int first = static_cast<int>(begin - data.begin());
+    const int last = static_cast<int>(end - data.begin());
+    data.DeleteSubrange(last, data.size() - last);
+    data.DeleteSubrange(0, first);
+}
+
+void sliceChart(epoch_proto::Chart& chart, const XRange& range) {
+    switch (chart.chart_type_case()) {
+        case epoch_proto::Chart::kLinesDef:
+            for (auto& line : *chart.mutable_lines_def()->mutable_lines()) {
+                sliceLine(line, range);
+            }
+            break;
+        case epoch_proto::Chart::kAreaDef:
+            for (auto& area : *chart.mutable_area_def()->mutable_areas()) {
+                sliceLine(area, range);
+            }
+            break;
+        case epoch_proto::Chart::kNumericLinesDef:
+            for (auto& line : *chart.mutable_numeric_lines_def()->mutable_lines()) {
+                sliceLine(line, range);
+            }
+            break;
+        default:
+            break;
+    }
+}
+
+template <typename ArrayType>
+std::pair<int64_t, int64_t> rowRange(const ArrayType& x, const XRange& range) {
+    const auto* values = x.raw_values();
+    const auto* begin = std::lower_bound(values, values + x.length(), range.from,
+                                         [](auto value, double bound) { return static_cast<double>(value) < bound; });
+    const auto* end = std::upper_bound(begin, values + x.length(), range.to,
+                                       [](double bound, auto value) { return bound < static_cast<double>(value); });
+    return {begin - values, end - values};
+}
+
+std::shared_ptr<arrow::Table> sliceTable(const std::shared_ptr<arrow::Table>& table, const XRange& range) {
+    auto column = table->GetColumnByName(ArrowSidecar::kXColumn);
+    if (!column || column->num_chunks() == 0) {
+        return table;
+    }
+    std::shared_ptr<arrow::Array> x = column->chunk(0);
+    if (column->num_chunks() > 1) {
+        // Thrown rather than ValueOrDie so handle() answers 500 instead of aborting the server
+        auto concatenated = arrow::Concatenate(column->chunks());
+        if (!concatenated.ok()) {
+            throw std::runtime_error("TearSheetService: " + concatenated.status().ToString());
+        }
+        x = std::move(concatenated).ValueUnsafe();
+    }
+
+    std::pair<int64_t, int64_t> rows{0, table->num_rows()};
+    switch (x->type_id()) {
+        case arrow::Type::INT64:
+            rows = rowRange(static_cast<const arrow::Int64Array&>(*x), range);
+            break;
+        case arrow::Type::DOUBLE:
+            rows = rowRange(static_cast<const arrow::DoubleArray&>(*x), range);
+            break;
+        default:
+            throw BadRequest("range queries are not supported for x type " + x->type()->ToString());
+    }
+    return table->Slice(rows.first, rows.second - rows.first);
+}
+
+int parseChartIndex(const std::string& text) {
+    int index = 0;
+    const auto* end = text.data() + text.size();
+    auto [ptr, ec] = std::from_chars(text.data(), end, index);
+    if (ec != std::errc{} || ptr != end || index < 0) {
+        throw BadRequest("invalid chart index: " + text);
+    }
+    return index;
+}
+
+} // namespace
+
+void TearSheetService::registerProvider(const std::string& id, TearSheetProviderPtr provider) {
+    if (id.empty()) {
+        throw std::runtime_error("TearSheetService: provider id is required");
+    }
+    if (!provider) {
+        throw std::runtime_error("TearSheetService: provider '" + id + "' is null");
+    }
+    std::lock_guard lock(registry_mutex_);
+    if (!registry_.emplace(id, Registration{std::move(provider), std::make_shared<Loaded>()}).second) {
+        throw std::runtime_error("TearSheetService: duplicate provider id '" + id + "'");
+    }
+}
+
+void TearSheetService::invalidate(const std::string& id) {
+    std::lock_guard lock(registry_mutex_);
+    auto it = registry_.find(id);
+    if (it != registry_.end()) {
+        // In-flight requests keep the previous snapshot alive until they finish
+        it->second.loaded = std::make_shared<Loaded>();
+    }
+}
+
+std::vector<std::string> TearSheetService::providerIds() const {
+    std::lock_guard lock(registry_mutex_);
+    std::vector<std::string> ids;
+    ids.reserve(registry_.size());
+    for (const auto& entry : registry_) {
+        ids.push_back(entry.first);
+    }
+    return ids;
+}
+
+std::string TearSheetService::etagFor(std::string_view body) {
+    uint64_t hash = 14695981039346656037ULL;
+    for (unsigned char c : body) {
+        hash ^= c;
+        hash *= 1099511628211ULL;
+    }
+    char hex[16];
+    auto [end, ec] = std::to_chars(hex, hex + sizeof(hex), hash, 16);
+    (void)ec;
+    const size_t digits = static_cast<size_t>(end - hex);
+    return "\"" + std::string(16 - digits, '0') + std::string(hex, digits) + "\"";
+}
+
+bool TearSheetService::etagMatches(std::string_view if_none_match, std::string_view etag) {
+    size_t start = 0;
+    while (start < if_none_match.size()) {
+        size_t end = if_none_match.find(',', start);
+        if (end == std::string_view::npos) {
+            end = if_none_match.size();
+        }
+        auto candidate = if_none_match.substr(start, end - start);
+        while (!candidate.empty() && candidate.front() == ' ') {
+            candidate.remove_prefix(1);
+        }
+        while (!candidate.empty() && candidate.back() == ' ') {
+            candidate.remove_suffix(1);
+        }
+        // If-None-Match uses weak comparison
+        if (candidate.starts_with("W/")) {
+            candidate.remove_prefix(2);
+        }
+        if (candidate == "*" || candidate == etag) {
+            return true;
+        }
+        start = end + 1;
+    }
+    return false;
+}
+
+std::shared_ptr<TearSheetService::Loaded> TearSheetService::load(const std::string& id) const {
+    TearSheetProviderPtr provider;
+    std::shared_ptr<Loaded> loaded;
+    {
+        std::lock_guard lock(registry_mutex_);
+        auto it = registry_.find(id);
+        if (it == registry_.end()) {
+            return nullptr;
+        }
+        provider = it->second.provider;
+        loaded = it->second.loaded;
+    }
+
+    // Concurrent first requests wait for a single load
+    std::lock_guard lock(loaded->load_mutex);
+    if (!loaded->dashboard) {
+        auto sidecar = std::make_shared<ArrowSidecar>();
+        loaded->dashboard.emplace(provider->load(sidecar));
+        loaded->sidecar = std::move(sidecar);
+    }
+    return loaded;
+}
+
+ServiceResponse TearSheetService::handle(const ServiceRequest& request) {
+    const auto start = std::chrono::steady_clock::now();
+    std::string route = "unknown";
+
+    ServiceResponse response;
+    try {
+        response = dispatch(request, route);
+    } catch (const BadRequest& e) {
+        response = errorResponse(400, e.what());
+    } catch (const std::exception& e) {
+        response = errorResponse(500, e.what());
+    }
+
+    if (response.status == 200 && !response.etag.empty() && etagMatches(request.if_none_match, response.etag)) {
+        response.status = 304;
+        response.body.clear();
+    }
+
+    metrics_.observe(route, response.status, std::chrono::steady_clock::now() - start);
+    return response;
+}
+
+ServiceResponse TearSheetService::dispatch(const ServiceRequest& request, std::string& route) const {
+    const auto segments = splitPath(request.path);
+
+    if (segments.size() == 1 && segments[0] == "metrics") {
+        route = "metrics";
+        ServiceResponse response;
+        response.content_type = kMetricsContentType;
+        response.body = metrics_.renderPrometheus();
+        return response;
+    }
+    if (segments.empty() || segments[0] != "tearsheets") {
+        return errorResponse(404, "not found: " + request.path);
+    }
+    if (segments.size() == 1) {
+        route = "list";
+        return textResponse(providerIds());
+    }
+
+    const bool is_categories = segments.size() >= 3 && segments[2] == "categories";
+    const bool is_category = is_categories && segments.size() == 4;
+    const bool is_chart = is_categories && segments.size() == 6 && segments[4] == "charts";
+    const bool is_arrow = segments.size() == 5 && segments[2] == "charts" && segments[4] == "arrow";
+
+    if (segments.size() == 2) {
+        route = "tearsheet";
+    } else if (is_categories && segments.size() == 3) {
+        route = "categories";
+    } else if (is_category) {
+        route = "category";
+    } else if (is_chart) {
+        route = "chart";
+    } else if (is_arrow) {
+        route = "chart_arrow";
+    } else {
+        return errorResponse(404, "not found: " + request.path);
+    }
+
+    const XRange range = (is_chart || is_arrow) ? parseRange(request) : XRange{};
+    const int chart_index = is_chart ? parseChartIndex(segments[5]) : 0;
+
+    auto loaded = load(segments[1]);
+    if (!loaded) {
+        return errorResponse(404, "unknown tearsheet '" + segments[1] + "'");
+    }
+    const auto& dashboard = *loaded->dashboard;
+
+    // Ranges come from clients and are unbounded in number, so only whole responses are memoized
+    const bool memoize = !range.bounded();
+    if (memoize) {
+        std::lock_guard lock(loaded->responses_mutex);
+        if (auto it = loaded->responses.find(request.path); it != loaded->responses.end()) {
+            return it->second;
+        }
+    }
+
+    ServiceResponse response;
+    if (route == "tearsheet") {
+        response = protobufResponse(dashboard.build());
+    } else if (route == "categories") {
+        response = textResponse(dashboard.categoryNames());
+    } else if (is_category || is_chart) {
+        const auto& category = segments[3];
+        if (!dashboard.hasCategory(category)) {
+            return errorResponse(404, "unknown category '" + category + "'");
+        }
+        auto tearsheet = dashboard.buildCategory(category);
+        if (is_category) {
+            response = protobufResponse(tearsheet);
+        } else {
+            if (chart_index >= tearsheet.charts().charts_size()) {
+                return errorResponse(404, "chart index " + segments[5] + " out of range for category '" +
+                                          category + "'");
+            }
+            auto chart = tearsheet.charts().charts(chart_index);
+            if (range.bounded()) {
+                sliceChart(chart, range);
+            }
+            response = protobufResponse(chart);
+        }
+    } else {
+        const auto& chart_id = segments[3];
+        auto table = loaded->sidecar->get(chart_id);
+        if (!table) {
+            // Sidecar series are produced while categories build
+            dashboard.build();
+            table = loaded->sidecar->get(chart_id);
+        }
+        if (!table) {
+            return errorResponse(404, "no Arrow series for chart '" + chart_id + "'");
+        }
+        if (range.bounded()) {
+            table = sliceTable(table, range);
+        }
+        auto buffer = ArrowSidecar::serializeIPC(table);
+        response = contentResponse(buffer->ToString(), kArrowContentType);
+    }
+
+    if (memoize) {
+        std::lock_guard lock(loaded->responses_mutex);
+        loaded->responses.emplace(request.path, response);
+    }
+    return response;
+}
+
+} // namespace epoch_tearsheet
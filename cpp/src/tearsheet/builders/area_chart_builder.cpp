@@ -1,14 +1,107 @@
 #include "epoch_dashboard/tearsheet/area_chart_builder.h"
 #include "epoch_dashboard/tearsheet/dataframe_converter.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
 #include "epoch_dashboard/tearsheet/line_builder.h"
 #include "epoch_dashboard/tearsheet/validation_utils.h"
 #include "epoch_protos/common.pb.h"
 #include <arrow/api.h>
 #include <epoch_frame/dataframe.h>
 #include <epoch_frame/index.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
 
 namespace epoch_tearsheet {
 
+namespace {
+
+/**
+ * Running peak of a wealth curve. A period opens on the first row below the peak and
+ * closes on the first row back at it; closed periods go through a heap that keeps the
+ * top_n deepest, so memory does not grow with the number of drawdowns.
+ */
+class DrawdownTracker {
+public:
+    // initial_peak is the wealth before the first row, or NaN to start at the first row
+    DrawdownTracker(size_t top_n, double initial_peak) : top_n_(top_n), peak_(initial_peak) {}
+
+    // Drawdown of this row, <= 0
+    double step(int64_t x, double wealth) {
+        if (rows_ == 0) {
+            peak_ms_ = x;
+            peak_ = std::isnan(peak_) ? wealth : peak_;
+        }
+        double drawdown = 0.0;
+        if (wealth >= peak_) {
+            if (underwater_) {
+                close(x, x, rows_);
+            }
+            peak_ = wealth;
+            peak_ms_ = x;
+            peak_row_ = rows_;
+        } else {
+            drawdown = wealth / peak_ - 1.0;
+            if (!underwater_) {
+                underwater_ = true;
+                open_ = DrawdownPeriod{};
+                open_.peak_ms = peak_ms_;
+                open_.trough_ms = x;
+                open_.depth = drawdown;
+            } else if (drawdown < open_.depth) {
+                open_.trough_ms = x;
+                open_.depth = drawdown;
+            }
+        }
+        last_ms_ = x;
+        ++rows_;
+        return drawdown;
+    }
+
+    // Closes a period still open at the last row; deepest first, earlier peaks on ties
+    std::vector<DrawdownPeriod> finish() {
+        if (underwater_) {
+            close(std::nullopt, last_ms_, rows_ - 1);
+        }
+        std::sort(deepest_.begin(), deepest_.end(), [](const DrawdownPeriod& a, const DrawdownPeriod& b) {
+            return a.depth != b.depth ? a.depth < b.depth : a.peak_ms < b.peak_ms;
+        });
+        return std::move(deepest_);
+    }
+
+private:
+    static bool shallower(const DrawdownPeriod& a, const DrawdownPeriod& b) { return a.depth < b.depth; }
+
+    void close(std::optional<int64_t> recovery_ms, int64_t end_ms, size_t end_row) {
+        underwater_ = false;
+        open_.recovery_ms = recovery_ms;
+        open_.end_ms = end_ms;
+        open_.rows = end_row - peak_row_;
+        if (top_n_ == 0) {
+            return;
+        }
+        // Max-heap on depth: the front is the shallowest period kept
+        deepest_.push_back(open_);
+        std::push_heap(deepest_.begin(), deepest_.end(), shallower);
+        if (deepest_.size() > top_n_) {
+            std::pop_heap(deepest_.begin(), deepest_.end(), shallower);
+            deepest_.pop_back();
+        }
+    }
+
+    size_t top_n_;
+    double peak_;
+    int64_t peak_ms_ = 0;
+    size_t peak_row_ = 0;
+    int64_t last_ms_ = 0;
+    size_t rows_ = 0;
+    bool underwater_ = false;
+    DrawdownPeriod open_;
+    std::vector<DrawdownPeriod> deepest_;
+};
+
+} // namespace
+
 AreaChartBuilder::AreaChartBuilder() {
     area_def_.mutable_chart_def()->set_type(epoch_proto::WidgetArea);
     setYAxisType(epoch_proto::AxisLinear);
@@ -19,6 +112,9 @@ AreaChartBuilder::AreaChartBuilder() {
 }
 
 AreaChartBuilder& AreaChartBuilder::addArea(const epoch_proto::Line& area) {
+    ScopedSpan span("AreaChartBuilder", SpanPhase::Validation, instrumentationSink());
+    span.describe(area_def_.chart_def()).addPointsOut(area.data_size());
+
     // Validate the area data before adding
     epoch_proto::Line validated_area = area;
     ValidationUtils::validateLineData(validated_area, validation_options_);
@@ -27,7 +123,11 @@ AreaChartBuilder& AreaChartBuilder::addArea(const epoch_proto::Line& area) {
 }
 
 AreaChartBuilder& AreaChartBuilder::addAreas(const std::vector<epoch_proto::Line>& areas) {
+    ScopedSpan span("AreaChartBuilder", SpanPhase::Validation, instrumentationSink());
+    span.describe(area_def_.chart_def());
+
     for (const auto& area : areas) {
+        span.addPointsOut(area.data_size());
         // Validate each area before adding
         epoch_proto::Line validated_area = area;
         ValidationUtils::validateLineData(validated_area, validation_options_);
@@ -56,44 +156,74 @@ AreaChartBuilder& AreaChartBuilder::setStackType(epoch_proto::StackType stack_ty
     return *this;
 }
 
+void AreaChartBuilder::fromDataFrameToSidecar(const epoch_frame::DataFrame& df,
+                                              const std::vector<std::string>& y_cols) {
+    ScopedSpan span("AreaChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(area_def_.chart_def()).setRowsIn(df.table()->num_rows());
+
+    auto table = ArrowSidecar::makeTimeSeriesTable(df.index()->array().to_timestamp_view(), df.table(), y_cols);
+    table = ValidationUtils::validateSeriesTable(std::move(table), validation_options_);
+    sidecar_->add(area_def_.chart_def().id(), table);
+
+    // Column 0 is x; every other column becomes an area carrying only its name
+    for (int i = 1; i < table->num_columns(); ++i) {
+        area_def_.add_areas()->set_name(table->field(i)->name());
+    }
+    span.addPointsOut(table->num_rows() * (table->num_columns() - 1));
+}
+
 AreaChartBuilder& AreaChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df,
                                                     const std::vector<std::string>& y_cols) {
+    if (sidecar_) {
+        fromDataFrameToSidecar(df, y_cols);
+        setXAxisType(epoch_proto::AxisDateTime);
+        setYAxisType(epoch_proto::AxisLinear);
+        return *this;
+    }
+
     std::vector<epoch_proto::Line> areas;
     areas.reserve(y_cols.size());
 
-    auto arrow_table = df.table();
-    auto timestamp_array = df.index()->array().to_timestamp_view();
+    {
+        ScopedSpan span("AreaChartBuilder", SpanPhase::Conversion, instrumentationSink());
+        span.describe(area_def_.chart_def());
 
-    // Get the timestamp type to determine the time unit
-    auto timestamp_type = std::static_pointer_cast<arrow::TimestampType>(timestamp_array->type());
-    auto time_unit = timestamp_type->unit();
+        auto arrow_table = df.table();
+        span.setRowsIn(arrow_table->num_rows());
+        auto timestamp_array = df.index()->array().to_timestamp_view();
 
-    for (const auto& y_col : y_cols) {
-        epoch_proto::Line area;
-        area.set_name(y_col);
+        // Get the timestamp type to determine the time unit
+        auto timestamp_type = std::static_pointer_cast<arrow::TimestampType>(timestamp_array->type());
+        auto time_unit = timestamp_type->unit();
 
-        auto y_column = arrow_table->GetColumnByName(y_col);
-        if (!y_column) {
-            continue;
-        }
+        for (const auto& y_col : y_cols) {
+            epoch_proto::Line area;
+            area.set_name(y_col);
+
+            auto y_column = arrow_table->GetColumnByName(y_col);
+            if (!y_column) {
+                continue;
+            }
 
-        for (int64_t i = 0; i < std::min(timestamp_array->length(), y_column->length()); ++i) {
-            auto y_result = y_column->GetScalar(i);
+            for (int64_t i = 0; i < std::min(timestamp_array->length(), y_column->length()); ++i) {
+                auto y_result = y_column->GetScalar(i);
 
-            if (y_result.ok()) {
-                auto y_scalar = y_result.ValueOrDie();
+                if (y_result.ok()) {
+                    auto y_scalar = y_result.ValueOrDie();
 
-                if (y_scalar->is_valid && !timestamp_array->IsNull(i)) {
-                    auto* point = area.add_data();
-                    // Convert timestamp to milliseconds using the proper time unit
-                    int64_t timestamp_value = timestamp_array->Value(i);
-                    point->set_x(DataFrameFactory::toMilliseconds(timestamp_value, time_unit));
-                    point->set_y(std::static_pointer_cast<arrow::DoubleScalar>(y_scalar)->value);
+                    if (y_scalar->is_valid && !timestamp_array->IsNull(i)) {
+                        auto* point = area.add_data();
+                        // Convert timestamp to milliseconds using the proper time unit
+                        int64_t timestamp_value = timestamp_array->Value(i);
+                        point->set_x(DataFrameFactory::toMilliseconds(timestamp_value, time_unit));
+                        point->set_y(std::static_pointer_cast<arrow::DoubleScalar>(y_scalar)->value);
+                    }
                 }
             }
-        }
 
-        areas.push_back(area);
+            span.addPointsOut(area.data_size());
+            areas.push_back(area);
+        }
     }
 
     addAreas(areas);
@@ -105,6 +235,90 @@ AreaChartBuilder& AreaChartBuilder::fromDataFrame(const epoch_frame::DataFrame&
     return *this;
 }
 
+void AreaChartBuilder::addUnderwater(const epoch_frame::DataFrame& df,
+                                     const std::string& column,
+                                     bool compound,
+                                     const DrawdownOptions& options) {
+    ScopedSpan span("AreaChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(area_def_.chart_def()).setRowsIn(df.table()->num_rows());
+
+    auto values = df.table()->GetColumnByName(column);
+    if (!values) {
+        throw std::runtime_error("AreaChartBuilder: missing column '" + column + "'");
+    }
+    auto timestamp_array = df.index()->array().to_timestamp_view();
+    auto time_unit = std::static_pointer_cast<arrow::TimestampType>(timestamp_array->type())->unit();
+
+    epoch_proto::Line area;
+    area.set_name(options.name);
+    area.mutable_data()->Reserve(static_cast<int>(values->length() - values->null_count()));
+
+    DrawdownTracker tracker(options.top_n, compound ? 1.0 : std::numeric_limits<double>::quiet_NaN());
+    double wealth = 1.0;
+    int64_t row = 0;
+    for (const auto& chunk : values->chunks()) {
+        auto scan = [&](const auto* data) {
+            for (int64_t i = 0; i < chunk->length(); ++i, ++row) {
+                const double value = static_cast<double>(data[i]);
+                if (!chunk->IsValid(i) || std::isnan(value) || row >= timestamp_array->length() ||
+                    timestamp_array->IsNull(row)) {
+                    continue;
+                }
+                if (compound) {
+                    if (value < -1.0) {
+                        throw std::runtime_error("AreaChartBuilder: return below -100% in '" + column + "'");
+                    }
+                    wealth *= 1.0 + value;
+                } else {
+                    if (!(value > 0.0)) {
+                        throw std::runtime_error("AreaChartBuilder: equity in '" + column + "' must be positive");
+                    }
+                    wealth = value;
+                }
+                const int64_t x = DataFrameFactory::toMilliseconds(timestamp_array->Value(row), time_unit);
+                auto* point = area.add_data();
+                point->set_x(x);
+                point->set_y(tracker.step(x, wealth));
+            }
+        };
+        switch (chunk->type_id()) {
+            case arrow::Type::DOUBLE:
+                scan(chunk->data()->GetValues<double>(1));
+                break;
+            case arrow::Type::FLOAT:
+                scan(chunk->data()->GetValues<float>(1));
+                break;
+            default:
+                throw std::runtime_error("AreaChartBuilder: column '" + column + "' must be float or double, got " +
+                                         chunk->type()->ToString());
+        }
+    }
+    drawdown_periods_ = tracker.finish();
+    span.addPointsOut(area.data_size());
+
+    ValidationUtils::validateLineData(area, validation_options_);
+    *area_def_.add_areas() = std::move(area);
+}
+
+AreaChartBuilder& AreaChartBuilder::fromEquityCurve(const epoch_frame::DataFrame& df,
+                                                    const std::string& equity_col,
+                                                    const DrawdownOptions& options) {
+    addUnderwater(df, equity_col, false, options);
+    return *this;
+}
+
+AreaChartBuilder& AreaChartBuilder::fromReturns(const epoch_frame::DataFrame& df,
+                                                const std::string& returns_col,
+                                                const DrawdownOptions& options) {
+    addUnderwater(df, returns_col, true, options);
+    return *this;
+}
+
+AreaChartBuilder& AreaChartBuilder::setArrowSidecar(ArrowSidecarPtr sidecar) {
+    sidecar_ = std::move(sidecar);
+    return *this;
+}
+
 AreaChartBuilder& AreaChartBuilder::setValidationOptions(const ValidationUtils::ValidationOptions& options) {
     validation_options_ = options;
     return *this;
@@ -121,6 +335,9 @@ AreaChartBuilder& AreaChartBuilder::setStrictValidation(bool strict) {
 }
 
 epoch_proto::Chart AreaChartBuilder::build() const {
+    ScopedSpan span("AreaChartBuilder", SpanPhase::Build, instrumentationSink());
+    span.describe(area_def_.chart_def());
+
     // Final validation for stacked areas
     if (validation_options_.strict_validation && area_def_.stacked() && area_def_.areas_size() > 1) {
         std::vector<epoch_proto::Line> all_areas;
@@ -132,6 +349,13 @@ epoch_proto::Chart AreaChartBuilder::build() const {
 
     epoch_proto::Chart chart;
     *chart.mutable_area_def() = area_def_;
+
+    if (span.active()) {
+        for (const auto& area : area_def_.areas()) {
+            span.addPointsOut(area.data_size());
+        }
+        span.setBytesSerialized(static_cast<int64_t>(chart.ByteSizeLong()));
+    }
     return chart;
 }
 
@@ -0,0 +1,323 @@
+#include "epoch_dashboard/tearsheet/arrow_sidecar.h"
+#include "epoch_dashboard/tearsheet/dataframe_converter.h"
+#include <arrow/io/memory.h>
+#include <arrow/ipc/writer.h>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+template <typename T>
+T unwrap(arrow::Result<T> result, const char* context) {
+    if (!result.ok()) {
+        throw std::runtime_error(std::string(context) + ": " + result.status().ToString());
+    }
+    return std::move(result).ValueOrDie();
+}
+
+void check(const arrow::Status& status, const char* context) {
+    if (!status.ok()) {
+        throw std::runtime_error(std::string(context) + ": " + status.ToString());
+    }
+}
+
+// Same buffers, different logical type: no copy
+std::shared_ptr<arrow::Array> reinterpretAs(const std::shared_ptr<arrow::Array>& array,
+                                            const std::shared_ptr<arrow::DataType>& type) {
+    auto data = array->data()->Copy();
+    data->type = type;
+    return arrow::MakeArray(data);
+}
+
+template <typename ArrayType, typename Builder, typename Convert>
+std::shared_ptr<arrow::Array> convertArray(const arrow::Array& source, Convert convert) {
+    const auto& typed = static_cast<const ArrayType&>(source);
+    Builder builder;
+    check(builder.Reserve(typed.length()), "ArrowSidecar: reserve failed");
+    for (int64_t i = 0; i < typed.length(); ++i) {
+        if (typed.IsNull(i)) {
+            builder.UnsafeAppendNull();
+        } else {
+            builder.UnsafeAppend(convert(typed.Value(i)));
+        }
+    }
+    return unwrap(builder.Finish(), "ArrowSidecar: finish failed");
+}
+
+template <typename ArrayType>
+std::shared_ptr<arrow::Array> toDouble(const arrow::Array& source) {
+    return convertArray<ArrayType, arrow::DoubleBuilder>(source, [](auto v) { return static_cast<double>(v); });
+}
+
+std::shared_ptr<arrow::Array> toFloat64(const std::shared_ptr<arrow::Array>& array) {
+    switch (array->type_id()) {
+        case arrow::Type::DOUBLE: return array;
+        case arrow::Type::FLOAT: return toDouble<arrow::FloatArray>(*array);
+        case arrow::Type::INT64: return toDouble<arrow::Int64Array>(*array);
+        case arrow::Type::INT32: return toDouble<arrow::Int32Array>(*array);
+        case arrow::Type::INT16: return toDouble<arrow::Int16Array>(*array);
+        case arrow::Type::INT8: return toDouble<arrow::Int8Array>(*array);
+        case arrow::Type::UINT64: return toDouble<arrow::UInt64Array>(*array);
+        case arrow::Type::UINT32: return toDouble<arrow::UInt32Array>(*array);
+        case arrow::Type::UINT16: return toDouble<arrow::UInt16Array>(*array);
+        case arrow::Type::UINT8: return toDouble<arrow::UInt8Array>(*array);
+        default:
+            throw std::runtime_error("ArrowSidecar: unsupported column type " + array->type()->ToString() +
+                                     ", expected a numeric column");
+    }
+}
+
+std::shared_ptr<arrow::ChunkedArray> toFloat64(const std::shared_ptr<arrow::ChunkedArray>& column) {
+    if (column->type()->id() == arrow::Type::DOUBLE) {
+        return column;
+    }
+    arrow::ArrayVector chunks;
+    chunks.reserve(column->chunks().size());
+    for (const auto& chunk : column->chunks()) {
+        chunks.push_back(toFloat64(chunk));
+    }
+    return std::make_shared<arrow::ChunkedArray>(std::move(chunks), arrow::float64());
+}
+
+std::shared_ptr<arrow::Array> toEpochMillis(const std::shared_ptr<arrow::Array>& index) {
+    switch (index->type_id()) {
+        case arrow::Type::TIMESTAMP: {
+            const auto unit = std::static_pointer_cast<arrow::TimestampType>(index->type())->unit();
+            if (unit == arrow::TimeUnit::MILLI) {
+                return reinterpretAs(index, arrow::int64());
+            }
+            return convertArray<arrow::TimestampArray, arrow::Int64Builder>(
+                *index, [unit](int64_t v) { return DataFrameFactory::toMilliseconds(v, unit); });
+        }
+        case arrow::Type::INT64:
+            return index;
+        case arrow::Type::UINT64:
+            return convertArray<arrow::UInt64Array, arrow::Int64Builder>(
+                *index, [](uint64_t v) { return static_cast<int64_t>(v); });
+        default:
+            throw std::runtime_error("Unsupported index type for Arrow sidecar time series: " +
+                                     index->type()->ToString() + ". Supported types: timestamp, int64_t, uint64_t");
+    }
+}
+
+std::shared_ptr<arrow::Table> makeSeriesTable(std::shared_ptr<arrow::Array> x,
+                                              const std::shared_ptr<arrow::Table>& table,
+                                              const std::vector<std::string>& y_cols) {
+    if (x->length() != table->num_rows()) {
+        throw std::runtime_error("ArrowSidecar: index length " + std::to_string(x->length()) +
+                                 " does not match row count " + std::to_string(table->num_rows()));
+    }
+
+    arrow::FieldVector fields{arrow::field(ArrowSidecar::kXColumn, x->type())};
+    arrow::ChunkedArrayVector columns{std::make_shared<arrow::ChunkedArray>(std::move(x))};
+
+    for (const auto& y_col : y_cols) {
+        auto column = table->GetColumnByName(y_col);
+        if (!column) {
+            continue;
+        }
+        fields.push_back(arrow::field(y_col, arrow::float64()));
+        columns.push_back(toFloat64(column));
+    }
+
+    return arrow::Table::Make(arrow::schema(std::move(fields)), std::move(columns), table->num_rows());
+}
+
+// Codes and dictionary built by interning string views; views point into `column`
+class StringInterner {
+public:
+    explicit StringInterner(size_t max_distinct) : max_distinct_(max_distinct) {}
+
+    // False once the column has more than max_distinct values
+    bool add(const arrow::ChunkedArray& column) {
+        codes_.reserve(static_cast<size_t>(column.length()));
+        for (const auto& chunk : column.chunks()) {
+            const bool ok = visit(*chunk, [&](std::string_view value, bool valid) {
+                if (!valid) {
+                    codes_.push_back(-1);
+                    return true;
+                }
+                auto [it, inserted] = lookup_.try_emplace(value, static_cast<int32_t>(values_.size()));
+                if (inserted) {
+                    values_.push_back(value);
+                }
+                codes_.push_back(it->second);
+                return values_.size() <= max_distinct_;
+            });
+            if (!ok) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::shared_ptr<arrow::Array> finish() const {
+        arrow::Int32Builder codes;
+        check(codes.Reserve(static_cast<int64_t>(codes_.size())), "ArrowSidecar: failed to build dictionary codes");
+        for (const auto code : codes_) {
+            if (code < 0) {
+                codes.UnsafeAppendNull();
+            } else {
+                codes.UnsafeAppend(code);
+            }
+        }
+        arrow::StringBuilder dictionary;
+        for (const auto value : values_) {
+            check(dictionary.Append(value), "ArrowSidecar: failed to build dictionary");
+        }
+        auto indices = unwrap(codes.Finish(), "ArrowSidecar: failed to build dictionary codes");
+        auto values = unwrap(dictionary.Finish(), "ArrowSidecar: failed to build dictionary");
+        return unwrap(arrow::DictionaryArray::FromArrays(arrow::dictionary(arrow::int32(), arrow::utf8()), indices, values),
+                      "ArrowSidecar: failed to build dictionary column");
+    }
+
+    static bool supports(const arrow::DataType& type) {
+        if (type.id() == arrow::Type::DICTIONARY) {
+            const auto& value_type = *static_cast<const arrow::DictionaryType&>(type).value_type();
+            return value_type.id() == arrow::Type::STRING || value_type.id() == arrow::Type::LARGE_STRING;
+        }
+        return type.id() == arrow::Type::STRING || type.id() == arrow::Type::LARGE_STRING;
+    }
+
+private:
+    template <typename StringArrayType, typename Fn>
+    static bool visitStrings(const StringArrayType& strings, Fn&& fn) {
+        for (int64_t i = 0; i < strings.length(); ++i) {
+            if (!fn(strings.IsValid(i) ? strings.GetView(i) : std::string_view{}, strings.IsValid(i))) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename StringArrayType, typename Fn>
+    static bool visitDictionary(const arrow::DictionaryArray& keys, Fn&& fn) {
+        const auto& dictionary = static_cast<const StringArrayType&>(*keys.dictionary());
+        for (int64_t i = 0; i < keys.length(); ++i) {
+            const bool valid = keys.IsValid(i) && dictionary.IsValid(keys.GetValueIndex(i));
+            if (!fn(valid ? dictionary.GetView(keys.GetValueIndex(i)) : std::string_view{}, valid)) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    template <typename Fn>
+    static bool visit(const arrow::Array& chunk, Fn&& fn) {
+        switch (chunk.type_id()) {
+            case arrow::Type::STRING:
+                return visitStrings(static_cast<const arrow::StringArray&>(chunk), fn);
+            case arrow::Type::LARGE_STRING:
+                return visitStrings(static_cast<const arrow::LargeStringArray&>(chunk), fn);
+            default: {
+                const auto& keys = static_cast<const arrow::DictionaryArray&>(chunk);
+                if (keys.dictionary()->type_id() == arrow::Type::STRING) {
+                    return visitDictionary<arrow::StringArray>(keys, fn);
+                }
+                return visitDictionary<arrow::LargeStringArray>(keys, fn);
+            }
+        }
+    }
+
+    size_t max_distinct_;
+    std::unordered_map<std::string_view, int32_t> lookup_;
+    std::vector<std::string_view> values_;
+    std::vector<int32_t> codes_;
+};
+
+} // namespace
+
+void ArrowSidecar::add(const std::string& id, std::shared_ptr<arrow::Table> table) {
+    if (id.empty()) {
+        throw std::runtime_error("ArrowSidecar: chart id is required to reference sidecar data, call setId()");
+    }
+    std::lock_guard lock(mutex_);
+    if (!tables_.emplace(id, std::move(table)).second) {
+        throw std::runtime_error("ArrowSidecar: duplicate chart id '" + id + "'");
+    }
+}
+
+bool ArrowSidecar::contains(const std::string& id) const {
+    std::lock_guard lock(mutex_);
+    return tables_.contains(id);
+}
+
+std::shared_ptr<arrow::Table> ArrowSidecar::get(const std::string& id) const {
+    std::lock_guard lock(mutex_);
+    auto it = tables_.find(id);
+    return it == tables_.end() ? nullptr : it->second;
+}
+
+std::vector<std::string> ArrowSidecar::ids() const {
+    std::lock_guard lock(mutex_);
+    std::vector<std::string> result;
+    result.reserve(tables_.size());
+    for (const auto& [id, table] : tables_) {
+        result.push_back(id);
+    }
+    return result;
+}
+
+size_t ArrowSidecar::size() const {
+    std::lock_guard lock(mutex_);
+    return tables_.size();
+}
+
+std::shared_ptr<arrow::Buffer> ArrowSidecar::toIPC(const std::string& id) const {
+    auto table = get(id);
+    if (!table) {
+        throw std::runtime_error("ArrowSidecar: unknown chart id '" + id + "'");
+    }
+    return serializeIPC(table);
+}
+
+std::shared_ptr<arrow::Buffer> ArrowSidecar::serializeIPC(const std::shared_ptr<arrow::Table>& table) {
+    auto sink = unwrap(arrow::io::BufferOutputStream::Create(), "ArrowSidecar: failed to allocate IPC buffer");
+    auto writer = unwrap(arrow::ipc::MakeStreamWriter(sink, table->schema()),
+                         "ArrowSidecar: failed to open IPC writer");
+    check(writer->WriteTable(*table), "ArrowSidecar: failed to write IPC stream");
+    check(writer->Close(), "ArrowSidecar: failed to close IPC stream");
+    return unwrap(sink->Finish(), "ArrowSidecar: failed to finish IPC buffer");
+}
+
+std::shared_ptr<arrow::Table> ArrowSidecar::makeTimeSeriesTable(const std::shared_ptr<arrow::Array>& index,
+                                                                const std::shared_ptr<arrow::Table>& table,
+                                                                const std::vector<std::string>& y_cols) {
+    return makeSeriesTable(toEpochMillis(index), table, y_cols);
+}
+
+std::shared_ptr<arrow::Table> ArrowSidecar::makeNumericSeriesTable(const std::shared_ptr<arrow::Array>& index,
+                                                                   const std::shared_ptr<arrow::Table>& table,
+                                                                   const std::vector<std::string>& y_cols) {
+    return makeSeriesTable(toFloat64(index), table, y_cols);
+}
+
+std::shared_ptr<arrow::Table> ArrowSidecar::makeDictionaryTable(const std::shared_ptr<arrow::Table>& table,
+                                                                const std::vector<std::string>& columns,
+                                                                double max_distinct_ratio) {
+    const auto names = columns.empty() ? table->ColumnNames() : columns;
+    const auto max_distinct = static_cast<size_t>(max_distinct_ratio * static_cast<double>(table->num_rows()));
+
+    arrow::FieldVector fields;
+    arrow::ChunkedArrayVector selected;
+    for (const auto& name : names) {
+        auto column = table->GetColumnByName(name);
+        if (!column) {
+            throw std::runtime_error("ArrowSidecar: missing column '" + name + "'");
+        }
+        if (StringInterner::supports(*column->type())) {
+            StringInterner interner(max_distinct);
+            if (interner.add(*column)) {
+                column = std::make_shared<arrow::ChunkedArray>(interner.finish());
+            }
+        }
+        fields.push_back(arrow::field(name, column->type()));
+        selected.push_back(std::move(column));
+    }
+    return arrow::Table::Make(arrow::schema(std::move(fields)), std::move(selected), table->num_rows());
+}
+
+} // namespace epoch_tearsheet
@@ -1,11 +1,152 @@
 #include "epoch_dashboard/tearsheet/bar_chart_builder.h"
+#include "epoch_dashboard/tearsheet/arrow_values.h"
 #include "epoch_dashboard/tearsheet/dataframe_converter.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
 #include "epoch_dashboard/tearsheet/series_converter.h"
 #include "epoch_dashboard/tearsheet/validation_utils.h"
 #include "epoch_protos/common.pb.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
+#include <tbb/parallel_for.h>
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
 
 namespace epoch_tearsheet {
 
+namespace {
+
+struct Accumulator {
+    double sum = 0.0;
+    int64_t count = 0;
+    double last = 0.0;
+    int64_t last_row = -1;
+};
+
+// Groups of one or more batches, numbered in order of first appearance
+struct Groups {
+    explicit Groups(size_t width) : width(width) {}
+
+    int32_t groupOf(std::string_view key, int64_t row) {
+        auto [it, inserted] = lookup.try_emplace(key, static_cast<int32_t>(keys.size()));
+        if (inserted) {
+            keys.push_back(key);
+            first_row.push_back(row);
+            accs.resize(accs.size() + width);
+        }
+        return it->second;
+    }
+
+    Accumulator& at(int32_t group, size_t column) { return accs[static_cast<size_t>(group) * width + column]; }
+
+    size_t width;
+    std::unordered_map<std::string_view, int32_t> lookup;
+    std::vector<std::string_view> keys;
+    std::vector<int64_t> first_row;
+    std::vector<Accumulator> accs;
+};
+
+template <typename StringArrayType>
+void groupStrings(const StringArrayType& keys, int64_t offset, Groups& groups, std::vector<int32_t>& rows) {
+    for (int64_t i = 0; i < keys.length(); ++i) {
+        rows[i] = keys.IsValid(i) ? groups.groupOf(keys.GetView(i), offset + i) : -1;
+    }
+}
+
+// Resolves each dictionary index to a group once per batch
+template <typename IndexType, typename StringArrayType>
+void groupDictionary(const arrow::DictionaryArray& keys, const IndexType* indices, const StringArrayType& dictionary,
+                     int64_t offset, Groups& groups, std::vector<int32_t>& rows) {
+    constexpr int32_t kUnresolved = -2;
+    std::vector<int32_t> group_of_index(static_cast<size_t>(dictionary.length()), kUnresolved);
+    for (int64_t i = 0; i < keys.length(); ++i) {
+        if (!keys.IsValid(i)) {
+            rows[i] = -1;
+            continue;
+        }
+        const auto index = static_cast<int64_t>(indices[i]);
+        auto& group = group_of_index[static_cast<size_t>(index)];
+        if (group == kUnresolved) {
+            group = dictionary.IsValid(index) ? groups.groupOf(dictionary.GetView(index), offset + i) : -1;
+        }
+        rows[i] = group;
+    }
+}
+
+template <typename StringArrayType>
+void groupDictionary(const arrow::DictionaryArray& keys, int64_t offset, Groups& groups, std::vector<int32_t>& rows) {
+    const auto& dictionary = static_cast<const StringArrayType&>(*keys.dictionary());
+    visitDictionaryIndices(keys, "BarChartBuilder", [&](const auto* indices) {
+        groupDictionary(keys, indices, dictionary, offset, groups, rows);
+    });
+}
+
+// Group id per row of one batch, -1 for rows without a category
+std::vector<int32_t> groupRows(const std::shared_ptr<arrow::Array>& keys, int64_t offset, Groups& groups) {
+    std::vector<int32_t> rows(static_cast<size_t>(keys->length()));
+    switch (keys->type_id()) {
+        case arrow::Type::STRING:
+            groupStrings(static_cast<const arrow::StringArray&>(*keys), offset, groups, rows);
+            return rows;
+        case arrow::Type::LARGE_STRING:
+            groupStrings(static_cast<const arrow::LargeStringArray&>(*keys), offset, groups, rows);
+            return rows;
+        case arrow::Type::DICTIONARY: {
+            const auto& dictionary = static_cast<const arrow::DictionaryArray&>(*keys);
+            switch (dictionary.dictionary()->type_id()) {
+                case arrow::Type::STRING:
+                    groupDictionary<arrow::StringArray>(dictionary, offset, groups, rows);
+                    return rows;
+                case arrow::Type::LARGE_STRING:
+                    groupDictionary<arrow::LargeStringArray>(dictionary, offset, groups, rows);
+                    return rows;
+                default:
+                    break;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    throw std::runtime_error("BarChartBuilder: category column must be string or dictionary of strings, got " +
+                             keys->type()->ToString());
+}
+
+Groups aggregateBatch(const arrow::RecordBatch& batch, int64_t offset, size_t width) {
+    Groups groups(width);
+    const auto rows = groupRows(batch.column(0), offset, groups);
+    for (size_t c = 0; c < width; ++c) {
+        NumericValues values(batch.column(static_cast<int>(c) + 1), "BarChartBuilder");
+        for (int64_t i = 0; i < batch.num_rows(); ++i) {
+            if (rows[i] < 0 || !values.isValid(i)) {
+                continue;
+            }
+            auto& acc = groups.at(rows[i], c);
+            const double value = values[i];
+            acc.sum += value;
+            ++acc.count;
+            acc.last = value;
+            acc.last_row = offset + i;
+        }
+    }
+    return groups;
+}
+
+double finalize(const Accumulator& acc, BarAggregation agg) {
+    switch (agg) {
+        case BarAggregation::Sum: return acc.sum;
+        case BarAggregation::Mean: return acc.count > 0 ? acc.sum / static_cast<double>(acc.count) : 0.0;
+        case BarAggregation::Count: return static_cast<double>(acc.count);
+        case BarAggregation::Last: return acc.last;
+    }
+    return 0.0;
+}
+
+} // namespace
+
 BarChartBuilder::BarChartBuilder() {
     bar_def_.mutable_chart_def()->set_type(epoch_proto::WidgetBar);
 }
@@ -26,6 +167,9 @@ BarChartBuilder& BarChartBuilder::setData(const epoch_proto::Array& data) {
 }
 
 BarChartBuilder& BarChartBuilder::addBarData(const epoch_proto::BarData& data) {
+    ScopedSpan span("BarChartBuilder", SpanPhase::Validation, instrumentationSink());
+    span.describe(bar_def_.chart_def()).addPointsOut(data.values_size());
+
     // Validate bar data - for stacked bars, don't allow negative values
     bool allow_negative = !bar_def_.stacked();
     ValidationUtils::validateBarData(data, allow_negative);
@@ -60,8 +204,12 @@ BarChartBuilder& BarChartBuilder::setStackType(epoch_proto::StackType stack_type
 }
 
 BarChartBuilder& BarChartBuilder::fromSeries(const epoch_frame::Series& series) {
+    ScopedSpan span("BarChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(bar_def_.chart_def());
+
     // Convert Series to BarData format
     auto array = SeriesFactory::toArray(series);
+    span.setRowsIn(array.values_size());
     bar_def_.clear_data();
     auto* bar_data = bar_def_.add_data();
     bar_data->set_name("Series 1");
@@ -72,6 +220,7 @@ BarChartBuilder& BarChartBuilder::fromSeries(const epoch_frame::Series& series)
             bar_data->add_values(static_cast<double>(scalar.integer_value()));
         }
     }
+    span.addPointsOut(bar_data->values_size());
 
     // Set appropriate axis definitions for bar charts
     setXAxisType(epoch_proto::AxisCategory);
@@ -81,8 +230,12 @@ BarChartBuilder& BarChartBuilder::fromSeries(const epoch_frame::Series& series)
 }
 
 BarChartBuilder& BarChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df, const std::string& column) {
+    ScopedSpan span("BarChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(bar_def_.chart_def());
+
     // Convert DataFrame column to BarData format
     auto array = DataFrameFactory::toArray(df, column);
+    span.setRowsIn(array.values_size());
     bar_def_.clear_data();
     auto* bar_data = bar_def_.add_data();
     bar_data->set_name(column);
@@ -93,6 +246,7 @@ BarChartBuilder& BarChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df
             bar_data->add_values(static_cast<double>(scalar.integer_value()));
         }
     }
+    span.addPointsOut(bar_data->values_size());
 
     // Set appropriate axis definitions for bar charts
     setXAxisType(epoch_proto::AxisCategory);
@@ -101,9 +255,141 @@ BarChartBuilder& BarChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df
     return *this;
 }
 
+BarChartBuilder& BarChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df,
+                                                const std::string& category_col,
+                                                const std::vector<std::string>& value_cols,
+                                                BarAggregation agg,
+                                                BarSortOrder sort) {
+    ScopedSpan span("BarChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(bar_def_.chart_def());
+
+    if (value_cols.empty()) {
+        throw std::runtime_error("BarChartBuilder: at least one value column is required");
+    }
+    auto arrow_table = df.table();
+    span.setRowsIn(arrow_table->num_rows());
+
+    std::vector<std::string> names{category_col};
+    names.insert(names.end(), value_cols.begin(), value_cols.end());
+    arrow::FieldVector fields;
+    arrow::ChunkedArrayVector columns;
+    for (const auto& name : names) {
+        auto column = arrow_table->GetColumnByName(name);
+        if (!column) {
+            throw std::runtime_error("BarChartBuilder: missing column '" + name + "'");
+        }
+        fields.push_back(arrow::field(name, column->type()));
+        columns.push_back(std::move(column));
+    }
+
+    // Aligned batches; string views into them stay valid as long as arrow_table does
+    auto selected = arrow::Table::Make(arrow::schema(fields), columns);
+    arrow::TableBatchReader reader(*selected);
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+    std::vector<int64_t> offsets;
+    int64_t rows = 0;
+    std::shared_ptr<arrow::RecordBatch> batch;
+    while (true) {
+        auto status = reader.ReadNext(&batch);
+        if (!status.ok()) {
+            throw std::runtime_error("BarChartBuilder: " + status.ToString());
+        }
+        if (!batch) {
+            break;
+        }
+        offsets.push_back(rows);
+        rows += batch->num_rows();
+        batches.push_back(std::move(batch));
+    }
+
+    const size_t width = value_cols.size();
+    std::vector<Groups> partials(batches.size(), Groups(width));
+    tbb::parallel_for(size_t{0}, batches.size(), [&](size_t b) {
+        partials[b] = aggregateBatch(*batches[b], offsets[b], width);
+    });
+
+    // Merging in batch order keeps groups numbered by first appearance
+    Groups merged(width);
+    for (const auto& partial : partials) {
+        for (size_t g = 0; g < partial.keys.size(); ++g) {
+            const auto target = merged.groupOf(partial.keys[g], partial.first_row[g]);
+            for (size_t c = 0; c < width; ++c) {
+                const auto& from = partial.accs[g * width + c];
+                auto& into = merged.at(target, c);
+                into.sum += from.sum;
+                into.count += from.count;
+                if (from.last_row > into.last_row) {
+                    into.last = from.last;
+                    into.last_row = from.last_row;
+                }
+            }
+        }
+    }
+
+    const size_t group_count = merged.keys.size();
+    std::vector<int32_t> order(group_count);
+    std::iota(order.begin(), order.end(), 0);
+    if (sort != BarSortOrder::None) {
+        // NaN sorts last either way so the comparator stays a strict weak ordering
+        std::stable_sort(order.begin(), order.end(), [&](int32_t a, int32_t b) {
+            const double lhs = finalize(merged.at(a, 0), agg);
+            const double rhs = finalize(merged.at(b, 0), agg);
+            if (std::isnan(lhs) || std::isnan(rhs)) {
+                return !std::isnan(lhs) && std::isnan(rhs);
+            }
+            return sort == BarSortOrder::Ascending ? lhs < rhs : lhs > rhs;
+        });
+    }
+
+    std::vector<std::string> categories;
+    categories.reserve(group_count);
+    for (const auto group : order) {
+        categories.emplace_back(merged.keys[static_cast<size_t>(group)]);
+    }
+
+    // Same checks as addBarData, before any series replaces the current data
+    const bool allow_negative = !bar_def_.stacked();
+    std::vector<epoch_proto::BarData> series(width);
+    for (size_t c = 0; c < width; ++c) {
+        auto& bar_data = series[c];
+        bar_data.set_name(value_cols[c]);
+        auto* values = bar_data.mutable_values();
+        values->Resize(static_cast<int>(group_count), 0.0);
+        double* out = values->mutable_data();
+        for (size_t i = 0; i < group_count; ++i) {
+            out[i] = finalize(merged.at(order[i], c), agg);
+        }
+        if (group_count > 0) {
+            ValidationUtils::validateBarData(bar_data, allow_negative);
+        }
+    }
+
+    bar_def_.clear_data();
+    for (auto& bar_data : series) {
+        *bar_def_.add_data() = std::move(bar_data);
+        span.addPointsOut(static_cast<int64_t>(group_count));
+    }
+
+    setXAxisType(epoch_proto::AxisCategory);
+    setYAxisType(epoch_proto::AxisLinear);
+    setXAxisCategories(categories);
+
+    return *this;
+}
+
 epoch_proto::Chart BarChartBuilder::build() const {
+    ScopedSpan span("BarChartBuilder", SpanPhase::Build, instrumentationSink());
+    span.describe(bar_def_.chart_def());
+
     epoch_proto::Chart chart;
     *chart.mutable_bar_def() = bar_def_;
+
+    if (span.active()) {
+        for (const auto& data : bar_def_.data()) {
+            span.addPointsOut(data.values_size());
+        }
+        span.setBytesSerialized(static_cast<int64_t>(chart.ByteSizeLong()));
+    }
     return chart;
 }
 
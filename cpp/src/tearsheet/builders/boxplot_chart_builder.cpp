@@ -1,4 +1,6 @@
 #include "epoch_dashboard/tearsheet/boxplot_chart_builder.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include <algorithm>
 
 namespace epoch_tearsheet {
 
@@ -16,9 +18,43 @@ BoxPlotChartBuilder& BoxPlotChartBuilder::addDataPoint(const epoch_proto::BoxPlo
     return *this;
 }
 
+BoxPlotChartBuilder& BoxPlotChartBuilder::addSketch(const QuantileSketch& sketch, double whisker) {
+    const std::vector<double> quartiles = sketch.quantiles(std::vector<double>{0.25, 0.5, 0.75});
+    const double iqr = quartiles[2] - quartiles[0];
+    const double low_fence = quartiles[0] - whisker * iqr;
+    const double high_fence = quartiles[2] + whisker * iqr;
+
+    epoch_proto::BoxPlotDataPoint point;
+    point.set_low(std::max(sketch.min(), low_fence));
+    point.set_q1(quartiles[0]);
+    point.set_median(quartiles[1]);
+    point.set_q3(quartiles[2]);
+    point.set_high(std::min(sketch.max(), high_fence));
+
+    const auto category = static_cast<uint64_t>(box_plot_def_.data().points_size());
+    addDataPoint(point);
+    for (const double extreme : {sketch.min(), sketch.max()}) {
+        if (extreme < low_fence || extreme > high_fence) {
+            epoch_proto::BoxPlotOutlier outlier;
+            outlier.set_category_index(category);
+            outlier.set_value(extreme);
+            addOutlier(outlier);
+        }
+    }
+    return *this;
+}
+
 epoch_proto::Chart BoxPlotChartBuilder::build() const {
+    ScopedSpan span("BoxPlotChartBuilder", SpanPhase::Build, instrumentationSink());
+    span.describe(box_plot_def_.chart_def())
+        .addPointsOut(box_plot_def_.data().points_size() + box_plot_def_.data().outliers_size());
+
     epoch_proto::Chart chart;
     *chart.mutable_box_plot_def() = box_plot_def_;
+
+    if (span.active()) {
+        span.setBytesSerialized(static_cast<int64_t>(chart.ByteSizeLong()));
+    }
     return chart;
 }
 
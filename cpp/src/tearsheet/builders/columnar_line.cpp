@@ -0,0 +1,288 @@
+#include "epoch_dashboard/tearsheet/columnar_line.h"
+#include <bit>
+#include <stdexcept>
+
+#include <google/protobuf/io/coded_stream.h>
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/wire_format_lite.h>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+using google::protobuf::io::CodedInputStream;
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::internal::WireFormatLite;
+
+// Packed doubles are copied as raw little-endian bytes
+static_assert(std::endian::native == std::endian::little, "ColumnarLineCodec assumes a little-endian host");
+
+constexpr int kNameField = 1;
+constexpr int kXField = 2;
+constexpr int kYField = 3;
+constexpr int kDashStyleField = 4;
+constexpr int kLineWidthField = 5;
+
+template <typename LineT>
+void checkLengths(const LineT& line) {
+    if (line.x.size() != line.y.size()) {
+        throw std::runtime_error("Columnar line '" + line.name + "' has " + std::to_string(line.x.size()) +
+                                 " x values but " + std::to_string(line.y.size()) + " y values");
+    }
+}
+
+void writeTag(CodedOutputStream& out, int field, WireFormatLite::WireType type) {
+    out.WriteTag(WireFormatLite::MakeTag(field, type));
+}
+
+void writePackedDoubles(CodedOutputStream& out, int field, const std::vector<double>& values) {
+    if (values.empty()) {
+        return;
+    }
+    writeTag(out, field, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+    out.WriteVarint32(static_cast<uint32_t>(values.size() * sizeof(double)));
+    out.WriteRaw(values.data(), static_cast<int>(values.size() * sizeof(double)));
+}
+
+void writeDeltaSint64(CodedOutputStream& out, int field, const std::vector<int64_t>& values) {
+    if (values.empty()) {
+        return;
+    }
+    size_t bytes = 0;
+    int64_t previous = 0;
+    for (int64_t value : values) {
+        bytes += CodedOutputStream::VarintSize64(WireFormatLite::ZigZagEncode64(value - previous));
+        previous = value;
+    }
+    writeTag(out, field, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+    out.WriteVarint32(static_cast<uint32_t>(bytes));
+    previous = 0;
+    for (int64_t value : values) {
+        out.WriteVarint64(WireFormatLite::ZigZagEncode64(value - previous));
+        previous = value;
+    }
+}
+
+template <typename LineT>
+void writeHeader(CodedOutputStream& out, const LineT& line) {
+    if (!line.name.empty()) {
+        writeTag(out, kNameField, WireFormatLite::WIRETYPE_LENGTH_DELIMITED);
+        out.WriteVarint32(static_cast<uint32_t>(line.name.size()));
+        out.WriteString(line.name);
+    }
+}
+
+template <typename LineT>
+void writeStyle(CodedOutputStream& out, const LineT& line) {
+    if (line.dash_style) {
+        writeTag(out, kDashStyleField, WireFormatLite::WIRETYPE_VARINT);
+        out.WriteVarint64(static_cast<uint64_t>(static_cast<int64_t>(*line.dash_style)));
+    }
+    if (line.line_width) {
+        writeTag(out, kLineWidthField, WireFormatLite::WIRETYPE_VARINT);
+        out.WriteVarint32(*line.line_width);
+    }
+}
+
+template <typename LineT, typename EncodeX>
+std::string encodeLine(const LineT& line, EncodeX encode_x) {
+    checkLengths(line);
+    std::string bytes;
+    bytes.reserve(line.name.size() + line.size() * (sizeof(double) + 5) + 32);
+    {
+        google::protobuf::io::StringOutputStream stream(&bytes);
+        CodedOutputStream out(&stream);
+        writeHeader(out, line);
+        encode_x(out);
+        writePackedDoubles(out, kYField, line.y);
+        writeStyle(out, line);
+    }
+    return bytes;
+}
+
+[[noreturn]] void malformed(const char* what) {
+    throw std::runtime_error(std::string("Malformed columnar line: ") + what);
+}
+
+void expectWireType(uint32_t tag, WireFormatLite::WireType type, const char* field) {
+    if (WireFormatLite::GetTagWireType(tag) != type) {
+        malformed(field);
+    }
+}
+
+void readPackedDoubles(CodedInputStream& in, std::vector<double>& values) {
+    uint32_t length = 0;
+    if (!in.ReadVarint32(&length) || length % sizeof(double) != 0) {
+        malformed("packed double length");
+    }
+    const size_t offset = values.size();
+    values.resize(offset + length / sizeof(double));
+    if (!in.ReadRaw(values.data() + offset, static_cast<int>(length))) {
+        malformed("truncated packed doubles");
+    }
+}
+
+void readDeltaSint64(CodedInputStream& in, std::vector<int64_t>& values) {
+    uint32_t length = 0;
+    if (!in.ReadVarint32(&length)) {
+        malformed("packed sint64 length");
+    }
+    const auto limit = in.PushLimit(static_cast<int>(length));
+    int64_t previous = values.empty() ? 0 : values.back();
+    while (in.BytesUntilLimit() > 0) {
+        uint64_t raw = 0;
+        if (!in.ReadVarint64(&raw)) {
+            malformed("truncated packed sint64");
+        }
+        previous += WireFormatLite::ZigZagDecode64(raw);
+        values.push_back(previous);
+    }
+    in.PopLimit(limit);
+}
+
+template <typename LineT, typename DecodeX>
+LineT decodeLine(std::string_view bytes, DecodeX decode_x) {
+    LineT line;
+    CodedInputStream in(reinterpret_cast<const uint8_t*>(bytes.data()), static_cast<int>(bytes.size()));
+
+    while (const uint32_t tag = in.ReadTag()) {
+        switch (WireFormatLite::GetTagFieldNumber(tag)) {
+            case kNameField: {
+                expectWireType(tag, WireFormatLite::WIRETYPE_LENGTH_DELIMITED, "name");
+                uint32_t length = 0;
+                if (!in.ReadVarint32(&length) || !in.ReadString(&line.name, static_cast<int>(length))) {
+                    malformed("truncated name");
+                }
+                break;
+            }
+            case kXField:
+                expectWireType(tag, WireFormatLite::WIRETYPE_LENGTH_DELIMITED, "x must be packed");
+                decode_x(in, line.x);
+                break;
+            case kYField:
+                expectWireType(tag, WireFormatLite::WIRETYPE_LENGTH_DELIMITED, "y must be packed");
+                readPackedDoubles(in, line.y);
+                break;
+            case kDashStyleField: {
+                expectWireType(tag, WireFormatLite::WIRETYPE_VARINT, "dash_style");
+                uint64_t value = 0;
+                if (!in.ReadVarint64(&value)) {
+                    malformed("truncated dash_style");
+                }
+                line.dash_style = static_cast<epoch_proto::DashStyle>(static_cast<int>(value));
+                break;
+            }
+            case kLineWidthField: {
+                expectWireType(tag, WireFormatLite::WIRETYPE_VARINT, "line_width");
+                uint32_t value = 0;
+                if (!in.ReadVarint32(&value)) {
+                    malformed("truncated line_width");
+                }
+                line.line_width = value;
+                break;
+            }
+            default:
+                // Unknown fields from newer writers are skipped
+                if (!WireFormatLite::SkipField(&in, tag)) {
+                    malformed("unreadable field");
+                }
+        }
+    }
+    if (!in.ConsumedEntireMessage()) {
+        malformed("unexpected end of input");
+    }
+    checkLengths(line);
+    return line;
+}
+
+template <typename LineT, typename ProtoLine>
+void copyStyleToProto(const LineT& line, ProtoLine& proto) {
+    proto.set_name(line.name);
+    if (line.dash_style) {
+        proto.set_dash_style(*line.dash_style);
+    }
+    if (line.line_width) {
+        proto.set_line_width(*line.line_width);
+    }
+}
+
+template <typename ProtoLine, typename LineT>
+void copyStyleFromProto(const ProtoLine& proto, LineT& line) {
+    line.name = proto.name();
+    if (proto.has_dash_style()) {
+        line.dash_style = proto.dash_style();
+    }
+    if (proto.has_line_width()) {
+        line.line_width = proto.line_width();
+    }
+}
+
+} // namespace
+
+std::string ColumnarLineCodec::encode(const ColumnarLine& line) {
+    return encodeLine(line, [&](CodedOutputStream& out) { writeDeltaSint64(out, kXField, line.x); });
+}
+
+std::string ColumnarLineCodec::encode(const ColumnarNumericLine& line) {
+    return encodeLine(line, [&](CodedOutputStream& out) { writePackedDoubles(out, kXField, line.x); });
+}
+
+ColumnarLine ColumnarLineCodec::decodeLine(std::string_view bytes) {
+    return epoch_tearsheet::decodeLine<ColumnarLine>(bytes, readDeltaSint64);
+}
+
+ColumnarNumericLine ColumnarLineCodec::decodeNumericLine(std::string_view bytes) {
+    return epoch_tearsheet::decodeLine<ColumnarNumericLine>(bytes, readPackedDoubles);
+}
+
+epoch_proto::Line ColumnarLineCodec::toLegacy(const ColumnarLine& line) {
+    checkLengths(line);
+    epoch_proto::Line proto;
+    copyStyleToProto(line, proto);
+    proto.mutable_data()->Reserve(static_cast<int>(line.size()));
+    for (size_t i = 0; i < line.size(); ++i) {
+        auto* point = proto.add_data();
+        point->set_x(line.x[i]);
+        point->set_y(line.y[i]);
+    }
+    return proto;
+}
+
+epoch_proto::NumericLine ColumnarLineCodec::toLegacy(const ColumnarNumericLine& line) {
+    checkLengths(line);
+    epoch_proto::NumericLine proto;
+    copyStyleToProto(line, proto);
+    proto.mutable_data()->Reserve(static_cast<int>(line.size()));
+    for (size_t i = 0; i < line.size(); ++i) {
+        auto* point = proto.add_data();
+        point->set_x(line.x[i]);
+        point->set_y(line.y[i]);
+    }
+    return proto;
+}
+
+ColumnarLine ColumnarLineCodec::fromLegacy(const epoch_proto::Line& line) {
+    ColumnarLine columnar;
+    copyStyleFromProto(line, columnar);
+    columnar.x.reserve(static_cast<size_t>(line.data_size()));
+    columnar.y.reserve(static_cast<size_t>(line.data_size()));
+    for (const auto& point : line.data()) {
+        columnar.x.push_back(point.x());
+        columnar.y.push_back(point.y());
+    }
+    return columnar;
+}
+
+ColumnarNumericLine ColumnarLineCodec::fromLegacy(const epoch_proto::NumericLine& line) {
+    ColumnarNumericLine columnar;
+    copyStyleFromProto(line, columnar);
+    columnar.x.reserve(static_cast<size_t>(line.data_size()));
+    columnar.y.reserve(static_cast<size_t>(line.data_size()));
+    for (const auto& point : line.data()) {
+        columnar.x.push_back(point.x());
+        columnar.y.push_back(point.y());
+    }
+    return columnar;
+}
+
+} // namespace epoch_tearsheet
@@ -1,5 +1,6 @@
 #include "epoch_dashboard/tearsheet/dataframe_converter.h"
 #include "epoch_dashboard/tearsheet/scalar_converter.h"
+#include "epoch_dashboard/tearsheet/arrow_sidecar.h"
 #include <epoch_frame/dataframe.h>
 #include <epoch_frame/index.h>
 #include <arrow/api.h>
@@ -162,6 +163,89 @@ std::vector<epoch_proto::Line> DataFrameFactory::toLines(const epoch_frame::Data
     return lines;
 }
 
+namespace {
+
+// Walks a sidecar-layout table (x column, then float64 y columns) into columnar lines
+template <typename LineT, typename XArray>
+std::vector<LineT> toColumnar(const std::shared_ptr<arrow::Table>& table) {
+    std::vector<LineT> lines;
+    lines.reserve(static_cast<size_t>(table->num_columns() - 1));
+    const auto x = std::static_pointer_cast<XArray>(table->column(0)->chunk(0));
+
+    for (int c = 1; c < table->num_columns(); ++c) {
+        LineT line;
+        line.name = table->field(c)->name();
+        line.x.reserve(static_cast<size_t>(table->num_rows()));
+        line.y.reserve(static_cast<size_t>(table->num_rows()));
+
+        int64_t row = 0;
+        for (const auto& chunk : table->column(c)->chunks()) {
+            const auto y = std::static_pointer_cast<arrow::DoubleArray>(chunk);
+            if (y->null_count() == 0 && x->null_count() == 0) {
+                line.x.insert(line.x.end(), x->raw_values() + row, x->raw_values() + row + y->length());
+                line.y.insert(line.y.end(), y->raw_values(), y->raw_values() + y->length());
+            } else {
+                for (int64_t i = 0; i < y->length(); ++i) {
+                    if (y->IsValid(i) && x->IsValid(row + i)) {
+                        line.x.push_back(x->Value(row + i));
+                        line.y.push_back(y->Value(i));
+                    }
+                }
+            }
+            row += y->length();
+        }
+        lines.push_back(std::move(line));
+    }
+    return lines;
+}
+
+} // namespace
+
+std::vector<ColumnarLine> DataFrameFactory::toColumnarLines(const epoch_frame::DataFrame& df,
+                                                            const std::vector<std::string>& y_columns) {
+    std::shared_ptr<arrow::Array> index;
+    switch (df.index()->array()->type()->id()) {
+        case arrow::Type::TIMESTAMP:
+            index = df.index()->array().to_timestamp_view();
+            break;
+        case arrow::Type::INT64:
+            index = df.index()->array().to_view<int64_t>();
+            break;
+        case arrow::Type::UINT64:
+            index = df.index()->array().to_view<uint64_t>();
+            break;
+        default:
+            throw std::runtime_error("Unsupported index type for columnar lines. Supported types: timestamp, int64_t, uint64_t");
+    }
+
+    auto table = ArrowSidecar::makeTimeSeriesTable(index, df.table(), y_columns);
+    return toColumnar<ColumnarLine, arrow::Int64Array>(table);
+}
+
+std::vector<ColumnarNumericLine> DataFrameFactory::toColumnarNumericLines(const epoch_frame::DataFrame& df,
+                                                                          const std::vector<std::string>& y_columns) {
+    std::shared_ptr<arrow::Array> index;
+    switch (df.index()->array()->type()->id()) {
+        case arrow::Type::INT64:
+            index = df.index()->array().to_view<int64_t>();
+            break;
+        case arrow::Type::UINT64:
+            index = df.index()->array().to_view<uint64_t>();
+            break;
+        case arrow::Type::DOUBLE:
+            index = df.index()->array().to_view<double>();
+            break;
+        case arrow::Type::FLOAT:
+            index = df.index()->array().to_view<float>();
+            break;
+        default:
+            throw std::runtime_error("Unsupported index type for columnar numeric lines. Supported types: int64_t, uint64_t, float, double");
+    }
+
+    auto table = ArrowSidecar::makeNumericSeriesTable(index, df.table(), y_columns);
+    return toColumnar<ColumnarNumericLine, arrow::DoubleArray>(table);
+}
+
 epoch_proto::Array DataFrameFactory::toArray(const epoch_frame::DataFrame& df,
                                              const std::string& column_name) {
     epoch_proto::Array array;
@@ -0,0 +1,185 @@
+#include "epoch_dashboard/tearsheet/duckdb_query.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/c/bridge.h>
+#include <duckdb.h>
+#include <tbb/parallel_for.h>
+#include <stdexcept>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+// Connection scoped to one query; Arrow streams registered on it are released with it
+class Connection {
+public:
+    explicit Connection(duckdb_database database) {
+        if (duckdb_connect(database, &connection_) == DuckDBError) {
+            throw std::runtime_error("DuckDbQueryEngine: failed to open connection");
+        }
+    }
+
+    ~Connection() {
+        duckdb_disconnect(&connection_);
+        for (auto& stream : streams_) {
+            if (stream->release) {
+                stream->release(stream.get());
+            }
+        }
+    }
+
+    Connection(const Connection&) = delete;
+    Connection& operator=(const Connection&) = delete;
+
+    void execute(const std::string& sql) {
+        duckdb_result result;
+        const bool failed = duckdb_query(connection_, sql.c_str(), &result) == DuckDBError;
+        const std::string error = failed ? duckdb_result_error(&result) : "";
+        duckdb_destroy_result(&result);
+        if (failed) {
+            throw std::runtime_error("DuckDbQueryEngine: " + error);
+        }
+    }
+
+    void scanArrow(const std::string& name, const std::shared_ptr<arrow::Table>& table) {
+        auto stream = std::make_unique<ArrowArrayStream>();
+        auto status = arrow::ExportRecordBatchReader(std::make_shared<arrow::TableBatchReader>(table), stream.get());
+        if (!status.ok()) {
+            throw std::runtime_error("DuckDbQueryEngine: failed to export table '" + name + "': " + status.ToString());
+        }
+        auto* raw = stream.get();
+        streams_.push_back(std::move(stream));
+        if (duckdb_arrow_scan(connection_, name.c_str(), reinterpret_cast<duckdb_arrow_stream>(raw)) == DuckDBError) {
+            throw std::runtime_error("DuckDbQueryEngine: failed to register table '" + name + "'");
+        }
+    }
+
+    std::shared_ptr<arrow::Table> queryArrow(const std::string& sql) {
+        duckdb_arrow result = nullptr;
+        if (duckdb_query_arrow(connection_, sql.c_str(), &result) == DuckDBError) {
+            const std::string error = result ? duckdb_query_arrow_error(result) : "query failed";
+            duckdb_destroy_arrow(&result);
+            throw std::runtime_error("DuckDbQueryEngine: " + error);
+        }
+
+        try {
+            ArrowSchema c_schema{};
+            auto schema_ptr = reinterpret_cast<duckdb_arrow_schema>(&c_schema);
+            if (duckdb_query_arrow_schema(result, &schema_ptr) == DuckDBError) {
+                throw std::runtime_error("DuckDbQueryEngine: failed to fetch result schema");
+            }
+            auto schema = arrow::ImportSchema(&c_schema).ValueOrDie();
+
+            // Each chunk's buffers are adopted by the imported batch
+            std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+            while (true) {
+                ArrowArray c_array{};
+                auto array_ptr = reinterpret_cast<duckdb_arrow_array>(&c_array);
+                if (duckdb_query_arrow_array(result, &array_ptr) == DuckDBError) {
+                    throw std::runtime_error("DuckDbQueryEngine: " + std::string(duckdb_query_arrow_error(result)));
+                }
+                if (!c_array.release) {
+                    break;
+                }
+                batches.push_back(arrow::ImportRecordBatch(&c_array, schema).ValueOrDie());
+            }
+            duckdb_destroy_arrow(&result);
+            return batches.empty() ? arrow::Table::MakeEmpty(schema).ValueOrDie()
+                                   : arrow::Table::FromRecordBatches(schema, batches).ValueOrDie();
+        } catch (...) {
+            duckdb_destroy_arrow(&result);
+            throw;
+        }
+    }
+
+private:
+    duckdb_connection connection_ = nullptr;
+    std::vector<std::unique_ptr<ArrowArrayStream>> streams_;
+};
+
+std::string quoteIdentifier(const std::string& name) {
+    std::string quoted = "\"";
+    for (char c : name) {
+        quoted += c;
+        if (c == '"') {
+            quoted += '"';
+        }
+    }
+    return quoted + "\"";
+}
+
+std::string quoteLiteral(const std::string& value) {
+    std::string quoted = "'";
+    for (char c : value) {
+        quoted += c;
+        if (c == '\'') {
+            quoted += '\'';
+        }
+    }
+    return quoted + "'";
+}
+
+} // namespace
+
+struct DuckDbQueryEngine::Database {
+    duckdb_database handle = nullptr;
+
+    Database() {
+        if (duckdb_open(nullptr, &handle) == DuckDBError) {
+            throw std::runtime_error("DuckDbQueryEngine: failed to open in-memory database");
+        }
+    }
+
+    ~Database() { duckdb_close(&handle); }
+};
+
+DuckDbQueryEngine::DuckDbQueryEngine() : database_(std::make_unique<Database>()) {}
+
+DuckDbQueryEngine::~DuckDbQueryEngine() = default;
+
+void DuckDbQueryEngine::registerTable(const std::string& name, std::shared_ptr<arrow::Table> table) {
+    if (name.empty() || !table) {
+        throw std::runtime_error("DuckDbQueryEngine: table name and table are required");
+    }
+    std::lock_guard lock(tables_mutex_);
+    tables_[name] = std::move(table);
+}
+
+void DuckDbQueryEngine::registerParquet(const std::string& name, const std::string& path) {
+    if (name.empty()) {
+        throw std::runtime_error("DuckDbQueryEngine: view name is required");
+    }
+    Connection connection(database_->handle);
+    connection.execute("CREATE OR REPLACE VIEW " + quoteIdentifier(name) + " AS SELECT * FROM read_parquet(" +
+                       quoteLiteral(path) + ")");
+}
+
+std::shared_ptr<arrow::Table> DuckDbQueryEngine::query(const std::string& sql) const {
+    ScopedSpan span("DuckDbQueryEngine", SpanPhase::Conversion);
+
+    std::map<std::string, std::shared_ptr<arrow::Table>> tables;
+    {
+        std::lock_guard lock(tables_mutex_);
+        tables = tables_;
+    }
+
+    Connection connection(database_->handle);
+    for (const auto& [name, table] : tables) {
+        connection.scanArrow(name, table);
+    }
+    auto result = connection.queryArrow(sql);
+    span.addPointsOut(result->num_rows());
+    return result;
+}
+
+epoch_frame::DataFrame DuckDbQueryEngine::queryDataFrame(const std::string& sql) const {
+    return epoch_frame::DataFrame(query(sql));
+}
+
+std::vector<std::shared_ptr<arrow::Table>> DuckDbQueryEngine::queryAll(const std::vector<std::string>& sqls) const {
+    std::vector<std::shared_ptr<arrow::Table>> results(sqls.size());
+    tbb::parallel_for(size_t{0}, sqls.size(), [&](size_t i) { results[i] = query(sqls[i]); });
+    return results;
+}
+
+} // namespace epoch_tearsheet
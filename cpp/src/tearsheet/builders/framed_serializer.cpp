@@ -0,0 +1,294 @@
+#include "epoch_dashboard/tearsheet/framed_serializer.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <sstream>
+#include <stdexcept>
+#include <unordered_set>
+
+#include <tbb/parallel_for.h>
+#include <zstd.h>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+constexpr std::array<char, 4> kMagic = {'E', 'P', 'T', 'F'};
+constexpr uint16_t kFormatVersion = 1;
+// Name length, kind, chart index, offset, compressed and raw size of an empty-named entry
+constexpr uint64_t kMinIndexEntryBytes = 2 + 1 + 4 + 3 * 8;
+// Protobuf cannot parse a larger message, so no valid frame decompresses beyond this
+constexpr uint64_t kMaxRawFrameBytes = INT32_MAX;
+
+struct FrameJob {
+    const std::string* category = nullptr;
+    const epoch_proto::TearSheet* tearsheet = nullptr;
+    FrameKind kind = FrameKind::Category;
+    uint32_t chart_index = 0;
+    uint64_t raw_size = 0;
+    std::string compressed;
+};
+
+template <typename T>
+void writeLE(std::ostream& out, T value) {
+    std::array<char, sizeof(T)> bytes{};
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        bytes[i] = static_cast<char>((static_cast<uint64_t>(value) >> (8 * i)) & 0xFF);
+    }
+    out.write(bytes.data(), bytes.size());
+}
+
+template <typename T>
+T readLE(std::istream& in) {
+    std::array<unsigned char, sizeof(T)> bytes{};
+    if (!in.read(reinterpret_cast<char*>(bytes.data()), bytes.size())) {
+        throw std::runtime_error("Framed tearsheet: unexpected end of stream in header");
+    }
+    uint64_t value = 0;
+    for (size_t i = 0; i < sizeof(T); ++i) {
+        value |= static_cast<uint64_t>(bytes[i]) << (8 * i);
+    }
+    return static_cast<T>(value);
+}
+
+// Cards and tables of a category; charts travel in their own frames
+std::string serializeCategoryFrame(const epoch_proto::TearSheet& tearsheet, FrameGranularity granularity) {
+    if (granularity == FrameGranularity::Category || !tearsheet.has_charts()) {
+        return tearsheet.SerializeAsString();
+    }
+    epoch_proto::TearSheet without_charts;
+    if (tearsheet.has_cards()) {
+        *without_charts.mutable_cards() = tearsheet.cards();
+    }
+    if (tearsheet.has_tables()) {
+        *without_charts.mutable_tables() = tearsheet.tables();
+    }
+    return without_charts.SerializeAsString();
+}
+
+void compressFrame(FrameJob& job, FrameGranularity granularity, int level) {
+    const std::string raw = job.kind == FrameKind::Chart
+        ? job.tearsheet->charts().charts(static_cast<int>(job.chart_index)).SerializeAsString()
+        : serializeCategoryFrame(*job.tearsheet, granularity);
+
+    job.raw_size = raw.size();
+    job.compressed.resize(ZSTD_compressBound(raw.size()));
+    const size_t written = ZSTD_compress(job.compressed.data(), job.compressed.size(),
+                                         raw.data(), raw.size(), level);
+    if (ZSTD_isError(written)) {
+        throw std::runtime_error(std::string("Framed tearsheet: zstd compression failed: ") +
+                                 ZSTD_getErrorName(written));
+    }
+    job.compressed.resize(written);
+    job.compressed.shrink_to_fit();
+}
+
+} // namespace
+
+uint64_t FramedTearSheetWriter::write(const epoch_proto::FullTearSheet& full_tearsheet,
+                                      std::ostream& out,
+                                      const FramedWriteOptions& options) {
+    ScopedSpan span("FramedTearSheetWriter", SpanPhase::Build);
+
+    if (options.compression_level < ZSTD_minCLevel() || options.compression_level > ZSTD_maxCLevel()) {
+        throw std::runtime_error("Framed tearsheet: compression level " +
+                                 std::to_string(options.compression_level) + " is out of range");
+    }
+
+    // Map iteration order is unspecified; sort categories so output is deterministic
+    std::vector<const std::string*> names;
+    names.reserve(full_tearsheet.categories().size());
+    for (const auto& [category, tearsheet] : full_tearsheet.categories()) {
+        names.push_back(&category);
+    }
+    std::sort(names.begin(), names.end(), [](const auto* a, const auto* b) { return *a < *b; });
+
+    std::vector<FrameJob> jobs;
+    for (const auto* name : names) {
+        const auto& tearsheet = full_tearsheet.categories().at(*name);
+        if (name->size() > UINT16_MAX) {
+            throw std::runtime_error("Framed tearsheet: category name too long: " + name->substr(0, 64));
+        }
+        jobs.push_back({name, &tearsheet, FrameKind::Category, 0, 0, {}});
+        if (options.granularity == FrameGranularity::Chart) {
+            for (int i = 0; i < tearsheet.charts().charts_size(); ++i) {
+                jobs.push_back({name, &tearsheet, FrameKind::Chart, static_cast<uint32_t>(i), 0, {}});
+            }
+        }
+    }
+
+    tbb::parallel_for(size_t{0}, jobs.size(), [&](size_t i) {
+        compressFrame(jobs[i], options.granularity, options.compression_level);
+    });
+
+    out.write(kMagic.data(), kMagic.size());
+    writeLE<uint16_t>(out, kFormatVersion);
+    writeLE<uint8_t>(out, static_cast<uint8_t>(options.granularity));
+    writeLE<uint8_t>(out, 0);
+    writeLE<uint32_t>(out, static_cast<uint32_t>(jobs.size()));
+    uint64_t written = kMagic.size() + 2 + 1 + 1 + 4;
+
+    uint64_t offset = 0;
+    for (const auto& job : jobs) {
+        writeLE<uint16_t>(out, static_cast<uint16_t>(job.category->size()));
+        out.write(job.category->data(), static_cast<std::streamsize>(job.category->size()));
+        writeLE<uint8_t>(out, static_cast<uint8_t>(job.kind));
+        writeLE<uint32_t>(out, job.chart_index);
+        writeLE<uint64_t>(out, offset);
+        writeLE<uint64_t>(out, job.compressed.size());
+        writeLE<uint64_t>(out, job.raw_size);
+        written += 2 + job.category->size() + 1 + 4 + 3 * 8;
+        offset += job.compressed.size();
+    }
+
+    for (auto& job : jobs) {
+        out.write(job.compressed.data(), static_cast<std::streamsize>(job.compressed.size()));
+        std::string().swap(job.compressed);
+    }
+    written += offset;
+
+    if (!out) {
+        throw std::runtime_error("Framed tearsheet: failed to write output stream");
+    }
+
+    span.setRowsIn(static_cast<int64_t>(names.size()))
+        .addPointsOut(static_cast<int64_t>(jobs.size()))
+        .setBytesSerialized(static_cast<int64_t>(written));
+    return written;
+}
+
+std::string FramedTearSheetWriter::writeToString(const epoch_proto::FullTearSheet& full_tearsheet,
+                                                 const FramedWriteOptions& options) {
+    std::ostringstream out(std::ios::binary);
+    write(full_tearsheet, out, options);
+    return std::move(out).str();
+}
+
+FramedTearSheetReader::FramedTearSheetReader(std::istream& in) : in_(in) {
+    std::array<char, 4> magic{};
+    if (!in_.read(magic.data(), magic.size()) || magic != kMagic) {
+        throw std::runtime_error("Framed tearsheet: bad magic, not a framed tearsheet stream");
+    }
+    const auto version = readLE<uint16_t>(in_);
+    if (version != kFormatVersion) {
+        throw std::runtime_error("Framed tearsheet: unsupported format version " + std::to_string(version));
+    }
+    granularity_ = static_cast<FrameGranularity>(readLE<uint8_t>(in_));
+    readLE<uint8_t>(in_);
+    const auto frame_count = readLE<uint32_t>(in_);
+
+    // Sizes in the header are untrusted; nothing is allocated before they fit the stream
+    const auto index_start = in_.tellg();
+    in_.seekg(0, std::ios::end);
+    stream_end_ = in_.tellg();
+    in_.seekg(index_start);
+    if (static_cast<uint64_t>(frame_count) * kMinIndexEntryBytes >
+        static_cast<uint64_t>(stream_end_ - index_start)) {
+        throw std::runtime_error("Framed tearsheet: corrupt index, " + std::to_string(frame_count) +
+                                 " frames do not fit the stream");
+    }
+
+    index_.reserve(frame_count);
+    for (uint32_t i = 0; i < frame_count; ++i) {
+        FrameIndexEntry entry;
+        entry.category.resize(readLE<uint16_t>(in_));
+        if (!in_.read(entry.category.data(), static_cast<std::streamsize>(entry.category.size()))) {
+            throw std::runtime_error("Framed tearsheet: unexpected end of stream in index");
+        }
+        entry.kind = static_cast<FrameKind>(readLE<uint8_t>(in_));
+        entry.chart_index = readLE<uint32_t>(in_);
+        entry.offset = readLE<uint64_t>(in_);
+        entry.compressed_size = readLE<uint64_t>(in_);
+        entry.raw_size = readLE<uint64_t>(in_);
+        index_.push_back(std::move(entry));
+    }
+    data_start_ = in_.tellg();
+}
+
+std::vector<std::string> FramedTearSheetReader::categories() const {
+    std::vector<std::string> names;
+    std::unordered_set<std::string_view> seen;
+    for (const auto& entry : index_) {
+        if (seen.insert(entry.category).second) {
+            names.push_back(entry.category);
+        }
+    }
+    return names;
+}
+
+bool FramedTearSheetReader::hasCategory(const std::string& category) const {
+    return std::any_of(index_.begin(), index_.end(),
+                       [&](const auto& entry) { return entry.category == category; });
+}
+
+std::string FramedTearSheetReader::readFrame(const FrameIndexEntry& entry) {
+    const auto available = static_cast<uint64_t>(stream_end_ - data_start_);
+    if (entry.offset > available || entry.compressed_size > available - entry.offset) {
+        throw std::runtime_error("Framed tearsheet: truncated frame for category '" + entry.category + "'");
+    }
+    in_.clear();
+    in_.seekg(data_start_ + static_cast<std::streamoff>(entry.offset));
+    compressed_buffer_.resize(entry.compressed_size);
+    if (!in_.read(compressed_buffer_.data(), static_cast<std::streamsize>(compressed_buffer_.size()))) {
+        throw std::runtime_error("Framed tearsheet: truncated frame for category '" + entry.category + "'");
+    }
+
+    // The writer always records the content size in the zstd frame header
+    const auto content_size = ZSTD_getFrameContentSize(compressed_buffer_.data(), compressed_buffer_.size());
+    if (content_size == ZSTD_CONTENTSIZE_ERROR || content_size == ZSTD_CONTENTSIZE_UNKNOWN ||
+        content_size != entry.raw_size || entry.raw_size > kMaxRawFrameBytes) {
+        throw std::runtime_error("Framed tearsheet: corrupt frame for category '" + entry.category + "'");
+    }
+
+    std::string raw(entry.raw_size, '\0');
+    const size_t result = ZSTD_decompress(raw.data(), raw.size(),
+                                          compressed_buffer_.data(), compressed_buffer_.size());
+    if (ZSTD_isError(result) || result != entry.raw_size) {
+        throw std::runtime_error("Framed tearsheet: corrupt frame for category '" + entry.category + "'");
+    }
+    return raw;
+}
+
+epoch_proto::TearSheet FramedTearSheetReader::readCategory(const std::string& category) {
+    ScopedSpan span("FramedTearSheetReader", SpanPhase::Conversion);
+    span.setTitle(category);
+
+    epoch_proto::TearSheet tearsheet;
+    bool found = false;
+    for (const auto& entry : index_) {
+        if (entry.category != category) {
+            continue;
+        }
+        found = true;
+        const auto raw = readFrame(entry);
+        span.addPointsOut(1);
+
+        // Frames are written category frame first, then charts in order
+        bool parsed = false;
+        if (entry.kind == FrameKind::Chart) {
+            parsed = tearsheet.mutable_charts()->add_charts()->ParseFromString(raw);
+        } else {
+            epoch_proto::TearSheet part;
+            parsed = part.ParseFromString(raw);
+            tearsheet.MergeFrom(part);
+        }
+        if (!parsed) {
+            throw std::runtime_error("Framed tearsheet: failed to parse frame for category '" + category + "'");
+        }
+    }
+    if (!found) {
+        throw std::runtime_error("Framed tearsheet: category not found: " + category);
+    }
+    return tearsheet;
+}
+
+epoch_proto::FullTearSheet FramedTearSheetReader::readAll() {
+    epoch_proto::FullTearSheet full_tearsheet;
+    for (const auto& category : categories()) {
+        (*full_tearsheet.mutable_categories())[category] = readCategory(category);
+    }
+    return full_tearsheet;
+}
+
+} // namespace epoch_tearsheet
@@ -1,7 +1,107 @@
 #include "epoch_dashboard/tearsheet/heatmap_chart_builder.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
+#include <arrow/compute/api.h>
+#include <optional>
+#include <stdexcept>
+#include <type_traits>
+#include <unordered_map>
 
 namespace epoch_tearsheet {
 
+namespace {
+
+std::shared_ptr<arrow::Array> castChunk(const std::shared_ptr<arrow::Array>& chunk,
+                                        const std::shared_ptr<arrow::DataType>& type,
+                                        const std::string& column) {
+    auto cast = arrow::compute::Cast(*chunk, type);
+    if (!cast.ok()) {
+        throw std::runtime_error("HeatMapChartBuilder: cannot convert column '" + column + "' to " +
+                                 type->ToString() + ": " + cast.status().ToString());
+    }
+    return *cast;
+}
+
+template <typename T>
+void appendIndexes(const arrow::Array& chunk, const std::string& column, std::vector<std::optional<uint64_t>>& out) {
+    const auto* values = chunk.data()->GetValues<T>(1);
+    for (int64_t i = 0; i < chunk.length(); ++i) {
+        if (chunk.IsNull(i)) {
+            out.emplace_back();
+            continue;
+        }
+        if constexpr (std::is_signed_v<T>) {
+            if (values[i] < 0) {
+                throw std::runtime_error("HeatMapChartBuilder: negative axis value " + std::to_string(values[i]) +
+                                         " in column '" + column + "' at row " + std::to_string(out.size()));
+            }
+        }
+        out.emplace_back(static_cast<uint64_t>(values[i]));
+    }
+}
+
+// Maps a column's values to heat map axis indexes: integers are used as indexes, anything
+// else becomes a category in order of first appearance
+class AxisIndexer {
+public:
+    AxisIndexer(const arrow::ChunkedArray& column, const std::string& name)
+        : is_integer_(arrow::is_integer(column.type()->id())) {
+        indexes_.reserve(column.length());
+        for (const auto& chunk : column.chunks()) {
+            if (is_integer_) {
+                addIntegers(*chunk, name);
+            } else {
+                addCategories(chunk, name);
+            }
+        }
+    }
+
+    const std::optional<uint64_t>& indexAt(int64_t row) const { return indexes_[row]; }
+
+    bool hasCategories() const { return !is_integer_; }
+    const std::vector<std::string>& categories() const { return categories_; }
+
+private:
+    void addIntegers(const arrow::Array& chunk, const std::string& name) {
+        switch (chunk.type_id()) {
+            case arrow::Type::INT8: appendIndexes<int8_t>(chunk, name, indexes_); break;
+            case arrow::Type::INT16: appendIndexes<int16_t>(chunk, name, indexes_); break;
+            case arrow::Type::INT32: appendIndexes<int32_t>(chunk, name, indexes_); break;
+            case arrow::Type::INT64: appendIndexes<int64_t>(chunk, name, indexes_); break;
+            case arrow::Type::UINT8: appendIndexes<uint8_t>(chunk, name, indexes_); break;
+            case arrow::Type::UINT16: appendIndexes<uint16_t>(chunk, name, indexes_); break;
+            case arrow::Type::UINT32: appendIndexes<uint32_t>(chunk, name, indexes_); break;
+            case arrow::Type::UINT64: appendIndexes<uint64_t>(chunk, name, indexes_); break;
+            default:
+                throw std::runtime_error("HeatMapChartBuilder: unsupported integer column '" + name + "'");
+        }
+    }
+
+    void addCategories(const std::shared_ptr<arrow::Array>& chunk, const std::string& name) {
+        auto strings = chunk->type_id() == arrow::Type::STRING ? chunk : castChunk(chunk, arrow::utf8(), name);
+        const auto& array = static_cast<const arrow::StringArray&>(*strings);
+        for (int64_t i = 0; i < array.length(); ++i) {
+            if (array.IsNull(i)) {
+                indexes_.emplace_back();
+                continue;
+            }
+            auto [it, inserted] = lookup_.emplace(std::string(array.GetView(i)), categories_.size());
+            if (inserted) {
+                categories_.push_back(it->first);
+            }
+            indexes_.emplace_back(it->second);
+        }
+    }
+
+    bool is_integer_;
+    std::vector<std::optional<uint64_t>> indexes_;
+    std::unordered_map<std::string, uint64_t> lookup_;
+    std::vector<std::string> categories_;
+};
+
+} // namespace
+
 HeatMapChartBuilder::HeatMapChartBuilder() {
     heat_map_def_.mutable_chart_def()->set_type(epoch_proto::WidgetHeatMap);
 }
@@ -21,9 +121,59 @@ HeatMapChartBuilder& HeatMapChartBuilder::addPoints(const std::vector<epoch_prot
     return *this;
 }
 
+HeatMapChartBuilder& HeatMapChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df,
+                                                          const std::string& x_col,
+                                                          const std::string& y_col,
+                                                          const std::string& value_col) {
+    ScopedSpan span("HeatMapChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(heat_map_def_.chart_def());
+
+    auto arrow_table = df.table();
+    span.setRowsIn(arrow_table->num_rows());
+    auto x_column = arrow_table->GetColumnByName(x_col);
+    auto y_column = arrow_table->GetColumnByName(y_col);
+    auto value_column = arrow_table->GetColumnByName(value_col);
+    if (!x_column || !y_column || !value_column) {
+        throw std::runtime_error("HeatMapChartBuilder: missing column, expected '" + x_col + "', '" + y_col +
+                                 "' and '" + value_col + "'");
+    }
+
+    AxisIndexer x_axis(*x_column, x_col);
+    AxisIndexer y_axis(*y_column, y_col);
+    int64_t row = 0;
+    for (const auto& chunk : value_column->chunks()) {
+        auto doubles = chunk->type_id() == arrow::Type::DOUBLE ? chunk : castChunk(chunk, arrow::float64(), value_col);
+        const auto* values = doubles->data()->GetValues<double>(1);
+        for (int64_t i = 0; i < doubles->length(); ++i, ++row) {
+            const auto& x = x_axis.indexAt(row);
+            const auto& y = y_axis.indexAt(row);
+            if (doubles->IsNull(i) || !x || !y) {
+                continue;
+            }
+            addPoint(*x, *y, values[i]);
+        }
+    }
+
+    if (x_axis.hasCategories()) {
+        setXAxisCategories(x_axis.categories());
+    }
+    if (y_axis.hasCategories()) {
+        setYAxisCategories(y_axis.categories());
+    }
+    span.addPointsOut(heat_map_def_.points_size());
+    return *this;
+}
+
 epoch_proto::Chart HeatMapChartBuilder::build() const {
+    ScopedSpan span("HeatMapChartBuilder", SpanPhase::Build, instrumentationSink());
+    span.describe(heat_map_def_.chart_def()).addPointsOut(heat_map_def_.points_size());
+
     epoch_proto::Chart chart;
     *chart.mutable_heat_map_def() = heat_map_def_;
+
+    if (span.active()) {
+        span.setBytesSerialized(static_cast<int64_t>(chart.ByteSizeLong()));
+    }
     return chart;
 }
 
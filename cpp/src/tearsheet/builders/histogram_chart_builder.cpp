@@ -1,5 +1,7 @@
 #include "epoch_dashboard/tearsheet/histogram_chart_builder.h"
 #include "epoch_dashboard/tearsheet/dataframe_converter.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include "epoch_dashboard/tearsheet/scalar_converter.h"
 #include "epoch_dashboard/tearsheet/series_converter.h"
 #include "epoch_dashboard/tearsheet/validation_utils.h"
 #include "epoch_protos/common.pb.h"
@@ -36,7 +38,11 @@ HistogramChartBuilder& HistogramChartBuilder::setBinsCount(uint32_t bins) {
 }
 
 HistogramChartBuilder& HistogramChartBuilder::fromSeries(const epoch_frame::Series& series, uint32_t bins) {
+    ScopedSpan span("HistogramChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(histogram_def_.chart_def());
+
     auto data = SeriesFactory::toArray(series);
+    span.setRowsIn(data.values_size()).addPointsOut(data.values_size());
 
     // Validate histogram configuration
     ValidationUtils::validateHistogramBins(bins, data.values_size());
@@ -54,7 +60,11 @@ HistogramChartBuilder& HistogramChartBuilder::fromSeries(const epoch_frame::Seri
 HistogramChartBuilder& HistogramChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df,
                                                               const std::string& column,
                                                               uint32_t bins) {
+    ScopedSpan span("HistogramChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(histogram_def_.chart_def());
+
     auto data = DataFrameFactory::toArray(df, column);
+    span.setRowsIn(data.values_size()).addPointsOut(data.values_size());
 
     // Validate histogram configuration
     ValidationUtils::validateHistogramBins(bins, data.values_size());
@@ -77,9 +87,46 @@ HistogramChartBuilder& HistogramChartBuilder::fromDataFrame(const epoch_frame::D
     return *this;
 }
 
+HistogramChartBuilder& HistogramChartBuilder::fromSketch(const QuantileSketch& sketch,
+                                                           uint32_t bins,
+                                                           uint32_t sample_size) {
+    ScopedSpan span("HistogramChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(histogram_def_.chart_def()).setRowsIn(static_cast<int64_t>(sketch.count()));
+
+    ValidationUtils::validateHistogramBins(bins, sample_size);
+
+    // Midpoint ranks, so the sample neither starts at the min nor ends at the max
+    std::vector<double> qs(sample_size);
+    for (uint32_t i = 0; i < sample_size; ++i) {
+        qs[i] = (static_cast<double>(i) + 0.5) / sample_size;
+    }
+    epoch_proto::Array data;
+    for (const double value : sketch.quantiles(qs)) {
+        *data.add_values() = ScalarFactory::fromDecimal(value);
+    }
+    span.addPointsOut(data.values_size());
+
+    *histogram_def_.mutable_data() = std::move(data);
+    histogram_def_.set_bins_count(bins);
+
+    // Set appropriate axis definitions for histograms
+    setXAxisType(epoch_proto::AxisLinear);
+    setYAxisType(epoch_proto::AxisLinear);
+
+    return *this;
+}
+
 epoch_proto::Chart HistogramChartBuilder::build() const {
+    ScopedSpan span("HistogramChartBuilder", SpanPhase::Build, instrumentationSink());
+    span.describe(histogram_def_.chart_def());
+
     epoch_proto::Chart chart;
     *chart.mutable_histogram_def() = histogram_def_;
+
+    if (span.active()) {
+        span.addPointsOut(histogram_def_.data().values_size());
+        span.setBytesSerialized(static_cast<int64_t>(chart.ByteSizeLong()));
+    }
     return chart;
 }
 
@@ -0,0 +1,219 @@
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include <atomic>
+#include <iomanip>
+#include <sstream>
+#include <stdexcept>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+std::mutex& registryMutex() {
+    static std::mutex mutex;
+    return mutex;
+}
+
+InstrumentationSinkPtr& globalSinkStorage() {
+    static InstrumentationSinkPtr sink;
+    return sink;
+}
+
+std::function<uint64_t()>& allocationCounterStorage() {
+    static std::function<uint64_t()> counter;
+    return counter;
+}
+
+// Lets ScopedSpan skip the mutex entirely when nothing is registered
+std::atomic<bool> g_has_global_sink{false};
+std::atomic<bool> g_has_allocation_counter{false};
+
+thread_local InstrumentationSinkPtr t_scoped_sink;
+
+void writeJsonString(std::ostream& out, std::string_view value) {
+    out << '"';
+    for (char c : value) {
+        switch (c) {
+            case '"': out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            case '\r': out << "\\r"; break;
+            case '\t': out << "\\t"; break;
+            default:
+                if (static_cast<unsigned char>(c) < 0x20) {
+                    out << "\\u" << std::hex << std::setw(4) << std::setfill('0')
+                        << static_cast<int>(c) << std::dec << std::setfill(' ');
+                } else {
+                    out << c;
+                }
+        }
+    }
+    out << '"';
+}
+
+} // namespace
+
+std::string_view toString(SpanPhase phase) {
+    switch (phase) {
+        case SpanPhase::Conversion:
+            return "conversion";
+        case SpanPhase::Validation:
+            return "validation";
+        case SpanPhase::Build:
+            return "build";
+    }
+    return "unknown";
+}
+
+void Instrumentation::setGlobalSink(InstrumentationSinkPtr sink) {
+    std::lock_guard lock(registryMutex());
+    g_has_global_sink.store(sink != nullptr, std::memory_order_release);
+    globalSinkStorage() = std::move(sink);
+}
+
+InstrumentationSinkPtr Instrumentation::globalSink() {
+    if (!g_has_global_sink.load(std::memory_order_acquire)) {
+        return nullptr;
+    }
+    std::lock_guard lock(registryMutex());
+    return globalSinkStorage();
+}
+
+InstrumentationSinkPtr Instrumentation::currentSink() {
+    if (t_scoped_sink) {
+        return t_scoped_sink;
+    }
+    return globalSink();
+}
+
+void Instrumentation::setAllocationCounter(std::function<uint64_t()> counter) {
+    std::lock_guard lock(registryMutex());
+    g_has_allocation_counter.store(static_cast<bool>(counter), std::memory_order_release);
+    allocationCounterStorage() = std::move(counter);
+}
+
+uint64_t Instrumentation::allocationCount() {
+    if (!g_has_allocation_counter.load(std::memory_order_acquire)) {
+        return 0;
+    }
+    std::function<uint64_t()> counter;
+    {
+        std::lock_guard lock(registryMutex());
+        counter = allocationCounterStorage();
+    }
+    return counter ? counter() : 0;
+}
+
+InstrumentationScope::InstrumentationScope(InstrumentationSinkPtr sink)
+    : previous_(std::move(t_scoped_sink)) {
+    t_scoped_sink = std::move(sink);
+}
+
+InstrumentationScope::~InstrumentationScope() {
+    t_scoped_sink = std::move(previous_);
+}
+
+#if EPOCH_DASHBOARD_INSTRUMENTATION
+
+ScopedSpan::ScopedSpan(std::string_view builder, SpanPhase phase)
+    : ScopedSpan(builder, phase, nullptr) {}
+
+ScopedSpan::ScopedSpan(std::string_view builder, SpanPhase phase, const InstrumentationSinkPtr& sink)
+    : sink_(sink ? sink : Instrumentation::currentSink()) {
+    if (!sink_) {
+        return;
+    }
+    span_.builder = builder;
+    span_.phase = phase;
+    span_.thread_id = std::this_thread::get_id();
+    allocations_at_start_ = Instrumentation::allocationCount();
+    span_.start = std::chrono::steady_clock::now();
+}
+
+ScopedSpan::~ScopedSpan() {
+    if (!sink_) {
+        return;
+    }
+    span_.wall_time = std::chrono::steady_clock::now() - span_.start;
+    span_.allocations = static_cast<int64_t>(Instrumentation::allocationCount() - allocations_at_start_);
+    if (chart_def_) {
+        span_.chart_id = chart_def_->id();
+        if (span_.title.empty()) {
+            span_.title = chart_def_->title();
+        }
+    }
+    try {
+        sink_->onSpan(span_);
+    } catch (...) {
+        // Instrumentation must never turn a successful build into a failure
+    }
+}
+
+#endif
+
+ChromeTraceSink::ChromeTraceSink(std::ostream& out)
+    : out_(out), origin_(std::chrono::steady_clock::now()) {
+    out_ << "{\"traceEvents\":[";
+}
+
+ChromeTraceSink::ChromeTraceSink(const std::string& path)
+    : file_(path), out_(file_), origin_(std::chrono::steady_clock::now()) {
+    if (!file_) {
+        throw std::runtime_error("Failed to open trace file: " + path);
+    }
+    out_ << "{\"traceEvents\":[";
+}
+
+ChromeTraceSink::~ChromeTraceSink() {
+    close();
+}
+
+void ChromeTraceSink::onSpan(const BuildSpan& span) {
+    using std::chrono::duration_cast;
+    using std::chrono::microseconds;
+
+    std::lock_guard lock(mutex_);
+    if (closed_) {
+        return;
+    }
+
+    auto [it, inserted] = thread_ids_.try_emplace(span.thread_id, thread_ids_.size() + 1);
+    const auto ts = duration_cast<microseconds>(span.start - origin_).count();
+    const auto dur = duration_cast<microseconds>(span.wall_time).count();
+
+    std::string_view name = !span.title.empty() ? std::string_view(span.title)
+                          : !span.chart_id.empty() ? std::string_view(span.chart_id)
+                          : span.builder;
+
+    if (!first_event_) {
+        out_ << ',';
+    }
+    first_event_ = false;
+
+    out_ << "\n{\"name\":";
+    writeJsonString(out_, name);
+    out_ << ",\"cat\":";
+    writeJsonString(out_, toString(span.phase));
+    out_ << ",\"ph\":\"X\",\"ts\":" << ts << ",\"dur\":" << dur
+         << ",\"pid\":1,\"tid\":" << it->second << ",\"args\":{\"builder\":";
+    writeJsonString(out_, span.builder);
+    out_ << ",\"chart_id\":";
+    writeJsonString(out_, span.chart_id);
+    out_ << ",\"title\":";
+    writeJsonString(out_, span.title);
+    out_ << ",\"rows_in\":" << span.rows_in
+         << ",\"points_out\":" << span.points_out
+         << ",\"bytes_serialized\":" << span.bytes_serialized
+         << ",\"allocations\":" << span.allocations << "}}";
+}
+
+void ChromeTraceSink::close() {
+    std::lock_guard lock(mutex_);
+    if (closed_) {
+        return;
+    }
+    closed_ = true;
+    out_ << "\n]}\n";
+    out_.flush();
+}
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,694 @@
+#include "epoch_dashboard/tearsheet/json_serializer.h"
+#include <glaze/util/dtoa.hpp>
+#include <glaze/util/itoa.hpp>
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <stdexcept>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+// Appends JSON tokens to one buffer; with a stream attached the buffer is flushed when full
+class JsonWriter {
+public:
+    explicit JsonWriter(std::ostream* out = nullptr) : out_(out) {
+        buffer_.reserve(out_ ? JsonSerializer::kFlushBytes + kMaxToken : 4096);
+    }
+
+    void raw(char c) {
+        buffer_.push_back(c);
+    }
+
+    void raw(std::string_view text) {
+        buffer_.append(text);
+        maybeFlush();
+    }
+
+    void string(std::string_view text) {
+        buffer_.push_back('"');
+        size_t start = 0;
+        for (size_t i = 0; i < text.size(); ++i) {
+            const auto c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+            buffer_.append(text.substr(start, i - start));
+            start = i + 1;
+            switch (c) {
+                case '"': buffer_.append("\\\""); break;
+                case '\\': buffer_.append("\\\\"); break;
+                case '\b': buffer_.append("\\b"); break;
+                case '\f': buffer_.append("\\f"); break;
+                case '\n': buffer_.append("\\n"); break;
+                case '\r': buffer_.append("\\r"); break;
+                case '\t': buffer_.append("\\t"); break;
+                default: {
+                    constexpr char kHex[] = "0123456789abcdef";
+                    const char escaped[] = {'\\', 'u', '0', '0', kHex[c >> 4], kHex[c & 0xF]};
+                    buffer_.append(escaped, sizeof(escaped));
+                }
+            }
+        }
+        buffer_.append(text.substr(start));
+        buffer_.push_back('"');
+        maybeFlush();
+    }
+
+    void number(double value) {
+        if (std::isnan(value)) {
+            raw("\"NaN\"");
+        } else if (std::isinf(value)) {
+            raw(value > 0 ? "\"Infinity\"" : "\"-Infinity\"");
+        } else {
+            append([&](char* out) { return glz::to_chars(out, value); });
+        }
+    }
+
+    // Canonical JSON quotes 64-bit integers, which do not survive a round trip through double
+    void int64(int64_t value) {
+        append([&](char* out) {
+            *out = '"';
+            out = glz::to_chars(out + 1, value);
+            *out = '"';
+            return out + 1;
+        });
+    }
+
+    void uint64(uint64_t value) {
+        append([&](char* out) {
+            *out = '"';
+            out = glz::to_chars(out + 1, value);
+            *out = '"';
+            return out + 1;
+        });
+    }
+
+    void uint32(uint32_t value) {
+        append([&](char* out) { return glz::to_chars(out, value); });
+    }
+
+    void int32(int32_t value) {
+        append([&](char* out) { return glz::to_chars(out, value); });
+    }
+
+    void boolean(bool value) {
+        raw(value ? std::string_view("true") : std::string_view("false"));
+    }
+
+    template <typename Name>
+    void enumeration(int value, Name name) {
+        const auto& text = name(value);
+        if (text.empty()) {
+            int32(value);
+        } else {
+            string(text);
+        }
+    }
+
+    uint64_t finish() {
+        flush();
+        return bytes_written_;
+    }
+
+    std::string take() {
+        return std::move(buffer_);
+    }
+
+private:
+    static constexpr size_t kMaxToken = 32;
+
+    template <typename Format>
+    void append(Format format) {
+        const size_t size = buffer_.size();
+        buffer_.resize_and_overwrite(size + kMaxToken, [&](char* data, size_t) {
+            return static_cast<size_t>(format(data + size) - data);
+        });
+        maybeFlush();
+    }
+
+    void maybeFlush() {
+        if (out_ && buffer_.size() >= JsonSerializer::kFlushBytes) {
+            flush();
+        }
+    }
+
+    void flush() {
+        if (!out_ || buffer_.empty()) {
+            return;
+        }
+        out_->write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+        if (!*out_) {
+            throw std::runtime_error("JsonSerializer: failed to write to output stream");
+        }
+        bytes_written_ += buffer_.size();
+        buffer_.clear();
+    }
+
+    std::ostream* out_;
+    std::string buffer_;
+    uint64_t bytes_written_ = 0;
+};
+
+void write(JsonWriter& w, const epoch_proto::Scalar& scalar);
+void write(JsonWriter& w, const epoch_proto::Array& array);
+void write(JsonWriter& w, const epoch_proto::ColumnDef& column);
+void write(JsonWriter& w, const epoch_proto::TableRow& row);
+void write(JsonWriter& w, const epoch_proto::CardData& data);
+void write(JsonWriter& w, const epoch_proto::CardDef& card);
+void write(JsonWriter& w, const epoch_proto::Table& table);
+void write(JsonWriter& w, const epoch_proto::XRangePoint& point);
+void write(JsonWriter& w, const epoch_proto::StraightLineDef& line);
+void write(JsonWriter& w, const epoch_proto::Point& point);
+void write(JsonWriter& w, const epoch_proto::PieData& data);
+void write(JsonWriter& w, const epoch_proto::NumericPoint& point);
+void write(JsonWriter& w, const epoch_proto::HeatMapPoint& point);
+void write(JsonWriter& w, const epoch_proto::BoxPlotOutlier& outlier);
+void write(JsonWriter& w, const epoch_proto::BoxPlotDataPoint& point);
+void write(JsonWriter& w, const epoch_proto::BarData& data);
+void write(JsonWriter& w, const epoch_proto::PieDataDef& data);
+void write(JsonWriter& w, const epoch_proto::Line& line);
+void write(JsonWriter& w, const epoch_proto::NumericLine& line);
+void write(JsonWriter& w, const epoch_proto::Band& band);
+void write(JsonWriter& w, const epoch_proto::Chart& chart);
+void write(JsonWriter& w, const epoch_proto::TearSheet& tearsheet);
+
+void write(JsonWriter& w, double value) {
+    w.number(value);
+}
+
+void write(JsonWriter& w, const std::string& value) {
+    w.string(value);
+}
+
+// Fields of one object; the caller omits defaults, this only places the commas
+class Fields {
+public:
+    explicit Fields(JsonWriter& w) : w_(w) {}
+
+    JsonWriter& key(std::string_view name) {
+        w_.raw(first_ ? std::string_view("\"") : std::string_view(",\""));
+        first_ = false;
+        w_.raw(name);
+        w_.raw("\":");
+        return w_;
+    }
+
+    void string(std::string_view name, const std::string& value) {
+        if (!value.empty()) {
+            key(name).string(value);
+        }
+    }
+
+    void number(std::string_view name, double value) {
+        // Proto3 omits only +0.0; -0.0 has a different bit pattern and is printed
+        if (std::bit_cast<uint64_t>(value) != 0) {
+            key(name).number(value);
+        }
+    }
+
+    void int64(std::string_view name, int64_t value) {
+        if (value != 0) {
+            key(name).int64(value);
+        }
+    }
+
+    void uint64(std::string_view name, uint64_t value) {
+        if (value != 0) {
+            key(name).uint64(value);
+        }
+    }
+
+    void boolean(std::string_view name, bool value) {
+        if (value) {
+            key(name).boolean(true);
+        }
+    }
+
+    template <typename Name>
+    void enumeration(std::string_view name, int value, Name to_name) {
+        if (value != 0) {
+            key(name).enumeration(value, to_name);
+        }
+    }
+
+    template <typename Message>
+    void message(std::string_view name, bool present, const Message& value) {
+        if (present) {
+            write(key(name), value);
+        }
+    }
+
+    template <typename Repeated>
+    void repeated(std::string_view name, const Repeated& values) {
+        if (values.empty()) {
+            return;
+        }
+        auto& w = key(name);
+        w.raw('[');
+        bool first = true;
+        for (const auto& value : values) {
+            if (!first) {
+                w.raw(',');
+            }
+            first = false;
+            write(w, value);
+        }
+        w.raw(']');
+    }
+
+private:
+    JsonWriter& w_;
+    bool first_ = true;
+};
+
+template <typename Body>
+void object(JsonWriter& w, Body body) {
+    w.raw('{');
+    Fields fields(w);
+    body(fields);
+    w.raw('}');
+}
+
+const std::string& widgetName(int value) {
+    return epoch_proto::EpochFolioDashboardWidget_Name(static_cast<epoch_proto::EpochFolioDashboardWidget>(value));
+}
+
+const std::string& typeName(int value) {
+    return epoch_proto::EpochFolioType_Name(static_cast<epoch_proto::EpochFolioType>(value));
+}
+
+const std::string& axisTypeName(int value) {
+    return epoch_proto::AxisType_Name(static_cast<epoch_proto::AxisType>(value));
+}
+
+const std::string& dashStyleName(int value) {
+    return epoch_proto::DashStyle_Name(static_cast<epoch_proto::DashStyle>(value));
+}
+
+const std::string& stackTypeName(int value) {
+    return epoch_proto::StackType_Name(static_cast<epoch_proto::StackType>(value));
+}
+
+const std::string& nullValueName(int value) {
+    return epoch_proto::NullValue_Name(static_cast<epoch_proto::NullValue>(value));
+}
+
+// Oneof members are printed whenever they are set, default value or not
+void write(JsonWriter& w, const epoch_proto::Scalar& scalar) {
+    object(w, [&](Fields& f) {
+        switch (scalar.value_case()) {
+            case epoch_proto::Scalar::kStringValue: f.key("stringValue").string(scalar.string_value()); break;
+            case epoch_proto::Scalar::kIntegerValue: f.key("integerValue").int64(scalar.integer_value()); break;
+            case epoch_proto::Scalar::kDecimalValue: f.key("decimalValue").number(scalar.decimal_value()); break;
+            case epoch_proto::Scalar::kPercentValue: f.key("percentValue").number(scalar.percent_value()); break;
+            case epoch_proto::Scalar::kBooleanValue: f.key("booleanValue").boolean(scalar.boolean_value()); break;
+            case epoch_proto::Scalar::kTimestampMs: f.key("timestampMs").int64(scalar.timestamp_ms()); break;
+            case epoch_proto::Scalar::kDateValue: f.key("dateValue").int64(scalar.date_value()); break;
+            case epoch_proto::Scalar::kDayDuration: f.key("dayDuration").int32(scalar.day_duration()); break;
+            case epoch_proto::Scalar::kMonetaryValue: f.key("monetaryValue").number(scalar.monetary_value()); break;
+            case epoch_proto::Scalar::kDurationMs: f.key("durationMs").int64(scalar.duration_ms()); break;
+            case epoch_proto::Scalar::kNullValue:
+                f.key("nullValue").enumeration(scalar.null_value(), nullValueName);
+                break;
+            case epoch_proto::Scalar::VALUE_NOT_SET: break;
+        }
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::Array& array) {
+    object(w, [&](Fields& f) { f.repeated("values", array.values()); });
+}
+
+void write(JsonWriter& w, const epoch_proto::ColumnDef& column) {
+    object(w, [&](Fields& f) {
+        f.string("id", column.id());
+        f.string("name", column.name());
+        f.enumeration("type", column.type(), typeName);
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::TableRow& row) {
+    object(w, [&](Fields& f) { f.repeated("values", row.values()); });
+}
+
+void write(JsonWriter& w, const epoch_proto::CardData& data) {
+    object(w, [&](Fields& f) {
+        f.string("title", data.title());
+        f.message("value", data.has_value(), data.value());
+        f.enumeration("type", data.type(), typeName);
+        f.uint64("group", data.group());
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::CardDef& card) {
+    object(w, [&](Fields& f) {
+        f.enumeration("type", card.type(), widgetName);
+        f.string("category", card.category());
+        f.repeated("data", card.data());
+        f.uint64("groupSize", card.group_size());
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::Table& table) {
+    object(w, [&](Fields& f) {
+        f.enumeration("type", table.type(), widgetName);
+        f.string("category", table.category());
+        f.string("title", table.title());
+        f.repeated("columns", table.columns());
+        if (table.has_data()) {
+            object(f.key("data"), [&](Fields& data) { data.repeated("rows", table.data().rows()); });
+        }
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::XRangePoint& point) {
+    object(w, [&](Fields& f) {
+        f.int64("x", point.x());
+        f.int64("x2", point.x2());
+        f.uint64("y", point.y());
+        f.boolean("isLong", point.is_long());
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::StraightLineDef& line) {
+    object(w, [&](Fields& f) {
+        f.string("title", line.title());
+        f.number("value", line.value());
+        f.boolean("vertical", line.vertical());
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::Point& point) {
+    object(w, [&](Fields& f) {
+        f.int64("x", point.x());
+        f.number("y", point.y());
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::PieData& data) {
+    object(w, [&](Fields& f) {
+        f.string("name", data.name());
+        f.number("y", data.y());
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::NumericPoint& point) {
+    object(w, [&](Fields& f) {
+        f.number("x", point.x());
+        f.number("y", point.y());
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::HeatMapPoint& point) {
+    object(w, [&](Fields& f) {
+        f.uint64("x", point.x());
+        f.uint64("y", point.y());
+        f.number("value", point.value());
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::BoxPlotOutlier& outlier) {
+    object(w, [&](Fields& f) {
+        f.uint64("categoryIndex", outlier.category_index());
+        f.number("value", outlier.value());
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::BoxPlotDataPoint& point) {
+    object(w, [&](Fields& f) {
+        f.number("low", point.low());
+        f.number("q1", point.q1());
+        f.number("median", point.median());
+        f.number("q3", point.q3());
+        f.number("high", point.high());
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::BarData& data) {
+    object(w, [&](Fields& f) {
+        f.string("name", data.name());
+        f.repeated("values", data.values());
+        if (data.has_stack()) {
+            f.key("stack").string(data.stack());
+        }
+    });
+}
+
+void writeAxis(JsonWriter& w, const epoch_proto::AxisDef& axis) {
+    object(w, [&](Fields& f) {
+        if (axis.has_type()) {
+            f.key("type").enumeration(axis.type(), axisTypeName);
+        }
+        if (axis.has_label()) {
+            f.key("label").string(axis.label());
+        }
+        f.repeated("categories", axis.categories());
+    });
+}
+
+void writeChartDef(Fields& f, bool present, const epoch_proto::ChartDef& def) {
+    if (!present) {
+        return;
+    }
+    object(f.key("chartDef"), [&](Fields& c) {
+        c.string("id", def.id());
+        c.string("title", def.title());
+        c.enumeration("type", def.type(), widgetName);
+        c.string("category", def.category());
+        if (def.has_y_axis()) {
+            writeAxis(c.key("yAxis"), def.y_axis());
+        }
+        if (def.has_x_axis()) {
+            writeAxis(c.key("xAxis"), def.x_axis());
+        }
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::PieDataDef& data) {
+    object(w, [&](Fields& f) {
+        f.string("name", data.name());
+        f.repeated("points", data.points());
+        f.string("size", data.size());
+        if (data.has_inner_size()) {
+            f.key("innerSize").string(data.inner_size());
+        }
+    });
+}
+
+template <typename LineT>
+void writeLine(JsonWriter& w, const LineT& line) {
+    object(w, [&](Fields& f) {
+        f.repeated("data", line.data());
+        f.string("name", line.name());
+        if (line.has_dash_style()) {
+            f.key("dashStyle").enumeration(line.dash_style(), dashStyleName);
+        }
+        if (line.has_line_width()) {
+            f.key("lineWidth").uint32(line.line_width());
+        }
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::Line& line) {
+    writeLine(w, line);
+}
+
+void write(JsonWriter& w, const epoch_proto::NumericLine& line) {
+    writeLine(w, line);
+}
+
+void write(JsonWriter& w, const epoch_proto::Band& band) {
+    object(w, [&](Fields& f) {
+        f.message("from", band.has_from(), band.from());
+        f.message("to", band.has_to(), band.to());
+    });
+}
+
+// LinesDef and NumericLinesDef share a layout
+template <typename LinesDefT>
+void writeLinesDef(JsonWriter& w, const LinesDefT& def) {
+    object(w, [&](Fields& f) {
+        writeChartDef(f, def.has_chart_def(), def.chart_def());
+        f.repeated("lines", def.lines());
+        f.repeated("straightLines", def.straight_lines());
+        f.repeated("yPlotBands", def.y_plot_bands());
+        f.repeated("xPlotBands", def.x_plot_bands());
+        f.message("overlay", def.has_overlay(), def.overlay());
+        f.boolean("stacked", def.stacked());
+    });
+}
+
+void writeChartBody(Fields& f, const epoch_proto::Chart& chart) {
+    switch (chart.chart_type_case()) {
+        case epoch_proto::Chart::kLinesDef:
+            writeLinesDef(f.key("linesDef"), chart.lines_def());
+            break;
+        case epoch_proto::Chart::kHeatMapDef: {
+            const auto& def = chart.heat_map_def();
+            object(f.key("heatMapDef"), [&](Fields& c) {
+                writeChartDef(c, def.has_chart_def(), def.chart_def());
+                c.repeated("points", def.points());
+            });
+            break;
+        }
+        case epoch_proto::Chart::kBarDef: {
+            const auto& def = chart.bar_def();
+            object(f.key("barDef"), [&](Fields& c) {
+                writeChartDef(c, def.has_chart_def(), def.chart_def());
+                c.repeated("data", def.data());
+                c.repeated("straightLines", def.straight_lines());
+                if (def.has_bar_width()) {
+                    c.key("barWidth").uint32(def.bar_width());
+                }
+                c.boolean("vertical", def.vertical());
+                c.boolean("stacked", def.stacked());
+                if (def.has_stack_type()) {
+                    c.key("stackType").enumeration(def.stack_type(), stackTypeName);
+                }
+            });
+            break;
+        }
+        case epoch_proto::Chart::kHistogramDef: {
+            const auto& def = chart.histogram_def();
+            object(f.key("histogramDef"), [&](Fields& c) {
+                writeChartDef(c, def.has_chart_def(), def.chart_def());
+                c.message("data", def.has_data(), def.data());
+                c.repeated("straightLines", def.straight_lines());
+                if (def.has_bins_count()) {
+                    c.key("binsCount").uint32(def.bins_count());
+                }
+            });
+            break;
+        }
+        case epoch_proto::Chart::kBoxPlotDef: {
+            const auto& def = chart.box_plot_def();
+            object(f.key("boxPlotDef"), [&](Fields& c) {
+                writeChartDef(c, def.has_chart_def(), def.chart_def());
+                if (def.has_data()) {
+                    object(c.key("data"), [&](Fields& data) {
+                        data.repeated("outliers", def.data().outliers());
+                        data.repeated("points", def.data().points());
+                    });
+                }
+            });
+            break;
+        }
+        case epoch_proto::Chart::kXRangeDef: {
+            const auto& def = chart.x_range_def();
+            object(f.key("xRangeDef"), [&](Fields& c) {
+                writeChartDef(c, def.has_chart_def(), def.chart_def());
+                c.repeated("categories", def.categories());
+                c.repeated("points", def.points());
+            });
+            break;
+        }
+        case epoch_proto::Chart::kPieDef: {
+            const auto& def = chart.pie_def();
+            object(f.key("pieDef"), [&](Fields& c) {
+                writeChartDef(c, def.has_chart_def(), def.chart_def());
+                c.repeated("data", def.data());
+            });
+            break;
+        }
+        case epoch_proto::Chart::kAreaDef: {
+            const auto& def = chart.area_def();
+            object(f.key("areaDef"), [&](Fields& c) {
+                writeChartDef(c, def.has_chart_def(), def.chart_def());
+                c.repeated("areas", def.areas());
+                c.boolean("stacked", def.stacked());
+                if (def.has_stack_type()) {
+                    c.key("stackType").enumeration(def.stack_type(), stackTypeName);
+                }
+            });
+            break;
+        }
+        case epoch_proto::Chart::kNumericLinesDef:
+            writeLinesDef(f.key("numericLinesDef"), chart.numeric_lines_def());
+            break;
+        case epoch_proto::Chart::CHART_TYPE_NOT_SET:
+            break;
+    }
+}
+
+void write(JsonWriter& w, const epoch_proto::Chart& chart) {
+    object(w, [&](Fields& f) { writeChartBody(f, chart); });
+}
+
+void write(JsonWriter& w, const epoch_proto::TearSheet& tearsheet) {
+    object(w, [&](Fields& f) {
+        if (tearsheet.has_cards()) {
+            object(f.key("cards"), [&](Fields& c) { c.repeated("cards", tearsheet.cards().cards()); });
+        }
+        if (tearsheet.has_charts()) {
+            object(f.key("charts"), [&](Fields& c) { c.repeated("charts", tearsheet.charts().charts()); });
+        }
+        if (tearsheet.has_tables()) {
+            object(f.key("tables"), [&](Fields& c) { c.repeated("tables", tearsheet.tables().tables()); });
+        }
+    });
+}
+
+void write(JsonWriter& w, const epoch_proto::FullTearSheet& tearsheet) {
+    // Map iteration order is unspecified; canonical output sorts by key
+    std::vector<std::pair<const std::string*, const epoch_proto::TearSheet*>> entries;
+    entries.reserve(tearsheet.categories().size());
+    for (const auto& entry : tearsheet.categories()) {
+        entries.emplace_back(&entry.first, &entry.second);
+    }
+    std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) { return *a.first < *b.first; });
+
+    object(w, [&](Fields& f) {
+        if (entries.empty()) {
+            return;
+        }
+        auto& out = f.key("categories");
+        out.raw('{');
+        for (size_t i = 0; i < entries.size(); ++i) {
+            if (i > 0) {
+                out.raw(',');
+            }
+            out.string(*entries[i].first);
+            out.raw(':');
+            write(out, *entries[i].second);
+        }
+        out.raw('}');
+    });
+}
+
+template <typename Message>
+std::string serialize(const Message& message) {
+    JsonWriter writer;
+    write(writer, message);
+    return writer.take();
+}
+
+} // namespace
+
+std::string JsonSerializer::toJson(const epoch_proto::FullTearSheet& tearsheet) {
+    return serialize(tearsheet);
+}
+
+std::string JsonSerializer::toJson(const epoch_proto::TearSheet& tearsheet) {
+    return serialize(tearsheet);
+}
+
+std::string JsonSerializer::toJson(const epoch_proto::Chart& chart) {
+    return serialize(chart);
+}
+
+std::string JsonSerializer::toJson(const epoch_proto::Table& table) {
+    return serialize(table);
+}
+
+uint64_t JsonSerializer::writeTo(const epoch_proto::FullTearSheet& tearsheet, std::ostream& out) {
+    JsonWriter writer(&out);
+    write(writer, tearsheet);
+    return writer.finish();
+}
+
+} // namespace epoch_tearsheet
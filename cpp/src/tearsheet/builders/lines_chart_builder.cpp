@@ -1,5 +1,7 @@
 #include "epoch_dashboard/tearsheet/lines_chart_builder.h"
 #include "epoch_dashboard/tearsheet/dataframe_converter.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include "epoch_dashboard/tearsheet/scalar_converter.h"
 #include "epoch_dashboard/tearsheet/validation_utils.h"
 #include "epoch_protos/common.pb.h"
 #include <arrow/api.h>
@@ -18,6 +20,9 @@ LinesChartBuilder::LinesChartBuilder() {
 }
 
 LinesChartBuilder& LinesChartBuilder::addLine(const epoch_proto::Line& line) {
+    ScopedSpan span("LinesChartBuilder", SpanPhase::Validation, instrumentationSink());
+    span.describe(lines_def_.chart_def()).addPointsOut(line.data_size());
+
     // Validate the line data before adding
     epoch_proto::Line validated_line = line;
     ValidationUtils::validateLineData(validated_line, validation_options_);
@@ -26,7 +31,11 @@ LinesChartBuilder& LinesChartBuilder::addLine(const epoch_proto::Line& line) {
 }
 
 LinesChartBuilder& LinesChartBuilder::addLines(const std::vector<epoch_proto::Line>& lines) {
+    ScopedSpan span("LinesChartBuilder", SpanPhase::Validation, instrumentationSink());
+    span.describe(lines_def_.chart_def());
+
     for (const auto& line : lines) {
+        span.addPointsOut(line.data_size());
         // Validate each line before adding
         epoch_proto::Line validated_line = line;
         ValidationUtils::validateLineData(validated_line, validation_options_);
@@ -60,6 +69,15 @@ LinesChartBuilder& LinesChartBuilder::addXPlotBand(const epoch_proto::Band& band
     return *this;
 }
 
+LinesChartBuilder& LinesChartBuilder::addDrawdownBands(const std::vector<DrawdownPeriod>& periods) {
+    for (const auto& period : periods) {
+        auto* band = lines_def_.add_x_plot_bands();
+        *band->mutable_from() = ScalarFactory::fromTimestamp(std::chrono::milliseconds(period.peak_ms));
+        *band->mutable_to() = ScalarFactory::fromTimestamp(std::chrono::milliseconds(period.end_ms));
+    }
+    return *this;
+}
+
 LinesChartBuilder& LinesChartBuilder::setOverlay(const epoch_proto::Line& overlay) {
     *lines_def_.mutable_overlay() = overlay;
     return *this;
@@ -142,37 +160,91 @@ void LinesChartBuilder::processDataFrameWithIntegerIndex(const epoch_frame::Data
     }
 }
 
-LinesChartBuilder& LinesChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df,
-                                                      const std::vector<std::string>& y_cols) {
-    std::vector<epoch_proto::Line> lines;
-    lines.reserve(y_cols.size());
-
-    auto index_type = df.index()->array()->type();
+void LinesChartBuilder::fromDataFrameToSidecar(const epoch_frame::DataFrame& df,
+                                               const std::vector<std::string>& y_cols) {
+    ScopedSpan span("LinesChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(lines_def_.chart_def()).setRowsIn(df.table()->num_rows());
 
-    // Branch based on index type
-    switch (index_type->id()) {
+    std::shared_ptr<arrow::Array> index;
+    switch (df.index()->array()->type()->id()) {
         case arrow::Type::TIMESTAMP:
-            processDataFrameWithTimestampIndex(df, y_cols, lines);
+            index = df.index()->array().to_timestamp_view();
             setXAxisType(epoch_proto::AxisDateTime);
             break;
         case arrow::Type::INT64:
-            processDataFrameWithIntegerIndex<int64_t>(df, y_cols, lines);
+            index = df.index()->array().to_view<int64_t>();
             setXAxisType(epoch_proto::AxisLinear);
             break;
         case arrow::Type::UINT64:
-            processDataFrameWithIntegerIndex<uint64_t>(df, y_cols, lines);
+            index = df.index()->array().to_view<uint64_t>();
             setXAxisType(epoch_proto::AxisLinear);
             break;
         default:
             throw std::runtime_error("Unsupported index type for LinesChartBuilder. Supported types: timestamp, int64_t, uint64_t");
     }
 
+    auto table = ArrowSidecar::makeTimeSeriesTable(index, df.table(), y_cols);
+    table = ValidationUtils::validateSeriesTable(std::move(table), validation_options_);
+    sidecar_->add(lines_def_.chart_def().id(), table);
+
+    // Column 0 is x; every other column becomes a line carrying only its name
+    for (int i = 1; i < table->num_columns(); ++i) {
+        lines_def_.add_lines()->set_name(table->field(i)->name());
+    }
+    span.addPointsOut(table->num_rows() * (table->num_columns() - 1));
+}
+
+LinesChartBuilder& LinesChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df,
+                                                      const std::vector<std::string>& y_cols) {
+    if (sidecar_) {
+        fromDataFrameToSidecar(df, y_cols);
+        setYAxisType(epoch_proto::AxisLinear);
+        return *this;
+    }
+
+    std::vector<epoch_proto::Line> lines;
+    lines.reserve(y_cols.size());
+
+    {
+        ScopedSpan span("LinesChartBuilder", SpanPhase::Conversion, instrumentationSink());
+        span.describe(lines_def_.chart_def()).setRowsIn(df.table()->num_rows());
+
+        auto index_type = df.index()->array()->type();
+
+        // Branch based on index type
+        switch (index_type->id()) {
+            case arrow::Type::TIMESTAMP:
+                processDataFrameWithTimestampIndex(df, y_cols, lines);
+                setXAxisType(epoch_proto::AxisDateTime);
+                break;
+            case arrow::Type::INT64:
+                processDataFrameWithIntegerIndex<int64_t>(df, y_cols, lines);
+                setXAxisType(epoch_proto::AxisLinear);
+                break;
+            case arrow::Type::UINT64:
+                processDataFrameWithIntegerIndex<uint64_t>(df, y_cols, lines);
+                setXAxisType(epoch_proto::AxisLinear);
+                break;
+            default:
+                throw std::runtime_error("Unsupported index type for LinesChartBuilder. Supported types: timestamp, int64_t, uint64_t");
+        }
+
+        for (const auto& line : lines) {
+            span.addPointsOut(line.data_size());
+        }
+    }
+
     addLines(lines);
     setYAxisType(epoch_proto::AxisLinear);
 
     return *this;
 }
 
+LinesChartBuilder& LinesChartBuilder::setArrowSidecar(ArrowSidecarPtr sidecar) {
+    sidecar_ = std::move(sidecar);
+    return *this;
+}
+
 LinesChartBuilder& LinesChartBuilder::setValidationOptions(const ValidationUtils::ValidationOptions& options) {
     validation_options_ = options;
     return *this;
@@ -194,6 +266,9 @@ LinesChartBuilder& LinesChartBuilder::setAllowDuplicates(bool allow) {
 }
 
 epoch_proto::Chart LinesChartBuilder::build() const {
+    ScopedSpan span("LinesChartBuilder", SpanPhase::Build, instrumentationSink());
+    span.describe(lines_def_.chart_def());
+
     // Final validation of all lines before building
     if (validation_options_.strict_validation && lines_def_.stacked() && lines_def_.lines_size() > 1) {
         std::vector<epoch_proto::Line> all_lines;
@@ -205,6 +280,13 @@ epoch_proto::Chart LinesChartBuilder::build() const {
 
     epoch_proto::Chart chart;
     *chart.mutable_lines_def() = lines_def_;
+
+    if (span.active()) {
+        for (const auto& line : lines_def_.lines()) {
+            span.addPointsOut(line.data_size());
+        }
+        span.setBytesSerialized(static_cast<int64_t>(chart.ByteSizeLong()));
+    }
     return chart;
 }
 
@@ -1,5 +1,6 @@
 #include "epoch_dashboard/tearsheet/numeric_lines_chart_builder.h"
 #include "epoch_dashboard/tearsheet/dataframe_converter.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
 #include "epoch_dashboard/tearsheet/validation_utils.h"
 #include "epoch_protos/common.pb.h"
 #include <arrow/api.h>
@@ -92,11 +93,55 @@ void NumericLinesChartBuilder::processDataFrameWithNumericIndex(const epoch_fram
     }
 }
 
+void NumericLinesChartBuilder::fromDataFrameToSidecar(const epoch_frame::DataFrame& df,
+                                                      const std::vector<std::string>& y_cols) {
+    ScopedSpan span("NumericLinesChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(numeric_lines_def_.chart_def()).setRowsIn(df.table()->num_rows());
+
+    std::shared_ptr<arrow::Array> index;
+    switch (df.index()->array()->type()->id()) {
+        case arrow::Type::INT64:
+            index = df.index()->array().to_view<int64_t>();
+            break;
+        case arrow::Type::UINT64:
+            index = df.index()->array().to_view<uint64_t>();
+            break;
+        case arrow::Type::DOUBLE:
+            index = df.index()->array().to_view<double>();
+            break;
+        case arrow::Type::FLOAT:
+            index = df.index()->array().to_view<float>();
+            break;
+        default:
+            throw std::runtime_error("Unsupported index type for NumericLinesChartBuilder. Supported types: int64_t, uint64_t, float, double");
+    }
+
+    auto table = ArrowSidecar::makeNumericSeriesTable(index, df.table(), y_cols);
+    table = ValidationUtils::validateSeriesTable(std::move(table), validation_options_);
+    sidecar_->add(numeric_lines_def_.chart_def().id(), table);
+
+    // Column 0 is x; every other column becomes a line carrying only its name
+    for (int i = 1; i < table->num_columns(); ++i) {
+        numeric_lines_def_.add_lines()->set_name(table->field(i)->name());
+    }
+    span.addPointsOut(table->num_rows() * (table->num_columns() - 1));
+}
+
 NumericLinesChartBuilder& NumericLinesChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df,
                                                                      const std::vector<std::string>& y_cols) {
+    if (sidecar_) {
+        fromDataFrameToSidecar(df, y_cols);
+        setXAxisType(epoch_proto::AxisLinear);
+        setYAxisType(epoch_proto::AxisLinear);
+        return *this;
+    }
+
     std::vector<epoch_proto::NumericLine> lines;
     lines.reserve(y_cols.size());
 
+    ScopedSpan span("NumericLinesChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(numeric_lines_def_.chart_def()).setRowsIn(df.table()->num_rows());
+
     auto index_type = df.index()->array()->type();
 
     // Branch based on index type
@@ -121,12 +166,21 @@ NumericLinesChartBuilder& NumericLinesChartBuilder::fromDataFrame(const epoch_fr
             throw std::runtime_error("Unsupported index type for NumericLinesChartBuilder. Supported types: int64_t, uint64_t, float, double");
     }
 
+    for (const auto& line : lines) {
+        span.addPointsOut(line.data_size());
+    }
+
     addLines(lines);
     setYAxisType(epoch_proto::AxisLinear);
 
     return *this;
 }
 
+NumericLinesChartBuilder& NumericLinesChartBuilder::setArrowSidecar(ArrowSidecarPtr sidecar) {
+    sidecar_ = std::move(sidecar);
+    return *this;
+}
+
 NumericLinesChartBuilder& NumericLinesChartBuilder::setValidationOptions(const ValidationUtils::ValidationOptions& options) {
     validation_options_ = options;
     return *this;
@@ -148,9 +202,19 @@ NumericLinesChartBuilder& NumericLinesChartBuilder::setAllowDuplicates(bool allo
 }
 
 epoch_proto::Chart NumericLinesChartBuilder::build() const {
+    ScopedSpan span("NumericLinesChartBuilder", SpanPhase::Build, instrumentationSink());
+    span.describe(numeric_lines_def_.chart_def());
+
     // TODO: Add final validation when ValidationUtils supports NumericLine
     epoch_proto::Chart chart;
     *chart.mutable_numeric_lines_def() = numeric_lines_def_;
+
+    if (span.active()) {
+        for (const auto& line : numeric_lines_def_.lines()) {
+            span.addPointsOut(line.data_size());
+        }
+        span.setBytesSerialized(static_cast<int64_t>(chart.ByteSizeLong()));
+    }
     return chart;
 }
 
@@ -0,0 +1,374 @@
+#include "epoch_dashboard/tearsheet/ohlcv_resampler.h"
+#include "epoch_dashboard/tearsheet/dataframe_converter.h"
+#include <epoch_frame/dataframe.h>
+#include <epoch_frame/factory/index_factory.h>
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <limits>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+constexpr int64_t kDayMs = 86400000;
+
+void check(const arrow::Status& status, const char* context) {
+    if (!status.ok()) {
+        throw std::runtime_error(std::string(context) + ": " + status.ToString());
+    }
+}
+
+int64_t floorDiv(int64_t a, int64_t b) {
+    const int64_t q = a / b;
+    return (a % b != 0 && ((a < 0) != (b < 0))) ? q - 1 : q;
+}
+
+int64_t floorMod(int64_t a, int64_t b) {
+    return a - floorDiv(a, b) * b;
+}
+
+// Howard Hinnant's civil calendar conversions, proleptic Gregorian
+int64_t daysFromCivil(int64_t y, int64_t m, int64_t d) {
+    y -= m <= 2;
+    const int64_t era = floorDiv(y, 400);
+    const int64_t yoe = y - era * 400;
+    const int64_t doy = (153 * (m + (m > 2 ? -3 : 9)) + 2) / 5 + d - 1;
+    const int64_t doe = yoe * 365 + yoe / 4 - yoe / 100 + doy;
+    return era * 146097 + doe - 719468;
+}
+
+// Calendar month of a day count, as year * 12 + (month - 1)
+int64_t monthIndexFromDays(int64_t days) {
+    days += 719468;
+    const int64_t era = floorDiv(days, 146097);
+    const int64_t doe = days - era * 146097;
+    const int64_t yoe = (doe - doe / 1460 + doe / 36524 - doe / 146096) / 365;
+    const int64_t doy = doe - (365 * yoe + yoe / 4 - yoe / 100);
+    const int64_t mp = (5 * doy + 2) / 153;
+    const int64_t month = mp < 10 ? mp + 3 : mp - 9;
+    const int64_t year = yoe + era * 400 + (month <= 2);
+    return year * 12 + (month - 1);
+}
+
+int64_t daysFromMonthIndex(int64_t month_index) {
+    return daysFromCivil(floorDiv(month_index, 12), floorMod(month_index, 12) + 1, 1);
+}
+
+// Bucket [start, end) in session-local ms, where 0 is a session open on 1970-01-01
+std::pair<int64_t, int64_t> localBucket(int64_t local, const ResampleSpec& spec) {
+    switch (spec.unit) {
+        case ResampleSpec::Unit::Fixed: {
+            const int64_t day = floorDiv(local, kDayMs) * kDayMs;
+            const int64_t start = day + floorDiv(local - day, spec.duration_ms) * spec.duration_ms;
+            return {start, std::min(start + spec.duration_ms, day + kDayMs)};
+        }
+        case ResampleSpec::Unit::Day: {
+            const int64_t first = floorDiv(floorDiv(local, kDayMs), spec.count) * spec.count;
+            return {first * kDayMs, (first + spec.count) * kDayMs};
+        }
+        case ResampleSpec::Unit::Week: {
+            // Day 0 is a Thursday, so weeks counted from day -3 start on Monday
+            const int64_t week = floorDiv(floorDiv(local, kDayMs) + 3, 7);
+            const int64_t first = floorDiv(week, spec.count) * spec.count;
+            return {(first * 7 - 3) * kDayMs, ((first + spec.count) * 7 - 3) * kDayMs};
+        }
+        case ResampleSpec::Unit::Month: {
+            const int64_t month = monthIndexFromDays(floorDiv(local, kDayMs));
+            const int64_t first = floorDiv(month, spec.count) * spec.count;
+            return {daysFromMonthIndex(first) * kDayMs, daysFromMonthIndex(first + spec.count) * kDayMs};
+        }
+    }
+    throw std::runtime_error("OhlcvResampler: unknown resample unit");
+}
+
+std::pair<int64_t, int64_t> bucketBounds(int64_t timestamp_ms, const ResampleSpec& spec) {
+    const int64_t shift = spec.utc_offset_ms - spec.session_open_ms;
+    auto [start, end] = localBucket(timestamp_ms + shift, spec);
+    return {start - shift, end - shift};
+}
+
+void validate(const ResampleSpec& spec) {
+    if (spec.unit == ResampleSpec::Unit::Fixed && spec.duration_ms <= 0) {
+        throw std::runtime_error("OhlcvResampler: duration_ms must be positive");
+    }
+    if (spec.count <= 0) {
+        throw std::runtime_error("OhlcvResampler: count must be positive");
+    }
+}
+
+// float64 or int64 column read as double without conversion copies
+class Values {
+public:
+    Values(const arrow::RecordBatch& batch, const std::string& name) {
+        array_ = batch.GetColumnByName(name);
+        if (!array_) {
+            throw std::runtime_error("OhlcvResampler: missing column '" + name + "'");
+        }
+        switch (array_->type_id()) {
+            case arrow::Type::DOUBLE:
+                doubles_ = array_->data()->GetValues<double>(1);
+                break;
+            case arrow::Type::INT64:
+                ints_ = array_->data()->GetValues<int64_t>(1);
+                break;
+            default:
+                throw std::runtime_error("OhlcvResampler: column '" + name + "' must be float64 or int64, got " +
+                                         array_->type()->ToString());
+        }
+    }
+
+    double operator[](int64_t i) const { return doubles_ ? doubles_[i] : static_cast<double>(ints_[i]); }
+    bool hasNulls() const { return array_->null_count() > 0; }
+    bool isValid(int64_t i) const { return array_->IsValid(i); }
+
+private:
+    std::shared_ptr<arrow::Array> array_;
+    const double* doubles_ = nullptr;
+    const int64_t* ints_ = nullptr;
+};
+
+} // namespace
+
+ResampleSpec ResampleSpec::fixed(int64_t duration_ms) {
+    ResampleSpec spec;
+    spec.unit = Unit::Fixed;
+    spec.duration_ms = duration_ms;
+    return spec;
+}
+
+ResampleSpec ResampleSpec::calendar(Unit unit, int64_t count) {
+    ResampleSpec spec;
+    spec.unit = unit;
+    spec.count = count;
+    return spec;
+}
+
+ResampleSpec ResampleSpec::fromTimeframe(std::string_view timeframe) {
+    while (!timeframe.empty() && std::isspace(static_cast<unsigned char>(timeframe.front()))) {
+        timeframe.remove_prefix(1);
+    }
+    while (!timeframe.empty() && std::isspace(static_cast<unsigned char>(timeframe.back()))) {
+        timeframe.remove_suffix(1);
+    }
+
+    int64_t num = 1;
+    auto [ptr, ec] = std::from_chars(timeframe.data(), timeframe.data() + timeframe.size(), num);
+    if (ec != std::errc{} && ptr != timeframe.data()) {
+        throw std::runtime_error("ResampleSpec: invalid timeframe '" + std::string(timeframe) + "'");
+    }
+    std::string_view unit = timeframe.substr(static_cast<size_t>(ptr - timeframe.data()));
+    while (!unit.empty() && unit.front() == ' ') {
+        unit.remove_prefix(1);
+    }
+    std::string upper(unit);
+    std::transform(upper.begin(), upper.end(), upper.begin(), [](unsigned char c) { return std::toupper(c); });
+
+    if (num <= 0 || upper.empty() ||
+        !std::all_of(upper.begin(), upper.end(), [](unsigned char c) { return std::isalpha(c); })) {
+        throw std::runtime_error("ResampleSpec: invalid timeframe '" + std::string(timeframe) + "'");
+    }
+
+    // num units of `unit_ms` each, rejected before the multiplication could overflow
+    auto scaled = [&](int64_t factor, int64_t unit_ms) {
+        if (num > std::numeric_limits<int64_t>::max() / (factor * unit_ms)) {
+            throw std::runtime_error("ResampleSpec: invalid timeframe '" + std::string(timeframe) + "'");
+        }
+        return num * factor;
+    };
+
+    // Lowercase 'm' is minutes, uppercase 'M' months, as in getMsPerBar
+    if (unit == "m" || upper.starts_with("MIN")) {
+        return fixed(scaled(60000, 1));
+    }
+    if (upper.starts_with("H")) {
+        return fixed(scaled(3600000, 1));
+    }
+    if (upper.starts_with("D")) {
+        return calendar(Unit::Day, scaled(1, kDayMs));
+    }
+    if (upper.starts_with("W")) {
+        return calendar(Unit::Week, scaled(1, 7 * kDayMs));
+    }
+    if (upper.starts_with("MO") || unit == "M") {
+        return calendar(Unit::Month, scaled(1, 31 * kDayMs));
+    }
+    if (upper.starts_with("Q")) {
+        return calendar(Unit::Month, scaled(3, 31 * kDayMs));
+    }
+    if (upper.starts_with("Y")) {
+        return calendar(Unit::Month, scaled(12, 31 * kDayMs));
+    }
+    throw std::runtime_error("ResampleSpec: unsupported timeframe '" + std::string(timeframe) + "'");
+}
+
+OhlcvColumns OhlcvColumns::ticks(const std::string& price, const std::string& volume) {
+    OhlcvColumns columns;
+    columns.open = price;
+    columns.high = price;
+    columns.low = price;
+    columns.close = price;
+    columns.volume = volume;
+    return columns;
+}
+
+OhlcvResampler::OhlcvResampler(ResampleSpec spec, OhlcvColumns columns)
+    : spec_(spec), columns_(std::move(columns)) {
+    validate(spec_);
+}
+
+int64_t OhlcvResampler::bucketStart(int64_t timestamp_ms, const ResampleSpec& spec) {
+    validate(spec);
+    return bucketBounds(timestamp_ms, spec).first;
+}
+
+void OhlcvResampler::update(const arrow::RecordBatch& batch) {
+    auto timestamps = batch.GetColumnByName(columns_.timestamp);
+    if (!timestamps) {
+        throw std::runtime_error("OhlcvResampler: missing column '" + columns_.timestamp + "'");
+    }
+    auto unit = arrow::TimeUnit::MILLI;
+    if (timestamps->type_id() == arrow::Type::TIMESTAMP) {
+        unit = std::static_pointer_cast<arrow::TimestampType>(timestamps->type())->unit();
+    } else if (timestamps->type_id() != arrow::Type::INT64) {
+        throw std::runtime_error("OhlcvResampler: timestamp column must be timestamp or int64, got " +
+                                 timestamps->type()->ToString());
+    }
+    const int64_t* ts = timestamps->data()->GetValues<int64_t>(1);
+
+    const Values open(batch, columns_.open);
+    const Values high(batch, columns_.high);
+    const Values low(batch, columns_.low);
+    const Values close(batch, columns_.close);
+    const bool with_volume = !columns_.volume.empty();
+    std::optional<Values> volume;
+    if (with_volume) {
+        volume.emplace(batch, columns_.volume);
+    }
+
+    const bool has_nulls = timestamps->null_count() > 0 || open.hasNulls() || high.hasNulls() ||
+                           low.hasNulls() || close.hasNulls() || (volume && volume->hasNulls());
+
+    for (int64_t i = 0; i < batch.num_rows(); ++i) {
+        if (has_nulls && !(timestamps->IsValid(i) && open.isValid(i) && high.isValid(i) && low.isValid(i) &&
+                           close.isValid(i) && (!volume || volume->isValid(i)))) {
+            continue;
+        }
+
+        const int64_t t = DataFrameFactory::toMilliseconds(ts[i], unit);
+        if (t < last_timestamp_) {
+            throw std::runtime_error("OhlcvResampler: timestamps must be sorted");
+        }
+        last_timestamp_ = t;
+
+        const double v = with_volume ? (*volume)[i] : 0.0;
+        if (!has_bar_ || t >= bar_.end) {
+            // Bucket boundaries are only computed when a bar closes
+            flush();
+            auto [start, end] = bucketBounds(t, spec_);
+            bar_ = Bar{start, end, open[i], high[i], low[i], close[i], v};
+            has_bar_ = true;
+        } else {
+            bar_.high = std::max(bar_.high, high[i]);
+            bar_.low = std::min(bar_.low, low[i]);
+            bar_.close = close[i];
+            bar_.volume += v;
+        }
+    }
+}
+
+void OhlcvResampler::update(const arrow::Table& table) {
+    arrow::TableBatchReader reader(table);
+    std::shared_ptr<arrow::RecordBatch> batch;
+    while (true) {
+        check(reader.ReadNext(&batch), "OhlcvResampler: failed to read batch");
+        if (!batch) {
+            break;
+        }
+        update(*batch);
+    }
+}
+
+void OhlcvResampler::flush() {
+    if (!has_bar_) {
+        return;
+    }
+    check(timestamps_.Append(bar_.start), "OhlcvResampler: append failed");
+    check(open_.Append(bar_.open), "OhlcvResampler: append failed");
+    check(high_.Append(bar_.high), "OhlcvResampler: append failed");
+    check(low_.Append(bar_.low), "OhlcvResampler: append failed");
+    check(close_.Append(bar_.close), "OhlcvResampler: append failed");
+    if (!columns_.volume.empty()) {
+        check(volume_.Append(bar_.volume), "OhlcvResampler: append failed");
+    }
+    has_bar_ = false;
+}
+
+std::shared_ptr<arrow::Table> OhlcvResampler::finish() {
+    flush();
+
+    std::vector<std::shared_ptr<arrow::Field>> fields{
+        arrow::field(columns_.timestamp, arrow::timestamp(arrow::TimeUnit::MILLI)),
+        arrow::field("open", arrow::float64()),
+        arrow::field("high", arrow::float64()),
+        arrow::field("low", arrow::float64()),
+        arrow::field("close", arrow::float64())};
+    std::vector<std::shared_ptr<arrow::Array>> arrays(5);
+    check(timestamps_.Finish(&arrays[0]), "OhlcvResampler: finish failed");
+    check(open_.Finish(&arrays[1]), "OhlcvResampler: finish failed");
+    check(high_.Finish(&arrays[2]), "OhlcvResampler: finish failed");
+    check(low_.Finish(&arrays[3]), "OhlcvResampler: finish failed");
+    check(close_.Finish(&arrays[4]), "OhlcvResampler: finish failed");
+    if (!columns_.volume.empty()) {
+        fields.push_back(arrow::field("volume", arrow::float64()));
+        arrays.emplace_back();
+        check(volume_.Finish(&arrays.back()), "OhlcvResampler: finish failed");
+    }
+
+    last_timestamp_ = std::numeric_limits<int64_t>::min();
+    return arrow::Table::Make(arrow::schema(fields), arrays);
+}
+
+std::shared_ptr<arrow::Table> OhlcvResampler::resample(const epoch_frame::DataFrame& df, const ResampleSpec& spec,
+                                                       OhlcvColumns columns) {
+    std::shared_ptr<arrow::Array> index;
+    switch (df.index()->array()->type()->id()) {
+        case arrow::Type::TIMESTAMP:
+            index = df.index()->array().to_timestamp_view();
+            break;
+        case arrow::Type::INT64:
+            index = df.index()->array().to_view<int64_t>();
+            break;
+        default:
+            throw std::runtime_error("Unsupported index type for OhlcvResampler. Supported types: timestamp, int64_t");
+    }
+
+    // The index joins the frame's columns without copying; batches slice both
+    const auto source = df.table();
+    std::vector<std::shared_ptr<arrow::Field>> fields{arrow::field(columns.timestamp, index->type())};
+    std::vector<std::shared_ptr<arrow::ChunkedArray>> arrays{std::make_shared<arrow::ChunkedArray>(index)};
+    for (int i = 0; i < source->num_columns(); ++i) {
+        if (source->field(i)->name() != columns.timestamp) {
+            fields.push_back(source->field(i));
+            arrays.push_back(source->column(i));
+        }
+    }
+    auto table = arrow::Table::Make(arrow::schema(fields), arrays);
+
+    OhlcvResampler resampler(spec, std::move(columns));
+    resampler.update(*table);
+    return resampler.finish();
+}
+
+epoch_frame::DataFrame OhlcvResampler::toDataFrame(const std::shared_ptr<arrow::Table>& bars) {
+    auto combined = bars->CombineChunks().ValueOrDie();
+    auto index = epoch_frame::factory::index::make_index(combined->column(0)->chunk(0), std::nullopt,
+                                                         combined->field(0)->name());
+    return epoch_frame::DataFrame(index, combined->RemoveColumn(0).ValueOrDie());
+}
+
+} // namespace epoch_tearsheet
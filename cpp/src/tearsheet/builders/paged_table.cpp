@@ -0,0 +1,277 @@
+#include "epoch_dashboard/tearsheet/paged_table.h"
+#include "epoch_dashboard/tearsheet/dataframe_converter.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include "epoch_dashboard/tearsheet/scalar_converter.h"
+#include <epoch_frame/dataframe.h>
+#include <epoch_frame/scalar.h>
+#include <arrow/api.h>
+#include <tbb/parallel_for.h>
+#include <tbb/parallel_sort.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <string_view>
+#include <type_traits>
+#include <variant>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+// Comparable values of one column with a validity flag per row
+struct SortKeys {
+    std::variant<std::vector<int64_t>, std::vector<uint64_t>, std::vector<double>, std::vector<std::string_view>> values;
+    std::vector<uint8_t> valid;
+};
+
+template <typename ArrowType, typename Key>
+SortKeys collect(const arrow::ChunkedArray& column) {
+    using ArrayType = typename arrow::TypeTraits<ArrowType>::ArrayType;
+    std::vector<Key> values;
+    std::vector<uint8_t> valid;
+    values.reserve(static_cast<size_t>(column.length()));
+    valid.reserve(static_cast<size_t>(column.length()));
+    for (const auto& chunk : column.chunks()) {
+        const auto& array = static_cast<const ArrayType&>(*chunk);
+        for (int64_t i = 0; i < array.length(); ++i) {
+            bool is_valid = array.IsValid(i);
+            values.push_back(is_valid ? static_cast<Key>(array.Value(i)) : Key{});
+            if constexpr (std::is_floating_point_v<Key>) {
+                is_valid = is_valid && !std::isnan(values.back());
+            }
+            valid.push_back(is_valid);
+        }
+    }
+    return SortKeys{std::move(values), std::move(valid)};
+}
+
+SortKeys collectDictionary(const arrow::ChunkedArray& column) {
+    std::vector<std::string_view> values;
+    std::vector<uint8_t> valid;
+    values.reserve(static_cast<size_t>(column.length()));
+    valid.reserve(static_cast<size_t>(column.length()));
+    for (const auto& chunk : column.chunks()) {
+        const auto& keys = static_cast<const arrow::DictionaryArray&>(*chunk);
+        const auto& dictionary = static_cast<const arrow::StringArray&>(*keys.dictionary());
+        for (int64_t i = 0; i < keys.length(); ++i) {
+            const bool is_valid = keys.IsValid(i) && dictionary.IsValid(keys.GetValueIndex(i));
+            values.push_back(is_valid ? dictionary.GetView(keys.GetValueIndex(i)) : std::string_view{});
+            valid.push_back(is_valid);
+        }
+    }
+    return SortKeys{std::move(values), std::move(valid)};
+}
+
+// Keys for a sortable column; views into string buffers live as long as the column
+std::optional<SortKeys> sortKeys(const arrow::ChunkedArray& column) {
+    switch (column.type()->id()) {
+        case arrow::Type::BOOL: return collect<arrow::BooleanType, int64_t>(column);
+        case arrow::Type::INT8: return collect<arrow::Int8Type, int64_t>(column);
+        case arrow::Type::INT16: return collect<arrow::Int16Type, int64_t>(column);
+        case arrow::Type::INT32: return collect<arrow::Int32Type, int64_t>(column);
+        case arrow::Type::INT64: return collect<arrow::Int64Type, int64_t>(column);
+        case arrow::Type::UINT8: return collect<arrow::UInt8Type, uint64_t>(column);
+        case arrow::Type::UINT16: return collect<arrow::UInt16Type, uint64_t>(column);
+        case arrow::Type::UINT32: return collect<arrow::UInt32Type, uint64_t>(column);
+        case arrow::Type::UINT64: return collect<arrow::UInt64Type, uint64_t>(column);
+        case arrow::Type::FLOAT: return collect<arrow::FloatType, double>(column);
+        case arrow::Type::DOUBLE: return collect<arrow::DoubleType, double>(column);
+        case arrow::Type::DATE32: return collect<arrow::Date32Type, int64_t>(column);
+        case arrow::Type::DATE64: return collect<arrow::Date64Type, int64_t>(column);
+        case arrow::Type::TIMESTAMP: return collect<arrow::TimestampType, int64_t>(column);
+        case arrow::Type::STRING: return collect<arrow::StringType, std::string_view>(column);
+        case arrow::Type::LARGE_STRING: return collect<arrow::LargeStringType, std::string_view>(column);
+        case arrow::Type::DICTIONARY: {
+            const auto& type = static_cast<const arrow::DictionaryType&>(*column.type());
+            if (type.value_type()->id() == arrow::Type::STRING) {
+                return collectDictionary(column);
+            }
+            return std::nullopt;
+        }
+        default:
+            return std::nullopt;
+    }
+}
+
+} // namespace
+
+PagedTable::PagedTable(const epoch_frame::DataFrame& df, const std::vector<std::string>& columns) {
+    ScopedSpan span("PagedTable", SpanPhase::Conversion);
+    auto source = df.table();
+    source_ = source;
+    span.setRowsIn(source->num_rows());
+    if (source->num_rows() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("PagedTable: frame has more than 2^32 - 1 rows");
+    }
+    row_count_ = static_cast<size_t>(source->num_rows());
+
+    const auto names = columns.empty() ? source->ColumnNames() : columns;
+    arrow::FieldVector fields;
+    arrow::ChunkedArrayVector selected;
+    for (const auto& name : names) {
+        auto column = source->GetColumnByName(name);
+        if (!column) {
+            throw std::runtime_error("PagedTable: missing column '" + name + "'");
+        }
+        fields.push_back(arrow::field(name, column->type()));
+        selected.push_back(std::move(column));
+        column_defs_.push_back(DataFrameFactory::toColumnDef(df, name));
+    }
+    table_ = arrow::Table::Make(arrow::schema(fields), selected, source->num_rows());
+
+    // One argsort per sortable column, columns and sorts both in parallel
+    std::vector<std::optional<SortIndex>> indexes(names.size());
+    tbb::parallel_for(size_t{0}, names.size(), [&](size_t c) {
+        auto keys = sortKeys(*selected[c]);
+        if (!keys) {
+            return;
+        }
+        SortIndex index;
+        index.order.reserve(row_count_);
+        std::vector<uint32_t> nulls;
+        for (uint32_t row = 0; row < row_count_; ++row) {
+            (keys->valid[row] ? index.order : nulls).push_back(row);
+        }
+        index.valid = index.order.size();
+        std::visit([&](const auto& values) {
+            tbb::parallel_sort(index.order.begin(), index.order.end(), [&](uint32_t a, uint32_t b) {
+                return values[a] < values[b] || (values[a] == values[b] && a < b);
+            });
+        }, keys->values);
+        index.order.insert(index.order.end(), nulls.begin(), nulls.end());
+        indexes[c] = std::move(index);
+    });
+    for (size_t c = 0; c < names.size(); ++c) {
+        if (indexes[c]) {
+            sort_indexes_.emplace(names[c], std::move(*indexes[c]));
+        }
+    }
+}
+
+size_t PagedTable::rowCount(const TableFilter& filter) const {
+    return TableFilterCache::shared().select(filter, source_)->size();
+}
+
+size_t PagedTable::pageCount(size_t page_size, const std::optional<TableFilter>& filter) const {
+    if (page_size == 0) {
+        throw std::runtime_error("PagedTable: page_size must be positive");
+    }
+    const size_t rows = filter ? rowCount(*filter) : row_count_;
+    return (rows + page_size - 1) / page_size;
+}
+
+std::shared_ptr<const PagedTable::SortIndex> PagedTable::sortedSelection(const std::string& column,
+                                                                        const SortIndex& index,
+                                                                        const TableFilter& filter) const {
+    const std::string key = filter.key() + '|' + column;
+    {
+        std::lock_guard lock(sorted_selections_mutex_);
+        if (auto it = sorted_lookup_.find(key); it != sorted_lookup_.end()) {
+            sorted_selections_.splice(sorted_selections_.begin(), sorted_selections_, it->second);
+            return it->second->index;
+        }
+    }
+
+    // Build unlocked; a concurrent miss on the same key just builds it twice
+    const auto selection = TableFilterCache::shared().select(filter, source_);
+    std::vector<uint8_t> matches(row_count_, 0);
+    for (const auto row : *selection) {
+        matches[row] = 1;
+    }
+    auto sorted = std::make_shared<SortIndex>();
+    sorted->order.reserve(selection->size());
+    for (size_t position = 0; position < index.order.size(); ++position) {
+        const auto row = index.order[position];
+        if (matches[row]) {
+            sorted->order.push_back(row);
+            sorted->valid += position < index.valid;
+        }
+    }
+
+    std::lock_guard lock(sorted_selections_mutex_);
+    if (!sorted_lookup_.contains(key)) {
+        sorted_selections_.push_front(SortedSelection{key, sorted});
+        sorted_lookup_.emplace(key, sorted_selections_.begin());
+        while (sorted_selections_.size() > kSortedSelectionCapacity) {
+            sorted_lookup_.erase(sorted_selections_.back().key);
+            sorted_selections_.pop_back();
+        }
+    }
+    return sorted;
+}
+
+std::vector<uint32_t> PagedTable::pageRows(const TablePageQuery& query) const {
+    if (query.page_size == 0) {
+        throw std::runtime_error("PagedTable: page_size must be positive");
+    }
+    const SortIndex* index = nullptr;
+    if (query.sort_column) {
+        auto it = sort_indexes_.find(*query.sort_column);
+        if (it == sort_indexes_.end()) {
+            throw std::runtime_error("PagedTable: column '" + *query.sort_column + "' is not sortable");
+        }
+        index = &it->second;
+    }
+    // A sorted, filtered page reads the sort index restricted to the filter's rows
+    std::shared_ptr<const std::vector<uint32_t>> selection;
+    std::shared_ptr<const SortIndex> sorted_selection;
+    if (query.filter && index) {
+        sorted_selection = sortedSelection(*query.sort_column, *index, *query.filter);
+        index = sorted_selection.get();
+    } else if (query.filter) {
+        selection = TableFilterCache::shared().select(*query.filter, source_);
+    }
+
+    std::vector<uint32_t> rows;
+    const size_t total = selection ? selection->size() : index ? index->order.size() : row_count_;
+    if (query.page >= (total + query.page_size - 1) / query.page_size) {
+        return rows;
+    }
+    const size_t begin = query.page * query.page_size;
+    const size_t end = std::min(begin + query.page_size, total);
+    rows.reserve(end - begin);
+
+    // Frame row at a position of the requested order
+    auto rowAt = [&](size_t position) -> uint32_t {
+        if (!index) {
+            return static_cast<uint32_t>(position);
+        }
+        if (query.direction == SortDirection::Ascending || position >= index->valid) {
+            return index->order[position];
+        }
+        return index->order[index->valid - 1 - position];
+    };
+
+    if (selection) {
+        rows.assign(selection->begin() + static_cast<std::ptrdiff_t>(begin),
+                    selection->begin() + static_cast<std::ptrdiff_t>(end));
+    } else {
+        for (size_t position = begin; position < end; ++position) {
+            rows.push_back(rowAt(position));
+        }
+    }
+    return rows;
+}
+
+std::vector<epoch_proto::TableRow> PagedTable::page(const TablePageQuery& query) const {
+    ScopedSpan span("PagedTable", SpanPhase::Conversion);
+    span.setRowsIn(static_cast<int64_t>(row_count_));
+
+    std::vector<epoch_proto::TableRow> rows;
+    for (const auto row_index : pageRows(query)) {
+        auto& row = rows.emplace_back();
+        for (const auto& column : table_->columns()) {
+            auto scalar_result = column->GetScalar(row_index);
+            if (scalar_result.ok()) {
+                *row.add_values() = ScalarFactory::create(epoch_frame::Scalar(scalar_result.ValueOrDie()));
+            } else {
+                row.add_values()->set_null_value(epoch_proto::NULL_VALUE);
+            }
+        }
+    }
+    span.addPointsOut(static_cast<int64_t>(rows.size()));
+    return rows;
+}
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,213 @@
+#include "epoch_dashboard/tearsheet/parquet_source.h"
+#include "epoch_dashboard/tearsheet/dataframe_converter.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include "epoch_dashboard/tearsheet/time_window.h"
+#include <epoch_frame/dataframe.h>
+#include <epoch_frame/factory/index_factory.h>
+#include <arrow/io/file.h>
+#include <parquet/arrow/reader.h>
+#include <parquet/file_reader.h>
+#include <parquet/metadata.h>
+#include <parquet/statistics.h>
+#include <algorithm>
+#include <stdexcept>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+void check(const arrow::Status& status, const std::string& context) {
+    if (!status.ok()) {
+        throw std::runtime_error(context + ": " + status.ToString());
+    }
+}
+
+arrow::TimeUnit::type indexUnit(const arrow::Schema& schema, const std::string& index_column) {
+    auto field = schema.GetFieldByName(index_column);
+    if (!field) {
+        throw std::runtime_error("ParquetSource: unknown index column '" + index_column + "'");
+    }
+    switch (field->type()->id()) {
+        case arrow::Type::TIMESTAMP:
+            return std::static_pointer_cast<arrow::TimestampType>(field->type())->unit();
+        case arrow::Type::INT64:
+            return arrow::TimeUnit::MILLI;
+        default:
+            throw std::runtime_error("ParquetSource: index column '" + index_column +
+                                     "' must be timestamp or int64, got " + field->type()->ToString());
+    }
+}
+
+// Requested (or all) columns other than the index, which becomes the frame's index
+std::vector<std::string> valueColumns(const arrow::Schema& schema, const ParquetScanOptions& options) {
+    std::vector<std::string> names;
+    if (!options.columns.empty()) {
+        for (const auto& name : options.columns) {
+            if (name != options.index_column && std::find(names.begin(), names.end(), name) == names.end()) {
+                names.push_back(name);
+            }
+        }
+        return names;
+    }
+    for (const auto& field : schema.fields()) {
+        if (field->name() != options.index_column) {
+            names.push_back(field->name());
+        }
+    }
+    return names;
+}
+
+epoch_frame::DataFrame toFrame(const std::shared_ptr<arrow::Table>& table, const std::string& index_column) {
+    const int index_position = table->schema()->GetFieldIndex(index_column);
+    auto index = epoch_frame::factory::index::make_index(table->column(index_position)->chunk(0), std::nullopt,
+                                                         index_column);
+    return epoch_frame::DataFrame(index, table->RemoveColumn(index_position).ValueOrDie());
+}
+
+} // namespace
+
+ParquetSource::ParquetSource(const std::string& path) : path_(path) {
+    auto input = arrow::io::ReadableFile::Open(path);
+    check(input.status(), "ParquetSource: failed to open '" + path + "'");
+
+    parquet::arrow::FileReaderBuilder builder;
+    check(builder.Open(*input), "ParquetSource: failed to read Parquet footer of '" + path + "'");
+    check(builder.memory_pool(arrow::default_memory_pool())->Build(&reader_),
+          "ParquetSource: failed to create reader for '" + path + "'");
+    check(reader_->GetSchema(&schema_), "ParquetSource: failed to read schema of '" + path + "'");
+}
+
+ParquetSource::~ParquetSource() = default;
+
+std::shared_ptr<arrow::Schema> ParquetSource::schema() const {
+    return schema_;
+}
+
+int ParquetSource::numRowGroups() const {
+    return reader_->num_row_groups();
+}
+
+std::vector<int> ParquetSource::selectRowGroups(const ParquetScanOptions& options) const {
+    const auto unit = indexUnit(*schema_, options.index_column);
+    const auto metadata = reader_->parquet_reader()->metadata();
+    const int leaf = metadata->schema()->ColumnIndex(options.index_column);
+
+    std::vector<int> groups;
+    for (int g = 0; g < metadata->num_row_groups(); ++g) {
+        if (!options.from_ms && !options.to_ms) {
+            groups.push_back(g);
+            continue;
+        }
+        auto stats = metadata->RowGroup(g)->ColumnChunk(leaf)->statistics();
+        if (!stats || !stats->HasMinMax() || stats->physical_type() != parquet::Type::INT64) {
+            groups.push_back(g);
+            continue;
+        }
+        const auto& typed = static_cast<const parquet::Int64Statistics&>(*stats);
+        // toMilliseconds truncates, which can only widen the group's range
+        const int64_t min_ms = DataFrameFactory::toMilliseconds(typed.min(), unit);
+        const int64_t max_ms = DataFrameFactory::toMilliseconds(typed.max(), unit);
+        if ((options.from_ms && max_ms < *options.from_ms) || (options.to_ms && min_ms > *options.to_ms)) {
+            continue;
+        }
+        groups.push_back(g);
+    }
+    return groups;
+}
+
+std::vector<int> ParquetSource::columnIndexes(const ParquetScanOptions& options) const {
+    const auto metadata = reader_->parquet_reader()->metadata();
+    std::vector<std::string> names{options.index_column};
+    for (const auto& name : valueColumns(*schema_, options)) {
+        names.push_back(name);
+    }
+
+    std::vector<int> indexes;
+    for (const auto& name : names) {
+        const int leaf = metadata->schema()->ColumnIndex(name);
+        if (leaf < 0) {
+            throw std::runtime_error("ParquetSource: unknown column '" + name + "' in '" + path_ + "'");
+        }
+        if (std::find(indexes.begin(), indexes.end(), leaf) == indexes.end()) {
+            indexes.push_back(leaf);
+        }
+    }
+    return indexes;
+}
+
+ParquetScanStats ParquetSource::scan(const ParquetScanOptions& options, const BatchVisitor& visit) const {
+    ScopedSpan span("ParquetSource", SpanPhase::Conversion);
+    span.setTitle(path_);
+
+    ParquetScanStats stats;
+    stats.row_groups_total = numRowGroups();
+    const auto groups = selectRowGroups(options);
+    const auto columns = columnIndexes(options);
+    const bool bounded = options.from_ms || options.to_ms;
+    const TimeWindowQuery window{options.from_ms, options.to_ms, std::nullopt, 0, 0};
+
+    for (int group : groups) {
+        std::shared_ptr<arrow::Table> table;
+        check(reader_->ReadRowGroup(group, columns, &table),
+              "ParquetSource: failed to read row group " + std::to_string(group) + " of '" + path_ + "'");
+        ++stats.row_groups_read;
+        stats.rows_read += table->num_rows();
+
+        arrow::TableBatchReader batches(*table);
+        std::shared_ptr<arrow::RecordBatch> batch;
+        while (true) {
+            check(batches.ReadNext(&batch), "ParquetSource: failed to slice row group");
+            if (!batch) {
+                break;
+            }
+            const auto range = bounded ? TimeWindow::locate(batch->GetColumnByName(options.index_column), window)
+                                       : RowRange{0, batch->num_rows()};
+            if (range.length == 0) {
+                continue;
+            }
+            stats.rows_emitted += range.length;
+            visit(range.length == batch->num_rows() ? batch : batch->Slice(range.offset, range.length));
+        }
+    }
+
+    span.setRowsIn(stats.rows_read).addPointsOut(stats.rows_emitted);
+    return stats;
+}
+
+epoch_frame::DataFrame ParquetSource::readDataFrame(const ParquetScanOptions& options) const {
+    std::vector<std::shared_ptr<arrow::RecordBatch>> batches;
+    scan(options, [&](const std::shared_ptr<arrow::RecordBatch>& batch) { batches.push_back(batch); });
+
+    std::shared_ptr<arrow::Table> table;
+    if (batches.empty()) {
+        std::vector<std::shared_ptr<arrow::Field>> fields{schema_->GetFieldByName(options.index_column)};
+        for (const auto& name : valueColumns(*schema_, options)) {
+            fields.push_back(schema_->GetFieldByName(name));
+        }
+        table = arrow::Table::MakeEmpty(arrow::schema(fields)).ValueOrDie();
+    } else {
+        table = arrow::Table::FromRecordBatches(batches).ValueOrDie();
+    }
+    return toFrame(table->CombineChunks().ValueOrDie(), options.index_column);
+}
+
+std::vector<ColumnarLine> ParquetSource::readColumnarLines(const ParquetScanOptions& options) const {
+    const auto names = valueColumns(*schema_, options);
+    std::vector<ColumnarLine> lines(names.size());
+    for (size_t i = 0; i < names.size(); ++i) {
+        lines[i].name = names[i];
+    }
+
+    scan(options, [&](const std::shared_ptr<arrow::RecordBatch>& batch) {
+        auto frame = toFrame(arrow::Table::FromRecordBatches({batch}).ValueOrDie(), options.index_column);
+        // Matched by name, so a column the conversion skips cannot shift the others
+        for (auto& converted : DataFrameFactory::toColumnarLines(frame, names)) {
+            auto& line = lines[std::find(names.begin(), names.end(), converted.name) - names.begin()];
+            line.x.insert(line.x.end(), converted.x.begin(), converted.x.end());
+            line.y.insert(line.y.end(), converted.y.begin(), converted.y.end());
+        }
+    });
+    return lines;
+}
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,637 @@
+#include "epoch_dashboard/tearsheet/payload_budget.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+#include <optional>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+// Wire cost constants: field tag + length prefix for a nested message
+constexpr size_t kMessageFraming = 3;
+constexpr size_t kChartOverhead = 64;      // ChartDef, axes and oneof framing
+constexpr size_t kDoubleField = 9;         // tag + fixed64
+
+// Small repeated messages (points, scalars) carry a one-byte tag and one-byte length
+constexpr size_t kNumericPointCost = 2 + 2 * kDoubleField;
+constexpr size_t kHeatMapPointCost = 2 + 4 + kDoubleField;
+constexpr size_t kBoxPlotPointCost = 2 + 5 * kDoubleField;
+constexpr size_t kBoxPlotOutlierCost = 2 + 2 + kDoubleField;
+constexpr size_t kXRangePointCost = 2 + 2 * 7 + 4 + 2;
+
+// Degrading by the size ratio overshoots slightly because of fixed overhead
+constexpr int kMaxShrinkPasses = 4;
+
+size_t varintSize(uint64_t value) {
+    size_t size = 1;
+    while (value >= 0x80) {
+        value >>= 7;
+        ++size;
+    }
+    return size;
+}
+
+size_t stringCost(const std::string& value) {
+    return value.empty() ? 0 : 1 + varintSize(value.size()) + value.size();
+}
+
+size_t framedCost(size_t body) {
+    return 1 + varintSize(body) + body;
+}
+
+// Timestamps dominate x, so the first point's varint width stands in for all of them
+size_t estimateLine(const epoch_proto::Line& line) {
+    size_t cost = kMessageFraming + stringCost(line.name()) + 4;
+    if (line.data_size() > 0) {
+        const size_t point_cost = framedCost(1 + varintSize(static_cast<uint64_t>(line.data(0).x())) + kDoubleField);
+        cost += point_cost * static_cast<size_t>(line.data_size());
+    }
+    return cost;
+}
+
+size_t estimateLine(const epoch_proto::NumericLine& line) {
+    return kMessageFraming + stringCost(line.name()) + 4 +
+        kNumericPointCost * static_cast<size_t>(line.data_size());
+}
+
+// Samples the first element; arrays are homogeneous in practice
+size_t estimateArray(const epoch_proto::Array& array) {
+    if (array.values_size() == 0) {
+        return 0;
+    }
+    const size_t value_cost = framedCost(array.values(0).ByteSizeLong());
+    return kMessageFraming + value_cost * static_cast<size_t>(array.values_size());
+}
+
+const epoch_proto::ChartDef* chartDefOf(const epoch_proto::Chart& chart) {
+    switch (chart.chart_type_case()) {
+        case epoch_proto::Chart::kLinesDef: return &chart.lines_def().chart_def();
+        case epoch_proto::Chart::kHeatMapDef: return &chart.heat_map_def().chart_def();
+        case epoch_proto::Chart::kBarDef: return &chart.bar_def().chart_def();
+        case epoch_proto::Chart::kHistogramDef: return &chart.histogram_def().chart_def();
+        case epoch_proto::Chart::kBoxPlotDef: return &chart.box_plot_def().chart_def();
+        case epoch_proto::Chart::kXRangeDef: return &chart.x_range_def().chart_def();
+        case epoch_proto::Chart::kPieDef: return &chart.pie_def().chart_def();
+        case epoch_proto::Chart::kAreaDef: return &chart.area_def().chart_def();
+        case epoch_proto::Chart::kNumericLinesDef: return &chart.numeric_lines_def().chart_def();
+        default: return nullptr;
+    }
+}
+
+std::optional<double> numericValue(const epoch_proto::Scalar& scalar) {
+    switch (scalar.value_case()) {
+        case epoch_proto::Scalar::kIntegerValue: return static_cast<double>(scalar.integer_value());
+        case epoch_proto::Scalar::kDecimalValue: return scalar.decimal_value();
+        case epoch_proto::Scalar::kPercentValue: return scalar.percent_value();
+        case epoch_proto::Scalar::kMonetaryValue: return scalar.monetary_value();
+        case epoch_proto::Scalar::kTimestampMs: return static_cast<double>(scalar.timestamp_ms());
+        case epoch_proto::Scalar::kDateValue: return static_cast<double>(scalar.date_value());
+        case epoch_proto::Scalar::kDayDuration: return static_cast<double>(scalar.day_duration());
+        case epoch_proto::Scalar::kDurationMs: return static_cast<double>(scalar.duration_ms());
+        default: return std::nullopt;
+    }
+}
+
+template <typename Point>
+std::vector<int> lttbIndices(const google::protobuf::RepeatedPtrField<Point>& data, size_t target) {
+    const int n = data.size();
+    std::vector<int> indices;
+    indices.reserve(target);
+
+    if (target < 3) {
+        indices.push_back(0);
+        if (target == 2 && n > 1) {
+            indices.push_back(n - 1);
+        }
+        return indices;
+    }
+
+    const double bucket_size = static_cast<double>(n - 2) / static_cast<double>(target - 2);
+    int a = 0;
+    indices.push_back(a);
+
+    for (size_t i = 0; i < target - 2; ++i) {
+        // Average of the next bucket is the third triangle vertex
+        int next_start = static_cast<int>(std::floor(static_cast<double>(i + 1) * bucket_size)) + 1;
+        int next_end = std::min(static_cast<int>(std::floor(static_cast<double>(i + 2) * bucket_size)) + 1, n);
+        if (next_start >= next_end) {
+            next_start = n - 1;
+            next_end = n;
+        }
+        double avg_x = 0.0;
+        double avg_y = 0.0;
+        for (int j = next_start; j < next_end; ++j) {
+            avg_x += static_cast<double>(data.Get(j).x());
+            avg_y += data.Get(j).y();
+        }
+        avg_x /= static_cast<double>(next_end - next_start);
+        avg_y /= static_cast<double>(next_end - next_start);
+
+        const int start = static_cast<int>(std::floor(static_cast<double>(i) * bucket_size)) + 1;
+        const int end = std::min(static_cast<int>(std::floor(static_cast<double>(i + 1) * bucket_size)) + 1, n - 1);
+
+        const double ax = static_cast<double>(data.Get(a).x());
+        const double ay = data.Get(a).y();
+        double max_area = -1.0;
+        int chosen = start;
+        for (int j = start; j < end; ++j) {
+            const double area = std::abs((ax - avg_x) * (data.Get(j).y() - ay) -
+                                         (ax - static_cast<double>(data.Get(j).x())) * (avg_y - ay));
+            if (area > max_area) {
+                max_area = area;
+                chosen = j;
+            }
+        }
+        indices.push_back(chosen);
+        a = chosen;
+    }
+
+    indices.push_back(n - 1);
+    return indices;
+}
+
+// Same indices for every series so stacked lines stay aligned on x
+std::vector<int> strideIndices(int n, size_t target) {
+    std::vector<int> indices;
+    indices.reserve(target);
+    if (target < 2) {
+        indices.push_back(0);
+        return indices;
+    }
+    for (size_t i = 0; i < target; ++i) {
+        indices.push_back(static_cast<int>(std::llround(
+            static_cast<double>(i) * static_cast<double>(n - 1) / static_cast<double>(target - 1))));
+    }
+    return indices;
+}
+
+// Compacts the selected (strictly increasing) indices to the front without copying elements
+template <typename T>
+void keepIndices(google::protobuf::RepeatedPtrField<T>& data, const std::vector<int>& indices) {
+    for (size_t k = 0; k < indices.size(); ++k) {
+        if (static_cast<int>(k) != indices[k]) {
+            data.SwapElements(static_cast<int>(k), indices[k]);
+        }
+    }
+    const int keep = static_cast<int>(indices.size());
+    if (data.size() > keep) {
+        data.DeleteSubrange(keep, data.size() - keep);
+    }
+}
+
+template <typename LineT>
+void downsampleLines(google::protobuf::RepeatedPtrField<LineT>& lines, double fraction,
+                     size_t min_points, bool stacked) {
+    for (auto& line : lines) {
+        const size_t n = static_cast<size_t>(line.data_size());
+        const size_t target = std::max(min_points,
+            static_cast<size_t>(std::floor(static_cast<double>(n) * fraction)));
+        if (target >= n) {
+            continue;
+        }
+        if (stacked) {
+            keepIndices(*line.mutable_data(), strideIndices(static_cast<int>(n), target));
+        } else {
+            PayloadBudgetEnforcer::downsampleLine(line, target);
+        }
+    }
+}
+
+// Distinct from tearsheet_spec.h's WidgetKind: only what the enforcer can degrade
+enum class BudgetWidgetKind { Lines, Histogram, Table, Fixed };
+
+struct Widget {
+    std::string category;
+    BudgetWidgetKind kind = BudgetWidgetKind::Fixed;
+    epoch_proto::Chart* chart = nullptr;
+    epoch_proto::Table* table = nullptr;
+    size_t bytes = 0;
+    std::optional<size_t> action_index;
+};
+
+size_t itemCount(const Widget& widget) {
+    size_t count = 0;
+    if (widget.table) {
+        return static_cast<size_t>(widget.table->data().rows_size());
+    }
+    const auto& chart = *widget.chart;
+    switch (chart.chart_type_case()) {
+        case epoch_proto::Chart::kLinesDef:
+            for (const auto& line : chart.lines_def().lines()) count += static_cast<size_t>(line.data_size());
+            break;
+        case epoch_proto::Chart::kAreaDef:
+            for (const auto& line : chart.area_def().areas()) count += static_cast<size_t>(line.data_size());
+            break;
+        case epoch_proto::Chart::kNumericLinesDef:
+            for (const auto& line : chart.numeric_lines_def().lines()) count += static_cast<size_t>(line.data_size());
+            break;
+        case epoch_proto::Chart::kHistogramDef:
+            count = static_cast<size_t>(chart.histogram_def().data().values_size());
+            break;
+        default:
+            break;
+    }
+    return count;
+}
+
+BudgetWidgetKind kindOf(const epoch_proto::Chart& chart) {
+    switch (chart.chart_type_case()) {
+        case epoch_proto::Chart::kLinesDef:
+        case epoch_proto::Chart::kAreaDef:
+        case epoch_proto::Chart::kNumericLinesDef:
+            return BudgetWidgetKind::Lines;
+        case epoch_proto::Chart::kHistogramDef:
+            return BudgetWidgetKind::Histogram;
+        default:
+            return BudgetWidgetKind::Fixed;
+    }
+}
+
+size_t estimateWidget(const Widget& widget) {
+    return widget.table ? PayloadEstimator::estimate(*widget.table) : PayloadEstimator::estimate(*widget.chart);
+}
+
+// Charts then tables, the order PayloadBudgetSession records action indices in
+void collectWidgets(const std::string& category, epoch_proto::TearSheet& tearsheet, std::vector<Widget>& widgets) {
+    for (auto& chart : *tearsheet.mutable_charts()->mutable_charts()) {
+        widgets.push_back({category, kindOf(chart), &chart, nullptr, PayloadEstimator::estimate(chart), std::nullopt});
+    }
+    for (auto& table : *tearsheet.mutable_tables()->mutable_tables()) {
+        widgets.push_back({category, BudgetWidgetKind::Table, nullptr, &table, PayloadEstimator::estimate(table),
+                           std::nullopt});
+    }
+}
+
+class Enforcer {
+public:
+    Enforcer(const PayloadBudget& budget, BudgetReport& report) : budget_(budget), report_(report) {}
+
+    // Shrinks a degradable widget so its estimate approaches target_bytes, respecting minimums
+    void shrink(Widget& widget, size_t target_bytes) {
+        if (widget.kind == BudgetWidgetKind::Fixed || widget.bytes <= target_bytes || widget.bytes == 0) {
+            return;
+        }
+        const size_t items_before = itemCount(widget);
+        const size_t bytes_before = widget.bytes;
+
+        // First pass scales by the byte ratio; later passes use the measured per-item cost
+        // to remove the overshoot left by fixed overhead
+        size_t items = items_before;
+        size_t previous_items = 0;
+        size_t previous_bytes = 0;
+        for (int pass = 0; pass < kMaxShrinkPasses && widget.bytes > target_bytes && items > 0; ++pass) {
+            double fraction = static_cast<double>(target_bytes) / static_cast<double>(widget.bytes);
+            if (pass > 0) {
+                // Signed: a pass can leave the estimate unchanged or even larger
+                const double per_item = (static_cast<double>(previous_bytes) - static_cast<double>(widget.bytes)) /
+                                        static_cast<double>(previous_items - items);
+                if (per_item <= 0.0) {
+                    break;
+                }
+                const double excess_items = std::ceil(static_cast<double>(widget.bytes - target_bytes) / per_item);
+                fraction = std::max(0.0, 1.0 - excess_items / static_cast<double>(items));
+            }
+            previous_items = items;
+            previous_bytes = widget.bytes;
+
+            degrade(widget, items, fraction);
+            widget.bytes = estimateWidget(widget);
+            items = itemCount(widget);
+            if (items == previous_items) {
+                break;  // Minimums reached
+            }
+        }
+
+        const size_t items_after = items;
+        if (items_after == items_before) {
+            return;
+        }
+
+        if (widget.action_index) {
+            auto& action = report_.actions[*widget.action_index];
+            action.items_after = items_after;
+            action.estimated_bytes_after = widget.bytes;
+            return;
+        }
+
+        BudgetAction action;
+        action.category = widget.category;
+        if (widget.table) {
+            action.widget = widget.table->title();
+            action.kind = DegradationKind::TruncateTable;
+        } else {
+            const auto* chart_def = chartDefOf(*widget.chart);
+            if (chart_def) {
+                action.widget = chart_def->id().empty() ? chart_def->title() : chart_def->id();
+            }
+            action.kind = widget.kind == BudgetWidgetKind::Lines ? DegradationKind::DownsampleLines
+                                                           : DegradationKind::PreBinHistogram;
+        }
+        action.items_before = items_before;
+        action.items_after = items_after;
+        action.estimated_bytes_before = bytes_before;
+        action.estimated_bytes_after = widget.bytes;
+        widget.action_index = report_.actions.size();
+        report_.actions.push_back(std::move(action));
+    }
+
+private:
+    void degrade(Widget& widget, size_t items, double fraction) {
+        switch (widget.kind) {
+            case BudgetWidgetKind::Lines:
+                shrinkLines(*widget.chart, fraction);
+                break;
+            case BudgetWidgetKind::Histogram: {
+                auto& histogram = *widget.chart->mutable_histogram_def();
+                const size_t min_values = std::max(budget_.min_histogram_values,
+                                                   static_cast<size_t>(histogram.bins_count()));
+                const size_t target = std::max(min_values,
+                    static_cast<size_t>(std::floor(static_cast<double>(items) * fraction)));
+                if (target < items) {
+                    PayloadBudgetEnforcer::preBinHistogram(histogram, target);
+                }
+                break;
+            }
+            case BudgetWidgetKind::Table: {
+                const size_t target = std::max(budget_.min_table_rows,
+                    static_cast<size_t>(std::floor(static_cast<double>(items) * fraction)));
+                if (target < items) {
+                    PayloadBudgetEnforcer::truncateTable(*widget.table, target);
+                }
+                break;
+            }
+            case BudgetWidgetKind::Fixed:
+                break;
+        }
+    }
+
+    void shrinkLines(epoch_proto::Chart& chart, double fraction) {
+        switch (chart.chart_type_case()) {
+            case epoch_proto::Chart::kLinesDef: {
+                auto& def = *chart.mutable_lines_def();
+                downsampleLines(*def.mutable_lines(), fraction, budget_.min_line_points, def.stacked());
+                break;
+            }
+            case epoch_proto::Chart::kAreaDef: {
+                auto& def = *chart.mutable_area_def();
+                downsampleLines(*def.mutable_areas(), fraction, budget_.min_line_points, def.stacked());
+                break;
+            }
+            case epoch_proto::Chart::kNumericLinesDef:
+                downsampleLines(*chart.mutable_numeric_lines_def()->mutable_lines(), fraction,
+                                budget_.min_line_points, false);
+                break;
+            default:
+                break;
+        }
+    }
+
+    const PayloadBudget& budget_;
+    BudgetReport& report_;
+};
+
+} // namespace
+
+std::string_view toString(DegradationKind kind) {
+    switch (kind) {
+        case DegradationKind::DownsampleLines:
+            return "downsample_lines";
+        case DegradationKind::PreBinHistogram:
+            return "pre_bin_histogram";
+        case DegradationKind::TruncateTable:
+            return "truncate_table";
+    }
+    return "unknown";
+}
+
+size_t PayloadEstimator::estimate(const epoch_proto::Chart& chart) {
+    size_t cost = kChartOverhead;
+    if (const auto* chart_def = chartDefOf(chart)) {
+        cost += stringCost(chart_def->id()) + stringCost(chart_def->title());
+    }
+
+    switch (chart.chart_type_case()) {
+        case epoch_proto::Chart::kLinesDef:
+            for (const auto& line : chart.lines_def().lines()) cost += estimateLine(line);
+            break;
+        case epoch_proto::Chart::kAreaDef:
+            for (const auto& line : chart.area_def().areas()) cost += estimateLine(line);
+            break;
+        case epoch_proto::Chart::kNumericLinesDef:
+            for (const auto& line : chart.numeric_lines_def().lines()) cost += estimateLine(line);
+            break;
+        case epoch_proto::Chart::kHistogramDef:
+            cost += estimateArray(chart.histogram_def().data());
+            break;
+        case epoch_proto::Chart::kHeatMapDef:
+            cost += kHeatMapPointCost * static_cast<size_t>(chart.heat_map_def().points_size());
+            break;
+        case epoch_proto::Chart::kBarDef:
+            for (const auto& bar : chart.bar_def().data()) {
+                cost += kMessageFraming + stringCost(bar.name()) + 3 + 8 * static_cast<size_t>(bar.values_size());
+            }
+            break;
+        case epoch_proto::Chart::kBoxPlotDef: {
+            const auto& data = chart.box_plot_def().data();
+            cost += kBoxPlotPointCost * static_cast<size_t>(data.points_size()) +
+                kBoxPlotOutlierCost * static_cast<size_t>(data.outliers_size());
+            break;
+        }
+        case epoch_proto::Chart::kXRangeDef:
+            for (const auto& category : chart.x_range_def().categories()) cost += stringCost(category);
+            cost += kXRangePointCost * static_cast<size_t>(chart.x_range_def().points_size());
+            break;
+        case epoch_proto::Chart::kPieDef:
+            for (const auto& pie : chart.pie_def().data()) {
+                cost += kMessageFraming + stringCost(pie.name()) + 2 * kDoubleField;
+                for (const auto& point : pie.points()) {
+                    cost += kMessageFraming + stringCost(point.name()) + kDoubleField;
+                }
+            }
+            break;
+        default:
+            break;
+    }
+    return cost;
+}
+
+size_t PayloadEstimator::estimate(const epoch_proto::Table& table) {
+    size_t cost = kMessageFraming + stringCost(table.title()) + stringCost(table.category()) + 2;
+    for (const auto& column : table.columns()) {
+        cost += kMessageFraming + stringCost(column.id()) + stringCost(column.name()) + 2;
+    }
+    const auto& rows = table.data().rows();
+    if (!rows.empty()) {
+        cost += kMessageFraming + framedCost(rows.Get(0).ByteSizeLong()) * static_cast<size_t>(rows.size());
+    }
+    return cost;
+}
+
+size_t PayloadEstimator::estimate(const epoch_proto::CardDef& card) {
+    return kMessageFraming + card.ByteSizeLong();
+}
+
+size_t PayloadEstimator::estimate(const epoch_proto::TearSheet& tearsheet) {
+    size_t cost = 0;
+    for (const auto& card : tearsheet.cards().cards()) cost += estimate(card);
+    for (const auto& chart : tearsheet.charts().charts()) cost += kMessageFraming + estimate(chart);
+    for (const auto& table : tearsheet.tables().tables()) cost += estimate(table);
+    return cost;
+}
+
+size_t PayloadEstimator::estimateCategory(const std::string& category, const epoch_proto::TearSheet& tearsheet) {
+    return 2 * kMessageFraming + stringCost(category) + estimate(tearsheet);
+}
+
+size_t PayloadEstimator::estimate(const epoch_proto::FullTearSheet& full_tearsheet) {
+    size_t cost = 0;
+    for (const auto& [category, tearsheet] : full_tearsheet.categories()) {
+        cost += estimateCategory(category, tearsheet);
+    }
+    return cost;
+}
+
+BudgetReport PayloadBudgetEnforcer::apply(epoch_proto::FullTearSheet& full_tearsheet, const PayloadBudget& budget) {
+    PayloadBudgetSession session(budget);
+    for (auto& [category, tearsheet] : *full_tearsheet.mutable_categories()) {
+        session.addCategory(category, tearsheet);
+    }
+    return session.finish();
+}
+
+PayloadBudgetSession::PayloadBudgetSession(const PayloadBudget& budget) : budget_(budget) {}
+
+void PayloadBudgetSession::addCategory(const std::string& category, epoch_proto::TearSheet& tearsheet) {
+    report_.estimated_bytes_before += PayloadEstimator::estimateCategory(category, tearsheet);
+
+    std::vector<Widget> widgets;
+    collectWidgets(category, tearsheet, widgets);
+    if (budget_.per_widget_bytes > 0) {
+        Enforcer enforcer(budget_, report_);
+        for (auto& widget : widgets) {
+            enforcer.shrink(widget, budget_.per_widget_bytes);
+        }
+    }
+    for (const auto& widget : widgets) {
+        action_indices_.push_back(widget.action_index);
+    }
+    categories_.emplace_back(category, &tearsheet);
+}
+
+BudgetReport PayloadBudgetSession::finish() {
+    ScopedSpan span("PayloadBudgetEnforcer", SpanPhase::Build);
+
+    // Estimates are cheap, so widgets are re-collected rather than kept between categories
+    std::vector<Widget> widgets;
+    size_t capped_bytes = 0;
+    for (const auto& [category, tearsheet] : categories_) {
+        capped_bytes += PayloadEstimator::estimateCategory(category, *tearsheet);
+        collectWidgets(category, *tearsheet, widgets);
+    }
+    size_t widget_bytes = 0;
+    for (size_t i = 0; i < widgets.size(); ++i) {
+        widgets[i].action_index = action_indices_[i];
+        widget_bytes += widgets[i].bytes;
+    }
+    span.setRowsIn(static_cast<int64_t>(widgets.size()));
+    // Framing and cards are never degraded
+    const size_t fixed_bytes = capped_bytes - std::min(capped_bytes, widget_bytes);
+
+    Enforcer enforcer(budget_, report_);
+
+    auto total = [&] {
+        return fixed_bytes + std::accumulate(widgets.begin(), widgets.end(), size_t{0},
+                                             [](size_t sum, const Widget& w) { return sum + w.bytes; });
+    };
+
+    if (budget_.total_bytes > 0) {
+        for (auto stage : {BudgetWidgetKind::Lines, BudgetWidgetKind::Histogram, BudgetWidgetKind::Table}) {
+            const size_t current = total();
+            if (current <= budget_.total_bytes) {
+                break;
+            }
+            size_t stage_bytes = 0;
+            for (const auto& widget : widgets) {
+                if (widget.kind == stage) stage_bytes += widget.bytes;
+            }
+            if (stage_bytes == 0) {
+                continue;
+            }
+            // Scale every widget of this stage by the same fraction
+            const size_t excess = current - budget_.total_bytes;
+            const double fraction = stage_bytes > excess
+                ? static_cast<double>(stage_bytes - excess) / static_cast<double>(stage_bytes)
+                : 0.0;
+            for (auto& widget : widgets) {
+                if (widget.kind == stage) {
+                    enforcer.shrink(widget, static_cast<size_t>(static_cast<double>(widget.bytes) * fraction));
+                }
+            }
+        }
+    }
+
+    report_.estimated_bytes_after = total();
+    report_.within_budget = budget_.total_bytes == 0 || report_.estimated_bytes_after <= budget_.total_bytes;
+    if (budget_.per_widget_bytes > 0) {
+        for (const auto& widget : widgets) {
+            if (widget.bytes > budget_.per_widget_bytes) {
+                report_.within_budget = false;
+            }
+        }
+    }
+
+    span.addPointsOut(static_cast<int64_t>(report_.actions.size()));
+    return std::move(report_);
+}
+
+void PayloadBudgetEnforcer::downsampleLine(epoch_proto::Line& line, size_t target_points) {
+    if (target_points >= static_cast<size_t>(line.data_size())) {
+        return;
+    }
+    keepIndices(*line.mutable_data(), lttbIndices(line.data(), target_points));
+}
+
+void PayloadBudgetEnforcer::downsampleLine(epoch_proto::NumericLine& line, size_t target_points) {
+    if (target_points >= static_cast<size_t>(line.data_size())) {
+        return;
+    }
+    keepIndices(*line.mutable_data(), lttbIndices(line.data(), target_points));
+}
+
+void PayloadBudgetEnforcer::preBinHistogram(epoch_proto::HistogramDef& histogram, size_t target_values) {
+    const auto& values = histogram.data().values();
+    std::vector<std::pair<double, int>> numeric;
+    numeric.reserve(static_cast<size_t>(values.size()));
+    for (int i = 0; i < values.size(); ++i) {
+        if (auto value = numericValue(values.Get(i)); value && std::isfinite(*value)) {
+            numeric.emplace_back(*value, i);
+        }
+    }
+    if (target_values >= numeric.size() && numeric.size() == static_cast<size_t>(values.size())) {
+        return;
+    }
+    std::sort(numeric.begin(), numeric.end());
+
+    const size_t n = numeric.size();
+    const size_t m = std::min(target_values, n);
+    epoch_proto::Array resampled;
+    resampled.mutable_values()->Reserve(static_cast<int>(m));
+    for (size_t i = 0; i < m; ++i) {
+        // Midpoint quantile of each of m equal-mass slices
+        const size_t rank = std::min(n - 1, static_cast<size_t>((static_cast<double>(i) + 0.5) *
+                                                                static_cast<double>(n) / static_cast<double>(m)));
+        *resampled.add_values() = values.Get(numeric[rank].second);
+    }
+    histogram.mutable_data()->Swap(&resampled);
+}
+
+void PayloadBudgetEnforcer::truncateTable(epoch_proto::Table& table, size_t target_rows) {
+    auto* rows = table.mutable_data()->mutable_rows();
+    if (target_rows < static_cast<size_t>(rows->size())) {
+        rows->DeleteSubrange(static_cast<int>(target_rows), rows->size() - static_cast<int>(target_rows));
+    }
+}
+
+} // namespace epoch_tearsheet
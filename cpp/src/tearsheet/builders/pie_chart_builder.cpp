@@ -1,9 +1,83 @@
 #include "epoch_dashboard/tearsheet/pie_chart_builder.h"
+#include "epoch_dashboard/tearsheet/arrow_values.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
 #include <epoch_frame/dataframe.h>
 #include <arrow/api.h>
+#include <algorithm>
+#include <stdexcept>
+#include <string_view>
+#include <unordered_map>
 
 namespace epoch_tearsheet {
 
+namespace {
+
+using GroupSums = std::unordered_map<std::string_view, double>;
+
+template <typename StringArrayType>
+void sumByString(const StringArrayType& names, const NumericValues& values, GroupSums& sums) {
+    for (int64_t i = 0; i < names.length(); ++i) {
+        if (names.IsValid(i) && values.isValid(i)) {
+            sums[names.GetView(i)] += values[i];
+        }
+    }
+}
+
+// Sums per dictionary index first, so only distinct names are hashed
+template <typename IndexType, typename StringArrayType>
+void sumByDictionary(const arrow::DictionaryArray& names, const IndexType* indices, const StringArrayType& dictionary,
+                     const NumericValues& values, GroupSums& sums) {
+    std::vector<double> per_index(static_cast<size_t>(dictionary.length()), 0.0);
+    std::vector<bool> seen(per_index.size(), false);
+    for (int64_t i = 0; i < names.length(); ++i) {
+        if (names.IsValid(i) && values.isValid(i)) {
+            const auto index = static_cast<size_t>(indices[i]);
+            per_index[index] += values[i];
+            seen[index] = true;
+        }
+    }
+    for (size_t index = 0; index < per_index.size(); ++index) {
+        if (seen[index] && dictionary.IsValid(static_cast<int64_t>(index))) {
+            sums[dictionary.GetView(static_cast<int64_t>(index))] += per_index[index];
+        }
+    }
+}
+
+template <typename StringArrayType>
+void sumByDictionary(const arrow::DictionaryArray& names, const NumericValues& values, GroupSums& sums) {
+    const auto& dictionary = static_cast<const StringArrayType&>(*names.dictionary());
+    visitDictionaryIndices(names, "PieChartBuilder", [&](const auto* indices) {
+        sumByDictionary(names, indices, dictionary, values, sums);
+    });
+}
+
+void sumBatch(const std::shared_ptr<arrow::Array>& names, const NumericValues& values, GroupSums& sums) {
+    switch (names->type_id()) {
+        case arrow::Type::STRING:
+            return sumByString(static_cast<const arrow::StringArray&>(*names), values, sums);
+        case arrow::Type::LARGE_STRING:
+            return sumByString(static_cast<const arrow::LargeStringArray&>(*names), values, sums);
+        case arrow::Type::DICTIONARY: {
+            const auto& dictionary = static_cast<const arrow::DictionaryArray&>(*names);
+            switch (dictionary.dictionary()->type_id()) {
+                case arrow::Type::STRING:
+                    return sumByDictionary<arrow::StringArray>(dictionary, values, sums);
+                case arrow::Type::LARGE_STRING:
+                    return sumByDictionary<arrow::LargeStringArray>(dictionary, values, sums);
+                default:
+                    break;
+            }
+            break;
+        }
+        default:
+            break;
+    }
+    throw std::runtime_error("PieChartBuilder: name column must be string or dictionary of strings, got " +
+                             names->type()->ToString());
+}
+
+} // namespace
+
 PieChartBuilder::PieChartBuilder() {
     pie_def_.mutable_chart_def()->set_type(epoch_proto::WidgetPie);
 }
@@ -30,7 +104,11 @@ PieChartBuilder& PieChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df
                                                   const std::string& series_name,
                                                   const PieSize& size,
                                                   const std::optional<PieInnerSize>& inner_size) {
+    ScopedSpan span("PieChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(pie_def_.chart_def());
+
     auto arrow_table = df.table();
+    span.setRowsIn(arrow_table->num_rows());
     auto name_column = arrow_table->GetColumnByName(name_col);
     auto value_column = arrow_table->GetColumnByName(value_col);
 
@@ -52,15 +130,91 @@ PieChartBuilder& PieChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df
                 }
             }
         }
+        span.addPointsOut(static_cast<int64_t>(points.size()));
         addSeries(series_name, points, size, inner_size);
     }
 
     return *this;
 }
 
+PieChartBuilder& PieChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df,
+                                                  const std::string& name_col,
+                                                  const std::string& value_col,
+                                                  const std::string& series_name,
+                                                  const PieSize& size,
+                                                  const PieTopN& top_n,
+                                                  const std::optional<PieInnerSize>& inner_size) {
+    ScopedSpan span("PieChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(pie_def_.chart_def());
+
+    auto arrow_table = df.table();
+    span.setRowsIn(arrow_table->num_rows());
+    auto name_column = arrow_table->GetColumnByName(name_col);
+    auto value_column = arrow_table->GetColumnByName(value_col);
+    if (!name_column || !value_column) {
+        throw std::runtime_error("PieChartBuilder: missing column, expected '" + name_col + "' and '" +
+                                 value_col + "'");
+    }
+
+    // Aligned batches over both columns; views into the name buffers stay valid with the table
+    auto pair = arrow::Table::Make(arrow::schema({arrow::field("name", name_column->type()),
+                                                  arrow::field("value", value_column->type())}),
+                                   {name_column, value_column});
+    arrow::TableBatchReader batches(*pair);
+    GroupSums sums;
+    std::shared_ptr<arrow::RecordBatch> batch;
+    while (true) {
+        auto status = batches.ReadNext(&batch);
+        if (!status.ok()) {
+            throw std::runtime_error("PieChartBuilder: " + status.ToString());
+        }
+        if (!batch) {
+            break;
+        }
+        sumBatch(batch->column(0), NumericValues(batch->column(1), "PieChartBuilder"), sums);
+    }
+
+    std::vector<std::pair<std::string_view, double>> groups(sums.begin(), sums.end());
+    const size_t kept = std::min(top_n.count, groups.size());
+    std::partial_sort(groups.begin(), groups.begin() + static_cast<std::ptrdiff_t>(kept), groups.end(),
+                      [](const auto& a, const auto& b) {
+                          return a.second != b.second ? a.second > b.second : a.first < b.first;
+                      });
+
+    std::vector<epoch_proto::PieData> points;
+    points.reserve(kept + 1);
+    for (size_t i = 0; i < kept; ++i) {
+        auto& point = points.emplace_back();
+        point.set_name(std::string(groups[i].first));
+        point.set_y(groups[i].second);
+    }
+    if (kept < groups.size()) {
+        double other = 0.0;
+        for (size_t i = kept; i < groups.size(); ++i) {
+            other += groups[i].second;
+        }
+        auto& point = points.emplace_back();
+        point.set_name(top_n.other_name);
+        point.set_y(other);
+    }
+
+    span.addPointsOut(static_cast<int64_t>(points.size()));
+    return addSeries(series_name, points, size, inner_size);
+}
+
 epoch_proto::Chart PieChartBuilder::build() const {
+    ScopedSpan span("PieChartBuilder", SpanPhase::Build, instrumentationSink());
+    span.describe(pie_def_.chart_def());
+
     epoch_proto::Chart chart;
     *chart.mutable_pie_def() = pie_def_;
+
+    if (span.active()) {
+        for (const auto& series : pie_def_.data()) {
+            span.addPointsOut(series.points_size());
+        }
+        span.setBytesSerialized(static_cast<int64_t>(chart.ByteSizeLong()));
+    }
     return chart;
 }
 
@@ -0,0 +1,237 @@
+#include "epoch_dashboard/tearsheet/quantile_sketch.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
+#include <tbb/combinable.h>
+#include <tbb/parallel_for.h>
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <thread>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+constexpr int64_t kBlockRows = int64_t{1} << 16;
+
+template <typename T>
+void addValues(QuantileSketch& sketch, const arrow::Array& array, int64_t begin, int64_t end) {
+    const auto* data = array.data()->GetValues<T>(1);
+    if (array.null_count() == 0) {
+        for (int64_t i = begin; i < end; ++i) {
+            sketch.update(static_cast<double>(data[i]));
+        }
+        return;
+    }
+    for (int64_t i = begin; i < end; ++i) {
+        if (array.IsValid(i)) {
+            sketch.update(static_cast<double>(data[i]));
+        }
+    }
+}
+
+void addRows(QuantileSketch& sketch, const arrow::Array& array, int64_t begin, int64_t end) {
+    switch (array.type_id()) {
+        case arrow::Type::DOUBLE: addValues<double>(sketch, array, begin, end); break;
+        case arrow::Type::FLOAT: addValues<float>(sketch, array, begin, end); break;
+        case arrow::Type::INT64: addValues<int64_t>(sketch, array, begin, end); break;
+        case arrow::Type::INT32: addValues<int32_t>(sketch, array, begin, end); break;
+        case arrow::Type::UINT64: addValues<uint64_t>(sketch, array, begin, end); break;
+        case arrow::Type::UINT32: addValues<uint32_t>(sketch, array, begin, end); break;
+        default:
+            throw std::runtime_error("QuantileSketch: column must be numeric, got " + array.type()->ToString());
+    }
+}
+
+} // namespace
+
+QuantileSketch::QuantileSketch(uint32_t k, uint64_t seed)
+    : k_(k),
+      min_(std::numeric_limits<double>::quiet_NaN()),
+      max_(std::numeric_limits<double>::quiet_NaN()),
+      rng_(seed) {
+    if (k_ < 8) {
+        throw std::runtime_error("QuantileSketch: k must be at least 8");
+    }
+    addLevel();
+}
+
+size_t QuantileSketch::capacity(size_t level) const {
+    const auto depth = static_cast<double>(levels_.size() - 1 - level);
+    return std::max<size_t>(2, static_cast<size_t>(std::ceil(k_ * std::pow(2.0 / 3.0, depth))));
+}
+
+void QuantileSketch::addLevel() {
+    levels_.emplace_back();
+    max_retained_ = 0;
+    for (size_t level = 0; level < levels_.size(); ++level) {
+        max_retained_ += capacity(level);
+    }
+}
+
+void QuantileSketch::update(double value) {
+    if (std::isnan(value)) {
+        return;
+    }
+    if (count_ == 0) {
+        min_ = max_ = value;
+    } else {
+        min_ = std::min(min_, value);
+        max_ = std::max(max_, value);
+    }
+    levels_.front().push_back(value);
+    ++count_;
+    if (++retained_ >= max_retained_) {
+        compress();
+    }
+}
+
+void QuantileSketch::compress() {
+    while (retained_ >= max_retained_) {
+        // Some level is at capacity whenever the total is
+        size_t level = 0;
+        while (levels_[level].size() < capacity(level)) {
+            ++level;
+        }
+        if (level + 1 == levels_.size()) {
+            addLevel();
+        }
+
+        auto& items = levels_[level];
+        std::sort(items.begin(), items.end());
+        // An odd item out stays behind at this level
+        const size_t kept = items.size() % 2;
+        const size_t offset = kept + static_cast<size_t>(rng_() & 1);
+        auto& above = levels_[level + 1];
+        for (size_t i = offset; i < items.size(); i += 2) {
+            above.push_back(items[i]);
+        }
+        const size_t promoted = (items.size() - kept) / 2;
+        items.resize(kept);
+        retained_ -= promoted;
+    }
+}
+
+void QuantileSketch::merge(const QuantileSketch& other) {
+    if (other.k_ != k_) {
+        throw std::runtime_error("QuantileSketch: cannot merge sketches with different k");
+    }
+    if (other.empty()) {
+        return;
+    }
+    while (levels_.size() < other.levels_.size()) {
+        addLevel();
+    }
+    for (size_t level = 0; level < other.levels_.size(); ++level) {
+        levels_[level].insert(levels_[level].end(), other.levels_[level].begin(), other.levels_[level].end());
+    }
+    retained_ += other.retained_;
+    min_ = empty() ? other.min_ : std::min(min_, other.min_);
+    max_ = empty() ? other.max_ : std::max(max_, other.max_);
+    count_ += other.count_;
+    if (retained_ >= max_retained_) {
+        compress();
+    }
+}
+
+std::vector<QuantileSketch::WeightedValue> QuantileSketch::sortedView() const {
+    std::vector<WeightedValue> view;
+    view.reserve(retained_);
+    for (size_t level = 0; level < levels_.size(); ++level) {
+        for (const double value : levels_[level]) {
+            view.push_back({value, uint64_t{1} << level});
+        }
+    }
+    std::sort(view.begin(), view.end(), [](const WeightedValue& a, const WeightedValue& b) {
+        return a.value < b.value;
+    });
+    // Weights become cumulative ranks
+    for (size_t i = 1; i < view.size(); ++i) {
+        view[i].weight += view[i - 1].weight;
+    }
+    return view;
+}
+
+std::vector<double> QuantileSketch::quantiles(std::span<const double> qs) const {
+    if (empty()) {
+        throw std::runtime_error("QuantileSketch: no values");
+    }
+    const auto view = sortedView();
+    std::vector<double> result;
+    result.reserve(qs.size());
+    for (const double q : qs) {
+        if (!(q >= 0.0 && q <= 1.0)) {
+            throw std::runtime_error("QuantileSketch: quantile must be in [0, 1]");
+        }
+        if (q == 0.0) {
+            result.push_back(min_);
+        } else if (q == 1.0) {
+            result.push_back(max_);
+        } else {
+            const double rank = q * static_cast<double>(count_);
+            auto it = std::lower_bound(view.begin(), view.end(), rank, [](const WeightedValue& item, double target) {
+                return static_cast<double>(item.weight) < target;
+            });
+            result.push_back(it == view.end() ? max_ : it->value);
+        }
+    }
+    return result;
+}
+
+double QuantileSketch::quantile(double q) const {
+    return quantiles(std::span<const double>(&q, 1)).front();
+}
+
+std::vector<double> QuantileSketch::binEdges(uint32_t bins) const {
+    if (bins == 0) {
+        throw std::runtime_error("QuantileSketch: bins must be positive");
+    }
+    std::vector<double> qs(bins + 1);
+    for (uint32_t i = 0; i <= bins; ++i) {
+        qs[i] = static_cast<double>(i) / bins;
+    }
+    return quantiles(qs);
+}
+
+QuantileSketch QuantileSketch::fromChunkedArray(const std::shared_ptr<arrow::ChunkedArray>& values, uint32_t k) {
+    ScopedSpan span("QuantileSketch", SpanPhase::Conversion);
+    span.setRowsIn(values->length());
+
+    struct Block {
+        const arrow::Array* array;
+        int64_t begin;
+        int64_t end;
+    };
+    std::vector<Block> blocks;
+    for (const auto& chunk : values->chunks()) {
+        for (int64_t begin = 0; begin < chunk->length(); begin += kBlockRows) {
+            blocks.push_back({chunk.get(), begin, std::min(begin + kBlockRows, chunk->length())});
+        }
+    }
+
+    // Seeded per thread so the threads' coin flips are independent
+    tbb::combinable<QuantileSketch> local([k] {
+        return QuantileSketch(k, std::hash<std::thread::id>{}(std::this_thread::get_id()));
+    });
+    tbb::parallel_for(size_t{0}, blocks.size(), [&](size_t b) {
+        addRows(local.local(), *blocks[b].array, blocks[b].begin, blocks[b].end);
+    });
+
+    QuantileSketch sketch(k);
+    local.combine_each([&](const QuantileSketch& partial) { sketch.merge(partial); });
+    span.addPointsOut(static_cast<int64_t>(sketch.retained()));
+    return sketch;
+}
+
+QuantileSketch QuantileSketch::fromDataFrame(const epoch_frame::DataFrame& df, const std::string& column, uint32_t k) {
+    auto values = df.table()->GetColumnByName(column);
+    if (!values) {
+        throw std::runtime_error("QuantileSketch: missing column '" + column + "'");
+    }
+    return fromChunkedArray(values, k);
+}
+
+} // namespace epoch_tearsheet
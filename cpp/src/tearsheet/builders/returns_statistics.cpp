@@ -0,0 +1,263 @@
+#include "epoch_dashboard/tearsheet/returns_statistics.h"
+#include "epoch_dashboard/tearsheet/card_builder.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include "epoch_dashboard/tearsheet/scalar_converter.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+#include <vector>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+// Neumaier's variant of Kahan summation; stays exact when an addend dwarfs the running sum
+class CompensatedSum {
+public:
+    void add(double x) {
+        const double t = sum_ + x;
+        if (std::abs(sum_) >= std::abs(x)) {
+            compensation_ += (sum_ - t) + x;
+        } else {
+            compensation_ += (x - t) + sum_;
+        }
+        sum_ = t;
+    }
+
+    double value() const { return sum_ + compensation_; }
+
+private:
+    double sum_ = 0.0;
+    double compensation_ = 0.0;
+};
+
+// Streaming central moments (Welford, extended to M3/M4 by Terriberry)
+class Moments {
+public:
+    void add(double x) {
+        const double n1 = static_cast<double>(n_);
+        ++n_;
+        const double n = static_cast<double>(n_);
+        const double delta = x - mean_;
+        const double delta_n = delta / n;
+        const double delta_n2 = delta_n * delta_n;
+        const double term = delta * delta_n * n1;
+        mean_ += delta_n;
+        m4_ += term * delta_n2 * (n * n - 3.0 * n + 3.0) + 6.0 * delta_n2 * m2_ - 4.0 * delta_n * m3_;
+        m3_ += term * delta_n * (n - 2.0) - 3.0 * delta_n * m2_;
+        m2_ += term;
+    }
+
+    double sampleVariance() const { return n_ > 1 ? m2_ / static_cast<double>(n_ - 1) : kNaN; }
+
+    double skew() const {
+        return m2_ > 0.0 ? std::sqrt(static_cast<double>(n_)) * m3_ / std::pow(m2_, 1.5) : kNaN;
+    }
+
+    double excessKurtosis() const {
+        return m2_ > 0.0 ? static_cast<double>(n_) * m4_ / (m2_ * m2_) - 3.0 : kNaN;
+    }
+
+private:
+    size_t n_ = 0;
+    double mean_ = 0.0;
+    double m2_ = 0.0;
+    double m3_ = 0.0;
+    double m4_ = 0.0;
+};
+
+double ratio(double numerator, double denominator) {
+    return denominator != 0.0 ? numerator / denominator : kNaN;
+}
+
+epoch_proto::CardData card(const std::string& title, double value, epoch_proto::EpochFolioType type, uint64_t group) {
+    epoch_proto::Scalar scalar;
+    if (!std::isfinite(value)) {
+        scalar = ScalarFactory::null();
+    } else if (type == epoch_proto::TypePercent) {
+        scalar = ScalarFactory::fromPercentValue(value * 100.0);
+    } else if (type == epoch_proto::TypeInteger) {
+        scalar = ScalarFactory::fromInteger(static_cast<int64_t>(value));
+    } else {
+        scalar = ScalarFactory::fromDecimal(value);
+    }
+    return CardDataBuilder().setTitle(title).setValue(scalar).setType(type).setGroup(group).build();
+}
+
+} // namespace
+
+ReturnsStatistics ReturnsStatistics::compute(std::span<const double> returns, const ReturnsStatisticsOptions& options) {
+    if (returns.empty()) {
+        throw std::runtime_error("ReturnsStatistics: returns must not be empty");
+    }
+    if (!(options.periods_per_year > 0.0)) {
+        throw std::runtime_error("ReturnsStatistics: periods_per_year must be positive");
+    }
+    ScopedSpan span("ReturnsStatistics", SpanPhase::Conversion);
+    span.setRowsIn(static_cast<int64_t>(returns.size()));
+
+    const double risk_free = options.risk_free_rate / options.periods_per_year;
+    CompensatedSum sum;
+    CompensatedSum log_wealth;
+    CompensatedSum downside_squares;
+    CompensatedSum win_sum;
+    CompensatedSum loss_sum;
+    Moments moments;
+    size_t wins = 0;
+    size_t losses = 0;
+    double log_peak = 0.0;
+    size_t underwater = 0;
+    bool ruined = false;  // Wealth reached zero; log wealth would be -inf from here on
+
+    ReturnsStatistics stats;
+    stats.observations = returns.size();
+    stats.best = returns.front();
+    stats.worst = returns.front();
+
+    // Pass 1: every streaming statistic at once
+    for (const double r : returns) {
+        if (r < -1.0) {
+            throw std::runtime_error("ReturnsStatistics: return below -100%");
+        }
+        sum.add(r);
+        moments.add(r);
+        stats.best = std::max(stats.best, r);
+        stats.worst = std::min(stats.worst, r);
+
+        const double excess = std::min(r - risk_free, 0.0);
+        downside_squares.add(excess * excess);
+        if (r > 0.0) {
+            ++wins;
+            win_sum.add(r);
+        } else if (r < 0.0) {
+            ++losses;
+            loss_sum.add(r);
+        }
+
+        ruined = ruined || r == -1.0;
+        if (ruined) {
+            // Nothing compounds back from zero wealth
+            ++underwater;
+            stats.max_drawdown = -1.0;
+            stats.max_drawdown_duration = std::max(stats.max_drawdown_duration, underwater);
+            continue;
+        }
+        log_wealth.add(std::log1p(r));
+        const double level = log_wealth.value();
+        if (level >= log_peak) {
+            log_peak = level;
+            underwater = 0;
+        } else {
+            ++underwater;
+            stats.max_drawdown = std::min(stats.max_drawdown, std::expm1(level - log_peak));
+            stats.max_drawdown_duration = std::max(stats.max_drawdown_duration, underwater);
+        }
+    }
+
+    const double n = static_cast<double>(returns.size());
+    const double annualizer = std::sqrt(options.periods_per_year);
+    const double mean_excess = sum.value() / n - risk_free;
+    const double volatility = std::sqrt(moments.sampleVariance());
+
+    stats.total_return = ruined ? -1.0 : std::expm1(log_wealth.value());
+    stats.cagr = ruined ? -1.0 : std::expm1(log_wealth.value() * options.periods_per_year / n);
+    stats.annual_volatility = volatility * annualizer;
+    stats.sharpe = ratio(mean_excess, volatility) * annualizer;
+    stats.sortino = ratio(mean_excess, std::sqrt(downside_squares.value() / n)) * annualizer;
+    stats.calmar = ratio(stats.cagr, -stats.max_drawdown);
+    stats.skew = moments.skew();
+    stats.excess_kurtosis = moments.excessKurtosis();
+    stats.hit_rate = static_cast<double>(wins) / n;
+    stats.average_win = wins > 0 ? win_sum.value() / static_cast<double>(wins) : kNaN;
+    stats.average_loss = losses > 0 ? loss_sum.value() / static_cast<double>(losses) : kNaN;
+    stats.win_loss_ratio = ratio(stats.average_win, -stats.average_loss);
+    stats.profit_factor = ratio(win_sum.value(), -loss_sum.value());
+
+    // Pass 2: lower tail of a partially sorted copy
+    std::vector<double> sorted(returns.begin(), returns.end());
+    const size_t tail = std::min(static_cast<size_t>(0.05 * n), sorted.size() - 1);
+    std::nth_element(sorted.begin(), sorted.begin() + static_cast<std::ptrdiff_t>(tail), sorted.end());
+    CompensatedSum tail_sum;
+    for (size_t i = 0; i <= tail; ++i) {
+        tail_sum.add(sorted[i]);
+    }
+    stats.value_at_risk_95 = sorted[tail];
+    stats.conditional_value_at_risk_95 = tail_sum.value() / static_cast<double>(tail + 1);
+
+    return stats;
+}
+
+ReturnsStatistics ReturnsStatistics::fromDataFrame(const epoch_frame::DataFrame& df,
+                                                   const std::string& column,
+                                                   const ReturnsStatisticsOptions& options) {
+    auto values = df.table()->GetColumnByName(column);
+    if (!values) {
+        throw std::runtime_error("ReturnsStatistics: missing column '" + column + "'");
+    }
+
+    std::vector<double> returns;
+    returns.reserve(static_cast<size_t>(values->length() - values->null_count()));
+    for (const auto& chunk : values->chunks()) {
+        auto append = [&](const auto* data) {
+            for (int64_t i = 0; i < chunk->length(); ++i) {
+                const double r = static_cast<double>(data[i]);
+                if (chunk->IsValid(i) && !std::isnan(r)) {
+                    returns.push_back(r);
+                }
+            }
+        };
+        switch (chunk->type_id()) {
+            case arrow::Type::DOUBLE:
+                append(chunk->data()->GetValues<double>(1));
+                break;
+            case arrow::Type::FLOAT:
+                append(chunk->data()->GetValues<float>(1));
+                break;
+            default:
+                throw std::runtime_error("ReturnsStatistics: column '" + column + "' must be float or double, got " +
+                                         chunk->type()->ToString());
+        }
+    }
+    if (returns.empty()) {
+        throw std::runtime_error("ReturnsStatistics: column '" + column + "' has no valid returns");
+    }
+    return compute(returns, options);
+}
+
+epoch_proto::CardDef ReturnsStatistics::toCardDef(const std::string& category) const {
+    using epoch_proto::TypeDecimal;
+    using epoch_proto::TypeInteger;
+    using epoch_proto::TypePercent;
+
+    return CardBuilder()
+        .setType(epoch_proto::WidgetCard)
+        .setCategory(category)
+        .addCardData(card("Total Return", total_return, TypePercent, 0))
+        .addCardData(card("CAGR", cagr, TypePercent, 0))
+        .addCardData(card("Best Period", best, TypePercent, 0))
+        .addCardData(card("Worst Period", worst, TypePercent, 0))
+        .addCardData(card("Annual Volatility", annual_volatility, TypePercent, 1))
+        .addCardData(card("Max Drawdown", max_drawdown, TypePercent, 1))
+        .addCardData(card("Max Drawdown Duration", static_cast<double>(max_drawdown_duration), TypeInteger, 1))
+        .addCardData(card("VaR 95%", value_at_risk_95, TypePercent, 1))
+        .addCardData(card("CVaR 95%", conditional_value_at_risk_95, TypePercent, 1))
+        .addCardData(card("Sharpe Ratio", sharpe, TypeDecimal, 2))
+        .addCardData(card("Sortino Ratio", sortino, TypeDecimal, 2))
+        .addCardData(card("Calmar Ratio", calmar, TypeDecimal, 2))
+        .addCardData(card("Skew", skew, TypeDecimal, 3))
+        .addCardData(card("Excess Kurtosis", excess_kurtosis, TypeDecimal, 3))
+        .addCardData(card("Observations", static_cast<double>(observations), TypeInteger, 3))
+        .addCardData(card("Hit Rate", hit_rate, TypePercent, 4))
+        .addCardData(card("Average Win", average_win, TypePercent, 4))
+        .addCardData(card("Average Loss", average_loss, TypePercent, 4))
+        .addCardData(card("Win/Loss Ratio", win_loss_ratio, TypeDecimal, 4))
+        .addCardData(card("Profit Factor", profit_factor, TypeDecimal, 4))
+        .build();
+}
+
+} // namespace epoch_tearsheet
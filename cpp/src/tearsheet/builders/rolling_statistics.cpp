@@ -0,0 +1,349 @@
+#include "epoch_dashboard/tearsheet/rolling_statistics.h"
+#include "epoch_dashboard/tearsheet/dataframe_converter.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
+#include <algorithm>
+#include <cmath>
+#include <deque>
+#include <limits>
+#include <map>
+#include <stdexcept>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+constexpr double kNaN = std::numeric_limits<double>::quiet_NaN();
+
+bool needsDispersion(RollingStat stat) {
+    return stat == RollingStat::StdDev || stat == RollingStat::Volatility || stat == RollingStat::Sharpe ||
+           stat == RollingStat::Beta;
+}
+
+/**
+ * State of one window length. Moments slide with Welford add/remove updates; the
+ * co-moment against the benchmark is only kept when a Beta line needs it. Every
+ * `window` steps the moments are rebuilt from the rows in the window, which bounds the
+ * drift of repeated removals at an amortized extra O(1) per step. Runs of equal values
+ * are counted so a flat window reports exactly zero dispersion instead of round-off.
+ */
+class WindowKernel {
+public:
+    WindowKernel(size_t window, bool extremes, bool beta) : window_(window), extremes_(extremes), beta_(beta) {}
+
+    void step(const double* y, const double* benchmark, size_t i) {
+        add(y[i], beta_ ? benchmark[i] : 0.0);
+        if (i >= window_) {
+            remove(y[i - window_], beta_ ? benchmark[i - window_] : 0.0);
+        }
+        if (full() && (i + 1) % window_ == 0) {
+            rebuild(y, benchmark, i);
+        }
+        flat_y_ = i > 0 && y[i] == y[i - 1] ? flat_y_ + 1 : 1;
+        if (beta_) {
+            flat_b_ = i > 0 && benchmark[i] == benchmark[i - 1] ? flat_b_ + 1 : 1;
+        }
+
+        if (extremes_) {
+            while (!min_rows_.empty() && y[min_rows_.back()] >= y[i]) {
+                min_rows_.pop_back();
+            }
+            min_rows_.push_back(i);
+            while (!max_rows_.empty() && y[max_rows_.back()] <= y[i]) {
+                max_rows_.pop_back();
+            }
+            max_rows_.push_back(i);
+            if (min_rows_.front() + window_ <= i) {
+                min_rows_.pop_front();
+            }
+            if (max_rows_.front() + window_ <= i) {
+                max_rows_.pop_front();
+            }
+        }
+    }
+
+    bool full() const { return count_ == window_; }
+
+    double value(RollingStat stat, const double* y, const RollingOptions& options) const {
+        const double n = static_cast<double>(count_);
+        const double stddev = flat_y_ >= window_ ? 0.0 : std::sqrt(std::max(m2_y_, 0.0) / (n - 1.0));
+        switch (stat) {
+            case RollingStat::Mean:
+                return mean_y_;
+            case RollingStat::StdDev:
+                return stddev;
+            case RollingStat::Volatility:
+                return stddev * std::sqrt(options.periods_per_year);
+            case RollingStat::Sharpe: {
+                const double excess = mean_y_ - options.risk_free_rate / options.periods_per_year;
+                return stddev > 0.0 ? excess / stddev * std::sqrt(options.periods_per_year) : kNaN;
+            }
+            case RollingStat::Min:
+                return y[min_rows_.front()];
+            case RollingStat::Max:
+                return y[max_rows_.front()];
+            case RollingStat::Beta:
+                return flat_b_ < window_ && m2_b_ > 0.0 ? c_yb_ / m2_b_ : kNaN;
+        }
+        return kNaN;
+    }
+
+private:
+    void add(double y, double b) {
+        ++count_;
+        const double n = static_cast<double>(count_);
+        const double dy = y - mean_y_;
+        mean_y_ += dy / n;
+        m2_y_ += dy * (y - mean_y_);
+        if (beta_) {
+            const double db = b - mean_b_;
+            mean_b_ += db / n;
+            m2_b_ += db * (b - mean_b_);
+            c_yb_ += dy * (b - mean_b_);
+        }
+    }
+
+    // Exact inverse of add(): undo the sample using the means from before it was added
+    void remove(double y, double b) {
+        --count_;
+        const double n = static_cast<double>(count_);
+        const double mean_y = mean_y_ - (y - mean_y_) / n;
+        m2_y_ -= (y - mean_y) * (y - mean_y_);
+        if (beta_) {
+            const double mean_b = mean_b_ - (b - mean_b_) / n;
+            m2_b_ -= (b - mean_b) * (b - mean_b_);
+            c_yb_ -= (y - mean_y) * (b - mean_b_);
+            mean_b_ = mean_b;
+        }
+        mean_y_ = mean_y;
+    }
+
+    void rebuild(const double* y, const double* benchmark, size_t last) {
+        count_ = 0;
+        mean_y_ = m2_y_ = mean_b_ = m2_b_ = c_yb_ = 0.0;
+        for (size_t j = last + 1 - window_; j <= last; ++j) {
+            add(y[j], beta_ ? benchmark[j] : 0.0);
+        }
+    }
+
+    size_t window_;
+    bool extremes_;
+    bool beta_;
+    size_t count_ = 0;
+    double mean_y_ = 0.0;
+    double m2_y_ = 0.0;
+    double mean_b_ = 0.0;
+    double m2_b_ = 0.0;
+    double c_yb_ = 0.0;
+    size_t flat_y_ = 0;  // Length of the run of equal values ending at the current row
+    size_t flat_b_ = 0;
+    std::deque<size_t> min_rows_;  // Rows with increasing values, front is the minimum
+    std::deque<size_t> max_rows_;  // Rows with decreasing values, front is the maximum
+};
+
+std::shared_ptr<arrow::Array> indexArray(const epoch_frame::DataFrame& df) {
+    switch (df.index()->array()->type()->id()) {
+        case arrow::Type::TIMESTAMP:
+            return df.index()->array().to_timestamp_view();
+        case arrow::Type::INT64:
+            return df.index()->array().to_view<int64_t>();
+        case arrow::Type::UINT64:
+            return df.index()->array().to_view<uint64_t>();
+        default:
+            throw std::runtime_error("Unsupported index type for RollingStatistics. Supported types: timestamp, int64_t, uint64_t");
+    }
+}
+
+std::vector<int64_t> readIndex(const epoch_frame::DataFrame& df) {
+    auto index = indexArray(df);
+    if (index->null_count() > 0) {
+        throw std::runtime_error("RollingStatistics: index must not contain nulls");
+    }
+    std::vector<int64_t> x(static_cast<size_t>(index->length()));
+    const auto& data = *index->data();
+    switch (index->type_id()) {
+        case arrow::Type::TIMESTAMP: {
+            const auto unit = std::static_pointer_cast<arrow::TimestampType>(index->type())->unit();
+            const auto* values = data.GetValues<int64_t>(1);
+            for (size_t i = 0; i < x.size(); ++i) {
+                x[i] = DataFrameFactory::toMilliseconds(values[i], unit);
+            }
+            break;
+        }
+        case arrow::Type::INT64:
+            std::copy_n(data.GetValues<int64_t>(1), x.size(), x.begin());
+            break;
+        default:
+            std::copy_n(data.GetValues<uint64_t>(1), x.size(), x.begin());
+            break;
+    }
+    return x;
+}
+
+// Column values with nulls as NaN
+std::vector<double> readColumn(const epoch_frame::DataFrame& df, const std::string& column) {
+    auto values = df.table()->GetColumnByName(column);
+    if (!values) {
+        throw std::runtime_error("RollingStatistics: missing column '" + column + "'");
+    }
+    std::vector<double> y;
+    y.reserve(static_cast<size_t>(values->length()));
+    for (const auto& chunk : values->chunks()) {
+        auto append = [&](const auto* data) {
+            for (int64_t i = 0; i < chunk->length(); ++i) {
+                y.push_back(chunk->IsValid(i) ? static_cast<double>(data[i]) : kNaN);
+            }
+        };
+        switch (chunk->type_id()) {
+            case arrow::Type::DOUBLE:
+                append(chunk->data()->GetValues<double>(1));
+                break;
+            case arrow::Type::FLOAT:
+                append(chunk->data()->GetValues<float>(1));
+                break;
+            default:
+                throw std::runtime_error("RollingStatistics: column '" + column + "' must be float or double, got " +
+                                         chunk->type()->ToString());
+        }
+    }
+    return y;
+}
+
+} // namespace
+
+RollingStatistics::RollingStatistics(std::vector<int64_t> x,
+                                     std::vector<double> y,
+                                     std::optional<std::vector<double>> benchmark)
+    : x_(std::move(x)), y_(std::move(y)), benchmark_(std::move(benchmark)) {
+    if (x_.size() != y_.size() || (benchmark_ && benchmark_->size() != y_.size())) {
+        throw std::runtime_error("RollingStatistics: x, y and benchmark must have the same length");
+    }
+    auto finite = [](double v) { return std::isfinite(v); };
+    if (!std::all_of(y_.begin(), y_.end(), finite) ||
+        (benchmark_ && !std::all_of(benchmark_->begin(), benchmark_->end(), finite))) {
+        throw std::runtime_error("RollingStatistics: values must be finite");
+    }
+}
+
+RollingStatistics RollingStatistics::fromDataFrame(const epoch_frame::DataFrame& df,
+                                                   const std::string& column,
+                                                   const std::optional<std::string>& benchmark_column) {
+    auto x = readIndex(df);
+    auto y = readColumn(df, column);
+    std::optional<std::vector<double>> benchmark;
+    if (benchmark_column) {
+        benchmark = readColumn(df, *benchmark_column);
+    }
+
+    size_t kept = 0;
+    for (size_t i = 0; i < y.size(); ++i) {
+        if (std::isnan(y[i]) || (benchmark && std::isnan((*benchmark)[i]))) {
+            continue;
+        }
+        x[kept] = x[i];
+        y[kept] = y[i];
+        if (benchmark) {
+            (*benchmark)[kept] = (*benchmark)[i];
+        }
+        ++kept;
+    }
+    x.resize(kept);
+    y.resize(kept);
+    if (benchmark) {
+        benchmark->resize(kept);
+    }
+    return RollingStatistics(std::move(x), std::move(y), std::move(benchmark));
+}
+
+std::string RollingStatistics::defaultName(RollingStat stat, size_t window) {
+    const char* label = "";
+    switch (stat) {
+        case RollingStat::Mean: label = "Mean"; break;
+        case RollingStat::StdDev: label = "Std Dev"; break;
+        case RollingStat::Volatility: label = "Volatility"; break;
+        case RollingStat::Sharpe: label = "Sharpe"; break;
+        case RollingStat::Min: label = "Min"; break;
+        case RollingStat::Max: label = "Max"; break;
+        case RollingStat::Beta: label = "Beta"; break;
+    }
+    return "Rolling " + std::string(label) + " (" + std::to_string(window) + ")";
+}
+
+std::vector<ColumnarLine> RollingStatistics::compute(const std::vector<RollingRequest>& requests,
+                                                     const RollingOptions& options) const {
+    struct Kernel {
+        size_t window;
+        bool extremes = false;
+        bool beta = false;
+        std::vector<size_t> outputs;  // Request indices
+    };
+
+    if (!(options.periods_per_year > 0.0)) {
+        throw std::runtime_error("RollingStatistics: periods_per_year must be positive");
+    }
+
+    // Group requests by window so each window length slides once
+    std::map<size_t, Kernel> by_window;
+    for (size_t r = 0; r < requests.size(); ++r) {
+        const auto& request = requests[r];
+        if (request.window == 0) {
+            throw std::runtime_error("RollingStatistics: window must be positive");
+        }
+        if (needsDispersion(request.stat) && request.window < 2) {
+            throw std::runtime_error("RollingStatistics: " + defaultName(request.stat, request.window) +
+                                     " needs a window of at least 2");
+        }
+        if (request.stat == RollingStat::Beta && !benchmark_) {
+            throw std::runtime_error("RollingStatistics: Beta needs a benchmark series");
+        }
+        auto& kernel = by_window.try_emplace(request.window, Kernel{request.window}).first->second;
+        kernel.extremes |= request.stat == RollingStat::Min || request.stat == RollingStat::Max;
+        kernel.beta |= request.stat == RollingStat::Beta;
+        kernel.outputs.push_back(r);
+    }
+
+    ScopedSpan span("RollingStatistics", SpanPhase::Conversion);
+    span.setRowsIn(static_cast<int64_t>(x_.size()));
+
+    std::vector<ColumnarLine> lines(requests.size());
+    for (size_t r = 0; r < requests.size(); ++r) {
+        lines[r].name = requests[r].name.empty() ? defaultName(requests[r].stat, requests[r].window)
+                                                 : requests[r].name;
+        const size_t points = x_.size() >= requests[r].window ? x_.size() - requests[r].window + 1 : 0;
+        lines[r].x.reserve(points);
+        lines[r].y.reserve(points);
+    }
+
+    std::vector<Kernel> kernels;
+    std::vector<WindowKernel> states;
+    for (auto& [window, kernel] : by_window) {
+        states.emplace_back(window, kernel.extremes, kernel.beta);
+        kernels.push_back(std::move(kernel));
+    }
+
+    const double* y = y_.data();
+    const double* benchmark = benchmark_ ? benchmark_->data() : nullptr;
+    for (size_t i = 0; i < x_.size(); ++i) {
+        for (size_t k = 0; k < kernels.size(); ++k) {
+            states[k].step(y, benchmark, i);
+            if (!states[k].full()) {
+                continue;
+            }
+            for (const size_t r : kernels[k].outputs) {
+                const double value = states[k].value(requests[r].stat, y, options);
+                if (std::isfinite(value)) {
+                    lines[r].x.push_back(x_[i]);
+                    lines[r].y.push_back(value);
+                }
+            }
+        }
+    }
+
+    for (const auto& line : lines) {
+        span.addPointsOut(static_cast<int64_t>(line.size()));
+    }
+    return lines;
+}
+
+} // namespace epoch_tearsheet
@@ -1,5 +1,6 @@
 #include "epoch_dashboard/tearsheet/scalar_converter.h"
 #include <epoch_frame/scalar.h>
+#include <arrow/scalar.h>
 #include <arrow/type.h>
 #include <arrow/type_traits.h>
 #include <stdexcept>
@@ -35,7 +36,8 @@ epoch_proto::Scalar ScalarFactory::create(const epoch_frame::Scalar& scalar) {
             break;
         case arrow::Type::STRING:
         case arrow::Type::LARGE_STRING:
-            result.set_string_value(scalar.repr());
+            // Straight from the value buffer; repr() would format into a temporary first
+            result.set_string_value(std::static_pointer_cast<arrow::BaseBinaryScalar>(scalar.value())->view());
             break;
         case arrow::Type::TIMESTAMP: {
             auto ts_type = std::static_pointer_cast<arrow::TimestampType>(type);
@@ -107,6 +107,48 @@ epoch_proto::Line SeriesFactory::toLine(const epoch_frame::Series& series,
     return line;
 }
 
+ColumnarLine SeriesFactory::toColumnarLine(const epoch_frame::Series& series,
+                                           const std::string& name,
+                                           const LineStyle& style) {
+    ColumnarLine line;
+    line.name = name.empty() ? series.name().value_or("line") : name;
+    line.dash_style = style.dash_style;
+    line.line_width = style.line_width;
+
+    const auto arr = series.contiguous_array().to_view<double>();
+    const auto size = static_cast<int64_t>(series.size());
+    line.x.reserve(static_cast<size_t>(size));
+    line.y.assign(arr->raw_values(), arr->raw_values() + size);
+
+    auto index_array = series.index()->array();
+    switch (index_array->type()->id()) {
+        case arrow::Type::TIMESTAMP: {
+            const auto timestamp_array = index_array.to_timestamp_view();
+            const auto time_unit = std::static_pointer_cast<arrow::TimestampType>(timestamp_array->type())->unit();
+            for (int64_t i = 0; i < size; ++i) {
+                line.x.push_back(DataFrameFactory::toMilliseconds(timestamp_array->Value(i), time_unit));
+            }
+            break;
+        }
+        case arrow::Type::INT64: {
+            const auto int64_view = index_array.to_view<int64_t>();
+            line.x.assign(int64_view->raw_values(), int64_view->raw_values() + size);
+            break;
+        }
+        case arrow::Type::UINT64: {
+            const auto uint64_view = index_array.to_view<uint64_t>();
+            for (int64_t i = 0; i < size; ++i) {
+                line.x.push_back(static_cast<int64_t>(uint64_view->Value(i)));
+            }
+            break;
+        }
+        default:
+            throw std::runtime_error("Index must be either timestamp or numeric (int64/uint64) type for line conversion");
+    }
+
+    return line;
+}
+
 std::vector<epoch_proto::Point> SeriesFactory::toPoints(const epoch_frame::Series& y_series) {
     std::vector<epoch_proto::Point> points;
     uint64_t size = y_series.size();
@@ -0,0 +1,156 @@
+#include "epoch_dashboard/tearsheet/series_pyramid.h"
+#include "epoch_dashboard/tearsheet/dataframe_converter.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <limits>
+#include <stdexcept>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+// NaN never wins, so a bucket only reports NaN when all of its samples are NaN
+bool lessY(double candidate, double current) {
+    return !std::isnan(candidate) && (std::isnan(current) || candidate < current);
+}
+
+bool greaterY(double candidate, double current) {
+    return !std::isnan(candidate) && (std::isnan(current) || candidate > current);
+}
+
+} // namespace
+
+SeriesPyramid::SeriesPyramid(ColumnarLine line) : line_(std::move(line)) {
+    if (line_.x.size() != line_.y.size()) {
+        throw std::runtime_error("SeriesPyramid: x and y lengths differ for line '" + line_.name + "'");
+    }
+    if (line_.size() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("SeriesPyramid: line '" + line_.name + "' has too many samples");
+    }
+    build();
+}
+
+std::vector<SeriesPyramid> SeriesPyramid::fromDataFrame(const epoch_frame::DataFrame& df,
+                                                        const std::vector<std::string>& y_cols) {
+    std::vector<SeriesPyramid> pyramids;
+    pyramids.reserve(y_cols.size());
+    for (auto& line : DataFrameFactory::toColumnarLines(df, y_cols)) {
+        pyramids.emplace_back(std::move(line));
+    }
+    return pyramids;
+}
+
+void SeriesPyramid::build() {
+    ScopedSpan span("SeriesPyramid", SpanPhase::Conversion);
+    span.setTitle(line_.name).setRowsIn(static_cast<int64_t>(line_.size()));
+
+    const size_t n = line_.size();
+    size_t levels = 0;
+    size_t total = 0;
+    while (levels < kMaxLevel && (n >> (levels + 1)) > 0) {
+        ++levels;
+        total += n >> levels;
+    }
+
+    buckets_.resize(total);
+    level_offsets_.assign(1, 0);
+    const auto& y = line_.y;
+
+    // Level 1 from sample pairs, every higher level from pairs of buckets one level down
+    for (size_t level = 1; level <= levels; ++level) {
+        const size_t begin = level_offsets_.back();
+        const size_t count = n >> level;
+        for (size_t j = 0; j < count; ++j) {
+            Bucket bucket;
+            if (level == 1) {
+                const auto a = static_cast<uint32_t>(2 * j);
+                const auto b = a + 1;
+                bucket.min_index = lessY(y[b], y[a]) ? b : a;
+                bucket.max_index = greaterY(y[b], y[a]) ? b : a;
+            } else {
+                const size_t below = level_offsets_[level - 2];
+                const auto& left = buckets_[below + 2 * j];
+                const auto& right = buckets_[below + 2 * j + 1];
+                bucket.min_index = lessY(y[right.min_index], y[left.min_index]) ? right.min_index : left.min_index;
+                bucket.max_index = greaterY(y[right.max_index], y[left.max_index]) ? right.max_index : left.max_index;
+            }
+            buckets_[begin + j] = bucket;
+        }
+        level_offsets_.push_back(begin + count);
+    }
+    span.addPointsOut(static_cast<int64_t>(total));
+}
+
+size_t SeriesPyramid::bucketCount(size_t level) const {
+    if (level == 0) {
+        return size();
+    }
+    if (level > levels()) {
+        return 0;
+    }
+    return level_offsets_[level] - level_offsets_[level - 1];
+}
+
+size_t SeriesPyramid::levelFor(size_t samples, size_t pixel_width) {
+    if (pixel_width == 0 || samples <= 4 * pixel_width) {
+        return 0;
+    }
+    // Largest 2^k with samples / 2^k >= pixel_width
+    return std::min<size_t>(std::bit_width(samples / pixel_width) - 1, kMaxLevel);
+}
+
+void SeriesPyramid::appendBlock(epoch_proto::Line& line, size_t level, size_t position) const {
+    auto append = [&](size_t i) {
+        auto* point = line.add_data();
+        point->set_x(line_.x[i]);
+        point->set_y(line_.y[i]);
+    };
+
+    if (level == 0) {
+        append(position);
+        return;
+    }
+
+    const auto& bucket = buckets_[level_offsets_[level - 1] + (position >> level)];
+    std::array<size_t, 4> indexes{position, bucket.min_index, bucket.max_index, position + (size_t{1} << level) - 1};
+    std::sort(indexes.begin(), indexes.end());
+    const auto last = std::unique(indexes.begin(), indexes.end());
+    for (auto it = indexes.begin(); it != last; ++it) {
+        append(*it);
+    }
+}
+
+epoch_proto::Line SeriesPyramid::query(int64_t from_ms, int64_t to_ms, size_t pixel_width) const {
+    if (pixel_width == 0) {
+        throw std::runtime_error("SeriesPyramid: pixel_width must be positive");
+    }
+    if (from_ms > to_ms) {
+        throw std::runtime_error("SeriesPyramid: from_ms must not be greater than to_ms");
+    }
+
+    // Empty line carrying only the name and style
+    auto line = ColumnarLineCodec::toLegacy(ColumnarLine{line_.name, line_.dash_style, line_.line_width, {}, {}});
+
+    const auto& x = line_.x;
+    const auto lo = static_cast<size_t>(std::lower_bound(x.begin(), x.end(), from_ms) - x.begin());
+    const auto hi = static_cast<size_t>(std::upper_bound(x.begin() + lo, x.end(), to_ms) - x.begin());
+    const size_t level = std::min(levelFor(hi - lo, pixel_width), levels());
+
+    // Cover [lo, hi) with aligned blocks no coarser than `level`; only the unaligned
+    // edges fall back to finer levels, adding at most 2 * level blocks
+    size_t position = lo;
+    while (position < hi) {
+        size_t k = level;
+        while (k > 0 && ((position & ((size_t{1} << k) - 1)) != 0 || position + (size_t{1} << k) > hi)) {
+            --k;
+        }
+        appendBlock(line, k, position);
+        position += size_t{1} << k;
+    }
+    return line;
+}
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,74 @@
+#include "epoch_dashboard/tearsheet/streaming_writer.h"
+#include <stdexcept>
+
+#include <google/protobuf/wire_format_lite.h>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+using google::protobuf::io::CodedOutputStream;
+using google::protobuf::internal::WireFormatLite;
+
+constexpr int kCategoriesField = 1;  // FullTearSheet.categories
+constexpr int kMapKeyField = 1;
+constexpr int kMapValueField = 2;
+
+size_t lengthDelimitedSize(int field, size_t body) {
+    return WireFormatLite::TagSize(field, WireFormatLite::TYPE_BYTES) + CodedOutputStream::VarintSize64(body) + body;
+}
+
+void writeLengthPrefix(CodedOutputStream& out, int field, size_t body) {
+    out.WriteTag(WireFormatLite::MakeTag(field, WireFormatLite::WIRETYPE_LENGTH_DELIMITED));
+    out.WriteVarint64(body);
+}
+
+} // namespace
+
+StreamingTearSheetWriter::StreamingTearSheetWriter(google::protobuf::io::ZeroCopyOutputStream* output)
+    : out_(std::make_unique<CodedOutputStream>(output)) {}
+
+StreamingTearSheetWriter::~StreamingTearSheetWriter() = default;
+
+void StreamingTearSheetWriter::writeCategory(const std::string& category, const epoch_proto::TearSheet& tearsheet) {
+    if (!out_) {
+        throw std::runtime_error("StreamingTearSheetWriter: writer is already finished");
+    }
+    if (!written_.insert(category).second) {
+        throw std::runtime_error("StreamingTearSheetWriter: duplicate category '" + category + "'");
+    }
+
+    // ByteSizeLong caches sizes for SerializeWithCachedSizes, so the category is walked once for sizing
+    const size_t value_size = tearsheet.ByteSizeLong();
+    const size_t entry_size = lengthDelimitedSize(kMapKeyField, category.size()) +
+                              lengthDelimitedSize(kMapValueField, value_size);
+
+    writeLengthPrefix(*out_, kCategoriesField, entry_size);
+    writeLengthPrefix(*out_, kMapKeyField, category.size());
+    out_->WriteString(category);
+    writeLengthPrefix(*out_, kMapValueField, value_size);
+    tearsheet.SerializeWithCachedSizes(out_.get());
+
+    if (out_->HadError()) {
+        throw std::runtime_error("StreamingTearSheetWriter: failed to write category '" + category + "'");
+    }
+    bytes_written_ += lengthDelimitedSize(kCategoriesField, entry_size);
+}
+
+uint64_t StreamingTearSheetWriter::finish() {
+    if (out_) {
+        out_->Trim();
+        const bool failed = out_->HadError();
+        out_.reset();
+        if (failed) {
+            throw std::runtime_error("StreamingTearSheetWriter: failed to flush output stream");
+        }
+    }
+    return bytes_written_;
+}
+
+uint64_t StreamingTearSheetWriter::bytesWritten() const {
+    return bytes_written_;
+}
+
+} // namespace epoch_tearsheet
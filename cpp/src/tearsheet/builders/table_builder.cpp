@@ -1,5 +1,8 @@
 #include "epoch_dashboard/tearsheet/table_builder.h"
 #include "epoch_dashboard/tearsheet/dataframe_converter.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include "epoch_dashboard/tearsheet/scalar_converter.h"
+#include <epoch_frame/dataframe.h>
 
 namespace epoch_tearsheet {
 
@@ -50,8 +53,33 @@ TableBuilder& TableBuilder::addRows(const std::vector<epoch_proto::TableRow>& ro
     return *this;
 }
 
+TableBuilder& TableBuilder::setInstrumentationSink(InstrumentationSinkPtr sink) {
+    instrumentation_sink_ = std::move(sink);
+    return *this;
+}
+
+TableBuilder& TableBuilder::setArrowSidecar(ArrowSidecarPtr sidecar, std::string id, double max_distinct_ratio) {
+    sidecar_ = std::move(sidecar);
+    sidecar_id_ = std::move(id);
+    max_distinct_ratio_ = max_distinct_ratio;
+    return *this;
+}
+
 TableBuilder& TableBuilder::fromDataFrame(const epoch_frame::DataFrame& df,
                                           const std::vector<std::string>& columns) {
+    ScopedSpan span("TableBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.setTitle(table_.title()).setRowsIn(df.table()->num_rows());
+
+    if (sidecar_) {
+        auto table = ArrowSidecar::makeDictionaryTable(df.table(), columns, max_distinct_ratio_);
+        sidecar_->add(sidecar_id_, table);
+        for (const auto& field : table->schema()->fields()) {
+            addColumn(DataFrameFactory::toColumnDef(df, field->name()));
+        }
+        span.addPointsOut(table->num_rows());
+        return *this;
+    }
+
     if (columns.empty()) {
         addColumns(DataFrameFactory::toColumnDefs(df));
         addRows(DataFrameFactory::toTableRows(df));
@@ -61,11 +89,75 @@ TableBuilder& TableBuilder::fromDataFrame(const epoch_frame::DataFrame& df,
         }
         addRows(DataFrameFactory::toTableRows(df, columns));
     }
+    span.addPointsOut(table_.data().rows_size());
 
     return *this;
 }
 
+TableBuilder& TableBuilder::fromDataFrame(const epoch_frame::DataFrame& df,
+                                          const TableFilter& filter,
+                                          const std::vector<std::string>& columns) {
+    ScopedSpan span("TableBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.setTitle(table_.title()).setRowsIn(df.table()->num_rows());
+
+    if (columns.empty()) {
+        addColumns(DataFrameFactory::toColumnDefs(df));
+    } else {
+        for (const auto& col_name : columns) {
+            addColumn(DataFrameFactory::toColumnDef(df, col_name));
+        }
+    }
+    const auto selection = TableFilterCache::shared().select(filter, df.table());
+    auto* rows = table_.mutable_data()->mutable_rows();
+    rows->Reserve(rows->size() + static_cast<int>(selection->size()));
+    for (const auto row_index : *selection) {
+        *rows->Add() = columns.empty() ? DataFrameFactory::toTableRow(df, row_index)
+                                       : DataFrameFactory::toTableRow(df, row_index, columns);
+    }
+    span.addPointsOut(static_cast<int64_t>(selection->size()));
+
+    return *this;
+}
+
+TableBuilder& TableBuilder::fromPage(const PagedTable& paged, const TablePageQuery& query) {
+    addColumns(paged.columnDefs());
+    addRows(paged.page(query));
+    return *this;
+}
+
+TableBuilder& TableBuilder::fromDrawdownPeriods(const std::vector<DrawdownPeriod>& periods) {
+    constexpr int64_t kDayMs = 24 * 60 * 60 * 1000;
+    addColumn("rank", "Rank", epoch_proto::TypeInteger);
+    addColumn("peak", "Peak", epoch_proto::TypeDateTime);
+    addColumn("trough", "Trough", epoch_proto::TypeDateTime);
+    addColumn("recovery", "Recovery", epoch_proto::TypeDateTime);
+    addColumn("depth", "Depth", epoch_proto::TypePercent);
+    addColumn("duration", "Duration", epoch_proto::TypeDayDuration);
+
+    auto* rows = table_.mutable_data()->mutable_rows();
+    for (size_t i = 0; i < periods.size(); ++i) {
+        const auto& period = periods[i];
+        auto* row = rows->Add();
+        *row->add_values() = ScalarFactory::fromInteger(static_cast<int64_t>(i + 1));
+        *row->add_values() = ScalarFactory::fromTimestamp(std::chrono::milliseconds(period.peak_ms));
+        *row->add_values() = ScalarFactory::fromTimestamp(std::chrono::milliseconds(period.trough_ms));
+        *row->add_values() = period.recovery_ms
+            ? ScalarFactory::fromTimestamp(std::chrono::milliseconds(*period.recovery_ms))
+            : ScalarFactory::null();
+        *row->add_values() = ScalarFactory::fromPercentValue(period.depth * 100.0);
+        *row->add_values() = ScalarFactory::fromDayDuration(
+            static_cast<int32_t>((period.end_ms - period.peak_ms) / kDayMs));
+    }
+    return *this;
+}
+
 epoch_proto::Table TableBuilder::build() const {
+    ScopedSpan span("TableBuilder", SpanPhase::Build, instrumentationSink());
+    span.setTitle(table_.title()).addPointsOut(table_.data().rows_size());
+
+    if (span.active()) {
+        span.setBytesSerialized(static_cast<int64_t>(table_.ByteSizeLong()));
+    }
     return table_;
 }
 
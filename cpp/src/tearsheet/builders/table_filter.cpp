@@ -0,0 +1,289 @@
+#include "epoch_dashboard/tearsheet/table_filter.h"
+#include <arrow/api.h>
+#include <arrow/compute/api.h>
+#include <arrow/compute/expression.h>
+#include <iomanip>
+#include <limits>
+#include <sstream>
+#include <stdexcept>
+
+namespace epoch_tearsheet {
+
+namespace cp = arrow::compute;
+
+namespace {
+
+const char* symbolOf(TableFilter::Op op) {
+    switch (op) {
+        case TableFilter::Op::Equal: return "=";
+        case TableFilter::Op::NotEqual: return "!=";
+        case TableFilter::Op::Less: return "<";
+        case TableFilter::Op::LessEqual: return "<=";
+        case TableFilter::Op::Greater: return ">";
+        case TableFilter::Op::GreaterEqual: return ">=";
+        case TableFilter::Op::In: return "IN";
+        case TableFilter::Op::And: return "AND";
+        case TableFilter::Op::Or: return "OR";
+    }
+    return "?";
+}
+
+const char* functionOf(TableFilter::Op op) {
+    switch (op) {
+        case TableFilter::Op::Equal: return "equal";
+        case TableFilter::Op::NotEqual: return "not_equal";
+        case TableFilter::Op::Less: return "less";
+        case TableFilter::Op::LessEqual: return "less_equal";
+        case TableFilter::Op::Greater: return "greater";
+        case TableFilter::Op::GreaterEqual: return "greater_equal";
+        default:
+            throw std::runtime_error("TableFilter: not a comparison");
+    }
+}
+
+void render(std::ostream& out, const FilterValue& value) {
+    std::visit([&](const auto& v) {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, bool>) {
+            out << (v ? "true" : "false");
+        } else if constexpr (std::is_same_v<T, std::string>) {
+            out << std::quoted(v, '\'');
+        } else if constexpr (std::is_same_v<T, double>) {
+            out << std::setprecision(std::numeric_limits<double>::max_digits10) << v << 'd';
+        } else {
+            out << v;
+        }
+    }, value);
+}
+
+std::shared_ptr<arrow::Scalar> toScalar(const FilterValue& value) {
+    return std::visit([](const auto& v) -> std::shared_ptr<arrow::Scalar> {
+        using T = std::decay_t<decltype(v)>;
+        if constexpr (std::is_same_v<T, bool>) {
+            return std::make_shared<arrow::BooleanScalar>(v);
+        } else if constexpr (std::is_same_v<T, int64_t>) {
+            return std::make_shared<arrow::Int64Scalar>(v);
+        } else if constexpr (std::is_same_v<T, double>) {
+            return std::make_shared<arrow::DoubleScalar>(v);
+        } else {
+            return std::make_shared<arrow::StringScalar>(v);
+        }
+    }, value);
+}
+
+template <typename T>
+T orThrow(arrow::Result<T> result) {
+    if (!result.ok()) {
+        throw std::runtime_error("TableFilter: " + result.status().ToString());
+    }
+    return std::move(result).ValueUnsafe();
+}
+
+void orThrow(const arrow::Status& status) {
+    if (!status.ok()) {
+        throw std::runtime_error("TableFilter: " + status.ToString());
+    }
+}
+
+} // namespace
+
+TableFilter::TableFilter(Op op, std::string column, std::vector<FilterValue> values, std::vector<TableFilter> children)
+    : op_(op), column_(std::move(column)), values_(std::move(values)), children_(std::move(children)) {
+    std::ostringstream key;
+    if (op_ == Op::And || op_ == Op::Or) {
+        key << '(';
+        for (size_t i = 0; i < children_.size(); ++i) {
+            key << (i > 0 ? std::string(" ") + symbolOf(op_) + " " : "") << children_[i].key();
+        }
+        key << ')';
+    } else if (op_ == Op::In) {
+        key << std::quoted(column_, '"') << " IN [";
+        for (size_t i = 0; i < values_.size(); ++i) {
+            key << (i > 0 ? ", " : "");
+            render(key, values_[i]);
+        }
+        key << ']';
+    } else {
+        key << std::quoted(column_, '"') << ' ' << symbolOf(op_) << ' ';
+        render(key, values_.front());
+    }
+    key_ = key.str();
+}
+
+TableFilter TableFilter::equal(std::string column, FilterValue value) {
+    return TableFilter(Op::Equal, std::move(column), {std::move(value)}, {});
+}
+
+TableFilter TableFilter::notEqual(std::string column, FilterValue value) {
+    return TableFilter(Op::NotEqual, std::move(column), {std::move(value)}, {});
+}
+
+TableFilter TableFilter::less(std::string column, FilterValue value) {
+    return TableFilter(Op::Less, std::move(column), {std::move(value)}, {});
+}
+
+TableFilter TableFilter::lessEqual(std::string column, FilterValue value) {
+    return TableFilter(Op::LessEqual, std::move(column), {std::move(value)}, {});
+}
+
+TableFilter TableFilter::greater(std::string column, FilterValue value) {
+    return TableFilter(Op::Greater, std::move(column), {std::move(value)}, {});
+}
+
+TableFilter TableFilter::greaterEqual(std::string column, FilterValue value) {
+    return TableFilter(Op::GreaterEqual, std::move(column), {std::move(value)}, {});
+}
+
+TableFilter TableFilter::isIn(std::string column, std::vector<FilterValue> values) {
+    if (values.empty()) {
+        throw std::runtime_error("TableFilter: IN on '" + column + "' needs at least one value");
+    }
+    for (const auto& value : values) {
+        if (value.index() != values.front().index()) {
+            throw std::runtime_error("TableFilter: IN on '" + column + "' mixes value types");
+        }
+    }
+    return TableFilter(Op::In, std::move(column), std::move(values), {});
+}
+
+TableFilter TableFilter::allOf(std::vector<TableFilter> filters) {
+    if (filters.empty()) {
+        throw std::runtime_error("TableFilter: AND needs at least one filter");
+    }
+    return TableFilter(Op::And, {}, {}, std::move(filters));
+}
+
+TableFilter TableFilter::anyOf(std::vector<TableFilter> filters) {
+    if (filters.empty()) {
+        throw std::runtime_error("TableFilter: OR needs at least one filter");
+    }
+    return TableFilter(Op::Or, {}, {}, std::move(filters));
+}
+
+cp::Expression TableFilter::expression(const arrow::Schema& schema) const {
+    if (op_ == Op::And || op_ == Op::Or) {
+        std::vector<cp::Expression> operands;
+        for (const auto& child : children_) {
+            operands.push_back(child.expression(schema));
+        }
+        return op_ == Op::And ? cp::and_(operands) : cp::or_(operands);
+    }
+
+    auto field = schema.GetFieldByName(column_);
+    if (!field) {
+        throw std::runtime_error("TableFilter: missing column '" + column_ + "'");
+    }
+    if (op_ != Op::In) {
+        return cp::call(functionOf(op_), {cp::field_ref(column_), cp::literal(arrow::Datum(toScalar(values_.front())))});
+    }
+
+    // is_in wants the value set in the column's (decoded) type
+    auto builder = orThrow(arrow::MakeBuilder(toScalar(values_.front())->type));
+    for (const auto& value : values_) {
+        orThrow(builder->AppendScalar(*toScalar(value)));
+    }
+    auto value_set = orThrow(builder->Finish());
+    auto type = field->type();
+    if (type->id() == arrow::Type::DICTIONARY) {
+        type = static_cast<const arrow::DictionaryType&>(*type).value_type();
+    }
+    if (!value_set->type()->Equals(*type)) {
+        value_set = orThrow(cp::Cast(*value_set, type));
+    }
+    return cp::call("is_in", {cp::field_ref(column_)}, cp::SetLookupOptions(value_set));
+}
+
+std::vector<uint32_t> TableFilter::select(const std::shared_ptr<arrow::Table>& table) const {
+    if (table->num_rows() > std::numeric_limits<uint32_t>::max()) {
+        throw std::runtime_error("TableFilter: table has more than 2^32 - 1 rows");
+    }
+    const auto& schema = *table->schema();
+    auto bound = orThrow(expression(schema).Bind(schema));
+
+    std::vector<uint32_t> rows;
+    arrow::TableBatchReader reader(*table);
+    std::shared_ptr<arrow::RecordBatch> batch;
+    uint32_t offset = 0;
+    while (true) {
+        orThrow(reader.ReadNext(&batch));
+        if (!batch) {
+            break;
+        }
+        auto mask = orThrow(cp::ExecuteScalarExpression(bound, schema, arrow::Datum(batch)));
+        const auto length = static_cast<uint32_t>(batch->num_rows());
+        if (mask.is_scalar()) {
+            const auto& scalar = static_cast<const arrow::BooleanScalar&>(*mask.scalar());
+            if (scalar.is_valid && scalar.value) {
+                for (uint32_t i = 0; i < length; ++i) {
+                    rows.push_back(offset + i);
+                }
+            }
+        } else {
+            const arrow::BooleanArray matches(mask.array());
+            for (uint32_t i = 0; i < length; ++i) {
+                if (matches.IsValid(i) && matches.Value(i)) {
+                    rows.push_back(offset + i);
+                }
+            }
+        }
+        offset += length;
+    }
+    return rows;
+}
+
+TableFilterCache::TableFilterCache(size_t capacity) : capacity_(capacity) {}
+
+std::shared_ptr<const std::vector<uint32_t>> TableFilterCache::select(const TableFilter& filter,
+                                                                      const std::shared_ptr<arrow::Table>& table) {
+    std::ostringstream key;
+    key << static_cast<const void*>(table.get()) << '|' << filter.key();
+    {
+        std::lock_guard lock(mutex_);
+        if (auto it = lookup_.find(key.str()); it != lookup_.end()) {
+            if (it->second->table.lock() == table) {
+                entries_.splice(entries_.begin(), entries_, it->second);
+                ++hits_;
+                return it->second->rows;
+            }
+            entries_.erase(it->second);
+            lookup_.erase(it);
+        }
+        ++misses_;
+    }
+
+    // Evaluate unlocked; a concurrent miss on the same key just computes it twice
+    auto rows = std::make_shared<const std::vector<uint32_t>>(filter.select(table));
+
+    std::lock_guard lock(mutex_);
+    if (!lookup_.contains(key.str()) && capacity_ > 0) {
+        entries_.push_front(Entry{key.str(), table, rows});
+        lookup_.emplace(entries_.front().key, entries_.begin());
+        while (entries_.size() > capacity_) {
+            lookup_.erase(entries_.back().key);
+            entries_.pop_back();
+        }
+    }
+    return rows;
+}
+
+size_t TableFilterCache::size() const {
+    std::lock_guard lock(mutex_);
+    return entries_.size();
+}
+
+uint64_t TableFilterCache::hits() const {
+    std::lock_guard lock(mutex_);
+    return hits_;
+}
+
+uint64_t TableFilterCache::misses() const {
+    std::lock_guard lock(mutex_);
+    return misses_;
+}
+
+TableFilterCache& TableFilterCache::shared() {
+    static TableFilterCache cache;
+    return cache;
+}
+
+} // namespace epoch_tearsheet
@@ -1,4 +1,9 @@
 #include "epoch_dashboard/tearsheet/tearsheet_builder.h"
+#include <algorithm>
+#include <optional>
+#include <stdexcept>
+
+#include <google/protobuf/io/zero_copy_stream_impl.h>
 
 namespace epoch_tearsheet {
 
@@ -22,7 +27,21 @@ DashboardBuilder& DashboardBuilder::addTable(const epoch_proto::Table& table) {
     return *this;
 }
 
+DashboardBuilder& DashboardBuilder::setInstrumentationSink(InstrumentationSinkPtr sink) {
+    instrumentation_sink_ = std::move(sink);
+    return *this;
+}
+
 epoch_proto::TearSheet DashboardBuilder::build() const {
+    std::optional<InstrumentationScope> scope;
+    if (instrumentation_sink_) {
+        scope.emplace(instrumentation_sink_);
+    }
+
+    ScopedSpan span("DashboardBuilder", SpanPhase::Build);
+    span.setTitle(category_)
+        .addPointsOut(static_cast<int64_t>(cards_.size() + charts_.size() + tables_.size()));
+
     epoch_proto::TearSheet tearsheet;
 
     if (!cards_.empty()) {
@@ -46,29 +65,189 @@ epoch_proto::TearSheet DashboardBuilder::build() const {
         }
     }
 
+    if (span.active()) {
+        span.setBytesSerialized(static_cast<int64_t>(tearsheet.ByteSizeLong()));
+    }
     return tearsheet;
 }
 
 FullDashboardBuilder& FullDashboardBuilder::addCategory(const std::string& category,
                                                          const epoch_proto::TearSheet& dashboard) {
+    lazy_categories_.erase(category);
     categories_[category] = dashboard;
     return *this;
 }
 
 FullDashboardBuilder& FullDashboardBuilder::addCategoryBuilder(const std::string& category,
                                                                 const DashboardBuilder& builder) {
+    lazy_categories_.erase(category);
     categories_[category] = builder.build();
     return *this;
 }
 
+FullDashboardBuilder& FullDashboardBuilder::addCategoryFactory(const std::string& category,
+                                                                CategoryFactory factory) {
+    if (!factory) {
+        throw std::runtime_error("FullDashboardBuilder: category factory for '" + category + "' is empty");
+    }
+    categories_.erase(category);
+    auto lazy = std::make_shared<LazyCategory>();
+    lazy->factory = std::move(factory);
+    lazy_categories_[category] = std::move(lazy);
+    return *this;
+}
+
+std::vector<std::string> FullDashboardBuilder::categoryNames() const {
+    std::vector<std::string> names;
+    names.reserve(categories_.size() + lazy_categories_.size());
+    for (const auto& entry : categories_) {
+        names.push_back(entry.first);
+    }
+    for (const auto& entry : lazy_categories_) {
+        names.push_back(entry.first);
+    }
+    // Both maps are sorted and never share a key
+    std::inplace_merge(names.begin(), names.begin() + static_cast<std::ptrdiff_t>(categories_.size()), names.end());
+    return names;
+}
+
+bool FullDashboardBuilder::hasCategory(const std::string& category) const {
+    return categories_.contains(category) || lazy_categories_.contains(category);
+}
+
+epoch_proto::TearSheet FullDashboardBuilder::buildCategory(const std::string& category) const {
+    if (auto it = categories_.find(category); it != categories_.end()) {
+        return it->second;
+    }
+    if (auto it = lazy_categories_.find(category); it != lazy_categories_.end()) {
+        return *it->second->resolve();
+    }
+    throw std::runtime_error("FullDashboardBuilder: unknown category '" + category + "'");
+}
+
+std::shared_ptr<const epoch_proto::TearSheet> FullDashboardBuilder::LazyCategory::resolve() {
+    std::lock_guard lock(mutex);
+    if (!built) {
+        built = std::make_shared<const epoch_proto::TearSheet>(factory().build());
+    }
+    return built;
+}
+
+std::shared_ptr<const epoch_proto::TearSheet> FullDashboardBuilder::LazyCategory::cached() {
+    std::lock_guard lock(mutex);
+    return built;
+}
+
+void FullDashboardBuilder::forEachCategory(const CategoryVisitor& visit, bool memoize) const {
+    for (const auto& name : categoryNames()) {
+        if (auto it = categories_.find(name); it != categories_.end()) {
+            visit(name, it->second);
+            continue;
+        }
+        auto& lazy = *lazy_categories_.at(name);
+        if (auto tearsheet = memoize ? lazy.resolve() : lazy.cached()) {
+            visit(name, *tearsheet);
+        } else {
+            visit(name, lazy.factory().build());
+        }
+    }
+}
+
+FullDashboardBuilder& FullDashboardBuilder::setPayloadBudget(const PayloadBudget& budget) {
+    budget_ = budget;
+    return *this;
+}
+
+size_t FullDashboardBuilder::estimatePayloadBytes(bool build_lazy) const {
+    if (build_lazy) {
+        size_t bytes = 0;
+        forEachCategory([&](const std::string& category, const epoch_proto::TearSheet& tearsheet) {
+            bytes += PayloadEstimator::estimateCategory(category, tearsheet);
+        }, true);
+        return bytes;
+    }
+
+    size_t bytes = 0;
+    for (const auto& [category, tearsheet] : categories_) {
+        bytes += PayloadEstimator::estimateCategory(category, tearsheet);
+    }
+    for (const auto& [category, lazy] : lazy_categories_) {
+        if (auto tearsheet = lazy->cached()) {
+            bytes += PayloadEstimator::estimateCategory(category, *tearsheet);
+        }
+    }
+    return bytes;
+}
+
 epoch_proto::FullTearSheet FullDashboardBuilder::build() const {
+    BudgetReport report;
+    return build(report);
+}
+
+epoch_proto::FullTearSheet FullDashboardBuilder::build(BudgetReport& report) const {
     epoch_proto::FullTearSheet full_tearsheet;
 
-    for (const auto& [category, tearsheet] : categories_) {
-        (*full_tearsheet.mutable_categories())[category] = tearsheet;
+    // Without a budget nothing is degraded, so the report stays empty rather than paying for an estimate
+    if (!budget_) {
+        forEachCategory([&](const std::string& category, const epoch_proto::TearSheet& tearsheet) {
+            (*full_tearsheet.mutable_categories())[category] = tearsheet;
+        }, true);
+        report = BudgetReport{};
+        return full_tearsheet;
     }
 
+    // Each category's widgets are capped as it is copied; only the total budget needs the whole sheet.
+    // std::map keeps the copies at stable addresses for the session.
+    std::map<std::string, epoch_proto::TearSheet> copies;
+    PayloadBudgetSession session(*budget_);
+    forEachCategory([&](const std::string& category, const epoch_proto::TearSheet& tearsheet) {
+        session.addCategory(category, copies.emplace(category, tearsheet).first->second);
+    }, true);
+    report = session.finish();
+
+    for (auto& [category, tearsheet] : copies) {
+        (*full_tearsheet.mutable_categories())[category] = std::move(tearsheet);
+    }
     return full_tearsheet;
 }
 
+uint64_t FullDashboardBuilder::writeTo(google::protobuf::io::ZeroCopyOutputStream* output) const {
+    StreamingTearSheetWriter writer(output);
+    if (budget_) {
+        const auto full_tearsheet = build();
+        // Same category order as the unbudgeted path
+        for (const auto& category : categoryNames()) {
+            writer.writeCategory(category, full_tearsheet.categories().at(category));
+        }
+    } else {
+        // Lazy categories are written and dropped rather than memoized, keeping one in memory
+        forEachCategory([&](const std::string& category, const epoch_proto::TearSheet& tearsheet) {
+            writer.writeCategory(category, tearsheet);
+        }, false);
+    }
+    return writer.finish();
+}
+
+uint64_t FullDashboardBuilder::writeTo(std::ostream& out) const {
+    uint64_t bytes = 0;
+    {
+        google::protobuf::io::OstreamOutputStream stream(&out);
+        bytes = writeTo(&stream);
+    }
+    if (!out) {
+        throw std::runtime_error("FullDashboardBuilder: failed to write to output stream");
+    }
+    return bytes;
+}
+
+uint64_t FullDashboardBuilder::writeToFileDescriptor(int fd) const {
+    google::protobuf::io::FileOutputStream stream(fd);
+    const uint64_t bytes = writeTo(&stream);
+    if (!stream.Flush()) {
+        throw std::runtime_error("FullDashboardBuilder: failed to write to file descriptor, errno " +
+                                 std::to_string(stream.GetErrno()));
+    }
+    return bytes;
+}
+
 } // namespace epoch_tearsheet
\ No newline at end of file
@@ -0,0 +1,335 @@
+#include "epoch_dashboard/tearsheet/tearsheet_plan.h"
+#include "epoch_dashboard/tearsheet/area_chart_builder.h"
+#include "epoch_dashboard/tearsheet/bar_chart_builder.h"
+#include "epoch_dashboard/tearsheet/heatmap_chart_builder.h"
+#include "epoch_dashboard/tearsheet/histogram_chart_builder.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include "epoch_dashboard/tearsheet/pie_chart_builder.h"
+#include "epoch_dashboard/tearsheet/table_builder.h"
+#include <epoch_frame/dataframe.h>
+#include <tbb/parallel_for.h>
+#include <algorithm>
+#include <map>
+#include <optional>
+#include <set>
+#include <stdexcept>
+#include <tuple>
+#include <variant>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+using Column = std::shared_ptr<arrow::ChunkedArray>;
+
+// Calls visit(valid, value) for every row of a float64 or int64 column
+template <typename Visit>
+void forEachValue(const arrow::ChunkedArray& column, const std::string& name, Visit visit) {
+    for (const auto& chunk : column.chunks()) {
+        const double* doubles = nullptr;
+        const int64_t* ints = nullptr;
+        switch (chunk->type_id()) {
+            case arrow::Type::DOUBLE:
+                doubles = chunk->data()->GetValues<double>(1);
+                break;
+            case arrow::Type::INT64:
+                ints = chunk->data()->GetValues<int64_t>(1);
+                break;
+            default:
+                throw std::runtime_error("TearsheetPlan: series '" + name + "' must be float64 or int64, got " +
+                                         chunk->type()->ToString());
+        }
+        for (int64_t i = 0; i < chunk->length(); ++i) {
+            visit(chunk->IsValid(i), doubles ? doubles[i] : static_cast<double>(ints[i]));
+        }
+    }
+}
+
+Column derive(DerivedOp op, const arrow::ChunkedArray& input, const std::string& name, uint32_t window) {
+    arrow::DoubleBuilder builder;
+    if (!builder.Reserve(input.length()).ok()) {
+        throw std::runtime_error("TearsheetPlan: failed to allocate series '" + name + "'");
+    }
+    auto emit = [&](bool valid, double value) {
+        if (valid) {
+            builder.UnsafeAppend(value);
+        } else {
+            builder.UnsafeAppendNull();
+        }
+    };
+
+    switch (op) {
+        case DerivedOp::Returns: {
+            std::optional<double> previous;
+            forEachValue(input, name, [&](bool valid, double value) {
+                emit(valid && previous, valid && previous ? value / *previous - 1.0 : 0.0);
+                if (valid) {
+                    previous = value;
+                }
+            });
+            break;
+        }
+        case DerivedOp::CumulativeReturns: {
+            double growth = 1.0;
+            forEachValue(input, name, [&](bool valid, double value) {
+                if (valid) {
+                    growth *= 1.0 + value;
+                }
+                emit(valid, growth - 1.0);
+            });
+            break;
+        }
+        case DerivedOp::Drawdown: {
+            std::optional<double> peak;
+            forEachValue(input, name, [&](bool valid, double value) {
+                if (valid) {
+                    peak = peak ? std::max(*peak, value) : value;
+                }
+                emit(valid && *peak != 0.0, valid && *peak != 0.0 ? value / *peak - 1.0 : 0.0);
+            });
+            break;
+        }
+        case DerivedOp::RollingMean: {
+            // Ring of the last `window` rows; a null anywhere in the window nulls the mean
+            std::vector<double> ring(window, 0.0);
+            std::vector<bool> ring_valid(window, false);
+            double sum = 0.0;
+            uint32_t valid_count = 0;
+            uint64_t row = 0;
+            forEachValue(input, name, [&](bool valid, double value) {
+                const size_t slot = row % window;
+                if (row >= window && ring_valid[slot]) {
+                    sum -= ring[slot];
+                    --valid_count;
+                }
+                ring[slot] = valid ? value : 0.0;
+                ring_valid[slot] = valid;
+                if (valid) {
+                    sum += value;
+                    ++valid_count;
+                }
+                ++row;
+                emit(valid_count == window, sum / window);
+            });
+            break;
+        }
+    }
+
+    std::shared_ptr<arrow::Array> result;
+    if (!builder.Finish(&result).ok()) {
+        throw std::runtime_error("TearsheetPlan: failed to finish series '" + name + "'");
+    }
+    return std::make_shared<arrow::ChunkedArray>(result);
+}
+
+template <typename Builder>
+Builder& describe(Builder& builder, const WidgetSpec& spec, const std::string& category) {
+    builder.setTitle(spec.title).setCategory(category);
+    if (!spec.id.empty()) {
+        builder.setId(spec.id);
+    }
+    if (!spec.x_label.empty()) {
+        builder.setXAxisLabel(spec.x_label);
+    }
+    if (!spec.y_label.empty()) {
+        builder.setYAxisLabel(spec.y_label);
+    }
+    return builder;
+}
+
+using BuiltWidget = std::variant<epoch_proto::Chart, epoch_proto::Table>;
+
+BuiltWidget buildWidget(const WidgetSpec& spec, const std::string& category, const epoch_frame::DataFrame& frame) {
+    switch (spec.kind) {
+        case WidgetKind::Lines: {
+            LinesChartBuilder builder;
+            return describe(builder, spec, category).fromDataFrame(frame, spec.columns).build();
+        }
+        case WidgetKind::Area: {
+            AreaChartBuilder builder;
+            return describe(builder, spec, category).fromDataFrame(frame, spec.columns).build();
+        }
+        case WidgetKind::Bar: {
+            BarChartBuilder builder;
+            return describe(builder, spec, category).fromDataFrame(frame, spec.columns.front()).build();
+        }
+        case WidgetKind::Histogram: {
+            HistogramChartBuilder builder;
+            return describe(builder, spec, category).fromDataFrame(frame, spec.columns.front(), spec.bins).build();
+        }
+        case WidgetKind::Pie: {
+            PieChartBuilder builder;
+            return describe(builder, spec, category)
+                .fromDataFrame(frame, spec.name, spec.value, spec.title, PieSize(100))
+                .build();
+        }
+        case WidgetKind::HeatMap: {
+            HeatMapChartBuilder builder;
+            return describe(builder, spec, category).fromDataFrame(frame, spec.x, spec.y, spec.value).build();
+        }
+        case WidgetKind::Table:
+            return TableBuilder()
+                .setType(epoch_proto::WidgetDataTable)
+                .setCategory(category)
+                .setTitle(spec.title)
+                .fromDataFrame(frame, spec.columns)
+                .build();
+    }
+    throw std::runtime_error("TearsheetPlan: unsupported widget type");
+}
+
+} // namespace
+
+// Resolves names to slots depth first, sharing slots between identical reads and derivations
+class TearsheetPlan::Compiler {
+public:
+    Compiler(const TearsheetSpec& spec, TearsheetPlan& plan) : plan_(plan) {
+        for (const auto& series : spec.series) {
+            if (!series_.emplace(series.name, &series).second) {
+                throw std::runtime_error("TearsheetPlan: duplicate series '" + series.name + "'");
+            }
+        }
+    }
+
+    size_t resolve(const std::string& name) {
+        if (auto it = resolved_.find(name); it != resolved_.end()) {
+            return it->second;
+        }
+
+        auto series = series_.find(name);
+        if (series == series_.end()) {
+            return resolved_[name] = addRead(name);
+        }
+        if (!visiting_.insert(name).second) {
+            throw std::runtime_error("TearsheetPlan: series '" + name + "' depends on itself");
+        }
+        const auto& spec = *series->second;
+        const size_t input = resolve(spec.source);
+        visiting_.erase(name);
+
+        const uint32_t window = spec.op == DerivedOp::RollingMean ? spec.window : 0;
+        if (spec.op == DerivedOp::RollingMean && window == 0) {
+            throw std::runtime_error("TearsheetPlan: series '" + name + "' requires a positive window");
+        }
+        const auto key = std::make_tuple(spec.op, input, window);
+        if (auto it = derivations_.find(key); it != derivations_.end()) {
+            return resolved_[name] = it->second;
+        }
+
+        const size_t slot = plan_.slots_.size();
+        plan_.slots_.push_back(Slot{"", name, spec.op, input, window});
+        depths_.push_back(depths_[input] + 1);
+        if (plan_.stages_.size() < depths_[slot]) {
+            plan_.stages_.resize(depths_[slot]);
+        }
+        plan_.stages_[depths_[slot] - 1].push_back(slot);
+        derivations_.emplace(key, slot);
+        return resolved_[name] = slot;
+    }
+
+private:
+    size_t addRead(const std::string& column) {
+        const size_t slot = plan_.slots_.size();
+        plan_.slots_.push_back(Slot{column, column});
+        plan_.reads_.push_back(slot);
+        depths_.push_back(0);
+        return slot;
+    }
+
+    TearsheetPlan& plan_;
+    std::map<std::string, const DerivedSeriesSpec*> series_;
+    std::map<std::string, size_t> resolved_;
+    std::set<std::string> visiting_;
+    std::map<std::tuple<DerivedOp, size_t, uint32_t>, size_t> derivations_;
+    std::vector<size_t> depths_;    // Parallel to plan_.slots_
+};
+
+TearsheetPlan TearsheetPlan::compile(const TearsheetSpec& spec) {
+    TearsheetPlan plan;
+    Compiler compiler(spec, plan);
+    for (const auto& category : spec.categories) {
+        Category compiled{category.name, {}};
+        for (const auto& widget : category.widgets) {
+            widget.validate();
+            Widget compiled_widget{widget, category.name, {}};
+            for (const auto& input : widget.inputs()) {
+                compiled_widget.slots.push_back(compiler.resolve(input));
+            }
+            compiled.widgets.push_back(plan.widgets_.size());
+            plan.widgets_.push_back(std::move(compiled_widget));
+        }
+        plan.categories_.push_back(std::move(compiled));
+    }
+    return plan;
+}
+
+std::vector<std::string> TearsheetPlan::sourceColumns() const {
+    std::vector<std::string> columns;
+    columns.reserve(reads_.size());
+    for (size_t slot : reads_) {
+        columns.push_back(slots_[slot].column);
+    }
+    return columns;
+}
+
+size_t TearsheetPlan::derivedCount() const {
+    return slots_.size() - reads_.size();
+}
+
+FullDashboardBuilder TearsheetPlan::execute(const epoch_frame::DataFrame& df) const {
+    ScopedSpan span("TearsheetPlan", SpanPhase::Conversion);
+    auto table = df.table();
+    span.setRowsIn(table->num_rows());
+
+    // Column lookups are cheap; only the derived stages and widgets are worth parallelizing
+    std::vector<Column> values(slots_.size());
+    for (size_t slot : reads_) {
+        values[slot] = table->GetColumnByName(slots_[slot].column);
+        if (!values[slot]) {
+            throw std::runtime_error("TearsheetPlan: missing column '" + slots_[slot].column + "'");
+        }
+    }
+    // The current sink is thread-local, so worker threads re-enter it for their spans
+    const auto sink = Instrumentation::currentSink();
+    for (const auto& stage : stages_) {
+        tbb::parallel_for(size_t{0}, stage.size(), [&](size_t i) {
+            InstrumentationScope scope(sink);
+            const auto& slot = slots_[stage[i]];
+            values[stage[i]] = derive(slot.op, *values[slot.input], slots_[slot.input].name, slot.window);
+        });
+    }
+
+    std::vector<BuiltWidget> built(widgets_.size());
+    tbb::parallel_for(size_t{0}, widgets_.size(), [&](size_t i) {
+        InstrumentationScope scope(sink);
+        const auto& widget = widgets_[i];
+        const auto inputs = widget.spec.inputs();
+        arrow::FieldVector fields;
+        arrow::ChunkedArrayVector columns;
+        for (size_t c = 0; c < inputs.size(); ++c) {
+            fields.push_back(arrow::field(inputs[c], values[widget.slots[c]]->type()));
+            columns.push_back(values[widget.slots[c]]);
+        }
+        epoch_frame::DataFrame frame(df.index(), arrow::Table::Make(arrow::schema(fields), columns, table->num_rows()));
+        built[i] = buildWidget(widget.spec, widget.category, frame);
+    });
+
+    FullDashboardBuilder dashboard;
+    for (const auto& category : categories_) {
+        DashboardBuilder builder;
+        builder.setCategory(category.name);
+        for (size_t w : category.widgets) {
+            if (const auto* chart = std::get_if<epoch_proto::Chart>(&built[w])) {
+                builder.addChart(*chart);
+            } else {
+                builder.addTable(std::get<epoch_proto::Table>(built[w]));
+            }
+        }
+        dashboard.addCategoryBuilder(category.name, builder);
+    }
+    span.addPointsOut(static_cast<int64_t>(widgets_.size()));
+    return dashboard;
+}
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,226 @@
+#include "epoch_dashboard/tearsheet/tearsheet_spec.h"
+#include <yaml-cpp/yaml.h>
+#include <algorithm>
+#include <array>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+#include <utility>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+constexpr std::array<std::pair<WidgetKind, std::string_view>, 7> kWidgetKinds{{
+    {WidgetKind::Lines, "lines"},
+    {WidgetKind::Area, "area"},
+    {WidgetKind::Bar, "bar"},
+    {WidgetKind::Histogram, "histogram"},
+    {WidgetKind::Pie, "pie"},
+    {WidgetKind::HeatMap, "heatmap"},
+    {WidgetKind::Table, "table"},
+}};
+
+constexpr std::array<std::pair<DerivedOp, std::string_view>, 4> kDerivedOps{{
+    {DerivedOp::Returns, "returns"},
+    {DerivedOp::CumulativeReturns, "cumulative_returns"},
+    {DerivedOp::Drawdown, "drawdown"},
+    {DerivedOp::RollingMean, "rolling_mean"},
+}};
+
+[[noreturn]] void fail(const YAML::Node& node, const std::string& message) {
+    const auto mark = node.Mark();
+    throw std::runtime_error("TearsheetSpec: " + message + " (line " + std::to_string(mark.line + 1) + ")");
+}
+
+void requireMap(const YAML::Node& node, const std::string& what, std::initializer_list<std::string_view> keys) {
+    if (!node.IsMap()) {
+        fail(node, what + " must be a mapping");
+    }
+    for (const auto& entry : node) {
+        const auto key = entry.first.as<std::string>();
+        if (std::find(keys.begin(), keys.end(), key) == keys.end()) {
+            fail(entry.first, "unknown key '" + key + "' in " + what);
+        }
+    }
+}
+
+template <typename T>
+T read(const YAML::Node& node, const std::string& key, T fallback) {
+    const auto value = node[key];
+    if (!value) {
+        return fallback;
+    }
+    try {
+        return value.as<T>();
+    } catch (const YAML::Exception&) {
+        fail(value, "invalid value for '" + key + "'");
+    }
+}
+
+// Absent keys read as an empty sequence
+YAML::Node readSequence(const YAML::Node& node, const std::string& key) {
+    auto value = node[key];
+    if (value && !value.IsSequence()) {
+        fail(value, "'" + key + "' must be a sequence");
+    }
+    return value;
+}
+
+std::string readRequired(const YAML::Node& node, const std::string& key, const std::string& what) {
+    auto value = read<std::string>(node, key, "");
+    if (value.empty()) {
+        fail(node, what + " requires '" + key + "'");
+    }
+    return value;
+}
+
+template <typename Enum, size_t N>
+Enum parseEnum(const YAML::Node& node, const std::array<std::pair<Enum, std::string_view>, N>& names,
+               const std::string& what) {
+    const auto text = node.as<std::string>();
+    for (const auto& [value, name] : names) {
+        if (name == text) {
+            return value;
+        }
+    }
+    fail(node, "unknown " + what + " '" + text + "'");
+}
+
+DerivedSeriesSpec parseSeries(const YAML::Node& node) {
+    requireMap(node, "series", {"name", "op", "source", "window"});
+    DerivedSeriesSpec series;
+    series.name = readRequired(node, "name", "series");
+    series.source = readRequired(node, "source", "series '" + series.name + "'");
+    if (!node["op"]) {
+        fail(node, "series '" + series.name + "' requires 'op'");
+    }
+    series.op = parseEnum(node["op"], kDerivedOps, "series op");
+    series.window = read<uint32_t>(node, "window", 0);
+    if (series.op == DerivedOp::RollingMean && series.window == 0) {
+        fail(node, "series '" + series.name + "' requires a positive 'window'");
+    }
+    return series;
+}
+
+WidgetSpec parseWidget(const YAML::Node& node) {
+    requireMap(node, "widget",
+               {"type", "id", "title", "x_label", "y_label", "columns", "x", "y", "name", "value", "bins"});
+    if (!node["type"]) {
+        fail(node, "widget requires 'type'");
+    }
+    WidgetSpec widget;
+    widget.kind = parseEnum(node["type"], kWidgetKinds, "widget type");
+    widget.id = read<std::string>(node, "id", "");
+    widget.title = read<std::string>(node, "title", "");
+    widget.x_label = read<std::string>(node, "x_label", "");
+    widget.y_label = read<std::string>(node, "y_label", "");
+    widget.columns = read<std::vector<std::string>>(node, "columns", {});
+    widget.x = read<std::string>(node, "x", "");
+    widget.y = read<std::string>(node, "y", "");
+    widget.name = read<std::string>(node, "name", "");
+    widget.value = read<std::string>(node, "value", "");
+    widget.bins = read<uint32_t>(node, "bins", widget.bins);
+    widget.validate();
+    return widget;
+}
+
+} // namespace
+
+std::vector<std::string> WidgetSpec::inputs() const {
+    switch (kind) {
+        case WidgetKind::Pie:
+            return {name, value};
+        case WidgetKind::HeatMap:
+            return {x, y, value};
+        default:
+            return columns;
+    }
+}
+
+void WidgetSpec::validate() const {
+    const auto label = std::string(toString(kind)) + " widget '" + (title.empty() ? id : title) + "'";
+    switch (kind) {
+        case WidgetKind::Lines:
+        case WidgetKind::Area:
+        case WidgetKind::Table:
+            if (columns.empty()) {
+                throw std::runtime_error("TearsheetSpec: " + label + " requires 'columns'");
+            }
+            break;
+        case WidgetKind::Bar:
+        case WidgetKind::Histogram:
+            if (columns.size() != 1) {
+                throw std::runtime_error("TearsheetSpec: " + label + " requires exactly one column");
+            }
+            break;
+        case WidgetKind::Pie:
+        case WidgetKind::HeatMap:
+            break;
+    }
+    for (const auto& column : inputs()) {
+        if (column.empty()) {
+            throw std::runtime_error("TearsheetSpec: " + label + " requires " +
+                                     (kind == WidgetKind::Pie ? "'name' and 'value'" : "'x', 'y' and 'value'"));
+        }
+    }
+}
+
+TearsheetSpec TearsheetSpec::fromYaml(const std::string& yaml) {
+    YAML::Node root;
+    try {
+        root = YAML::Load(yaml);
+    } catch (const YAML::Exception& e) {
+        throw std::runtime_error(std::string("TearsheetSpec: ") + e.what());
+    }
+    requireMap(root, "tearsheet spec", {"series", "categories"});
+
+    TearsheetSpec spec;
+    for (const auto& series : readSequence(root, "series")) {
+        spec.series.push_back(parseSeries(series));
+    }
+    const auto categories = readSequence(root, "categories");
+    if (!categories || categories.size() == 0) {
+        fail(root, "tearsheet spec requires at least one category");
+    }
+    for (const auto& node : categories) {
+        requireMap(node, "category", {"name", "widgets"});
+        CategorySpec category;
+        category.name = readRequired(node, "name", "category");
+        for (const auto& widget : readSequence(node, "widgets")) {
+            category.widgets.push_back(parseWidget(widget));
+        }
+        spec.categories.push_back(std::move(category));
+    }
+    return spec;
+}
+
+TearsheetSpec TearsheetSpec::fromYamlFile(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) {
+        throw std::runtime_error("TearsheetSpec: failed to open '" + path + "'");
+    }
+    std::ostringstream yaml;
+    yaml << in.rdbuf();
+    return fromYaml(yaml.str());
+}
+
+std::string_view toString(WidgetKind kind) {
+    for (const auto& [value, name] : kWidgetKinds) {
+        if (value == kind) {
+            return name;
+        }
+    }
+    return "unknown";
+}
+
+std::string_view toString(DerivedOp op) {
+    for (const auto& [value, name] : kDerivedOps) {
+        if (value == op) {
+            return name;
+        }
+    }
+    return "unknown";
+}
+
+} // namespace epoch_tearsheet
@@ -0,0 +1,174 @@
+#include "epoch_dashboard/tearsheet/time_window.h"
+#include "epoch_dashboard/tearsheet/arrow_sidecar.h"
+#include <epoch_frame/dataframe.h>
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+namespace epoch_tearsheet {
+
+namespace {
+
+template <typename A, typename B>
+bool lessThan(A a, B b) {
+    if constexpr (std::is_floating_point_v<A> || std::is_floating_point_v<B>) {
+        return static_cast<double>(a) < static_cast<double>(b);
+    } else {
+        return std::cmp_less(a, b);
+    }
+}
+
+int64_t saturatingScale(int64_t ms, int64_t factor, int64_t offset) {
+    constexpr auto kMax = std::numeric_limits<int64_t>::max();
+    constexpr auto kMin = std::numeric_limits<int64_t>::min();
+    if (ms > (kMax - offset) / factor) {
+        return kMax;
+    }
+    if (ms < kMin / factor) {
+        return kMin;
+    }
+    return ms * factor + offset;
+}
+
+/**
+ * Convert a millisecond bound into index units. Lower bounds round up to the first
+ * value at or after the instant, upper bounds round down to the last value that
+ * DataFrameFactory::toMilliseconds still maps to it.
+ */
+int64_t toIndexUnit(int64_t ms, arrow::TimeUnit::type unit, bool upper) {
+    switch (unit) {
+        case arrow::TimeUnit::SECOND: {
+            const int64_t quotient = ms / 1000;
+            const int64_t remainder = ms % 1000;
+            if (remainder == 0) {
+                return quotient;
+            }
+            if (upper) {
+                return remainder < 0 ? quotient - 1 : quotient;
+            }
+            return remainder > 0 ? quotient + 1 : quotient;
+        }
+        case arrow::TimeUnit::MILLI:
+            return ms;
+        case arrow::TimeUnit::MICRO:
+            return saturatingScale(ms, 1000, upper ? 999 : 0);
+        case arrow::TimeUnit::NANO:
+            return saturatingScale(ms, 1000000, upper ? 999999 : 0);
+    }
+    return ms;
+}
+
+template <typename T>
+RowRange locateIn(const T* values, int64_t n, const TimeWindowQuery& query, arrow::TimeUnit::type unit) {
+    auto lowerIndex = [&](int64_t ms) -> int64_t {
+        const int64_t bound = toIndexUnit(ms, unit, false);
+        return std::lower_bound(values, values + n, bound,
+                                [](T value, int64_t b) { return lessThan(value, b); }) - values;
+    };
+    auto upperIndex = [&](int64_t ms) -> int64_t {
+        const int64_t bound = toIndexUnit(ms, unit, true);
+        return std::upper_bound(values, values + n, bound,
+                                [](int64_t b, T value) { return lessThan(b, value); }) - values;
+    };
+
+    const int64_t lo = query.from_ms ? lowerIndex(*query.from_ms) : 0;
+    const int64_t hi = query.to_ms ? upperIndex(*query.to_ms) : n;
+    // Pads beyond the row count are equivalent to the row count and cannot overflow
+    const int64_t pad_front = std::min(query.pad_front, n);
+    const int64_t pad_back = std::min(query.pad_back, n);
+
+    int64_t begin = 0;
+    int64_t end = 0;
+    if (query.pivot_ms) {
+        const int64_t pivot = std::clamp(lowerIndex(*query.pivot_ms), lo, hi);
+        begin = std::max(lo, pivot - pad_front);
+        end = std::min(hi, pivot + pad_back);
+    } else {
+        begin = std::max<int64_t>(0, lo - pad_front);
+        end = std::min(n, hi + pad_back);
+    }
+    end = std::max(begin, end);
+    return {begin, end - begin};
+}
+
+void validate(const TimeWindowQuery& query) {
+    if (query.pad_front < 0 || query.pad_back < 0) {
+        throw std::runtime_error("TimeWindow: pad_front and pad_back must not be negative");
+    }
+    if (query.from_ms && query.to_ms && *query.from_ms > *query.to_ms) {
+        throw std::runtime_error("TimeWindow: from_ms must not be greater than to_ms");
+    }
+}
+
+std::shared_ptr<arrow::Array> indexArray(const epoch_frame::DataFrame& df) {
+    switch (df.index()->array()->type()->id()) {
+        case arrow::Type::TIMESTAMP:
+            return df.index()->array().to_timestamp_view();
+        case arrow::Type::INT64:
+            return df.index()->array().to_view<int64_t>();
+        case arrow::Type::UINT64:
+            return df.index()->array().to_view<uint64_t>();
+        default:
+            throw std::runtime_error("Unsupported index type for TimeWindow. Supported types: timestamp, int64_t, uint64_t");
+    }
+}
+
+} // namespace
+
+RowRange TimeWindow::locate(const std::shared_ptr<arrow::Array>& index, const TimeWindowQuery& query) {
+    validate(query);
+    if (!index) {
+        throw std::runtime_error("TimeWindow: index is required");
+    }
+    if (index->null_count() > 0) {
+        throw std::runtime_error("TimeWindow: index must not contain nulls");
+    }
+
+    const auto& data = *index->data();
+    const int64_t n = index->length();
+    switch (index->type_id()) {
+        case arrow::Type::TIMESTAMP: {
+            const auto unit = std::static_pointer_cast<arrow::TimestampType>(index->type())->unit();
+            return locateIn(data.GetValues<int64_t>(1), n, query, unit);
+        }
+        case arrow::Type::INT64:
+            return locateIn(data.GetValues<int64_t>(1), n, query, arrow::TimeUnit::MILLI);
+        case arrow::Type::UINT64:
+            return locateIn(data.GetValues<uint64_t>(1), n, query, arrow::TimeUnit::MILLI);
+        case arrow::Type::DOUBLE:
+            return locateIn(data.GetValues<double>(1), n, query, arrow::TimeUnit::MILLI);
+        default:
+            throw std::runtime_error("TimeWindow: unsupported index type " + index->type()->ToString());
+    }
+}
+
+epoch_frame::DataFrame TimeWindow::slice(const epoch_frame::DataFrame& df, const TimeWindowQuery& query) {
+    const auto range = locate(indexArray(df), query);
+    return df.iloc(epoch_frame::UnResolvedIntegerSliceBound{range.offset, range.end()});
+}
+
+std::shared_ptr<arrow::Table> TimeWindow::slice(const std::shared_ptr<arrow::Table>& table,
+                                                const TimeWindowQuery& query) {
+    auto column = table ? table->GetColumnByName(ArrowSidecar::kXColumn) : nullptr;
+    if (!column) {
+        throw std::runtime_error("TimeWindow: table has no '" + std::string(ArrowSidecar::kXColumn) + "' column");
+    }
+    if (column->num_chunks() == 0) {
+        return table;
+    }
+    // Sidecar tables hold a single chunk; anything else is flattened for the search only
+    std::shared_ptr<arrow::Array> x = column->chunk(0);
+    if (column->num_chunks() > 1) {
+        auto concatenated = arrow::Concatenate(column->chunks());
+        if (!concatenated.ok()) {
+            throw std::runtime_error("TimeWindow: " + concatenated.status().ToString());
+        }
+        x = std::move(concatenated).ValueUnsafe();
+    }
+    const auto range = locate(x, query);
+    return table->Slice(range.offset, range.length);
+}
+
+} // namespace epoch_tearsheet
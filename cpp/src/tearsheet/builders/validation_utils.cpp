@@ -1,9 +1,52 @@
 #include "epoch_dashboard/tearsheet/validation_utils.h"
+#include <arrow/api.h>
+#include <arrow/compute/api.h>
 #include <sstream>
 #include <iomanip>
 
 namespace epoch_tearsheet {
 
+namespace {
+
+struct XOrder {
+    int64_t unsorted_at = -1;   // First row whose x is below the previous row's
+    int64_t duplicate_at = -1;  // First row whose x equals the previous row's
+};
+
+template <typename T>
+XOrder scanX(const arrow::ChunkedArray& x) {
+    XOrder order;
+    int64_t row = 0;
+    bool first = true;
+    T previous{};
+    for (const auto& chunk : x.chunks()) {
+        const auto* values = chunk->data()->GetValues<T>(1);
+        for (int64_t i = 0; i < chunk->length(); ++i, ++row) {
+            if (!first) {
+                if (values[i] < previous && order.unsorted_at < 0) {
+                    order.unsorted_at = row;
+                } else if (values[i] == previous && order.duplicate_at < 0) {
+                    order.duplicate_at = row;
+                }
+            }
+            previous = values[i];
+            first = false;
+        }
+    }
+    return order;
+}
+
+XOrder scanX(const arrow::ChunkedArray& x) {
+    switch (x.type()->id()) {
+        case arrow::Type::INT64: return scanX<int64_t>(x);
+        case arrow::Type::DOUBLE: return scanX<double>(x);
+        default:
+            throw std::runtime_error("Unsupported x column type for series table: " + x.type()->ToString());
+    }
+}
+
+} // namespace
+
 bool ValidationUtils::isMonotonicallyIncreasing(const std::vector<epoch_proto::Point>& points) {
     if (points.size() <= 1) {
         return true;
@@ -138,6 +181,54 @@ void ValidationUtils::validateLineData(epoch_proto::Line& line, const Validation
     }
 }
 
+std::shared_ptr<arrow::Table> ValidationUtils::validateSeriesTable(std::shared_ptr<arrow::Table> table,
+                                                                  const ValidationOptions& options) {
+    // Check for finite values if requested
+    if (options.check_finite) {
+        for (int c = 1; c < table->num_columns(); ++c) {
+            int64_t row = 0;
+            for (const auto& chunk : table->column(c)->chunks()) {
+                const auto* values = chunk->data()->GetValues<double>(1);
+                for (int64_t i = 0; i < chunk->length(); ++i, ++row) {
+                    if (chunk->IsValid(i) && !std::isfinite(values[i])) {
+                        std::stringstream ss;
+                        ss << "Invalid data point in line '" << table->field(c)->name() << "' at index " << row << ": "
+                           << (std::isnan(values[i]) ? "NaN value found" : "Infinite value found");
+                        throw std::runtime_error(ss.str());
+                    }
+                }
+            }
+        }
+    }
+
+    // Check for monotonic increasing; range queries binary-search x, so a table is never left unsorted
+    auto order = scanX(*table->column(0));
+    if (order.unsorted_at >= 0) {
+        if (options.auto_sort || !options.strict_validation) {
+            namespace cp = arrow::compute;
+            cp::SortOptions sort({cp::SortKey(table->field(0)->name())});
+            auto indices = cp::SortIndices(arrow::Datum(table), sort).ValueOrDie();
+            table = cp::Take(arrow::Datum(table), arrow::Datum(indices)).ValueOrDie().table();
+            order = scanX(*table->column(0));
+        } else {
+            std::stringstream ss;
+            ss << "Chart data must be monotonically increasing on x-axis. Found a decrease at x["
+               << order.unsorted_at << "]. Consider enabling auto_sort option or sorting your data "
+               << "before adding to chart.";
+            throw std::runtime_error(ss.str());
+        }
+    }
+
+    // Sorted x values repeat only in adjacent rows
+    if (!options.allow_duplicates && order.duplicate_at >= 0 && options.strict_validation) {
+        std::stringstream ss;
+        ss << "Duplicate x-values detected at position " << order.duplicate_at << ". "
+           << "Charts require unique x-coordinates for proper rendering.";
+        throw std::runtime_error(ss.str());
+    }
+    return table;
+}
+
 void ValidationUtils::validateMultipleLines(const std::vector<epoch_proto::Line>& lines, bool require_same_x) {
     if (lines.empty()) {
         return;
@@ -1,9 +1,191 @@
 #include "epoch_dashboard/tearsheet/xrange_chart_builder.h"
+#include "epoch_dashboard/tearsheet/instrumentation.h"
 #include "epoch_dashboard/tearsheet/validation_utils.h"
+#include "epoch_dashboard/tearsheet/dataframe_converter.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
 #include <sstream>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
 
 namespace epoch_tearsheet {
 
+namespace {
+
+std::shared_ptr<arrow::ChunkedArray> requireColumn(const std::shared_ptr<arrow::Table>& table,
+                                                   const std::string& name) {
+    auto column = table->GetColumnByName(name);
+    if (!column) {
+        throw std::runtime_error("XRangeChartBuilder: missing column '" + name + "'");
+    }
+    return column;
+}
+
+void requireNoNulls(const arrow::ChunkedArray& column, const std::string& name) {
+    if (column.null_count() > 0) {
+        throw std::runtime_error("XRangeChartBuilder: column '" + name + "' must not contain nulls");
+    }
+}
+
+// Timestamp or int64 column in milliseconds
+std::vector<int64_t> readMillis(const arrow::ChunkedArray& column, const std::string& name) {
+    requireNoNulls(column, name);
+    std::vector<int64_t> out;
+    out.reserve(static_cast<size_t>(column.length()));
+    for (const auto& chunk : column.chunks()) {
+        const int64_t* values = chunk->data()->GetValues<int64_t>(1);
+        switch (chunk->type_id()) {
+            case arrow::Type::TIMESTAMP: {
+                const auto unit = std::static_pointer_cast<arrow::TimestampType>(chunk->type())->unit();
+                for (int64_t i = 0; i < chunk->length(); ++i) {
+                    out.push_back(DataFrameFactory::toMilliseconds(values[i], unit));
+                }
+                break;
+            }
+            case arrow::Type::INT64:
+                out.insert(out.end(), values, values + chunk->length());
+                break;
+            default:
+                throw std::runtime_error("XRangeChartBuilder: column '" + name +
+                                         "' must be timestamp or int64, got " + chunk->type()->ToString());
+        }
+    }
+    return out;
+}
+
+std::vector<uint8_t> readIsLong(const arrow::ChunkedArray& column, const std::string& name) {
+    std::vector<uint8_t> out;
+    out.reserve(static_cast<size_t>(column.length()));
+    for (const auto& chunk : column.chunks()) {
+        if (chunk->type_id() != arrow::Type::BOOL) {
+            throw std::runtime_error("XRangeChartBuilder: column '" + name + "' must be boolean, got " +
+                                     chunk->type()->ToString());
+        }
+        const auto& flags = static_cast<const arrow::BooleanArray&>(*chunk);
+        for (int64_t i = 0; i < flags.length(); ++i) {
+            out.push_back(flags.IsValid(i) && flags.Value(i));
+        }
+    }
+    return out;
+}
+
+// Lane per row plus the y categories they index
+struct Lanes {
+    std::vector<uint64_t> y;
+    std::vector<std::string> categories;
+};
+
+Lanes namedLanes(const arrow::ChunkedArray& column, const std::string& name) {
+    requireNoNulls(column, name);
+    Lanes lanes;
+    lanes.y.reserve(static_cast<size_t>(column.length()));
+    std::unordered_map<std::string_view, uint64_t> lookup;
+    auto laneOf = [&](std::string_view key) {
+        auto [it, inserted] = lookup.try_emplace(key, lanes.categories.size());
+        if (inserted) {
+            lanes.categories.emplace_back(key);
+        }
+        return it->second;
+    };
+    // Integer lanes are named after themselves, also in order of first appearance
+    std::unordered_map<uint64_t, uint64_t> integer_lookup;
+    auto integers = [&](const auto* values, int64_t length) {
+        for (int64_t i = 0; i < length; ++i) {
+            if (std::is_signed_v<std::remove_pointer_t<decltype(values)>> && values[i] < 0) {
+                throw std::runtime_error("XRangeChartBuilder: column '" + name + "' has a negative lane");
+            }
+            const auto key = static_cast<uint64_t>(values[i]);
+            auto [it, inserted] = integer_lookup.try_emplace(key, lanes.categories.size());
+            if (inserted) {
+                lanes.categories.push_back(std::to_string(key));
+            }
+            lanes.y.push_back(it->second);
+        }
+    };
+
+    for (const auto& chunk : column.chunks()) {
+        switch (chunk->type_id()) {
+            case arrow::Type::STRING: {
+                const auto& keys = static_cast<const arrow::StringArray&>(*chunk);
+                for (int64_t i = 0; i < keys.length(); ++i) {
+                    lanes.y.push_back(laneOf(keys.GetView(i)));
+                }
+                break;
+            }
+            case arrow::Type::LARGE_STRING: {
+                const auto& keys = static_cast<const arrow::LargeStringArray&>(*chunk);
+                for (int64_t i = 0; i < keys.length(); ++i) {
+                    lanes.y.push_back(laneOf(keys.GetView(i)));
+                }
+                break;
+            }
+            case arrow::Type::DICTIONARY: {
+                const auto& keys = static_cast<const arrow::DictionaryArray&>(*chunk);
+                if (keys.dictionary()->type_id() != arrow::Type::STRING) {
+                    throw std::runtime_error("XRangeChartBuilder: column '" + name +
+                                             "' must be a dictionary of strings, got " + chunk->type()->ToString());
+                }
+                const auto& dictionary = static_cast<const arrow::StringArray&>(*keys.dictionary());
+                for (int64_t i = 0; i < keys.length(); ++i) {
+                    lanes.y.push_back(laneOf(dictionary.GetView(keys.GetValueIndex(i))));
+                }
+                break;
+            }
+            case arrow::Type::INT64:
+                integers(chunk->data()->GetValues<int64_t>(1), chunk->length());
+                break;
+            case arrow::Type::INT32:
+                integers(chunk->data()->GetValues<int32_t>(1), chunk->length());
+                break;
+            case arrow::Type::UINT64:
+                integers(chunk->data()->GetValues<uint64_t>(1), chunk->length());
+                break;
+            case arrow::Type::UINT32:
+                integers(chunk->data()->GetValues<uint32_t>(1), chunk->length());
+                break;
+            default:
+                throw std::runtime_error("XRangeChartBuilder: column '" + name +
+                                         "' must be string, dictionary or integer, got " + chunk->type()->ToString());
+        }
+    }
+    return lanes;
+}
+
+// Greedy interval partitioning: visit intervals by entry and reuse the lane that frees up first
+Lanes packLanes(const std::vector<int64_t>& entry, const std::vector<int64_t>& exit) {
+    std::vector<size_t> order(entry.size());
+    std::iota(order.begin(), order.end(), size_t{0});
+    std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) { return entry[a] < entry[b]; });
+
+    using Busy = std::pair<int64_t, uint64_t>;  // (exit, lane)
+    std::priority_queue<Busy, std::vector<Busy>, std::greater<>> busy;
+    Lanes lanes;
+    lanes.y.resize(entry.size());
+    uint64_t lane_count = 0;
+    for (const auto i : order) {
+        uint64_t lane;
+        if (!busy.empty() && busy.top().first <= entry[i]) {
+            lane = busy.top().second;
+            busy.pop();
+        } else {
+            lane = lane_count++;
+        }
+        lanes.y[i] = lane;
+        busy.emplace(exit[i], lane);
+    }
+    for (uint64_t lane = 0; lane < lane_count; ++lane) {
+        lanes.categories.push_back("Lane " + std::to_string(lane + 1));
+    }
+    return lanes;
+}
+
+} // namespace
+
 XRangeChartBuilder::XRangeChartBuilder() {
     x_range_def_.mutable_chart_def()->set_type(epoch_proto::WidgetXRange);
 }
@@ -41,9 +223,72 @@ XRangeChartBuilder& XRangeChartBuilder::addPoint(const epoch_proto::XRangePoint&
     return *this;
 }
 
+XRangeChartBuilder& XRangeChartBuilder::fromDataFrame(const epoch_frame::DataFrame& df,
+                                                      const std::string& entry_col,
+                                                      const std::string& exit_col,
+                                                      const std::optional<std::string>& lane_col,
+                                                      const std::optional<std::string>& is_long_col) {
+    ScopedSpan span("XRangeChartBuilder", SpanPhase::Conversion, instrumentationSink());
+    span.describe(x_range_def_.chart_def());
+
+    auto table = df.table();
+    span.setRowsIn(table->num_rows());
+    const auto entry = readMillis(*requireColumn(table, entry_col), entry_col);
+    const auto exit = readMillis(*requireColumn(table, exit_col), exit_col);
+
+    // Branch-free count first; only locate the offending row when there is one
+    const size_t n = entry.size();
+    size_t invalid = 0;
+    for (size_t i = 0; i < n; ++i) {
+        invalid += entry[i] >= exit[i];
+    }
+    if (invalid > 0) {
+        size_t row = 0;
+        while (entry[row] < exit[row]) {
+            ++row;
+        }
+        std::stringstream ss;
+        ss << "Invalid XRange point: x (" << entry[row] << ") must be less than x2 (" << exit[row] << ") at row "
+           << row << " (" << invalid << " invalid rows)";
+        throw std::runtime_error(ss.str());
+    }
+
+    const auto lanes = lane_col ? namedLanes(*requireColumn(table, *lane_col), *lane_col) : packLanes(entry, exit);
+    const auto is_long = is_long_col ? readIsLong(*requireColumn(table, *is_long_col), *is_long_col)
+                                     : std::vector<uint8_t>(n, 0);
+
+    x_range_def_.clear_points();
+    auto* points = x_range_def_.mutable_points();
+    points->Reserve(static_cast<int>(n));
+    for (size_t i = 0; i < n; ++i) {
+        auto* point = points->Add();
+        point->set_x(entry[i]);
+        point->set_x2(exit[i]);
+        point->set_y(lanes.y[i]);
+        point->set_is_long(is_long[i] != 0);
+    }
+    span.addPointsOut(static_cast<int64_t>(n));
+
+    auto* y_axis = x_range_def_.mutable_chart_def()->mutable_y_axis();
+    y_axis->clear_categories();
+    for (const auto& category : lanes.categories) {
+        y_axis->add_categories(category);
+    }
+    setXAxisType(epoch_proto::AxisDateTime);
+
+    return *this;
+}
+
 epoch_proto::Chart XRangeChartBuilder::build() const {
+    ScopedSpan span("XRangeChartBuilder", SpanPhase::Build, instrumentationSink());
+    span.describe(x_range_def_.chart_def()).addPointsOut(x_range_def_.points_size());
+
     epoch_proto::Chart chart;
     *chart.mutable_x_range_def() = x_range_def_;
+
+    if (span.active()) {
+        span.setBytesSerialized(static_cast<int64_t>(chart.ByteSizeLong()));
+    }
     return chart;
 }
 
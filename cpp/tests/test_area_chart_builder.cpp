@@ -1,13 +1,42 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
 #include "epoch_dashboard/tearsheet/area_chart_builder.h"
 #include "epoch_dashboard/tearsheet/line_builder.h"
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include "epoch_dashboard/tearsheet/table_builder.h"
 #include "epoch_dashboard/tearsheet/scalar_converter.h"
 #include <epoch_frame/dataframe.h>
 #include <epoch_frame/factory/index_factory.h>
 #include <arrow/api.h>
+#include <cmath>
+#include <limits>
 
 using namespace epoch_tearsheet;
 using namespace epoch_frame;
+using Catch::Matchers::ContainsSubstring;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+constexpr int64_t kDayMs = 86400000;
+
+// One row per day from the epoch; NaN values become nulls
+DataFrame makeDailyFrame(const std::string& column, const std::vector<double>& values) {
+    arrow::TimestampBuilder timestamp_builder(arrow::timestamp(arrow::TimeUnit::MILLI), arrow::default_memory_pool());
+    arrow::DoubleBuilder value_builder;
+    for (size_t i = 0; i < values.size(); ++i) {
+        REQUIRE(timestamp_builder.Append(static_cast<int64_t>(i) * kDayMs).ok());
+        REQUIRE((std::isnan(values[i]) ? value_builder.AppendNull() : value_builder.Append(values[i])).ok());
+    }
+    std::shared_ptr<arrow::Array> timestamp_array, value_array;
+    REQUIRE(timestamp_builder.Finish(&timestamp_array).ok());
+    REQUIRE(value_builder.Finish(&value_array).ok());
+    auto table = arrow::Table::Make(arrow::schema({arrow::field(column, arrow::float64())}), {value_array});
+    return DataFrame(epoch_frame::factory::index::make_index(timestamp_array, std::nullopt, "timestamp"), table);
+}
+
+} // namespace
 
 TEST_CASE("AreaChartBuilder: Basic construction", "[area]") {
     auto chart = AreaChartBuilder()
@@ -250,4 +279,67 @@ TEST_CASE("AreaChartBuilder: Area with line styles", "[area]") {
 
     REQUIRE(chart.area_def().areas_size() == 1);
     REQUIRE(chart.area_def().areas(0).line_width() == 3);
-}
\ No newline at end of file
+}
+
+TEST_CASE("AreaChartBuilder: fromEquityCurve", "[area]") {
+    // Peaks at days 1, 5 and 8: -20% recovered on day 4, -10% on day 7, -5% still open
+    auto df = makeDailyFrame("equity", {100.0, 110.0, 99.0, 88.0, 110.0, 121.0, 108.9, 121.0, 130.0, 123.5});
+
+    AreaChartBuilder builder;
+    auto chart = builder.setTitle("Underwater").fromEquityCurve(df, "equity", {"Drawdown", 2}).build();
+
+    const auto& area = chart.area_def().areas(0);
+    REQUIRE(area.name() == "Drawdown");
+    REQUIRE(area.data_size() == 10);
+    REQUIRE(area.data(1).y() == 0.0);
+    REQUIRE_THAT(area.data(3).y(), WithinAbs(-0.2, 1e-12));
+    REQUIRE(area.data(3).x() == 3 * kDayMs);
+    REQUIRE_THAT(area.data(9).y(), WithinAbs(-0.05, 1e-12));
+
+    const auto& periods = builder.drawdownPeriods();
+    REQUIRE(periods.size() == 2);
+    REQUIRE(periods[0].peak_ms == kDayMs);
+    REQUIRE(periods[0].trough_ms == 3 * kDayMs);
+    REQUIRE(periods[0].recovery_ms == 4 * kDayMs);
+    REQUIRE(periods[0].rows == 3);
+    REQUIRE_THAT(periods[0].depth, WithinAbs(-0.2, 1e-12));
+    REQUIRE(periods[1].peak_ms == 5 * kDayMs);
+    REQUIRE(periods[1].end_ms == 7 * kDayMs);
+
+    auto bands = LinesChartBuilder().addDrawdownBands(periods).build();
+    REQUIRE(bands.lines_def().x_plot_bands_size() == 2);
+    REQUIRE(bands.lines_def().x_plot_bands(0).from().timestamp_ms() == kDayMs);
+    REQUIRE(bands.lines_def().x_plot_bands(0).to().timestamp_ms() == 4 * kDayMs);
+
+    auto table = TableBuilder().setType(epoch_proto::WidgetDataTable).fromDrawdownPeriods(periods).build();
+    REQUIRE(table.columns_size() == 6);
+    REQUIRE(table.data().rows_size() == 2);
+    REQUIRE(table.data().rows(0).values(0).integer_value() == 1);
+    REQUIRE(table.data().rows(0).values(5).day_duration() == 3);
+}
+
+TEST_CASE("AreaChartBuilder: fromReturns", "[area]") {
+    // Wealth 0.9, 0.99, skipped, 0.495, 0.99, 1.089: underwater from the start until day 5
+    const double missing = std::numeric_limits<double>::quiet_NaN();
+    auto df = makeDailyFrame("returns", {-0.1, 0.1, missing, -0.5, 1.0, 0.1});
+
+    AreaChartBuilder builder;
+    builder.fromReturns(df, "returns");
+    const auto& periods = builder.drawdownPeriods();
+    REQUIRE(periods.size() == 1);
+    REQUIRE(periods[0].peak_ms == 0);
+    REQUIRE(periods[0].trough_ms == 3 * kDayMs);
+    REQUIRE(periods[0].recovery_ms == 5 * kDayMs);
+    REQUIRE_THAT(periods[0].depth, WithinAbs(-0.505, 1e-12));
+
+    auto chart = builder.build();
+    REQUIRE(chart.area_def().areas(0).data_size() == 5);
+    REQUIRE_THAT(chart.area_def().areas(0).data(0).y(), WithinAbs(-0.1, 1e-12));
+
+    auto open = makeDailyFrame("returns", {-0.1, -0.1});
+    REQUIRE(AreaChartBuilder().fromReturns(open, "returns").drawdownPeriods()[0].recovery_ms == std::nullopt);
+
+    REQUIRE_THROWS_WITH(AreaChartBuilder().fromReturns(df, "pnl"), ContainsSubstring("missing column 'pnl'"));
+    REQUIRE_THROWS_WITH(AreaChartBuilder().fromEquityCurve(makeDailyFrame("equity", {1.0, -1.0}), "equity"),
+                        ContainsSubstring("must be positive"));
+}
@@ -0,0 +1,241 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/arrow_sidecar.h"
+#include "epoch_dashboard/tearsheet/numeric_lines_chart_builder.h"
+#include "epoch_dashboard/tearsheet/table_builder.h"
+#include <epoch_frame/dataframe.h>
+#include <epoch_frame/factory/index_factory.h>
+#include <arrow/api.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/reader.h>
+#include <cmath>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+template <typename Builder, typename T>
+std::shared_ptr<arrow::Array> finish(Builder& builder, const std::vector<T>& values) {
+    REQUIRE(builder.AppendValues(values).ok());
+    std::shared_ptr<arrow::Array> array;
+    REQUIRE(builder.Finish(&array).ok());
+    return array;
+}
+
+template <typename Builder, typename T>
+std::shared_ptr<arrow::Array> makeArray(const std::vector<T>& values) {
+    Builder builder;
+    return finish(builder, values);
+}
+
+std::shared_ptr<arrow::Array> makeTimestamps(const std::vector<int64_t>& values, arrow::TimeUnit::type unit) {
+    arrow::TimestampBuilder builder(arrow::timestamp(unit), arrow::default_memory_pool());
+    return finish(builder, values);
+}
+
+std::shared_ptr<arrow::Table> makeValues() {
+    auto returns = makeArray<arrow::DoubleBuilder>(std::vector<double>{0.01, -0.02, 0.03});
+    auto trades = makeArray<arrow::Int32Builder>(std::vector<int32_t>{1, 0, 4});
+    return arrow::Table::Make(arrow::schema({arrow::field("returns", arrow::float64()),
+                                             arrow::field("trades", arrow::int32())}),
+                              {returns, trades});
+}
+
+// 200 trades over three symbols and two sides; ids are unique per row
+std::shared_ptr<arrow::Table> makeTradeLog() {
+    const std::vector<std::string> symbols = {"AAPL", "MSFT", "NVDA"};
+    arrow::StringBuilder symbol_builder;
+    arrow::StringDictionaryBuilder side_builder;
+    arrow::StringBuilder id_builder;
+    arrow::DoubleBuilder pnl_builder;
+    for (int i = 0; i < 200; ++i) {
+        REQUIRE((i == 7 ? symbol_builder.AppendNull() : symbol_builder.Append(symbols[i % 3])).ok());
+        REQUIRE(side_builder.Append(i % 2 == 0 ? "long" : "short").ok());
+        REQUIRE(id_builder.Append("T" + std::to_string(i)).ok());
+        REQUIRE(pnl_builder.Append(static_cast<double>(i)).ok());
+    }
+    std::vector<std::shared_ptr<arrow::Array>> arrays(4);
+    REQUIRE(symbol_builder.Finish(&arrays[0]).ok());
+    REQUIRE(side_builder.Finish(&arrays[1]).ok());
+    REQUIRE(id_builder.Finish(&arrays[2]).ok());
+    REQUIRE(pnl_builder.Finish(&arrays[3]).ok());
+    return arrow::Table::Make(arrow::schema({arrow::field("symbol", arrow::utf8()),
+                                             arrow::field("side", arrays[1]->type()),
+                                             arrow::field("id", arrow::utf8()),
+                                             arrow::field("pnl", arrow::float64())}),
+                              arrays);
+}
+
+} // namespace
+
+TEST_CASE("ArrowSidecar: time series table", "[arrow_sidecar]") {
+    auto values = makeValues();
+
+    SECTION("Millisecond timestamps and float64 columns are not copied") {
+        auto index = makeTimestamps({1000, 2000, 3000}, arrow::TimeUnit::MILLI);
+        auto table = ArrowSidecar::makeTimeSeriesTable(index, values, {"returns"});
+
+        REQUIRE(table->num_columns() == 2);
+        REQUIRE(table->field(0)->name() == ArrowSidecar::kXColumn);
+        REQUIRE(table->field(0)->type()->Equals(arrow::int64()));
+        REQUIRE(table->column(0)->chunk(0)->data()->buffers[1]->data() == index->data()->buffers[1]->data());
+        REQUIRE(table->column(1) == values->GetColumnByName("returns"));
+    }
+
+    SECTION("Other units and types are converted") {
+        auto index = makeTimestamps({1'000'000'000, 2'000'000'000, 3'000'000'000}, arrow::TimeUnit::NANO);
+        auto table = ArrowSidecar::makeTimeSeriesTable(index, values, {"returns", "trades", "missing"});
+
+        REQUIRE(table->num_columns() == 3);
+        auto x = std::static_pointer_cast<arrow::Int64Array>(table->column(0)->chunk(0));
+        REQUIRE(x->Value(0) == 1000);
+        REQUIRE(x->Value(2) == 3000);
+        auto trades = std::static_pointer_cast<arrow::DoubleArray>(table->column(2)->chunk(0));
+        REQUIRE(table->field(2)->type()->Equals(arrow::float64()));
+        REQUIRE(trades->Value(2) == 4.0);
+    }
+
+    SECTION("Length mismatch") {
+        auto index = makeArray<arrow::Int64Builder>(std::vector<int64_t>{1, 2});
+        REQUIRE_THROWS_WITH(ArrowSidecar::makeTimeSeriesTable(index, values, {"returns"}),
+                            ContainsSubstring("does not match row count"));
+    }
+
+    SECTION("Unsupported index") {
+        auto index = makeArray<arrow::DoubleBuilder>(std::vector<double>{1, 2, 3});
+        REQUIRE_THROWS_WITH(ArrowSidecar::makeTimeSeriesTable(index, values, {"returns"}),
+                            ContainsSubstring("Unsupported index type"));
+    }
+}
+
+TEST_CASE("ArrowSidecar: numeric series table", "[arrow_sidecar]") {
+    auto index = makeArray<arrow::DoubleBuilder>(std::vector<double>{0.5, 1.5, 2.5});
+    auto table = ArrowSidecar::makeNumericSeriesTable(index, makeValues(), {"returns"});
+
+    REQUIRE(table->field(0)->type()->Equals(arrow::float64()));
+    REQUIRE(table->column(0)->chunk(0) == index);
+}
+
+TEST_CASE("ArrowSidecar: registry and IPC output", "[arrow_sidecar]") {
+    ArrowSidecar sidecar;
+    auto index = makeArray<arrow::Int64Builder>(std::vector<int64_t>{1, 2, 3});
+    auto table = ArrowSidecar::makeTimeSeriesTable(index, makeValues(), {"returns", "trades"});
+
+    sidecar.add("equity", table);
+    REQUIRE(sidecar.contains("equity"));
+    REQUIRE(sidecar.size() == 1);
+    REQUIRE(sidecar.ids() == std::vector<std::string>{"equity"});
+
+    REQUIRE_THROWS_WITH(sidecar.add("equity", table), ContainsSubstring("duplicate chart id"));
+    REQUIRE_THROWS_WITH(sidecar.add("", table), ContainsSubstring("chart id is required"));
+    REQUIRE_THROWS_WITH(sidecar.toIPC("missing"), ContainsSubstring("unknown chart id"));
+
+    auto buffer = sidecar.toIPC("equity");
+    auto input = std::make_shared<arrow::io::BufferReader>(buffer);
+    auto reader = arrow::ipc::RecordBatchStreamReader::Open(input).ValueOrDie();
+    auto restored = reader->ToTable().ValueOrDie();
+    REQUIRE(restored->Equals(*table));
+}
+
+TEST_CASE("NumericLinesChartBuilder: fromDataFrame into sidecar", "[arrow_sidecar]") {
+    auto sidecar = std::make_shared<ArrowSidecar>();
+    epoch_frame::DataFrame df(makeValues());
+
+    auto chart = NumericLinesChartBuilder()
+        .setId("returns_by_step")
+        .setTitle("Returns")
+        .setArrowSidecar(sidecar)
+        .fromDataFrame(df, {"returns", "trades"})
+        .build();
+
+    const auto& lines = chart.numeric_lines_def().lines();
+    REQUIRE(lines.size() == 2);
+    REQUIRE(lines[0].name() == "returns");
+    REQUIRE(lines[0].data_size() == 0);
+    REQUIRE(sidecar->contains("returns_by_step"));
+    REQUIRE(sidecar->get("returns_by_step")->num_rows() == 3);
+}
+
+TEST_CASE("NumericLinesChartBuilder: sidecar series are validated", "[arrow_sidecar]") {
+    auto makeFrame = [](const std::vector<double>& x, const std::vector<double>& y) {
+        auto values = makeArray<arrow::DoubleBuilder>(y);
+        return epoch_frame::DataFrame(
+            epoch_frame::factory::index::make_index(makeArray<arrow::DoubleBuilder>(x), std::nullopt, "x"),
+            arrow::Table::Make(arrow::schema({arrow::field("y", arrow::float64())}), {values}));
+    };
+    auto build = [](const epoch_frame::DataFrame& df, const ValidationUtils::ValidationOptions& options) {
+        auto sidecar = std::make_shared<ArrowSidecar>();
+        NumericLinesChartBuilder()
+            .setId("curve")
+            .setArrowSidecar(sidecar)
+            .setValidationOptions(options)
+            .fromDataFrame(df, {"y"});
+        return sidecar->get("curve");
+    };
+    const auto unsorted = makeFrame({2.0, 0.5, 1.0}, {20.0, 5.0, 10.0});
+
+    REQUIRE_THROWS_WITH(build(unsorted, {}), ContainsSubstring("monotonically increasing"));
+    REQUIRE_THROWS_WITH(build(makeFrame({0.5, 0.5}, {1.0, 2.0}), {}), ContainsSubstring("Duplicate x-values"));
+    REQUIRE_THROWS_WITH(build(makeFrame({0.5, 1.0}, {1.0, std::nan("")}), {}),
+                        ContainsSubstring("line 'y' at index 1: NaN"));
+
+    // Range queries binary-search x, so even lenient validation sorts
+    for (const auto& options : {ValidationUtils::ValidationOptions{.auto_sort = true},
+                                ValidationUtils::ValidationOptions{.strict_validation = false}}) {
+        auto table = build(unsorted, options);
+        REQUIRE(table->num_rows() == 3);
+        auto x = std::static_pointer_cast<arrow::DoubleArray>(table->column(0)->chunk(0));
+        auto y = std::static_pointer_cast<arrow::DoubleArray>(table->column(1)->chunk(0));
+        REQUIRE(x->Value(0) == 0.5);
+        REQUIRE(x->Value(2) == 2.0);
+        REQUIRE(y->Value(0) == 5.0);
+    }
+}
+
+TEST_CASE("ArrowSidecar: dictionary table", "[arrow_sidecar]") {
+    auto source = makeTradeLog();
+    auto table = ArrowSidecar::makeDictionaryTable(source);
+
+    const auto dictionary_type = arrow::dictionary(arrow::int32(), arrow::utf8());
+    REQUIRE(table->num_rows() == 200);
+    REQUIRE(table->GetColumnByName("symbol")->type()->Equals(*dictionary_type));
+    REQUIRE(table->GetColumnByName("side")->type()->Equals(*dictionary_type));
+    // 200 distinct ids exceed half the row count, so they stay plain strings
+    REQUIRE(table->GetColumnByName("id")->type()->id() == arrow::Type::STRING);
+    REQUIRE(table->GetColumnByName("pnl") == source->GetColumnByName("pnl"));
+
+    const auto& symbols = static_cast<const arrow::DictionaryArray&>(*table->GetColumnByName("symbol")->chunk(0));
+    REQUIRE(symbols.dictionary()->length() == 3);
+    REQUIRE(symbols.IsNull(7));
+    REQUIRE(static_cast<const arrow::StringArray&>(*symbols.dictionary()).GetView(symbols.GetValueIndex(4)) == "MSFT");
+
+    // The encoded stream decodes back to the same strings
+    auto input = std::make_shared<arrow::io::BufferReader>(ArrowSidecar::serializeIPC(table));
+    auto restored = arrow::ipc::RecordBatchStreamReader::Open(input).ValueOrDie()->ToTable().ValueOrDie();
+    REQUIRE(restored->Equals(*table));
+    REQUIRE(ArrowSidecar::serializeIPC(table)->size() < ArrowSidecar::serializeIPC(source)->size());
+
+    auto selected = ArrowSidecar::makeDictionaryTable(source, {"id", "side"}, 1.0);
+    REQUIRE(selected->num_columns() == 2);
+    REQUIRE(selected->GetColumnByName("id")->type()->Equals(*dictionary_type));
+    REQUIRE_THROWS_WITH(ArrowSidecar::makeDictionaryTable(source, {"fees"}), ContainsSubstring("missing column 'fees'"));
+}
+
+TEST_CASE("TableBuilder: fromDataFrame into sidecar", "[arrow_sidecar]") {
+    auto sidecar = std::make_shared<ArrowSidecar>();
+    epoch_frame::DataFrame df(makeTradeLog());
+
+    auto table = TableBuilder()
+        .setType(epoch_proto::WidgetDataTable)
+        .setTitle("Trades")
+        .setArrowSidecar(sidecar, "trades")
+        .fromDataFrame(df, {"symbol", "pnl"})
+        .build();
+
+    REQUIRE(table.columns_size() == 2);
+    REQUIRE(table.columns(0).id() == "symbol");
+    REQUIRE(table.data().rows_size() == 0);
+    REQUIRE(sidecar->get("trades")->num_rows() == 200);
+    REQUIRE(sidecar->get("trades")->GetColumnByName("symbol")->type()->id() == arrow::Type::DICTIONARY);
+}
@@ -1,11 +1,14 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
 #include "epoch_dashboard/tearsheet/bar_chart_builder.h"
 #include "epoch_dashboard/tearsheet/scalar_converter.h"
 #include <epoch_frame/dataframe.h>
 #include <arrow/api.h>
+#include <cmath>
 
 using namespace epoch_tearsheet;
 using namespace epoch_frame;
+using Catch::Matchers::ContainsSubstring;
 
 TEST_CASE("BarChartBuilder: Basic construction", "[bar]") {
     auto chart = BarChartBuilder()
@@ -247,4 +250,128 @@ TEST_CASE("BarChartBuilder: Complete stacked bar with multiple series", "[bar]")
     REQUIRE(def.stack_type() == epoch_proto::StackTypeNormal);
     REQUIRE(def.bar_width() == 40);
     REQUIRE(def.chart_def().x_axis().categories_size() == 4);
-}
\ No newline at end of file
+}
+
+namespace {
+
+// Two chunks so the per-batch partials have to be merged; "Energy" only appears in the second
+DataFrame makeTrades() {
+    auto chunk = [](const std::vector<std::string>& sectors, const std::vector<double>& pnl,
+                    const std::vector<int64_t>& qty) {
+        arrow::StringDictionaryBuilder sector_builder;
+        arrow::DoubleBuilder pnl_builder;
+        arrow::Int64Builder qty_builder;
+        for (size_t i = 0; i < sectors.size(); ++i) {
+            REQUIRE((sectors[i].empty() ? sector_builder.AppendNull() : sector_builder.Append(sectors[i])).ok());
+        }
+        REQUIRE(pnl_builder.AppendValues(pnl).ok());
+        REQUIRE(qty_builder.AppendValues(qty).ok());
+        std::vector<std::shared_ptr<arrow::Array>> arrays(3);
+        REQUIRE(sector_builder.Finish(&arrays[0]).ok());
+        REQUIRE(pnl_builder.Finish(&arrays[1]).ok());
+        REQUIRE(qty_builder.Finish(&arrays[2]).ok());
+        return arrays;
+    };
+    auto first = chunk({"Tech", "Finance", "Tech", ""}, {10.0, 5.0, 20.0, 99.0}, {1, 2, 3, 4});
+    auto second = chunk({"Energy", "Finance", "Tech"}, {40.0, 7.0, 30.0}, {5, 6, 7});
+
+    arrow::ChunkedArrayVector columns;
+    for (size_t c = 0; c < 3; ++c) {
+        columns.push_back(std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{first[c], second[c]}));
+    }
+    auto schema = arrow::schema({arrow::field("sector", columns[0]->type()),
+                                 arrow::field("pnl", arrow::float64()),
+                                 arrow::field("qty", arrow::int64())});
+    return DataFrame(arrow::Table::Make(schema, columns));
+}
+
+} // namespace
+
+TEST_CASE("BarChartBuilder: fromDataFrame group by", "[bar]") {
+    auto df = makeTrades();
+
+    SECTION("Sum keeps first-appearance order") {
+        auto chart = BarChartBuilder()
+            .fromDataFrame(df, "sector", {"pnl", "qty"}, BarAggregation::Sum)
+            .build();
+
+        const auto& bar = chart.bar_def();
+        REQUIRE(bar.chart_def().x_axis().type() == epoch_proto::AxisCategory);
+        const auto& categories = bar.chart_def().x_axis().categories();
+        REQUIRE(std::vector<std::string>(categories.begin(), categories.end()) ==
+                std::vector<std::string>{"Tech", "Finance", "Energy"});
+        REQUIRE(bar.data_size() == 2);
+        REQUIRE(bar.data(0).name() == "pnl");
+        REQUIRE(std::vector<double>(bar.data(0).values().begin(), bar.data(0).values().end()) ==
+                std::vector<double>{60.0, 12.0, 40.0});
+        REQUIRE(bar.data(1).values(0) == 11.0);
+    }
+
+    SECTION("Mean, count and last") {
+        auto mean = BarChartBuilder().fromDataFrame(df, "sector", {"pnl"}, BarAggregation::Mean).build();
+        REQUIRE(mean.bar_def().data(0).values(0) == 20.0);
+        REQUIRE(mean.bar_def().data(0).values(1) == 6.0);
+
+        auto count = BarChartBuilder().fromDataFrame(df, "sector", {"pnl"}, BarAggregation::Count).build();
+        REQUIRE(count.bar_def().data(0).values(0) == 3.0);
+        REQUIRE(count.bar_def().data(0).values(2) == 1.0);
+
+        auto last = BarChartBuilder().fromDataFrame(df, "sector", {"qty"}, BarAggregation::Last).build();
+        REQUIRE(last.bar_def().data(0).values(0) == 7.0);
+        REQUIRE(last.bar_def().data(0).values(1) == 6.0);
+    }
+
+    SECTION("Sorted by the first value column") {
+        auto chart = BarChartBuilder()
+            .fromDataFrame(df, "sector", {"pnl", "qty"}, BarAggregation::Sum, BarSortOrder::Ascending)
+            .build();
+
+        const auto& categories = chart.bar_def().chart_def().x_axis().categories();
+        REQUIRE(std::vector<std::string>(categories.begin(), categories.end()) ==
+                std::vector<std::string>{"Finance", "Energy", "Tech"});
+        // Every series follows the category order
+        REQUIRE(chart.bar_def().data(1).values(0) == 8.0);
+    }
+
+    SECTION("Errors") {
+        REQUIRE_THROWS_WITH(BarChartBuilder().fromDataFrame(df, "sector", {"fees"}, BarAggregation::Sum),
+                            ContainsSubstring("missing column 'fees'"));
+        REQUIRE_THROWS_WITH(BarChartBuilder().fromDataFrame(df, "sector", {"sector"}, BarAggregation::Sum),
+                            ContainsSubstring("must be numeric"));
+        REQUIRE_THROWS_WITH(BarChartBuilder().fromDataFrame(df, "qty", {"pnl"}, BarAggregation::Sum),
+                            ContainsSubstring("string or dictionary"));
+        REQUIRE_THROWS_WITH(BarChartBuilder().fromDataFrame(df, "sector", {}, BarAggregation::Sum),
+                            ContainsSubstring("at least one value column"));
+    }
+
+    SECTION("Aggregates are validated like addBarData") {
+        arrow::StringBuilder sector_builder;
+        arrow::DoubleBuilder pnl_builder;
+        arrow::DoubleBuilder fees_builder;
+        REQUIRE(sector_builder.AppendValues(std::vector<std::string>{"Tech", "Finance", "Energy"}).ok());
+        REQUIRE(pnl_builder.AppendValues(std::vector<double>{10.0, -5.0, 3.0}).ok());
+        REQUIRE(fees_builder.AppendValues(std::vector<double>{1.0, std::nan(""), 2.0}).ok());
+        arrow::ArrayVector arrays(3);
+        REQUIRE(sector_builder.Finish(&arrays[0]).ok());
+        REQUIRE(pnl_builder.Finish(&arrays[1]).ok());
+        REQUIRE(fees_builder.Finish(&arrays[2]).ok());
+        DataFrame trades(arrow::Table::Make(arrow::schema({arrow::field("sector", arrow::utf8()),
+                                                           arrow::field("pnl", arrow::float64()),
+                                                           arrow::field("fees", arrow::float64())}),
+                                            arrays));
+
+        REQUIRE_NOTHROW(BarChartBuilder().fromDataFrame(trades, "sector", {"pnl"}, BarAggregation::Sum));
+        REQUIRE_THROWS_WITH(
+            BarChartBuilder().setStacked(true).fromDataFrame(trades, "sector", {"pnl"}, BarAggregation::Sum),
+            ContainsSubstring("Negative values not allowed for stacked bars"));
+
+        // Sorting by a NaN group is well-defined; the NaN is then rejected
+        for (const auto sort : {BarSortOrder::None, BarSortOrder::Ascending, BarSortOrder::Descending}) {
+            REQUIRE_THROWS_WITH(BarChartBuilder().fromDataFrame(trades, "sector", {"fees"}, BarAggregation::Sum, sort),
+                                ContainsSubstring("NaN value found"));
+        }
+        auto counted = BarChartBuilder().fromDataFrame(trades, "sector", {"fees"}, BarAggregation::Count).build();
+        REQUIRE(counted.bar_def().data(0).values(1) == 1.0);
+    }
+    }
+}
@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/tearsheet_builder.h"
+#include "epoch_dashboard/tearsheet/card_builder.h"
+#include <google/protobuf/util/message_differencer.h>
+#include <atomic>
+#include <sstream>
+#include <thread>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+using google::protobuf::util::MessageDifferencer;
+
+namespace {
+
+DashboardBuilder makeDashboard(const std::string& title) {
+    return DashboardBuilder().addCard(CardBuilder()
+        .setType(epoch_proto::WidgetCard)
+        .setCategory(title)
+        .addCardData(CardDataBuilder().setTitle(title).setType(epoch_proto::TypeString).build())
+        .build());
+}
+
+CategoryFactory countingFactory(const std::string& title, std::atomic<int>& calls) {
+    return [title, &calls] {
+        ++calls;
+        return makeDashboard(title);
+    };
+}
+
+} // namespace
+
+TEST_CASE("FullDashboardBuilder: categories are built on demand", "[category_factories]") {
+    std::atomic<int> risk_calls{0};
+    std::atomic<int> returns_calls{0};
+
+    FullDashboardBuilder builder;
+    builder.addCategory("Strategy", makeDashboard("Strategy").build());
+    builder.addCategoryFactory("Risk", countingFactory("Risk", risk_calls));
+    builder.addCategoryFactory("Returns", countingFactory("Returns", returns_calls));
+
+    REQUIRE(builder.categoryNames() == std::vector<std::string>{"Returns", "Risk", "Strategy"});
+    REQUIRE(builder.hasCategory("Risk"));
+    REQUIRE_FALSE(builder.hasCategory("Positions"));
+    REQUIRE(risk_calls == 0);
+
+    auto risk = builder.buildCategory("Risk");
+    REQUIRE(risk.cards().cards(0).category() == "Risk");
+    REQUIRE(risk_calls == 1);
+    REQUIRE(returns_calls == 0);
+
+    builder.buildCategory("Risk");
+    REQUIRE(risk_calls == 1);
+
+    REQUIRE(builder.buildCategory("Strategy").cards().cards(0).category() == "Strategy");
+    REQUIRE_THROWS_WITH(builder.buildCategory("Positions"), ContainsSubstring("unknown category"));
+
+    SECTION("build() memoizes the remaining categories") {
+        auto full = builder.build();
+        REQUIRE(full.categories_size() == 3);
+        REQUIRE(MessageDifferencer::Equals(full.categories().at("Risk"), risk));
+
+        builder.build();
+        REQUIRE(risk_calls == 1);
+        REQUIRE(returns_calls == 1);
+    }
+
+    SECTION("Estimates leave unbuilt categories out unless asked to build them") {
+        const size_t built = builder.estimatePayloadBytes();
+        REQUIRE(built > 0);
+        REQUIRE(returns_calls == 0);
+
+        REQUIRE(builder.estimatePayloadBytes(true) > built);
+        REQUIRE(returns_calls == 1);
+        REQUIRE(builder.estimatePayloadBytes() == builder.estimatePayloadBytes(true));
+        REQUIRE(returns_calls == 1);
+    }
+
+    SECTION("writeTo does not keep categories it built") {
+        std::ostringstream out;
+        builder.writeTo(out);
+        REQUIRE(returns_calls == 1);
+
+        epoch_proto::FullTearSheet parsed;
+        REQUIRE(parsed.ParseFromString(out.str()));
+        REQUIRE(MessageDifferencer::Equals(parsed, builder.build()));
+        REQUIRE(returns_calls == 2);
+        REQUIRE(risk_calls == 1);
+    }
+}
+
+TEST_CASE("FullDashboardBuilder: replacing categories", "[category_factories]") {
+    std::atomic<int> calls{0};
+    FullDashboardBuilder builder;
+
+    builder.addCategory("Risk", makeDashboard("eager").build());
+    builder.addCategoryFactory("Risk", countingFactory("lazy", calls));
+    REQUIRE(builder.categoryNames().size() == 1);
+    REQUIRE(builder.buildCategory("Risk").cards().cards(0).category() == "lazy");
+
+    builder.addCategory("Risk", makeDashboard("eager").build());
+    REQUIRE(builder.categoryNames().size() == 1);
+    REQUIRE(builder.buildCategory("Risk").cards().cards(0).category() == "eager");
+
+    REQUIRE_THROWS_WITH(builder.addCategoryFactory("Risk", CategoryFactory{}), ContainsSubstring("is empty"));
+}
+
+TEST_CASE("FullDashboardBuilder: concurrent buildCategory builds once", "[category_factories]") {
+    std::atomic<int> calls{0};
+    FullDashboardBuilder builder;
+    builder.addCategoryFactory("Risk", countingFactory("Risk", calls));
+
+    std::vector<std::thread> threads;
+    for (int i = 0; i < 8; ++i) {
+        threads.emplace_back([&] { builder.buildCategory("Risk"); });
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    REQUIRE(calls == 1);
+}
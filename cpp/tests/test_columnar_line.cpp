@@ -0,0 +1,139 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/columnar_line.h"
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include "epoch_dashboard/tearsheet/numeric_lines_chart_builder.h"
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+ColumnarLine makeDailyLine(size_t n) {
+    ColumnarLine line;
+    line.name = "equity";
+    for (size_t i = 0; i < n; ++i) {
+        line.x.push_back(1'600'000'000'000 + static_cast<int64_t>(i) * 86'400'000);
+        line.y.push_back(100.0 + static_cast<double>(i) * 0.25);
+    }
+    return line;
+}
+
+} // namespace
+
+TEST_CASE("ColumnarLineCodec: line round trip", "[columnar_line]") {
+    SECTION("Values and style survive") {
+        auto line = makeDailyLine(50);
+        line.dash_style = epoch_proto::Dash;
+        line.line_width = 3;
+
+        auto decoded = ColumnarLineCodec::decodeLine(ColumnarLineCodec::encode(line));
+        REQUIRE(decoded.name == "equity");
+        REQUIRE(decoded.x == line.x);
+        REQUIRE(decoded.y == line.y);
+        REQUIRE(decoded.dash_style == epoch_proto::Dash);
+        REQUIRE(decoded.line_width == 3u);
+    }
+
+    SECTION("Unsorted and negative x values") {
+        ColumnarLine line;
+        line.x = {5, -3, 1'700'000'000'000, 0, -1'700'000'000'000};
+        line.y = {1, 2, 3, 4, 5};
+
+        auto decoded = ColumnarLineCodec::decodeLine(ColumnarLineCodec::encode(line));
+        REQUIRE(decoded.name.empty());
+        REQUIRE(decoded.x == line.x);
+        REQUIRE(decoded.y == line.y);
+        REQUIRE_FALSE(decoded.dash_style.has_value());
+        REQUIRE_FALSE(decoded.line_width.has_value());
+    }
+
+    SECTION("Empty line") {
+        ColumnarLine line;
+        line.name = "empty";
+        auto decoded = ColumnarLineCodec::decodeLine(ColumnarLineCodec::encode(line));
+        REQUIRE(decoded.name == "empty");
+        REQUIRE(decoded.size() == 0);
+    }
+}
+
+TEST_CASE("ColumnarLineCodec: numeric line round trip", "[columnar_line]") {
+    ColumnarNumericLine line;
+    line.name = "curve";
+    line.x = {-1.5, 0.0, 2.25};
+    line.y = {0.1, 0.2, 0.3};
+
+    auto decoded = ColumnarLineCodec::decodeNumericLine(ColumnarLineCodec::encode(line));
+    REQUIRE(decoded.name == "curve");
+    REQUIRE(decoded.x == line.x);
+    REQUIRE(decoded.y == line.y);
+}
+
+TEST_CASE("ColumnarLineCodec: smaller than Point encoding", "[columnar_line]") {
+    auto line = makeDailyLine(1000);
+    auto columnar = ColumnarLineCodec::encode(line);
+    auto legacy = ColumnarLineCodec::toLegacy(line);
+
+    // 12 bytes per daily sample against 18 for nested Points
+    REQUIRE(columnar.size() * 4 < legacy.ByteSizeLong() * 3);
+}
+
+TEST_CASE("ColumnarLineCodec: errors", "[columnar_line]") {
+    SECTION("Length mismatch") {
+        ColumnarLine line;
+        line.name = "bad";
+        line.x = {1, 2};
+        line.y = {1.0};
+        REQUIRE_THROWS_WITH(ColumnarLineCodec::encode(line), ContainsSubstring("2 x values but 1 y values"));
+        REQUIRE_THROWS(ColumnarLineCodec::toLegacy(line));
+    }
+
+    SECTION("Truncated input") {
+        auto bytes = ColumnarLineCodec::encode(makeDailyLine(10));
+        bytes.resize(bytes.size() - 3);
+        REQUIRE_THROWS_WITH(ColumnarLineCodec::decodeLine(bytes), ContainsSubstring("Malformed columnar line"));
+    }
+
+    SECTION("Packed doubles with a partial value") {
+        const std::string bytes{"\x1a\x03\x00\x00\x00", 5};
+        REQUIRE_THROWS_WITH(ColumnarLineCodec::decodeLine(bytes), ContainsSubstring("packed double length"));
+    }
+
+    SECTION("Unknown fields are skipped") {
+        auto bytes = ColumnarLineCodec::encode(makeDailyLine(3));
+        bytes += std::string{"\x30\x07", 2};  // field 6, varint 7
+        REQUIRE(ColumnarLineCodec::decodeLine(bytes).size() == 3);
+    }
+}
+
+TEST_CASE("ColumnarLineCodec: legacy conversion", "[columnar_line]") {
+    auto line = makeDailyLine(4);
+    line.line_width = 2;
+
+    auto legacy = ColumnarLineCodec::toLegacy(line);
+    REQUIRE(legacy.name() == "equity");
+    REQUIRE(legacy.data_size() == 4);
+    REQUIRE(legacy.data(3).x() == line.x[3]);
+    REQUIRE(legacy.data(3).y() == line.y[3]);
+    REQUIRE(legacy.line_width() == 2u);
+    REQUIRE_FALSE(legacy.has_dash_style());
+
+    auto restored = ColumnarLineCodec::fromLegacy(legacy);
+    REQUIRE(restored.x == line.x);
+    REQUIRE(restored.y == line.y);
+    REQUIRE(restored.line_width == 2u);
+    REQUIRE_FALSE(restored.dash_style.has_value());
+}
+
+TEST_CASE("Chart builders take converted columnar lines", "[columnar_line]") {
+    auto chart = LinesChartBuilder().setTitle("Equity").addLine(ColumnarLineCodec::toLegacy(makeDailyLine(5))).build();
+    REQUIRE(chart.lines_def().lines_size() == 1);
+    REQUIRE(chart.lines_def().lines(0).data_size() == 5);
+
+    ColumnarNumericLine numeric;
+    numeric.name = "curve";
+    numeric.x = {0.5, 1.5};
+    numeric.y = {1.0, 2.0};
+    auto numeric_chart = NumericLinesChartBuilder().addLine(ColumnarLineCodec::toLegacy(numeric)).build();
+    REQUIRE(numeric_chart.numeric_lines_def().lines(0).data(1).x() == 1.5);
+}
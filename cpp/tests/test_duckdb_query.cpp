@@ -0,0 +1,101 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/bar_chart_builder.h"
+#include "epoch_dashboard/tearsheet/duckdb_query.h"
+#include "epoch_dashboard/tearsheet/heatmap_chart_builder.h"
+#include "epoch_dashboard/tearsheet/pie_chart_builder.h"
+#include "epoch_dashboard/tearsheet/table_builder.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <parquet/arrow/writer.h>
+#include <filesystem>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+// Six closed trades across two sectors and two months
+std::shared_ptr<arrow::Table> makeTrades() {
+    arrow::StringBuilder sector_builder;
+    arrow::StringBuilder month_builder;
+    arrow::DoubleBuilder pnl_builder;
+    REQUIRE(sector_builder.AppendValues({"Tech", "Tech", "Energy", "Tech", "Energy", "Energy"}).ok());
+    REQUIRE(month_builder.AppendValues({"2024-01", "2024-02", "2024-01", "2024-01", "2024-02", "2024-02"}).ok());
+    REQUIRE(pnl_builder.AppendValues({100.0, -50.0, 30.0, 20.0, 10.0, 5.0}).ok());
+    return arrow::Table::Make(
+        arrow::schema({arrow::field("sector", arrow::utf8()),
+                       arrow::field("month", arrow::utf8()),
+                       arrow::field("pnl", arrow::float64())}),
+        {sector_builder.Finish().ValueOrDie(), month_builder.Finish().ValueOrDie(), pnl_builder.Finish().ValueOrDie()});
+}
+
+constexpr const char* kPnlBySector = "SELECT sector, sum(pnl) AS pnl FROM trades GROUP BY sector ORDER BY sector";
+
+} // namespace
+
+TEST_CASE("DuckDbQueryEngine: Arrow tables feed the builders", "[duckdb_query]") {
+    DuckDbQueryEngine engine;
+    engine.registerTable("trades", makeTrades());
+
+    auto by_sector = engine.queryDataFrame(kPnlBySector);
+    REQUIRE(by_sector.table()->num_rows() == 2);
+
+    SECTION("Bar chart") {
+        auto chart = BarChartBuilder().setTitle("PnL by Sector").fromDataFrame(by_sector, "pnl").build();
+        REQUIRE(chart.bar_def().data(0).values_size() == 2);
+        REQUIRE(chart.bar_def().data(0).values(0) == 45.0);
+        REQUIRE(chart.bar_def().data(0).values(1) == 70.0);
+    }
+
+    SECTION("Pie chart") {
+        auto chart = PieChartBuilder()
+            .setTitle("PnL Share")
+            .fromDataFrame(by_sector, "sector", "pnl", "PnL", PieSize(100))
+            .build();
+        REQUIRE(chart.pie_def().data(0).points(1).name() == "Tech");
+    }
+
+    SECTION("Table") {
+        auto table = TableBuilder().setTitle("PnL").fromDataFrame(by_sector).build();
+        REQUIRE(table.data().rows_size() == 2);
+    }
+
+    SECTION("Heat map of monthly PnL by sector") {
+        auto monthly = engine.queryDataFrame(
+            "SELECT month, sector, sum(pnl) AS pnl FROM trades GROUP BY ALL ORDER BY month, sector");
+        auto chart = HeatMapChartBuilder()
+            .setTitle("Monthly PnL")
+            .fromDataFrame(monthly, "month", "sector", "pnl")
+            .build();
+        REQUIRE(chart.heat_map_def().points_size() == 4);
+        REQUIRE(chart.heat_map_def().chart_def().x_axis().categories_size() == 2);
+        REQUIRE(chart.heat_map_def().points(1).value() == 120.0);
+    }
+}
+
+TEST_CASE("DuckDbQueryEngine: Parquet views and concurrent widgets", "[duckdb_query]") {
+    const auto path = (std::filesystem::temp_directory_path() / "epoch_dashboard_duckdb_trades.parquet").string();
+    {
+        auto output = arrow::io::FileOutputStream::Open(path).ValueOrDie();
+        REQUIRE(parquet::arrow::WriteTable(*makeTrades(), arrow::default_memory_pool(), output, 2).ok());
+        REQUIRE(output->Close().ok());
+    }
+
+    DuckDbQueryEngine engine;
+    engine.registerParquet("trades", path);
+
+    auto results = engine.queryAll({kPnlBySector,
+                                    "SELECT count(*) AS trades FROM trades",
+                                    "SELECT month FROM trades WHERE pnl < 0"});
+    REQUIRE(results.size() == 3);
+    REQUIRE(results[0]->num_rows() == 2);
+    REQUIRE(results[1]->num_rows() == 1);
+    REQUIRE(results[2]->num_rows() == 1);
+
+    REQUIRE(engine.query("SELECT * FROM trades WHERE pnl > 1000")->num_rows() == 0);
+    REQUIRE_THROWS_WITH(engine.query("SELECT * FROM missing_table"), ContainsSubstring("missing_table"));
+
+    std::filesystem::remove(path);
+}
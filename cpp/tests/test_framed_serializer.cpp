@@ -0,0 +1,153 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/framed_serializer.h"
+#include "epoch_dashboard/tearsheet/tearsheet_builder.h"
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include "epoch_dashboard/tearsheet/line_builder.h"
+#include "epoch_dashboard/tearsheet/card_builder.h"
+#include "epoch_dashboard/tearsheet/table_builder.h"
+#include <google/protobuf/util/message_differencer.h>
+#include <algorithm>
+#include <sstream>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+using google::protobuf::util::MessageDifferencer;
+
+namespace {
+
+epoch_proto::Chart makeChart(const std::string& id, int points) {
+    LineBuilder line;
+    line.setName(id);
+    for (int i = 0; i < points; ++i) {
+        line.addPoint(1704067200000 + i * 86400000LL, 100.0 + i * 0.5);
+    }
+    return LinesChartBuilder().setId(id).setTitle(id).addLine(line.build()).build();
+}
+
+epoch_proto::FullTearSheet makeFullTearSheet() {
+    epoch_proto::Scalar sharpe;
+    sharpe.set_decimal_value(1.42);
+
+    auto card = CardBuilder()
+        .setType(epoch_proto::WidgetCard)
+        .setCategory("Returns")
+        .addCardData(CardDataBuilder()
+            .setTitle("Sharpe")
+            .setValue(sharpe)
+            .setType(epoch_proto::TypeDecimal)
+            .build())
+        .build();
+
+    auto table = TableBuilder()
+        .setTitle("Trades")
+        .addColumn("pnl", "PnL", epoch_proto::TypeDecimal)
+        .build();
+
+    FullDashboardBuilder full;
+    full.addCategoryBuilder("Returns", DashboardBuilder()
+            .addCard(card)
+            .addChart(makeChart("equity", 2000))
+            .addChart(makeChart("drawdown", 2000))
+            .addTable(table))
+        .addCategoryBuilder("Risk", DashboardBuilder()
+            .addChart(makeChart("rolling_vol", 500)))
+        .addCategoryBuilder("Empty", DashboardBuilder());
+    return full.build();
+}
+
+} // namespace
+
+TEST_CASE("FramedTearSheet: round trip", "[framed_serializer]") {
+    const auto original = makeFullTearSheet();
+
+    for (auto granularity : {FrameGranularity::Category, FrameGranularity::Chart}) {
+        DYNAMIC_SECTION("granularity " << static_cast<int>(granularity)) {
+            const auto bytes = FramedTearSheetWriter::writeToString(original, {.granularity = granularity});
+            REQUIRE(bytes.size() < original.ByteSizeLong());
+
+            std::istringstream in(bytes);
+            FramedTearSheetReader reader(in);
+            REQUIRE(reader.granularity() == granularity);
+            REQUIRE(reader.categories() == std::vector<std::string>{"Empty", "Returns", "Risk"});
+            REQUIRE(reader.index().size() == (granularity == FrameGranularity::Chart ? 6u : 3u));
+
+            auto restored = reader.readAll();
+            REQUIRE(MessageDifferencer::Equals(restored, original));
+        }
+    }
+}
+
+TEST_CASE("FramedTearSheet: reads a single category", "[framed_serializer]") {
+    const auto original = makeFullTearSheet();
+    std::stringstream stream;
+    const auto written = FramedTearSheetWriter::write(original, stream,
+                                                      {.compression_level = 9, .granularity = FrameGranularity::Chart});
+    REQUIRE(written == stream.str().size());
+
+    FramedTearSheetReader reader(stream);
+    REQUIRE(reader.hasCategory("Risk"));
+    REQUIRE_FALSE(reader.hasCategory("Missing"));
+
+    auto risk = reader.readCategory("Risk");
+    REQUIRE(MessageDifferencer::Equals(risk, original.categories().at("Risk")));
+
+    // Out-of-order reads seek back to earlier frames
+    auto returns = reader.readCategory("Returns");
+    REQUIRE(returns.charts().charts_size() == 2);
+    REQUIRE(returns.charts().charts(1).lines_def().chart_def().id() == "drawdown");
+    REQUIRE(MessageDifferencer::Equals(returns, original.categories().at("Returns")));
+
+    REQUIRE_THROWS_WITH(reader.readCategory("Missing"), ContainsSubstring("category not found"));
+}
+
+TEST_CASE("FramedTearSheet: output is deterministic", "[framed_serializer]") {
+    const auto original = makeFullTearSheet();
+    REQUIRE(FramedTearSheetWriter::writeToString(original) == FramedTearSheetWriter::writeToString(original));
+}
+
+TEST_CASE("FramedTearSheet: invalid input", "[framed_serializer]") {
+    SECTION("Bad magic") {
+        std::istringstream in("not a tearsheet");
+        REQUIRE_THROWS_WITH(FramedTearSheetReader(in), ContainsSubstring("bad magic"));
+    }
+
+    SECTION("Truncated frame") {
+        auto bytes = FramedTearSheetWriter::writeToString(makeFullTearSheet());
+        bytes.resize(bytes.size() - 10);
+        std::istringstream in(bytes);
+        FramedTearSheetReader reader(in);
+        REQUIRE_THROWS_WITH(reader.readCategory("Risk"), ContainsSubstring("truncated frame"));
+    }
+
+    SECTION("Corrupt sizes are rejected before allocating") {
+        const auto bytes = FramedTearSheetWriter::writeToString(makeFullTearSheet());
+
+        auto huge_count = bytes;
+        std::fill(huge_count.begin() + 8, huge_count.begin() + 12, '\xFF');
+        std::istringstream count_in(huge_count);
+        REQUIRE_THROWS_WITH(FramedTearSheetReader(count_in), ContainsSubstring("corrupt index"));
+
+        std::istringstream in(bytes);
+        const auto first = FramedTearSheetReader(in).index().front();
+        // Header, then the first entry's name length, name, kind, chart index, offset and compressed size
+        const size_t raw_size_at = 12 + 2 + first.category.size() + 1 + 4 + 8 + 8;
+
+        auto huge_raw = bytes;
+        std::fill(huge_raw.begin() + raw_size_at, huge_raw.begin() + raw_size_at + 8, '\xFF');
+        std::istringstream raw_in(huge_raw);
+        FramedTearSheetReader raw_reader(raw_in);
+        REQUIRE_THROWS_WITH(raw_reader.readCategory(first.category), ContainsSubstring("corrupt frame"));
+
+        auto huge_compressed = bytes;
+        std::fill(huge_compressed.begin() + raw_size_at - 8, huge_compressed.begin() + raw_size_at, '\xFF');
+        std::istringstream compressed_in(huge_compressed);
+        FramedTearSheetReader compressed_reader(compressed_in);
+        REQUIRE_THROWS_WITH(compressed_reader.readCategory(first.category), ContainsSubstring("truncated frame"));
+    }
+
+    SECTION("Compression level out of range") {
+        REQUIRE_THROWS_WITH(FramedTearSheetWriter::writeToString(makeFullTearSheet(), {.compression_level = 100}),
+                            ContainsSubstring("out of range"));
+    }
+}
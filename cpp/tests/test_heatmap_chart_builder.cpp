@@ -1,7 +1,12 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
 #include "epoch_dashboard/tearsheet/heatmap_chart_builder.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
 
 using namespace epoch_tearsheet;
+using namespace epoch_frame;
+using Catch::Matchers::ContainsSubstring;
 
 TEST_CASE("HeatMapChartBuilder: Basic construction", "[heatmap]") {
     auto chart = HeatMapChartBuilder()
@@ -85,4 +90,79 @@ TEST_CASE("HeatMapChartBuilder: Large correlation matrix", "[heatmap]") {
 
     auto chart = builder.build();
     REQUIRE(chart.heat_map_def().points_size() == 25);
-}
\ No newline at end of file
+}
+
+TEST_CASE("HeatMapChartBuilder: fromDataFrame", "[heatmap]") {
+    arrow::StringBuilder month_builder;
+    arrow::Int64Builder hour_builder;
+    arrow::DoubleBuilder pnl_builder;
+    REQUIRE(month_builder.AppendValues({"Jan", "Jan", "Feb"}).ok());
+    REQUIRE(hour_builder.AppendValues({9, 15, 9}).ok());
+    REQUIRE(pnl_builder.AppendValues({1.5, -0.5, 2.0}).ok());
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field("month", arrow::utf8()),
+                       arrow::field("hour", arrow::int64()),
+                       arrow::field("pnl", arrow::float64())}),
+        {month_builder.Finish().ValueOrDie(), hour_builder.Finish().ValueOrDie(), pnl_builder.Finish().ValueOrDie()});
+    DataFrame df(table);
+
+    auto chart = HeatMapChartBuilder()
+        .setTitle("PnL by Hour")
+        .fromDataFrame(df, "month", "hour", "pnl")
+        .build();
+
+    // String columns become categories, integer columns are used as indexes
+    auto& heat_map = chart.heat_map_def();
+    REQUIRE(heat_map.points_size() == 3);
+    REQUIRE(heat_map.chart_def().x_axis().categories_size() == 2);
+    REQUIRE(heat_map.chart_def().x_axis().categories(1) == "Feb");
+    REQUIRE(heat_map.chart_def().y_axis().categories_size() == 0);
+    REQUIRE(heat_map.points(2).x() == 1);
+    REQUIRE(heat_map.points(1).y() == 15);
+    REQUIRE(heat_map.points(1).value() == -0.5);
+
+    REQUIRE_THROWS_WITH(HeatMapChartBuilder().fromDataFrame(df, "month", "day", "pnl"),
+                        ContainsSubstring("missing column"));
+}
+
+TEST_CASE("HeatMapChartBuilder: fromDataFrame over chunks and bad values", "[heatmap]") {
+    arrow::Int32Builder hour_builder;
+    arrow::Int32Builder pnl_builder;
+    REQUIRE(hour_builder.AppendValues({9, 15}).ok());
+    REQUIRE(pnl_builder.AppendValues({1, 2}).ok());
+    auto first_hours = hour_builder.Finish().ValueOrDie();
+    auto first_pnl = pnl_builder.Finish().ValueOrDie();
+    REQUIRE(hour_builder.AppendValues({10}).ok());
+    REQUIRE(pnl_builder.AppendNull().ok());
+    REQUIRE(hour_builder.AppendValues({-1}).ok());
+    REQUIRE(pnl_builder.Append(4).ok());
+    auto second_hours = hour_builder.Finish().ValueOrDie();
+    auto second_pnl = pnl_builder.Finish().ValueOrDie();
+
+    auto makeFrame = [&](const std::shared_ptr<arrow::ChunkedArray>& hours) {
+        auto days = std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{
+            arrow::MakeArrayFromScalar(arrow::StringScalar("Mon"), 3).ValueOrDie(),
+            arrow::MakeArrayFromScalar(arrow::StringScalar("Tue"), 1).ValueOrDie()});
+        auto pnl = std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{first_pnl, second_pnl});
+        return DataFrame(arrow::Table::Make(
+            arrow::schema({arrow::field("day", arrow::utf8()),
+                           arrow::field("hour", arrow::int32()),
+                           arrow::field("pnl", arrow::int32())}),
+            {days, hours, pnl}));
+    };
+
+    // Chunk boundaries differ between columns; the negative hour is the last row
+    auto valid = makeFrame(std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{
+        first_hours, second_hours->Slice(0, 1), arrow::MakeArrayFromScalar(arrow::Int32Scalar(3), 1).ValueOrDie()}));
+    auto chart = HeatMapChartBuilder().fromDataFrame(valid, "day", "hour", "pnl").build();
+    const auto& heat_map = chart.heat_map_def();
+    REQUIRE(heat_map.points_size() == 3);
+    REQUIRE(heat_map.points(1).y() == 15);
+    REQUIRE(heat_map.points(1).value() == 2.0);
+    REQUIRE(heat_map.points(2).x() == 1);
+    REQUIRE(heat_map.points(2).y() == 3);
+
+    auto negative = makeFrame(std::make_shared<arrow::ChunkedArray>(arrow::ArrayVector{first_hours, second_hours}));
+    REQUIRE_THROWS_WITH(HeatMapChartBuilder().fromDataFrame(negative, "day", "hour", "pnl"),
+                        ContainsSubstring("negative axis value -1 in column 'hour' at row 3"));
+}
@@ -0,0 +1,198 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include "epoch_dashboard/tearsheet/line_builder.h"
+#include "epoch_dashboard/tearsheet/tearsheet_builder.h"
+#include <epoch_frame/dataframe.h>
+#include <epoch_frame/factory/index_factory.h>
+#include <arrow/api.h>
+#include <algorithm>
+#include <sstream>
+#include <vector>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+class RecordingSink : public InstrumentationSink {
+public:
+    void onSpan(const BuildSpan& span) override {
+        std::lock_guard lock(mutex);
+        spans.push_back(span);
+    }
+
+    std::vector<BuildSpan> spans;
+    std::mutex mutex;
+};
+
+epoch_proto::Line makeLine() {
+    return LineBuilder()
+        .setName("Equity")
+        .addPoint(1000, 1.0)
+        .addPoint(2000, 1.1)
+        .addPoint(3000, 1.2)
+        .build();
+}
+
+} // namespace
+
+TEST_CASE("Instrumentation: no sink registered emits nothing", "[instrumentation]") {
+    Instrumentation::setGlobalSink(nullptr);
+    REQUIRE(Instrumentation::currentSink() == nullptr);
+
+    ScopedSpan span("LinesChartBuilder", SpanPhase::Build);
+    REQUIRE_FALSE(span.active());
+}
+
+TEST_CASE("Instrumentation: global sink receives builder spans", "[instrumentation]") {
+    auto sink = std::make_shared<RecordingSink>();
+    Instrumentation::setGlobalSink(sink);
+
+    auto chart = LinesChartBuilder()
+        .setTitle("Equity Curve")
+        .setId("equity")
+        .addLine(makeLine())
+        .build();
+
+    Instrumentation::setGlobalSink(nullptr);
+
+#if EPOCH_DASHBOARD_INSTRUMENTATION
+    REQUIRE(sink->spans.size() == 2);
+
+    const auto& validation = sink->spans[0];
+    REQUIRE(validation.builder == "LinesChartBuilder");
+    REQUIRE(validation.phase == SpanPhase::Validation);
+    REQUIRE(validation.points_out == 3);
+
+    const auto& build = sink->spans[1];
+    REQUIRE(build.phase == SpanPhase::Build);
+    REQUIRE(build.title == "Equity Curve");
+    REQUIRE(build.chart_id == "equity");
+    REQUIRE(build.points_out == 3);
+    REQUIRE(build.bytes_serialized == static_cast<int64_t>(chart.ByteSizeLong()));
+#else
+    REQUIRE(sink->spans.empty());
+#endif
+}
+
+TEST_CASE("Instrumentation: scoped sink overrides global sink", "[instrumentation]") {
+    auto global_sink = std::make_shared<RecordingSink>();
+    auto scoped_sink = std::make_shared<RecordingSink>();
+    Instrumentation::setGlobalSink(global_sink);
+
+    {
+        InstrumentationScope scope(scoped_sink);
+        REQUIRE(Instrumentation::currentSink() == scoped_sink);
+    }
+    REQUIRE(Instrumentation::currentSink() == global_sink);
+
+    Instrumentation::setGlobalSink(nullptr);
+}
+
+TEST_CASE("Instrumentation: DashboardBuilder routes spans to its own sink", "[instrumentation]") {
+    auto sink = std::make_shared<RecordingSink>();
+    Instrumentation::setGlobalSink(nullptr);
+
+    auto chart = LinesChartBuilder().setTitle("Returns").addLine(makeLine()).build();
+    auto tearsheet = DashboardBuilder()
+        .setCategory("Overview")
+        .addChart(chart)
+        .setInstrumentationSink(sink)
+        .build();
+
+#if EPOCH_DASHBOARD_INSTRUMENTATION
+    REQUIRE(sink->spans.size() == 1);
+    REQUIRE(sink->spans[0].builder == "DashboardBuilder");
+    REQUIRE(sink->spans[0].title == "Overview");
+    REQUIRE(sink->spans[0].points_out == 1);
+    REQUIRE(sink->spans[0].bytes_serialized == static_cast<int64_t>(tearsheet.ByteSizeLong()));
+#endif
+    REQUIRE(Instrumentation::currentSink() == nullptr);
+}
+
+TEST_CASE("Instrumentation: chart builders report to the dashboard's sink", "[instrumentation]") {
+    auto sink = std::make_shared<RecordingSink>();
+    Instrumentation::setGlobalSink(nullptr);
+
+    arrow::TimestampBuilder time_builder(arrow::timestamp(arrow::TimeUnit::MILLI), arrow::default_memory_pool());
+    REQUIRE(time_builder.AppendValues(std::vector<int64_t>{1000, 2000, 3000}).ok());
+    std::shared_ptr<arrow::Array> times;
+    REQUIRE(time_builder.Finish(&times).ok());
+    arrow::DoubleBuilder equity_builder;
+    REQUIRE(equity_builder.AppendValues(std::vector<double>{1.0, 1.1, 1.2}).ok());
+    std::shared_ptr<arrow::Array> equity;
+    REQUIRE(equity_builder.Finish(&equity).ok());
+    epoch_frame::DataFrame df(epoch_frame::factory::index::make_index(times, std::nullopt, "timestamp"),
+                              arrow::Table::Make(arrow::schema({arrow::field("equity", arrow::float64())}), {equity}));
+
+    DashboardBuilder dashboard;
+    dashboard.setCategory("Overview").setInstrumentationSink(sink);
+    auto chart = LinesChartBuilder()
+        .setTitle("Equity")
+        .setInstrumentationSink(dashboard.instrumentationSink())
+        .fromDataFrame(df, {"equity"})
+        .build();
+    dashboard.addChart(chart).build();
+
+#if EPOCH_DASHBOARD_INSTRUMENTATION
+    auto conversion = std::find_if(sink->spans.begin(), sink->spans.end(), [](const BuildSpan& span) {
+        return span.builder == "LinesChartBuilder" && span.phase == SpanPhase::Conversion;
+    });
+    REQUIRE(conversion != sink->spans.end());
+    REQUIRE(conversion->title == "Equity");
+    REQUIRE(conversion->rows_in == 3);
+    REQUIRE(conversion->points_out == 3);
+    REQUIRE(sink->spans.back().builder == "DashboardBuilder");
+#endif
+    REQUIRE(Instrumentation::currentSink() == nullptr);
+}
+
+TEST_CASE("Instrumentation: allocation counter deltas", "[instrumentation]") {
+    auto sink = std::make_shared<RecordingSink>();
+    uint64_t fake_allocations = 10;
+    Instrumentation::setAllocationCounter([&] { return fake_allocations += 5; });
+
+    {
+        InstrumentationScope scope(sink);
+        ScopedSpan span("TableBuilder", SpanPhase::Conversion);
+    }
+
+    Instrumentation::setAllocationCounter(nullptr);
+
+#if EPOCH_DASHBOARD_INSTRUMENTATION
+    REQUIRE(sink->spans.size() == 1);
+    REQUIRE(sink->spans[0].allocations == 5);
+#endif
+}
+
+TEST_CASE("ChromeTraceSink: writes trace-event JSON", "[instrumentation]") {
+    std::ostringstream out;
+    {
+        ChromeTraceSink trace(out);
+
+        BuildSpan span;
+        span.builder = "LinesChartBuilder";
+        span.phase = SpanPhase::Conversion;
+        span.title = "Rolling \"Sharpe\"";
+        span.rows_in = 252;
+        span.points_out = 250;
+        span.start = std::chrono::steady_clock::now();
+        span.wall_time = std::chrono::microseconds(1500);
+        span.thread_id = std::this_thread::get_id();
+        trace.onSpan(span);
+        trace.onSpan(span);
+    }
+
+    const auto json = out.str();
+    REQUIRE_THAT(json, ContainsSubstring("{\"traceEvents\":["));
+    REQUIRE_THAT(json, ContainsSubstring("\"name\":\"Rolling \\\"Sharpe\\\"\""));
+    REQUIRE_THAT(json, ContainsSubstring("\"cat\":\"conversion\""));
+    REQUIRE_THAT(json, ContainsSubstring("\"ph\":\"X\""));
+    REQUIRE_THAT(json, ContainsSubstring("\"dur\":1500"));
+    REQUIRE_THAT(json, ContainsSubstring("\"rows_in\":252"));
+    REQUIRE_THAT(json, ContainsSubstring("\"points_out\":250"));
+    REQUIRE_THAT(json, ContainsSubstring("}},\n{"));
+    REQUIRE_THAT(json, ContainsSubstring("]}"));
+}
@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+#include "epoch_dashboard/tearsheet/json_serializer.h"
+#include "epoch_dashboard/tearsheet/bar_chart_builder.h"
+#include "epoch_dashboard/tearsheet/card_builder.h"
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include "epoch_dashboard/tearsheet/scalar_converter.h"
+#include "epoch_dashboard/tearsheet/table_builder.h"
+#include "epoch_dashboard/tearsheet/tearsheet_builder.h"
+#include <google/protobuf/util/json_util.h>
+#include <google/protobuf/util/message_differencer.h>
+#include <cmath>
+#include <limits>
+#include <sstream>
+
+using namespace epoch_tearsheet;
+using google::protobuf::util::MessageDifferencer;
+
+namespace {
+
+std::string protobufJson(const google::protobuf::Message& message) {
+    std::string json;
+    REQUIRE(google::protobuf::util::MessageToJsonString(message, &json).ok());
+    return json;
+}
+
+template <typename Message>
+Message parse(const std::string& json) {
+    Message message;
+    REQUIRE(google::protobuf::util::JsonStringToMessage(json, &message).ok());
+    return message;
+}
+
+// Doubles with an exact short spelling, so both serializers print them identically
+epoch_proto::Chart makeLines() {
+    epoch_proto::Line line;
+    line.set_name("Strategy \"A\"\n");
+    for (int64_t i = 0; i < 4; ++i) {
+        auto* point = line.add_data();
+        point->set_x(1577836800000 + i * 86400000);
+        point->set_y(0.25 * static_cast<double>(i) - 0.5);
+    }
+    line.set_line_width(2);
+    line.set_dash_style(epoch_proto::Dash);
+
+    return LinesChartBuilder()
+        .setId("equity")
+        .setTitle("Equity")
+        .setXAxisType(epoch_proto::AxisDateTime)
+        .setYAxisLabel("")
+        .addLine(line)
+        .build();
+}
+
+epoch_proto::FullTearSheet makeFullTearSheet() {
+    epoch_proto::TableRow row;
+    *row.add_values() = ScalarFactory::fromString("AAPL");
+    *row.add_values() = ScalarFactory::fromPercentValue(12.5);
+    *row.add_values() = ScalarFactory::fromInteger(0);
+
+    auto table = TableBuilder()
+        .setType(epoch_proto::WidgetDataTable)
+        .setCategory("Positions")
+        .setTitle("Top Positions")
+        .addColumn("symbol", "Symbol", epoch_proto::TypeString)
+        .addColumn("weight", "Weight", epoch_proto::TypePercent)
+        .addColumn("trades", "Trades", epoch_proto::TypeInteger)
+        .addRow(row)
+        .build();
+
+    auto bar = BarChartBuilder()
+        .setTitle("Monthly")
+        .setBarWidth(3)
+        .setVertical(true)
+        .build();
+
+    return FullDashboardBuilder()
+        .addCategoryBuilder("Strategy", DashboardBuilder()
+            .addCard(CardBuilder()
+                .setType(epoch_proto::WidgetCard)
+                .setCategory("Strategy")
+                .addCardData(CardDataBuilder()
+                    .setTitle("Sharpe")
+                    .setValue(ScalarFactory::fromDecimal(1.75))
+                    .setType(epoch_proto::TypeDecimal)
+                    .setGroup(1)
+                    .build())
+                .build())
+            .addChart(makeLines())
+            .addChart(bar))
+        .addCategoryBuilder("Positions", DashboardBuilder().addTable(table))
+        .build();
+}
+
+} // namespace
+
+TEST_CASE("JsonSerializer: matches MessageToJsonString", "[json_serializer]") {
+    SECTION("Chart") {
+        auto chart = makeLines();
+        REQUIRE(JsonSerializer::toJson(chart) == protobufJson(chart));
+    }
+
+    SECTION("Full tearsheet with sorted categories") {
+        auto full = makeFullTearSheet();
+        const auto json = JsonSerializer::toJson(full);
+        REQUIRE(json == protobufJson(full));
+        REQUIRE(json.find("\"Positions\"") < json.find("\"Strategy\""));
+        REQUIRE(json.find("\"x\":\"1577836800000\"") != std::string::npos);
+    }
+
+    SECTION("Table and category") {
+        auto full = makeFullTearSheet();
+        const auto& positions = full.categories().at("Positions");
+        REQUIRE(JsonSerializer::toJson(positions) == protobufJson(positions));
+        REQUIRE(JsonSerializer::toJson(positions.tables().tables(0)) == protobufJson(positions.tables().tables(0)));
+    }
+}
+
+TEST_CASE("JsonSerializer: round trips through JsonStringToMessage", "[json_serializer]") {
+    epoch_proto::Line line;
+    line.set_name("noise");
+    for (int64_t i = 0; i < 1000; ++i) {
+        auto* point = line.add_data();
+        point->set_x(i);
+        point->set_y(std::sin(static_cast<double>(i)) * 1e-7 + 1e21 * (i % 3 == 0));
+    }
+    line.mutable_data(1)->set_y(std::numeric_limits<double>::quiet_NaN());
+    line.mutable_data(2)->set_y(-std::numeric_limits<double>::infinity());
+    auto chart = LinesChartBuilder().setTitle("Noise").addLine(line).build();
+
+    auto parsed = parse<epoch_proto::Chart>(JsonSerializer::toJson(chart));
+    REQUIRE(std::isnan(parsed.lines_def().lines(0).data(1).y()));
+
+    // NaN never compares equal; clear it on both sides before comparing
+    parsed.mutable_lines_def()->mutable_lines(0)->mutable_data(1)->set_y(0.0);
+    chart.mutable_lines_def()->mutable_lines(0)->mutable_data(1)->set_y(0.0);
+    REQUIRE(MessageDifferencer::Equals(parsed, chart));
+}
+
+TEST_CASE("JsonSerializer: streams to an ostream", "[json_serializer]") {
+    epoch_proto::FullTearSheet full;
+    auto& category = (*full.mutable_categories())["Large"];
+    for (int c = 0; c < 8; ++c) {
+        epoch_proto::Line line;
+        line.set_name("series " + std::to_string(c));
+        for (int64_t i = 0; i < 20000; ++i) {
+            auto* point = line.add_data();
+            point->set_x(i);
+            point->set_y(static_cast<double>(i) / 8.0);
+        }
+        *category.mutable_charts()->add_charts() = LinesChartBuilder().addLine(line).build();
+    }
+
+    std::ostringstream out;
+    const auto bytes = JsonSerializer::writeTo(full, out);
+    REQUIRE(bytes > JsonSerializer::kFlushBytes);
+    REQUIRE(bytes == out.str().size());
+    REQUIRE(out.str() == JsonSerializer::toJson(full));
+    REQUIRE(MessageDifferencer::Equals(parse<epoch_proto::FullTearSheet>(out.str()), full));
+}
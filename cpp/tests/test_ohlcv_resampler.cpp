@@ -0,0 +1,157 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include "epoch_dashboard/tearsheet/ohlcv_resampler.h"
+#include <epoch_frame/dataframe.h>
+#include <epoch_frame/factory/index_factory.h>
+#include <arrow/api.h>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+constexpr int64_t kMinuteMs = 60000;
+constexpr int64_t kHourMs = 3600000;
+constexpr int64_t kDayMs = 86400000;
+constexpr int64_t kMonday = 1704067200000;  // 2024-01-01 00:00 UTC
+
+template <typename Builder, typename T>
+std::shared_ptr<arrow::Array> finish(Builder& builder, const std::vector<T>& values) {
+    REQUIRE(builder.AppendValues(values).ok());
+    std::shared_ptr<arrow::Array> array;
+    REQUIRE(builder.Finish(&array).ok());
+    return array;
+}
+
+std::shared_ptr<arrow::Table> makeTicks(const std::vector<int64_t>& times, const std::vector<double>& prices,
+                                        const std::vector<int64_t>& sizes) {
+    arrow::TimestampBuilder time_builder(arrow::timestamp(arrow::TimeUnit::MILLI), arrow::default_memory_pool());
+    arrow::DoubleBuilder price_builder;
+    arrow::Int64Builder size_builder;
+    return arrow::Table::Make(
+        arrow::schema({arrow::field("timestamp", arrow::timestamp(arrow::TimeUnit::MILLI)),
+                       arrow::field("price", arrow::float64()),
+                       arrow::field("volume", arrow::int64())}),
+        {finish(time_builder, times), finish(price_builder, prices), finish(size_builder, sizes)});
+}
+
+double valueAt(const std::shared_ptr<arrow::Table>& table, const std::string& column, int64_t row) {
+    return std::static_pointer_cast<arrow::DoubleArray>(table->GetColumnByName(column)->chunk(0))->Value(row);
+}
+
+int64_t timeAt(const std::shared_ptr<arrow::Table>& table, int64_t row) {
+    return std::static_pointer_cast<arrow::TimestampArray>(table->column(0)->chunk(0))->Value(row);
+}
+
+} // namespace
+
+TEST_CASE("ResampleSpec: bucket alignment", "[ohlcv_resampler]") {
+    const int64_t t = kMonday + 2 * kDayMs + 14 * kHourMs + 47 * kMinuteMs;  // Wed 14:47 UTC
+
+    REQUIRE(OhlcvResampler::bucketStart(t, ResampleSpec::fixed(5 * kMinuteMs)) == t - 2 * kMinuteMs);
+    REQUIRE(OhlcvResampler::bucketStart(t, ResampleSpec::calendar(ResampleSpec::Unit::Day)) == kMonday + 2 * kDayMs);
+    REQUIRE(OhlcvResampler::bucketStart(t, ResampleSpec::calendar(ResampleSpec::Unit::Week)) == kMonday);
+    REQUIRE(OhlcvResampler::bucketStart(kMonday + 40 * kDayMs, ResampleSpec::calendar(ResampleSpec::Unit::Month)) ==
+            kMonday + 31 * kDayMs);
+    REQUIRE(OhlcvResampler::bucketStart(kMonday + 100 * kDayMs, ResampleSpec::fromTimeframe("1Q")) == kMonday + 91 * kDayMs);
+
+    SECTION("Session-aware hourly bars start at the session open") {
+        // New York 09:30 open at UTC-5: 14:30 UTC
+        auto spec = ResampleSpec::fixed(kHourMs);
+        spec.utc_offset_ms = -5 * kHourMs;
+        spec.session_open_ms = 9 * kHourMs + 30 * kMinuteMs;
+        REQUIRE(OhlcvResampler::bucketStart(t, spec) == kMonday + 2 * kDayMs + 14 * kHourMs + 30 * kMinuteMs);
+
+        auto daily = ResampleSpec::calendar(ResampleSpec::Unit::Day);
+        daily.utc_offset_ms = spec.utc_offset_ms;
+        daily.session_open_ms = spec.session_open_ms;
+        // 14:00 UTC is before the open, so it belongs to Tuesday's session
+        REQUIRE(OhlcvResampler::bucketStart(kMonday + 2 * kDayMs + 14 * kHourMs, daily) ==
+                kMonday + kDayMs + 14 * kHourMs + 30 * kMinuteMs);
+    }
+
+    SECTION("Frontend timeframes") {
+        REQUIRE(ResampleSpec::fromTimeframe("5m").duration_ms == 5 * kMinuteMs);
+        REQUIRE(ResampleSpec::fromTimeframe("15min").duration_ms == 15 * kMinuteMs);
+        REQUIRE(ResampleSpec::fromTimeframe("1H").duration_ms == kHourMs);
+        REQUIRE(ResampleSpec::fromTimeframe("1D").unit == ResampleSpec::Unit::Day);
+        REQUIRE(ResampleSpec::fromTimeframe("W").unit == ResampleSpec::Unit::Week);
+        REQUIRE(ResampleSpec::fromTimeframe("3M").count == 3);
+        REQUIRE(ResampleSpec::fromTimeframe("1Y").count == 12);
+        REQUIRE_THROWS_WITH(ResampleSpec::fromTimeframe("5x"), ContainsSubstring("unsupported timeframe"));
+        REQUIRE_THROWS_WITH(ResampleSpec::fromTimeframe("0m"), ContainsSubstring("invalid timeframe"));
+        REQUIRE_THROWS_WITH(ResampleSpec::fromTimeframe("9223372036854775807m"), ContainsSubstring("invalid timeframe"));
+        REQUIRE_THROWS_WITH(ResampleSpec::fromTimeframe("400000000000000H"), ContainsSubstring("invalid timeframe"));
+        REQUIRE_THROWS_WITH(ResampleSpec::fromTimeframe("1000000000000000000Y"), ContainsSubstring("invalid timeframe"));
+    }
+}
+
+TEST_CASE("OhlcvResampler: ticks to bars", "[ohlcv_resampler]") {
+    OhlcvResampler resampler(ResampleSpec::fixed(5 * kMinuteMs), OhlcvColumns::ticks());
+
+    // Two batches; the second bar spans the batch boundary, the third is empty and skipped
+    resampler.update(*makeTicks({kMonday, kMonday + kMinuteMs, kMonday + 4 * kMinuteMs, kMonday + 6 * kMinuteMs},
+                                {10.0, 12.0, 9.0, 11.0}, {1, 2, 3, 4}));
+    resampler.update(*makeTicks({kMonday + 7 * kMinuteMs, kMonday + 16 * kMinuteMs}, {13.0, 8.0}, {5, 6}));
+    auto bars = resampler.finish();
+
+    REQUIRE(bars->num_rows() == 3);
+    REQUIRE(timeAt(bars, 0) == kMonday);
+    REQUIRE(valueAt(bars, "open", 0) == 10.0);
+    REQUIRE(valueAt(bars, "high", 0) == 12.0);
+    REQUIRE(valueAt(bars, "low", 0) == 9.0);
+    REQUIRE(valueAt(bars, "close", 0) == 9.0);
+    REQUIRE(valueAt(bars, "volume", 0) == 6.0);
+
+    REQUIRE(timeAt(bars, 1) == kMonday + 5 * kMinuteMs);
+    REQUIRE(valueAt(bars, "open", 1) == 11.0);
+    REQUIRE(valueAt(bars, "close", 1) == 13.0);
+    REQUIRE(valueAt(bars, "volume", 1) == 9.0);
+    REQUIRE(timeAt(bars, 2) == kMonday + 15 * kMinuteMs);
+
+    SECTION("The resampler is reusable after finish") {
+        resampler.update(*makeTicks({kMonday}, {1.0}, {1}));
+        REQUIRE(resampler.finish()->num_rows() == 1);
+    }
+
+    SECTION("Unsorted input is rejected") {
+        resampler.update(*makeTicks({kMonday + kHourMs}, {1.0}, {1}));
+        REQUIRE_THROWS_WITH(resampler.update(*makeTicks({kMonday}, {1.0}, {1})),
+                            ContainsSubstring("must be sorted"));
+    }
+
+    SECTION("Missing columns") {
+        OhlcvResampler bars_only(ResampleSpec::fixed(kMinuteMs));
+        REQUIRE_THROWS_WITH(bars_only.update(*makeTicks({kMonday}, {1.0}, {1})),
+                            ContainsSubstring("missing column 'open'"));
+    }
+}
+
+TEST_CASE("OhlcvResampler: DataFrame round trip into a chart", "[ohlcv_resampler]") {
+    std::vector<int64_t> times;
+    std::vector<double> prices;
+    for (int64_t i = 0; i < 3 * 24 * 60; ++i) {
+        times.push_back(kMonday + i * kMinuteMs);
+        prices.push_back(static_cast<double>(i % 100));
+    }
+    arrow::TimestampBuilder time_builder(arrow::timestamp(arrow::TimeUnit::MILLI), arrow::default_memory_pool());
+    arrow::DoubleBuilder price_builder;
+    auto table = arrow::Table::Make(arrow::schema({arrow::field("price", arrow::float64())}),
+                                    {finish(price_builder, prices)});
+    epoch_frame::DataFrame df(
+        epoch_frame::factory::index::make_index(finish(time_builder, times), std::nullopt, "timestamp"), table);
+
+    auto bars = OhlcvResampler::resample(df, ResampleSpec::fromTimeframe("1D"), OhlcvColumns::ticks("price", ""));
+    REQUIRE(bars->num_rows() == 3);
+    REQUIRE(bars->num_columns() == 5);
+    REQUIRE(valueAt(bars, "high", 0) == 99.0);
+
+    auto chart = LinesChartBuilder()
+        .setId("daily_close")
+        .setTitle("Daily Close")
+        .fromDataFrame(OhlcvResampler::toDataFrame(bars), {"close"})
+        .build();
+    REQUIRE(chart.lines_def().lines(0).data_size() == 3);
+    REQUIRE(chart.lines_def().lines(0).data(1).x() == kMonday + kDayMs);
+}
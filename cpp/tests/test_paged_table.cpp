@@ -0,0 +1,109 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/paged_table.h"
+#include "epoch_dashboard/tearsheet/table_builder.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
+#include <limits>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+// Row i has pnl (i * 7) % 10 - 5, so rows 0 and 10 tie; row 3 has a null pnl and row 4 a NaN
+epoch_frame::DataFrame makeTradeLog() {
+    arrow::StringBuilder symbol_builder;
+    arrow::DoubleBuilder pnl_builder;
+    arrow::Int64Builder qty_builder;
+    arrow::ListBuilder tags_builder(arrow::default_memory_pool(), std::make_shared<arrow::Int64Builder>());
+    for (int64_t i = 0; i < 12; ++i) {
+        REQUIRE(symbol_builder.Append("S" + std::to_string(11 - i)).ok());
+        if (i == 3) {
+            REQUIRE(pnl_builder.AppendNull().ok());
+        } else if (i == 4) {
+            REQUIRE(pnl_builder.Append(std::numeric_limits<double>::quiet_NaN()).ok());
+        } else {
+            REQUIRE(pnl_builder.Append(static_cast<double>((i * 7) % 10 - 5)).ok());
+        }
+        REQUIRE(qty_builder.Append(i).ok());
+        REQUIRE(tags_builder.AppendNull().ok());
+    }
+    std::vector<std::shared_ptr<arrow::Array>> arrays(4);
+    REQUIRE(symbol_builder.Finish(&arrays[0]).ok());
+    REQUIRE(pnl_builder.Finish(&arrays[1]).ok());
+    REQUIRE(qty_builder.Finish(&arrays[2]).ok());
+    REQUIRE(tags_builder.Finish(&arrays[3]).ok());
+
+    auto schema = arrow::schema({arrow::field("symbol", arrow::utf8()),
+                                 arrow::field("pnl", arrow::float64()),
+                                 arrow::field("qty", arrow::int64()),
+                                 arrow::field("tags", arrow::list(arrow::int64()))});
+    return epoch_frame::DataFrame(arrow::Table::Make(schema, arrays));
+}
+
+std::vector<uint32_t> rowsOf(const PagedTable& paged, size_t page, size_t page_size, const char* column,
+                             SortDirection direction = SortDirection::Ascending) {
+    return paged.pageRows(TablePageQuery{page, page_size, column, direction});
+}
+
+} // namespace
+
+TEST_CASE("PagedTable: pages in row order", "[paged_table]") {
+    PagedTable paged(makeTradeLog(), {"symbol", "qty"});
+
+    REQUIRE(paged.rowCount() == 12);
+    REQUIRE(paged.pageCount(5) == 3);
+    REQUIRE(paged.columnDefs().size() == 2);
+    REQUIRE(paged.pageRows(TablePageQuery{2, 5}) == std::vector<uint32_t>{10, 11});
+    REQUIRE(paged.pageRows(TablePageQuery{3, 5}).empty());
+
+    auto rows = paged.page(TablePageQuery{1, 5});
+    REQUIRE(rows.size() == 5);
+    REQUIRE(rows[0].values_size() == 2);
+    REQUIRE(rows[0].values(0).string_value() == "S6");
+    REQUIRE(rows[0].values(1).integer_value() == 5);
+}
+
+TEST_CASE("PagedTable: sorted pages", "[paged_table]") {
+    PagedTable paged(makeTradeLog());
+
+    SECTION("Numeric ascending is stable with nulls and NaN last") {
+        // pnl by row: -5 2 -1 null NaN 0 -3 4 1 -2 -5 2
+        REQUIRE(rowsOf(paged, 0, 4, "pnl") == std::vector<uint32_t>{0, 10, 6, 9});
+        REQUIRE(rowsOf(paged, 2, 4, "pnl") == std::vector<uint32_t>{11, 7, 3, 4});
+    }
+
+    SECTION("Descending reverses the non-null rows only") {
+        REQUIRE(rowsOf(paged, 0, 3, "pnl", SortDirection::Descending) == std::vector<uint32_t>{7, 11, 1});
+        REQUIRE(rowsOf(paged, 3, 3, "pnl", SortDirection::Descending) == std::vector<uint32_t>{0, 3, 4});
+    }
+
+    SECTION("Strings") {
+        // "S0" < "S1" < "S10" < "S11" < "S2" ...
+        REQUIRE(rowsOf(paged, 0, 4, "symbol") == std::vector<uint32_t>{11, 10, 1, 0});
+    }
+
+    SECTION("Errors") {
+        REQUIRE_FALSE(paged.isSortable("tags"));
+        REQUIRE_THROWS_WITH(rowsOf(paged, 0, 4, "tags"), ContainsSubstring("'tags' is not sortable"));
+        REQUIRE_THROWS_WITH(paged.pageRows(TablePageQuery{0, 0}), ContainsSubstring("page_size must be positive"));
+        REQUIRE_THROWS_WITH(PagedTable(makeTradeLog(), {"fees"}), ContainsSubstring("missing column 'fees'"));
+    }
+}
+
+TEST_CASE("TableBuilder: fromPage", "[paged_table]") {
+    PagedTable paged(makeTradeLog(), {"qty", "pnl"});
+
+    auto table = TableBuilder()
+        .setType(epoch_proto::WidgetDataTable)
+        .setTitle("Trades")
+        .fromPage(paged, TablePageQuery{0, 2, "qty", SortDirection::Descending})
+        .build();
+
+    REQUIRE(table.columns_size() == 2);
+    REQUIRE(table.columns(0).id() == "qty");
+    REQUIRE(table.data().rows_size() == 2);
+    REQUIRE(table.data().rows(0).values(0).integer_value() == 11);
+    REQUIRE(table.data().rows(1).values(1).decimal_value() == -5.0);
+}
@@ -0,0 +1,129 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include "epoch_dashboard/tearsheet/parquet_source.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
+#include <arrow/io/file.h>
+#include <parquet/arrow/writer.h>
+#include <filesystem>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+constexpr int64_t kDayMs = 86400000;
+constexpr int64_t kFirstDayMs = 1577836800000;  // 2020-01-01
+
+// Five years of daily rows, 100 rows per row group
+std::string writeBacktest(const std::string& name) {
+    const int64_t rows = 5 * 365;
+    arrow::TimestampBuilder time_builder(arrow::timestamp(arrow::TimeUnit::MILLI), arrow::default_memory_pool());
+    arrow::DoubleBuilder equity_builder;
+    arrow::DoubleBuilder exposure_builder;
+    for (int64_t i = 0; i < rows; ++i) {
+        REQUIRE(time_builder.Append(kFirstDayMs + i * kDayMs).ok());
+        REQUIRE(equity_builder.Append(1.0 + static_cast<double>(i) / 1000.0).ok());
+        REQUIRE(exposure_builder.Append(0.5).ok());
+    }
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field("timestamp", arrow::timestamp(arrow::TimeUnit::MILLI)),
+                       arrow::field("equity", arrow::float64()),
+                       arrow::field("exposure", arrow::float64())}),
+        {time_builder.Finish().ValueOrDie(), equity_builder.Finish().ValueOrDie(), exposure_builder.Finish().ValueOrDie()});
+
+    const auto path = (std::filesystem::temp_directory_path() / name).string();
+    auto output = arrow::io::FileOutputStream::Open(path).ValueOrDie();
+    REQUIRE(parquet::arrow::WriteTable(*table, arrow::default_memory_pool(), output, 100).ok());
+    REQUIRE(output->Close().ok());
+    return path;
+}
+
+ParquetScanOptions oneYear() {
+    ParquetScanOptions options;
+    options.columns = {"equity"};
+    options.from_ms = kFirstDayMs + 365 * kDayMs;
+    options.to_ms = kFirstDayMs + 729 * kDayMs;
+    return options;
+}
+
+} // namespace
+
+TEST_CASE("ParquetSource: row group pruning and projection", "[parquet_source]") {
+    const auto path = writeBacktest("epoch_dashboard_parquet_source.parquet");
+    ParquetSource source(path);
+    REQUIRE(source.numRowGroups() == 19);
+
+    SECTION("Only overlapping row groups are read") {
+        // Rows 365..729 live in row groups 3..7
+        REQUIRE(source.selectRowGroups(oneYear()) == std::vector<int>{3, 4, 5, 6, 7});
+        REQUIRE(source.selectRowGroups(ParquetScanOptions{}).size() == 19);
+    }
+
+    SECTION("Scans emit the exact range with projected columns") {
+        int64_t rows = 0;
+        auto stats = source.scan(oneYear(), [&](const std::shared_ptr<arrow::RecordBatch>& batch) {
+            REQUIRE(batch->num_columns() == 2);
+            REQUIRE_FALSE(batch->GetColumnByName("exposure"));
+            rows += batch->num_rows();
+        });
+        REQUIRE(stats.row_groups_total == 19);
+        REQUIRE(stats.row_groups_read == 5);
+        REQUIRE(stats.rows_read == 500);
+        REQUIRE(stats.rows_emitted == 365);
+        REQUIRE(rows == 365);
+    }
+
+    SECTION("Frames feed the chart builders") {
+        auto df = source.readDataFrame(oneYear());
+        REQUIRE(df.table()->num_rows() == 365);
+
+        auto chart = LinesChartBuilder()
+            .setId("equity")
+            .setTitle("Equity")
+            .fromDataFrame(df, {"equity"})
+            .build();
+        const auto& data = chart.lines_def().lines(0).data();
+        REQUIRE(data.size() == 365);
+        REQUIRE(data[0].x() == kFirstDayMs + 365 * kDayMs);
+    }
+
+    SECTION("Columnar lines are converted row group by row group") {
+        auto lines = source.readColumnarLines(oneYear());
+        REQUIRE(lines.size() == 1);
+        REQUIRE(lines[0].name == "equity");
+        REQUIRE(lines[0].size() == 365);
+        REQUIRE(lines[0].x.back() == kFirstDayMs + 729 * kDayMs);
+    }
+
+    SECTION("A requested index column does not shift the lines") {
+        auto options = oneYear();
+        options.columns = {"timestamp", "exposure", "equity"};
+        auto lines = source.readColumnarLines(options);
+        REQUIRE(lines.size() == 2);
+        REQUIRE(lines[0].name == "exposure");
+        REQUIRE(lines[0].y.front() == 0.5);
+        REQUIRE(lines[1].name == "equity");
+        REQUIRE(lines[1].size() == 365);
+        REQUIRE(lines[1].y.front() == 1.0 + 365.0 / 1000.0);
+
+        auto df = source.readDataFrame(options);
+        REQUIRE(df.table()->num_columns() == 2);
+        REQUIRE_FALSE(df.table()->GetColumnByName("timestamp"));
+    }
+
+    SECTION("Empty ranges and errors") {
+        auto options = oneYear();
+        options.from_ms = kFirstDayMs - 10 * kDayMs;
+        options.to_ms = kFirstDayMs - kDayMs;
+        REQUIRE(source.selectRowGroups(options).empty());
+        REQUIRE(source.readDataFrame(options).table()->num_rows() == 0);
+
+        options.columns = {"missing"};
+        REQUIRE_THROWS_WITH(source.scan(options, [](const auto&) {}), ContainsSubstring("unknown column 'missing'"));
+        REQUIRE_THROWS_WITH(ParquetSource(path + ".nope"), ContainsSubstring("failed to open"));
+    }
+
+    std::filesystem::remove(path);
+}
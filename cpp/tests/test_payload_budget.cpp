@@ -0,0 +1,241 @@
+#include <catch2/catch_test_macros.hpp>
+#include "epoch_dashboard/tearsheet/payload_budget.h"
+#include "epoch_dashboard/tearsheet/tearsheet_builder.h"
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include "epoch_dashboard/tearsheet/line_builder.h"
+#include "epoch_dashboard/tearsheet/histogram_chart_builder.h"
+#include "epoch_dashboard/tearsheet/table_builder.h"
+#include <cmath>
+
+using namespace epoch_tearsheet;
+
+namespace {
+
+constexpr int64_t kStartMs = 1704067200000;  // 2024-01-01
+constexpr int64_t kDayMs = 86400000;
+
+epoch_proto::Line makeLine(const std::string& name, int points, double spike_at = -1) {
+    LineBuilder builder;
+    builder.setName(name);
+    for (int i = 0; i < points; ++i) {
+        double y = std::sin(i / 50.0);
+        if (i == static_cast<int>(spike_at)) {
+            y = 100.0;
+        }
+        builder.addPoint(kStartMs + i * kDayMs, y);
+    }
+    return builder.build();
+}
+
+epoch_proto::Chart makeLinesChart(const std::string& id, int points) {
+    return LinesChartBuilder()
+        .setId(id)
+        .setTitle(id)
+        .addLine(makeLine("Strategy", points))
+        .addLine(makeLine("Benchmark", points))
+        .build();
+}
+
+epoch_proto::Chart makeHistogram(const std::string& id, int values) {
+    epoch_proto::Array data;
+    for (int i = 0; i < values; ++i) {
+        data.add_values()->set_decimal_value(std::sin(i * 0.37) * 0.05);
+    }
+    return HistogramChartBuilder().setId(id).setTitle(id).setData(data).setBinsCount(50).build();
+}
+
+epoch_proto::Table makeTable(const std::string& title, int rows) {
+    TableBuilder builder;
+    builder.setTitle(title)
+        .addColumn("date", "Date", epoch_proto::TypeDate)
+        .addColumn("pnl", "PnL", epoch_proto::TypeDecimal);
+    for (int i = 0; i < rows; ++i) {
+        epoch_proto::TableRow row;
+        row.add_values()->set_date_value(kStartMs + i * kDayMs);
+        row.add_values()->set_decimal_value(i * 1.5);
+        builder.addRow(row);
+    }
+    return builder.build();
+}
+
+FullDashboardBuilder makeDashboard(int line_points, int histogram_values, int table_rows) {
+    DashboardBuilder overview;
+    overview.setCategory("Overview")
+        .addChart(makeLinesChart("equity", line_points))
+        .addChart(makeHistogram("returns_dist", histogram_values))
+        .addTable(makeTable("Trades", table_rows));
+
+    FullDashboardBuilder full;
+    full.addCategoryBuilder("Overview", overview);
+    return full;
+}
+
+void requireWithin(size_t estimate, size_t actual, double tolerance) {
+    const double error = std::abs(static_cast<double>(estimate) - static_cast<double>(actual)) /
+                         static_cast<double>(actual);
+    INFO("estimate=" << estimate << " actual=" << actual);
+    REQUIRE(error < tolerance);
+}
+
+} // namespace
+
+TEST_CASE("PayloadEstimator: close to serialized size", "[payload_budget]") {
+    SECTION("Lines chart") {
+        auto chart = makeLinesChart("equity", 5000);
+        requireWithin(PayloadEstimator::estimate(chart), chart.ByteSizeLong(), 0.05);
+    }
+
+    SECTION("Histogram") {
+        auto chart = makeHistogram("dist", 5000);
+        requireWithin(PayloadEstimator::estimate(chart), chart.ByteSizeLong(), 0.05);
+    }
+
+    SECTION("Table") {
+        auto table = makeTable("Trades", 2000);
+        requireWithin(PayloadEstimator::estimate(table), table.ByteSizeLong(), 0.05);
+    }
+
+    SECTION("Full tearsheet") {
+        auto full = makeDashboard(3000, 3000, 1000).build();
+        requireWithin(PayloadEstimator::estimate(full), full.ByteSizeLong(), 0.05);
+    }
+}
+
+TEST_CASE("PayloadBudgetEnforcer: LTTB downsampling", "[payload_budget]") {
+    auto line = makeLine("Spiky", 1000, 437);
+    PayloadBudgetEnforcer::downsampleLine(line, 100);
+
+    REQUIRE(line.data_size() == 100);
+    REQUIRE(line.data(0).x() == kStartMs);
+    REQUIRE(line.data(99).x() == kStartMs + 999 * kDayMs);
+
+    bool kept_spike = false;
+    for (int i = 1; i < line.data_size(); ++i) {
+        REQUIRE(line.data(i).x() > line.data(i - 1).x());
+        kept_spike = kept_spike || line.data(i).y() == 100.0;
+    }
+    REQUIRE(kept_spike);
+
+    SECTION("Target above size is a no-op") {
+        PayloadBudgetEnforcer::downsampleLine(line, 500);
+        REQUIRE(line.data_size() == 100);
+    }
+}
+
+TEST_CASE("PayloadBudgetEnforcer: histogram pre-binning keeps quantiles", "[payload_budget]") {
+    epoch_proto::HistogramDef histogram;
+    for (int i = 0; i < 1000; ++i) {
+        histogram.mutable_data()->add_values()->set_decimal_value(static_cast<double>(999 - i));
+    }
+    PayloadBudgetEnforcer::preBinHistogram(histogram, 10);
+
+    REQUIRE(histogram.data().values_size() == 10);
+    REQUIRE(histogram.data().values(0).decimal_value() == 50.0);
+    REQUIRE(histogram.data().values(9).decimal_value() == 950.0);
+}
+
+TEST_CASE("FullDashboardBuilder: no budget leaves payload untouched", "[payload_budget]") {
+    auto builder = makeDashboard(2000, 2000, 500);
+
+    BudgetReport report;
+    auto full = builder.build(report);
+
+    REQUIRE(report.actions.empty());
+    REQUIRE(report.within_budget);
+    REQUIRE(report.estimated_bytes_before == 0);
+    REQUIRE(full.categories().at("Overview").charts().charts(0).lines_def().lines(0).data_size() == 2000);
+}
+
+TEST_CASE("FullDashboardBuilder: per-widget cap", "[payload_budget]") {
+    auto builder = makeDashboard(10000, 500, 50);
+    builder.setPayloadBudget({.per_widget_bytes = 50000});
+
+    BudgetReport report;
+    auto full = builder.build(report);
+
+    REQUIRE(report.within_budget);
+    REQUIRE(report.actions.size() == 1);
+    REQUIRE(report.actions[0].kind == DegradationKind::DownsampleLines);
+    REQUIRE(report.actions[0].widget == "equity");
+    REQUIRE(report.actions[0].items_before == 20000);
+    REQUIRE(report.actions[0].estimated_bytes_after <= 50000);
+
+    const auto& chart = full.categories().at("Overview").charts().charts(0);
+    REQUIRE(chart.ByteSizeLong() <= 55000);
+    REQUIRE(chart.lines_def().lines(0).data_size() == chart.lines_def().lines(1).data_size());
+}
+
+TEST_CASE("FullDashboardBuilder: total budget degrades in priority order", "[payload_budget]") {
+    SECTION("Lines absorb the excess first") {
+        auto builder = makeDashboard(20000, 2000, 200);
+        const size_t before = builder.estimatePayloadBytes();
+        builder.setPayloadBudget({.total_bytes = before / 2});
+
+        BudgetReport report;
+        auto full = builder.build(report);
+
+        REQUIRE(report.within_budget);
+        REQUIRE(report.actions.size() == 1);
+        REQUIRE(report.actions[0].kind == DegradationKind::DownsampleLines);
+        REQUIRE(report.estimated_bytes_after <= before / 2);
+        REQUIRE(full.ByteSizeLong() <= before / 2 * 105 / 100);
+    }
+
+    SECTION("Histograms then tables once lines hit their minimum") {
+        auto builder = makeDashboard(1000, 20000, 5000);
+        builder.setPayloadBudget({.total_bytes = 60000, .min_line_points = 500});
+
+        BudgetReport report;
+        auto full = builder.build(report);
+
+        REQUIRE(report.within_budget);
+        REQUIRE(report.actions.size() == 3);
+        REQUIRE(report.actions[0].kind == DegradationKind::DownsampleLines);
+        REQUIRE(report.actions[0].items_after == 1000);
+        REQUIRE(report.actions[1].kind == DegradationKind::PreBinHistogram);
+        REQUIRE(report.actions[2].kind == DegradationKind::TruncateTable);
+        REQUIRE(report.actions[2].widget == "Trades");
+
+        const auto& overview = full.categories().at("Overview");
+        REQUIRE(overview.charts().charts(1).histogram_def().data().values_size() >= 256);
+        REQUIRE(overview.tables().tables(0).data().rows_size() < 5000);
+        REQUIRE(overview.tables().tables(0).data().rows(0).values(1).decimal_value() == 0.0);
+    }
+
+    SECTION("Minimums can make the budget unreachable") {
+        auto builder = makeDashboard(1000, 1000, 100);
+        builder.setPayloadBudget({.total_bytes = 1000});
+
+        BudgetReport report;
+        auto full = builder.build(report);
+
+        REQUIRE_FALSE(report.within_budget);
+        const auto& overview = full.categories().at("Overview");
+        REQUIRE(overview.charts().charts(0).lines_def().lines(0).data_size() == 64);
+        REQUIRE(overview.charts().charts(1).histogram_def().data().values_size() == 256);
+        REQUIRE(overview.tables().tables(0).data().rows_size() == 10);
+    }
+}
+
+TEST_CASE("PayloadBudgetSession: caps each category as it is added", "[payload_budget]") {
+    const PayloadBudget budget{.total_bytes = 120000, .per_widget_bytes = 50000};
+    auto overview = makeDashboard(10000, 500, 50).buildCategory("Overview");
+    auto risk = overview;
+
+    PayloadBudgetSession session(budget);
+    session.addCategory("Overview", overview);
+    // The cap is already applied before the next category exists
+    REQUIRE(PayloadEstimator::estimate(overview.charts().charts(0)) <= 50000);
+    session.addCategory("Risk", risk);
+    const auto report = session.finish();
+
+    epoch_proto::FullTearSheet full;
+    (*full.mutable_categories())["Overview"] = makeDashboard(10000, 500, 50).buildCategory("Overview");
+    (*full.mutable_categories())["Risk"] = full.categories().at("Overview");
+    const auto applied = PayloadBudgetEnforcer::apply(full, budget);
+
+    REQUIRE(report.estimated_bytes_before == applied.estimated_bytes_before);
+    REQUIRE(report.estimated_bytes_after == applied.estimated_bytes_after);
+    REQUIRE(report.actions.size() == applied.actions.size());
+    REQUIRE(report.within_budget == applied.within_budget);
+}
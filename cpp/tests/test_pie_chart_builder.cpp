@@ -1,4 +1,5 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
 #include "epoch_dashboard/tearsheet/pie_chart_builder.h"
 #include "epoch_dashboard/tearsheet/scalar_converter.h"
 #include <epoch_frame/dataframe.h>
@@ -6,6 +7,7 @@
 
 using namespace epoch_tearsheet;
 using namespace epoch_frame;
+using Catch::Matchers::ContainsSubstring;
 
 TEST_CASE("PieChartBuilder: Basic construction", "[pie]") {
     auto chart = PieChartBuilder()
@@ -165,4 +167,77 @@ TEST_CASE("PieChartBuilder: Multiple series", "[pie]") {
     REQUIRE(chart.pie_def().data(0).size() == "50%");
     REQUIRE(chart.pie_def().data(1).size() == "100%");
     REQUIRE(chart.pie_def().data(1).inner_size() == "60%");
-}
\ No newline at end of file
+}
+
+TEST_CASE("PieChartBuilder: fromDataFrame top N with dictionary names", "[pie]") {
+    // 1000 rows over five sectors; sector k carries weight k + 1 per row
+    const std::vector<std::string> sectors = {"Energy", "Tech", "Finance", "Utilities", "Healthcare"};
+    arrow::StringDictionaryBuilder name_builder;
+    arrow::DoubleBuilder value_builder;
+    for (int i = 0; i < 1000; ++i) {
+        const int k = i % 5;
+        REQUIRE(name_builder.Append(sectors[k]).ok());
+        REQUIRE(value_builder.Append(static_cast<double>(k + 1)).ok());
+    }
+    REQUIRE(name_builder.AppendNull().ok());
+    REQUIRE(value_builder.Append(1000.0).ok());
+
+    std::shared_ptr<arrow::Array> name_array, value_array;
+    REQUIRE(name_builder.Finish(&name_array).ok());
+    REQUIRE(value_builder.Finish(&value_array).ok());
+
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field("sector", name_array->type()), arrow::field("pnl", arrow::float64())}),
+        {name_array, value_array});
+    DataFrame df(table);
+
+    auto chart = PieChartBuilder()
+        .fromDataFrame(df, "sector", "pnl", "PnL", PieSize(100), PieTopN{2, "Rest"})
+        .build();
+
+    auto& series = chart.pie_def().data(0);
+    REQUIRE(series.points_size() == 3);
+    REQUIRE(series.points(0).name() == "Healthcare");
+    REQUIRE(series.points(0).y() == 1000.0);
+    REQUIRE(series.points(1).name() == "Utilities");
+    REQUIRE(series.points(1).y() == 800.0);
+    // The null-named row is skipped
+    REQUIRE(series.points(2).name() == "Rest");
+    REQUIRE(series.points(2).y() == 200.0 + 400.0 + 600.0);
+}
+
+TEST_CASE("PieChartBuilder: fromDataFrame top N with string names", "[pie]") {
+    arrow::StringBuilder name_builder;
+    arrow::Int64Builder value_builder;
+    REQUIRE(name_builder.AppendValues(std::vector<std::string>{"B", "A", "B", "C", "A"}).ok());
+    REQUIRE(value_builder.AppendValues(std::vector<int64_t>{2, 3, 2, 1, 1}).ok());
+
+    std::shared_ptr<arrow::Array> name_array, value_array;
+    REQUIRE(name_builder.Finish(&name_array).ok());
+    REQUIRE(value_builder.Finish(&value_array).ok());
+
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field("name", arrow::utf8()), arrow::field("value", arrow::int64())}),
+        {name_array, value_array});
+    DataFrame df(table);
+
+    // Ties are ordered by name; every group fits so there is no remainder slice
+    auto chart = PieChartBuilder()
+        .fromDataFrame(df, "name", "value", "Data", PieSize(80), PieTopN{}, PieInnerSize(40))
+        .build();
+
+    auto& series = chart.pie_def().data(0);
+    REQUIRE(series.inner_size() == "40%");
+    REQUIRE(series.points_size() == 3);
+    REQUIRE(series.points(0).name() == "A");
+    REQUIRE(series.points(0).y() == 4.0);
+    REQUIRE(series.points(1).name() == "B");
+    REQUIRE(series.points(2).name() == "C");
+
+    REQUIRE_THROWS_WITH(PieChartBuilder().fromDataFrame(df, "missing", "value", "Data", PieSize(80), PieTopN{}),
+                        ContainsSubstring("missing column"));
+    REQUIRE_THROWS_WITH(PieChartBuilder().fromDataFrame(df, "name", "name", "Data", PieSize(80), PieTopN{}),
+                        ContainsSubstring("must be numeric"));
+    REQUIRE_THROWS_WITH(PieChartBuilder().fromDataFrame(df, "value", "value", "Data", PieSize(80), PieTopN{}),
+                        ContainsSubstring("string or dictionary"));
+}
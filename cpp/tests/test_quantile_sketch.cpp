@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/quantile_sketch.h"
+#include "epoch_dashboard/tearsheet/boxplot_chart_builder.h"
+#include "epoch_dashboard/tearsheet/histogram_chart_builder.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <vector>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+// Fat-tailed, trade-return-like values in shuffled order
+std::vector<double> makeReturns(size_t n, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::student_t_distribution<double> returns(3.0);
+    std::vector<double> values(n);
+    for (auto& value : values) {
+        value = 0.01 * returns(rng);
+    }
+    return values;
+}
+
+// Whether some exact rank of `value` is within eps * n of q * n
+bool withinRankError(const std::vector<double>& sorted, double value, double q, double eps) {
+    const auto n = static_cast<double>(sorted.size());
+    const auto lo = static_cast<double>(std::lower_bound(sorted.begin(), sorted.end(), value) - sorted.begin());
+    const auto hi = static_cast<double>(std::upper_bound(sorted.begin(), sorted.end(), value) - sorted.begin());
+    return q * n >= lo - eps * n && q * n <= hi + eps * n;
+}
+
+} // namespace
+
+TEST_CASE("QuantileSketch: exact below capacity", "[quantile_sketch]") {
+    QuantileSketch sketch;
+    for (const double value : {5.0, 1.0, 4.0, 2.0, 3.0}) {
+        sketch.update(value);
+    }
+    sketch.update(std::nan(""));
+
+    REQUIRE(sketch.count() == 5);
+    REQUIRE(sketch.quantile(0.0) == 1.0);
+    REQUIRE(sketch.quantile(0.5) == 3.0);
+    REQUIRE(sketch.quantile(0.61) == 4.0);
+    REQUIRE(sketch.quantile(1.0) == 5.0);
+    REQUIRE(sketch.binEdges(2) == std::vector<double>{1.0, 3.0, 5.0});
+
+    REQUIRE_THROWS_WITH(sketch.quantile(1.5), ContainsSubstring("[0, 1]"));
+    REQUIRE_THROWS_WITH(QuantileSketch().quantile(0.5), ContainsSubstring("no values"));
+    REQUIRE_THROWS_WITH(QuantileSketch(4), ContainsSubstring("at least 8"));
+}
+
+TEST_CASE("QuantileSketch: bounded memory and rank error", "[quantile_sketch]") {
+    auto values = makeReturns(500000, 7);
+    QuantileSketch sketch;
+    for (const double value : values) {
+        sketch.update(value);
+    }
+    std::sort(values.begin(), values.end());
+
+    REQUIRE(sketch.count() == values.size());
+    REQUIRE(sketch.retained() < 4 * QuantileSketch::kDefaultK);
+    REQUIRE(sketch.min() == values.front());
+    REQUIRE(sketch.max() == values.back());
+    for (const double q : {0.001, 0.01, 0.05, 0.25, 0.5, 0.75, 0.95, 0.99, 0.999}) {
+        INFO("q = " << q);
+        REQUIRE(withinRankError(values, sketch.quantile(q), q, 0.02));
+    }
+}
+
+TEST_CASE("QuantileSketch: merge", "[quantile_sketch]") {
+    auto first = makeReturns(200000, 1);
+    auto second = makeReturns(100000, 2);
+    for (auto& value : second) {
+        value += 0.02;  // Shifted, so the merged median differs from either part's
+    }
+
+    QuantileSketch a;
+    QuantileSketch b(QuantileSketch::kDefaultK, 99);
+    for (const double value : first) {
+        a.update(value);
+    }
+    for (const double value : second) {
+        b.update(value);
+    }
+    a.merge(b);
+    a.merge(QuantileSketch());
+
+    std::vector<double> all(first);
+    all.insert(all.end(), second.begin(), second.end());
+    std::sort(all.begin(), all.end());
+    REQUIRE(a.count() == all.size());
+    REQUIRE(a.max() == all.back());
+    for (const double q : {0.1, 0.5, 0.9}) {
+        REQUIRE(withinRankError(all, a.quantile(q), q, 0.02));
+    }
+
+    REQUIRE_THROWS_WITH(a.merge(QuantileSketch(64)), ContainsSubstring("different k"));
+}
+
+TEST_CASE("QuantileSketch: from arrow chunks", "[quantile_sketch]") {
+    auto values = makeReturns(300000, 3);
+    std::vector<std::shared_ptr<arrow::Array>> chunks;
+    for (size_t begin = 0; begin < values.size(); begin += 70000) {
+        arrow::DoubleBuilder builder;
+        for (size_t i = begin; i < std::min(begin + 70000, values.size()); ++i) {
+            REQUIRE((i % 1000 == 0 ? builder.AppendNull() : builder.Append(values[i])).ok());
+        }
+        std::shared_ptr<arrow::Array> chunk;
+        REQUIRE(builder.Finish(&chunk).ok());
+        chunks.push_back(chunk);
+    }
+    auto column = std::make_shared<arrow::ChunkedArray>(chunks);
+
+    auto sketch = QuantileSketch::fromChunkedArray(column);
+    REQUIRE(sketch.count() == 300000 - 300);
+
+    std::vector<double> valid;
+    for (size_t i = 0; i < values.size(); ++i) {
+        if (i % 1000 != 0) {
+            valid.push_back(values[i]);
+        }
+    }
+    std::sort(valid.begin(), valid.end());
+    REQUIRE(sketch.min() == valid.front());
+    for (const double q : {0.05, 0.5, 0.95}) {
+        REQUIRE(withinRankError(valid, sketch.quantile(q), q, 0.02));
+    }
+
+    epoch_frame::DataFrame df(arrow::Table::Make(arrow::schema({arrow::field("returns", arrow::float64())}), {column}));
+    REQUIRE(QuantileSketch::fromDataFrame(df, "returns").count() == sketch.count());
+    REQUIRE_THROWS_WITH(QuantileSketch::fromDataFrame(df, "pnl"), ContainsSubstring("missing column 'pnl'"));
+}
+
+TEST_CASE("QuantileSketch: box plots and histograms", "[quantile_sketch]") {
+    QuantileSketch sketch;
+    for (int i = 1; i <= 100; ++i) {
+        sketch.update(static_cast<double>(i));
+    }
+    sketch.update(1000.0);
+
+    auto box = BoxPlotChartBuilder().addSketch(sketch).addSketch(sketch, 100.0).build();
+    const auto& data = box.box_plot_def().data();
+    REQUIRE(data.points_size() == 2);
+    REQUIRE(data.points(0).q1() == 26.0);
+    REQUIRE(data.points(0).median() == 51.0);
+    REQUIRE(data.points(0).q3() == 76.0);
+    REQUIRE(data.points(0).low() == 1.0);
+    REQUIRE(data.points(0).high() == 151.0);
+    // Only the first box's fences leave the max out
+    REQUIRE(data.outliers_size() == 1);
+    REQUIRE(data.outliers(0).category_index() == 0);
+    REQUIRE(data.outliers(0).value() == 1000.0);
+    REQUIRE(data.points(1).high() == 1000.0);
+
+    auto histogram = HistogramChartBuilder().fromSketch(sketch, 10, 101).build();
+    REQUIRE(histogram.histogram_def().bins_count() == 10);
+    REQUIRE(histogram.histogram_def().data().values_size() == 101);
+    REQUIRE(histogram.histogram_def().data().values(0).decimal_value() == 1.0);
+    REQUIRE(histogram.histogram_def().data().values(100).decimal_value() == 1000.0);
+
+    REQUIRE_THROWS(HistogramChartBuilder().fromSketch(sketch, 200, 100));
+    REQUIRE_THROWS_WITH(BoxPlotChartBuilder().addSketch(QuantileSketch()), ContainsSubstring("no values"));
+}
@@ -0,0 +1,135 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/returns_statistics.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
+#include <cmath>
+#include <vector>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+using Catch::Matchers::WithinAbs;
+using Catch::Matchers::WithinRel;
+
+namespace {
+
+// Wealth 1.1, 0.88, 0.924, 1.0164: one 20% drawdown that is never regained
+const std::vector<double> kReturns = {0.1, -0.2, 0.05, 0.1};
+
+// Textbook two-pass moments to check the streaming ones against
+struct Reference {
+    double mean = 0.0;
+    double m2 = 0.0;
+    double m3 = 0.0;
+    double m4 = 0.0;
+
+    explicit Reference(const std::vector<double>& xs) {
+        for (const double x : xs) {
+            mean += x / static_cast<double>(xs.size());
+        }
+        for (const double x : xs) {
+            m2 += std::pow(x - mean, 2);
+            m3 += std::pow(x - mean, 3);
+            m4 += std::pow(x - mean, 4);
+        }
+    }
+};
+
+} // namespace
+
+TEST_CASE("ReturnsStatistics: single fused pass", "[returns_statistics]") {
+    const auto stats = ReturnsStatistics::compute(kReturns);
+    const Reference ref(kReturns);
+    const double n = 4.0;
+
+    REQUIRE(stats.observations == 4);
+    REQUIRE_THAT(stats.total_return, WithinAbs(0.0164, 1e-12));
+    REQUIRE_THAT(stats.cagr, WithinRel(std::pow(1.0164, 252.0 / n) - 1.0, 1e-9));
+    REQUIRE_THAT(stats.max_drawdown, WithinAbs(-0.2, 1e-12));
+    REQUIRE(stats.max_drawdown_duration == 3);
+    REQUIRE_THAT(stats.calmar, WithinRel(stats.cagr / 0.2, 1e-12));
+
+    const double volatility = std::sqrt(ref.m2 / (n - 1.0));
+    REQUIRE_THAT(stats.annual_volatility, WithinRel(volatility * std::sqrt(252.0), 1e-12));
+    REQUIRE_THAT(stats.sharpe, WithinRel(ref.mean / volatility * std::sqrt(252.0), 1e-12));
+    REQUIRE_THAT(stats.sortino, WithinRel(ref.mean / std::sqrt(0.04 / n) * std::sqrt(252.0), 1e-12));
+    REQUIRE_THAT(stats.skew, WithinRel(std::sqrt(n) * ref.m3 / std::pow(ref.m2, 1.5), 1e-9));
+    REQUIRE_THAT(stats.excess_kurtosis, WithinRel(n * ref.m4 / (ref.m2 * ref.m2) - 3.0, 1e-9));
+
+    REQUIRE(stats.best == 0.1);
+    REQUIRE(stats.worst == -0.2);
+    REQUIRE(stats.hit_rate == 0.75);
+    REQUIRE_THAT(stats.average_win, WithinAbs(0.25 / 3.0, 1e-15));
+    REQUIRE(stats.average_loss == -0.2);
+    REQUIRE_THAT(stats.profit_factor, WithinAbs(1.25, 1e-12));
+    REQUIRE(stats.value_at_risk_95 == -0.2);
+    REQUIRE(stats.conditional_value_at_risk_95 == -0.2);
+}
+
+TEST_CASE("ReturnsStatistics: compensated sums over long series", "[returns_statistics]") {
+    // A naive running sum of a million log1p terms drifts well past the tolerance below
+    std::vector<double> returns(1000000, 1e-4);
+    returns[0] = 0.5;
+    const auto stats = ReturnsStatistics::compute(returns, {.periods_per_year = 1e6, .risk_free_rate = 0.0});
+    REQUIRE_THAT(stats.total_return, WithinRel(1.5 * std::exp(999999.0 * std::log1p(1e-4)) - 1.0, 1e-12));
+    REQUIRE_THAT(stats.max_drawdown, WithinAbs(0.0, 1e-12));
+    REQUIRE(std::isnan(stats.average_loss));
+}
+
+TEST_CASE("ReturnsStatistics: wealth reaching zero", "[returns_statistics]") {
+    const auto stats = ReturnsStatistics::compute(std::vector<double>{0.1, -1.0, 0.5, 0.2});
+    REQUIRE(stats.total_return == -1.0);
+    REQUIRE(stats.cagr == -1.0);
+    REQUIRE(stats.max_drawdown == -1.0);
+    REQUIRE(stats.max_drawdown_duration == 3);
+    REQUIRE(stats.calmar == -1.0);
+    REQUIRE(stats.worst == -1.0);
+    REQUIRE_FALSE(std::isnan(stats.sharpe));
+
+    auto cards = stats.toCardDef("Ruin");
+    REQUIRE(cards.data(0).value().percent_value() == -100.0);
+}
+
+TEST_CASE("ReturnsStatistics: cards", "[returns_statistics]") {
+    auto cards = ReturnsStatistics::compute(kReturns).toCardDef("Strategy");
+
+    REQUIRE(cards.type() == epoch_proto::WidgetCard);
+    REQUIRE(cards.category() == "Strategy");
+    REQUIRE(cards.data_size() == 20);
+    REQUIRE(cards.data(0).title() == "Total Return");
+    REQUIRE(cards.data(0).type() == epoch_proto::TypePercent);
+    REQUIRE_THAT(cards.data(0).value().percent_value(), WithinAbs(1.64, 1e-10));
+    REQUIRE(cards.data(6).value().integer_value() == 3);
+    REQUIRE(cards.data(9).title() == "Sharpe Ratio");
+    REQUIRE(cards.data(9).type() == epoch_proto::TypeDecimal);
+    REQUIRE(cards.data(9).group() == 2);
+
+    // A flat series has no Sharpe ratio; the card carries a null instead of NaN
+    auto flat = ReturnsStatistics::compute(std::vector<double>{0.0, 0.0, 0.0}).toCardDef("Flat");
+    REQUIRE(flat.data(9).value().has_null_value());
+}
+
+TEST_CASE("ReturnsStatistics: fromDataFrame", "[returns_statistics]") {
+    arrow::DoubleBuilder builder;
+    REQUIRE(builder.AppendValues(kReturns).ok());
+    REQUIRE(builder.AppendNull().ok());
+    REQUIRE(builder.Append(std::nan("")).ok());
+    arrow::StringBuilder names;
+    REQUIRE(names.AppendValues(std::vector<std::string>{"a", "b", "c", "d", "e", "f"}).ok());
+    std::shared_ptr<arrow::Array> returns, labels;
+    REQUIRE(builder.Finish(&returns).ok());
+    REQUIRE(names.Finish(&labels).ok());
+    epoch_frame::DataFrame df(arrow::Table::Make(
+        arrow::schema({arrow::field("returns", arrow::float64()), arrow::field("name", arrow::utf8())}),
+        {returns, labels}));
+
+    const auto stats = ReturnsStatistics::fromDataFrame(df, "returns");
+    REQUIRE(stats.observations == 4);
+    REQUIRE_THAT(stats.total_return, WithinAbs(0.0164, 1e-12));
+
+    REQUIRE_THROWS_WITH(ReturnsStatistics::fromDataFrame(df, "pnl"), ContainsSubstring("missing column 'pnl'"));
+    REQUIRE_THROWS_WITH(ReturnsStatistics::fromDataFrame(df, "name"), ContainsSubstring("must be float or double"));
+    REQUIRE_THROWS_WITH(ReturnsStatistics::compute(std::vector<double>{}), ContainsSubstring("must not be empty"));
+    REQUIRE_THROWS_WITH(ReturnsStatistics::compute(std::vector<double>{-1.5}), ContainsSubstring("below -100%"));
+}
@@ -0,0 +1,166 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/rolling_statistics.h"
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include <epoch_frame/dataframe.h>
+#include <epoch_frame/factory/index_factory.h>
+#include <arrow/api.h>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+template <typename Builder, typename T>
+std::shared_ptr<arrow::Array> finish(Builder& builder, const std::vector<T>& values) {
+    REQUIRE(builder.AppendValues(values).ok());
+    std::shared_ptr<arrow::Array> array;
+    REQUIRE(builder.Finish(&array).ok());
+    return array;
+}
+
+// Deterministic daily-return-like noise around a drift, plus a correlated benchmark
+struct Series {
+    std::vector<int64_t> x;
+    std::vector<double> y;
+    std::vector<double> benchmark;
+
+    explicit Series(size_t n) {
+        for (size_t i = 0; i < n; ++i) {
+            const double t = static_cast<double>(i);
+            const double market = 0.01 * std::sin(0.37 * t) + 0.004 * std::cos(1.91 * t);
+            x.push_back(static_cast<int64_t>(i) * 86400000);
+            benchmark.push_back(market);
+            y.push_back(0.0005 + 1.3 * market + 0.006 * std::sin(2.71 * t + 1.0));
+        }
+    }
+};
+
+// Textbook O(n * w) statistic over rows [end + 1 - w, end]
+double naive(RollingStat stat, const Series& s, size_t w, size_t end) {
+    const size_t begin = end + 1 - w;
+    double mean_y = 0.0;
+    double mean_b = 0.0;
+    for (size_t j = begin; j <= end; ++j) {
+        mean_y += s.y[j] / static_cast<double>(w);
+        mean_b += s.benchmark[j] / static_cast<double>(w);
+    }
+    double var_y = 0.0;
+    double var_b = 0.0;
+    double cov = 0.0;
+    for (size_t j = begin; j <= end; ++j) {
+        var_y += (s.y[j] - mean_y) * (s.y[j] - mean_y);
+        var_b += (s.benchmark[j] - mean_b) * (s.benchmark[j] - mean_b);
+        cov += (s.y[j] - mean_y) * (s.benchmark[j] - mean_b);
+    }
+    const double stddev = std::sqrt(var_y / static_cast<double>(w - 1));
+    const auto first = s.y.begin() + static_cast<std::ptrdiff_t>(begin);
+    const auto last = s.y.begin() + static_cast<std::ptrdiff_t>(end + 1);
+    switch (stat) {
+        case RollingStat::Mean: return mean_y;
+        case RollingStat::StdDev: return stddev;
+        case RollingStat::Volatility: return stddev * std::sqrt(252.0);
+        case RollingStat::Sharpe: return mean_y / stddev * std::sqrt(252.0);
+        case RollingStat::Min: return *std::min_element(first, last);
+        case RollingStat::Max: return *std::max_element(first, last);
+        case RollingStat::Beta: return cov / var_b;
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+} // namespace
+
+TEST_CASE("RollingStatistics: matches naive windows", "[rolling_statistics]") {
+    const Series series(600);
+    RollingStatistics rolling(series.x, series.y, series.benchmark);
+
+    std::vector<RollingRequest> requests;
+    for (const size_t w : {3, 21, 63, 252}) {
+        for (const auto stat : {RollingStat::Mean, RollingStat::StdDev, RollingStat::Volatility, RollingStat::Sharpe,
+                                RollingStat::Min, RollingStat::Max, RollingStat::Beta}) {
+            requests.push_back({stat, w, ""});
+        }
+    }
+    auto lines = rolling.compute(requests);
+    REQUIRE(lines.size() == requests.size());
+
+    for (size_t r = 0; r < requests.size(); ++r) {
+        const auto& [stat, w, name] = requests[r];
+        const auto& line = lines[r];
+        INFO(line.name);
+        REQUIRE(line.name == RollingStatistics::defaultName(stat, w));
+        REQUIRE(line.size() == series.x.size() - w + 1);
+        REQUIRE(line.x.front() == series.x[w - 1]);
+        for (size_t p = 0; p < line.size(); ++p) {
+            const size_t end = w - 1 + p;
+            REQUIRE_THAT(line.y[p], WithinAbs(naive(stat, series, w, end), 1e-9));
+        }
+    }
+}
+
+TEST_CASE("RollingStatistics: lines and undefined points", "[rolling_statistics]") {
+    // Flat stretch in the middle: zero dispersion leaves Sharpe undefined there
+    std::vector<int64_t> x = {0, 1, 2, 3, 4, 5, 6};
+    std::vector<double> y = {0.01, -0.02, 0.005, 0.005, 0.005, 0.03, -0.01};
+    RollingStatistics rolling(x, y);
+
+    auto lines = rolling.compute({{RollingStat::Sharpe, 3, "Sharpe"}, {RollingStat::Min, 3, ""}});
+    REQUIRE(lines[0].name == "Sharpe");
+    REQUIRE(lines[0].x == std::vector<int64_t>{2, 3, 5, 6});
+    REQUIRE(lines[1].name == "Rolling Min (3)");
+    REQUIRE(lines[1].y == std::vector<double>{-0.02, -0.02, 0.005, 0.005, -0.01});
+
+    // Windows longer than the series give empty lines
+    REQUIRE(rolling.compute({{RollingStat::Mean, 10, ""}}).front().size() == 0);
+
+    auto chart = LinesChartBuilder().setTitle("Rolling").addLine(ColumnarLineCodec::toLegacy(lines[1])).build();
+    REQUIRE(chart.lines_def().lines(0).data_size() == 5);
+}
+
+TEST_CASE("RollingStatistics: fromDataFrame", "[rolling_statistics]") {
+    arrow::TimestampBuilder index_builder(arrow::timestamp(arrow::TimeUnit::SECOND), arrow::default_memory_pool());
+    auto index = finish(index_builder, std::vector<int64_t>{1, 2, 3, 4, 5});
+
+    arrow::DoubleBuilder returns_builder;
+    REQUIRE(returns_builder.AppendValues(std::vector<double>{0.01, 0.02}).ok());
+    REQUIRE(returns_builder.AppendNull().ok());
+    REQUIRE(returns_builder.AppendValues(std::vector<double>{0.04, 0.05}).ok());
+    std::shared_ptr<arrow::Array> returns;
+    REQUIRE(returns_builder.Finish(&returns).ok());
+    arrow::DoubleBuilder benchmark_builder;
+    auto benchmark = finish(benchmark_builder, std::vector<double>{0.01, std::nan(""), 0.03, 0.04, 0.06});
+
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field("strategy", arrow::float64()), arrow::field("benchmark", arrow::float64())}),
+        {returns, benchmark});
+    epoch_frame::DataFrame df(epoch_frame::factory::index::make_index(index, std::nullopt, "timestamp"), table);
+
+    SECTION("Nulls are dropped and the index is in ms") {
+        auto rolling = RollingStatistics::fromDataFrame(df, "strategy");
+        REQUIRE(rolling.size() == 4);
+        auto mean = rolling.compute({{RollingStat::Mean, 2, ""}}).front();
+        REQUIRE(mean.x == std::vector<int64_t>{2000, 4000, 5000});
+        REQUIRE_THAT(mean.y[1], WithinAbs(0.03, 1e-12));
+    }
+
+    SECTION("A benchmark drops its own missing rows too") {
+        auto rolling = RollingStatistics::fromDataFrame(df, "strategy", "benchmark");
+        REQUIRE(rolling.size() == 3);
+        auto beta = rolling.compute({{RollingStat::Beta, 3, ""}}).front();
+        REQUIRE(beta.x == std::vector<int64_t>{5000});
+    }
+
+    SECTION("Errors") {
+        REQUIRE_THROWS_WITH(RollingStatistics::fromDataFrame(df, "fees"), ContainsSubstring("missing column 'fees'"));
+        auto rolling = RollingStatistics::fromDataFrame(df, "strategy");
+        REQUIRE_THROWS_WITH(rolling.compute({{RollingStat::Beta, 2, ""}}), ContainsSubstring("needs a benchmark"));
+        REQUIRE_THROWS_WITH(rolling.compute({{RollingStat::StdDev, 1, ""}}), ContainsSubstring("at least 2"));
+        REQUIRE_THROWS_WITH(rolling.compute({{RollingStat::Mean, 0, ""}}), ContainsSubstring("must be positive"));
+        REQUIRE_THROWS_WITH(RollingStatistics({0, 1}, {0.1}), ContainsSubstring("same length"));
+    }
+}
@@ -0,0 +1,121 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/series_pyramid.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+// Random walk sampled every second, x in epoch ms
+ColumnarLine makeWalk(size_t samples, uint64_t seed = 7) {
+    std::mt19937_64 rng(seed);
+    std::normal_distribution<double> step(0.0, 1.0);
+    ColumnarLine line;
+    line.name = "price";
+    line.dash_style = epoch_proto::Dash;
+    double value = 100.0;
+    for (size_t i = 0; i < samples; ++i) {
+        value += step(rng);
+        line.x.push_back(static_cast<int64_t>(i) * 1000);
+        line.y.push_back(value);
+    }
+    return line;
+}
+
+} // namespace
+
+TEST_CASE("SeriesPyramid: levels", "[series_pyramid]") {
+    SeriesPyramid pyramid(makeWalk(5000));
+    REQUIRE(pyramid.size() == 5000);
+    REQUIRE(pyramid.levels() == SeriesPyramid::kMaxLevel);
+    REQUIRE(pyramid.bucketCount(0) == 5000);
+    REQUIRE(pyramid.bucketCount(1) == 2500);
+    REQUIRE(pyramid.bucketCount(10) == 4);
+    REQUIRE(pyramid.bucketCount(11) == 0);
+
+    REQUIRE(SeriesPyramid(makeWalk(5)).levels() == 2);
+    REQUIRE(SeriesPyramid(ColumnarLine{}).levels() == 0);
+
+    REQUIRE(SeriesPyramid::levelFor(400, 100) == 0);
+    REQUIRE(SeriesPyramid::levelFor(800, 100) == 3);
+    REQUIRE(SeriesPyramid::levelFor(1'000'000'000, 100) == SeriesPyramid::kMaxLevel);
+}
+
+TEST_CASE("SeriesPyramid: query", "[series_pyramid]") {
+    const auto raw = makeWalk(100000);
+    SeriesPyramid pyramid(raw);
+
+    SECTION("Narrow ranges are returned at full resolution") {
+        auto line = pyramid.query(10000, 19000, 800);
+        REQUIRE(line.name() == "price");
+        REQUIRE(line.dash_style() == epoch_proto::Dash);
+        REQUIRE(line.data_size() == 10);
+        for (int i = 0; i < line.data_size(); ++i) {
+            REQUIRE(line.data(i).x() == raw.x[static_cast<size_t>(10 + i)]);
+            REQUIRE(line.data(i).y() == raw.y[static_cast<size_t>(10 + i)]);
+        }
+    }
+
+    SECTION("Wide ranges are O(pixels) and keep first, last and extremes") {
+        const int64_t from = 1234 * 1000;
+        const int64_t to = 98765 * 1000;
+        const size_t pixels = 500;
+        auto line = pyramid.query(from, to, pixels);
+
+        REQUIRE(line.data_size() <= static_cast<int>(8 * pixels + 4 * SeriesPyramid::kMaxLevel));
+        REQUIRE(line.data(0).x() == from);
+        REQUIRE(line.data(line.data_size() - 1).x() == to);
+        for (int i = 1; i < line.data_size(); ++i) {
+            REQUIRE(line.data(i - 1).x() < line.data(i).x());
+        }
+
+        const auto first = raw.y.begin() + 1234;
+        const auto last = raw.y.begin() + 98766;
+        auto [raw_min, raw_max] = std::minmax_element(first, last);
+        auto [out_min, out_max] = std::minmax_element(line.data().begin(), line.data().end(),
+            [](const auto& a, const auto& b) { return a.y() < b.y(); });
+        REQUIRE(out_min->y() == *raw_min);
+        REQUIRE(out_max->y() == *raw_max);
+    }
+
+    SECTION("Every bucket extreme is kept") {
+        // 1024 samples per bucket at level 10, 4 points per bucket
+        auto line = pyramid.query(0, 65535 * 1000, 64);
+        REQUIRE(line.data_size() <= 64 * 4);
+        for (size_t bucket = 0; bucket < 64; ++bucket) {
+            const auto begin = raw.y.begin() + static_cast<std::ptrdiff_t>(bucket * 1024);
+            const double expected = *std::max_element(begin, begin + 1024);
+            REQUIRE(std::any_of(line.data().begin(), line.data().end(),
+                                [&](const auto& point) { return point.y() == expected; }));
+        }
+    }
+
+    SECTION("Errors and empty ranges") {
+        REQUIRE(pyramid.query(-5000, -1000, 100).data_size() == 0);
+        REQUIRE_THROWS_WITH(pyramid.query(0, 1000, 0), ContainsSubstring("pixel_width"));
+        REQUIRE_THROWS_WITH(pyramid.query(1000, 0, 10), ContainsSubstring("from_ms"));
+
+        ColumnarLine mismatched = makeWalk(3);
+        mismatched.y.pop_back();
+        REQUIRE_THROWS_WITH(SeriesPyramid(mismatched), ContainsSubstring("lengths differ"));
+    }
+}
+
+TEST_CASE("SeriesPyramid: NaN samples never become extremes", "[series_pyramid]") {
+    auto line = makeWalk(4096);
+    for (size_t i = 0; i < line.y.size(); i += 3) {
+        line.y[i] = std::numeric_limits<double>::quiet_NaN();
+    }
+    SeriesPyramid pyramid(line);
+
+    auto out = pyramid.query(0, 4095 * 1000, 16);
+    for (int i = 1; i + 1 < out.data_size(); ++i) {
+        const bool bucket_edge = out.data(i).x() % (256 * 1000) == 0 || (out.data(i).x() / 1000 + 1) % 256 == 0;
+        REQUIRE((bucket_edge || !std::isnan(out.data(i).y())));
+    }
+}
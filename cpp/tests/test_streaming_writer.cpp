@@ -0,0 +1,122 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/streaming_writer.h"
+#include "epoch_dashboard/tearsheet/tearsheet_builder.h"
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include "epoch_dashboard/tearsheet/line_builder.h"
+#include "epoch_dashboard/tearsheet/table_builder.h"
+#include <google/protobuf/io/zero_copy_stream_impl_lite.h>
+#include <google/protobuf/util/message_differencer.h>
+#include <sstream>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+using google::protobuf::util::MessageDifferencer;
+
+namespace {
+
+epoch_proto::TearSheet makeCategory(const std::string& id, int points) {
+    LineBuilder line;
+    line.setName(id);
+    for (int i = 0; i < points; ++i) {
+        line.addPoint(1704067200000 + i * 86400000LL, 100.0 + i * 0.5);
+    }
+    epoch_proto::ColumnDef column;
+    column.set_id("metric");
+    column.set_name("Metric");
+    column.set_type(epoch_proto::TypeString);
+
+    return DashboardBuilder()
+        .addChart(LinesChartBuilder().setId(id).setTitle(id).addLine(line.build()).build())
+        .addTable(TableBuilder().setTitle(id).addColumn(column).build())
+        .build();
+}
+
+FullDashboardBuilder makeBuilder() {
+    FullDashboardBuilder builder;
+    builder.addCategory("Strategy", makeCategory("equity", 200));
+    builder.addCategory("Risk", makeCategory("drawdown", 50));
+    builder.addCategory("", makeCategory("unnamed", 1));
+    return builder;
+}
+
+} // namespace
+
+TEST_CASE("StreamingTearSheetWriter: output parses as FullTearSheet", "[streaming_writer]") {
+    std::string bytes;
+    {
+        google::protobuf::io::StringOutputStream stream(&bytes);
+        StreamingTearSheetWriter writer(&stream);
+        writer.writeCategory("Strategy", makeCategory("equity", 20));
+        writer.writeCategory("Risk", epoch_proto::TearSheet{});
+        REQUIRE(writer.categoriesWritten() == 2);
+        const auto written = writer.finish();
+        REQUIRE(written == bytes.size());
+    }
+
+    epoch_proto::FullTearSheet parsed;
+    REQUIRE(parsed.ParseFromString(bytes));
+    REQUIRE(parsed.categories_size() == 2);
+    REQUIRE(MessageDifferencer::Equals(parsed.categories().at("Strategy"), makeCategory("equity", 20)));
+    REQUIRE_FALSE(parsed.categories().at("Risk").has_charts());
+}
+
+TEST_CASE("StreamingTearSheetWriter: misuse", "[streaming_writer]") {
+    std::string bytes;
+    google::protobuf::io::StringOutputStream stream(&bytes);
+    StreamingTearSheetWriter writer(&stream);
+    writer.writeCategory("Strategy", epoch_proto::TearSheet{});
+
+    REQUIRE_THROWS_WITH(writer.writeCategory("Strategy", epoch_proto::TearSheet{}),
+                        ContainsSubstring("duplicate category"));
+
+    writer.finish();
+    REQUIRE_THROWS_WITH(writer.writeCategory("Risk", epoch_proto::TearSheet{}),
+                        ContainsSubstring("already finished"));
+}
+
+TEST_CASE("FullDashboardBuilder: writeTo matches build", "[streaming_writer]") {
+    auto builder = makeBuilder();
+    const auto expected = builder.build();
+
+    SECTION("ostream") {
+        std::ostringstream out;
+        const auto bytes = builder.writeTo(out);
+        REQUIRE(bytes == out.str().size());
+
+        epoch_proto::FullTearSheet parsed;
+        REQUIRE(parsed.ParseFromString(out.str()));
+        REQUIRE(MessageDifferencer::Equals(parsed, expected));
+    }
+
+    SECTION("Same bytes as deterministic serialization") {
+        std::string streamed;
+        {
+            google::protobuf::io::StringOutputStream stream(&streamed);
+            builder.writeTo(&stream);
+        }
+
+        std::string serialized;
+        {
+            google::protobuf::io::StringOutputStream stream(&serialized);
+            google::protobuf::io::CodedOutputStream out(&stream);
+            out.SetSerializationDeterministic(true);
+            expected.SerializeToCodedStream(&out);
+        }
+        REQUIRE(streamed == serialized);
+    }
+
+    SECTION("Payload budget is applied") {
+        PayloadBudget budget;
+        budget.total_bytes = 2000;
+        builder.setPayloadBudget(budget);
+
+        std::ostringstream out;
+        builder.writeTo(out);
+
+        epoch_proto::FullTearSheet parsed;
+        REQUIRE(parsed.ParseFromString(out.str()));
+        REQUIRE(MessageDifferencer::Equals(parsed, builder.build()));
+        REQUIRE(out.str().size() < expected.ByteSizeLong());
+    }
+}
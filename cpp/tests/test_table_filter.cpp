@@ -0,0 +1,130 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/table_filter.h"
+#include "epoch_dashboard/tearsheet/paged_table.h"
+#include "epoch_dashboard/tearsheet/table_builder.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+// side alternates long/short, pnl = i - 4 with row 5 null, symbols cycle A B C
+epoch_frame::DataFrame makeTrades() {
+    arrow::StringDictionaryBuilder side_builder;
+    arrow::StringBuilder symbol_builder;
+    arrow::DoubleBuilder pnl_builder;
+    arrow::Int64Builder qty_builder;
+    const std::vector<std::string> symbols = {"A", "B", "C"};
+    for (int64_t i = 0; i < 9; ++i) {
+        REQUIRE(side_builder.Append(i % 2 == 0 ? "long" : "short").ok());
+        REQUIRE(symbol_builder.Append(symbols[i % 3]).ok());
+        REQUIRE((i == 5 ? pnl_builder.AppendNull() : pnl_builder.Append(static_cast<double>(i - 4))).ok());
+        REQUIRE(qty_builder.Append(10 * (9 - i)).ok());
+    }
+    std::vector<std::shared_ptr<arrow::Array>> arrays(4);
+    REQUIRE(side_builder.Finish(&arrays[0]).ok());
+    REQUIRE(symbol_builder.Finish(&arrays[1]).ok());
+    REQUIRE(pnl_builder.Finish(&arrays[2]).ok());
+    REQUIRE(qty_builder.Finish(&arrays[3]).ok());
+
+    auto schema = arrow::schema({arrow::field("side", arrays[0]->type()),
+                                 arrow::field("symbol", arrow::utf8()),
+                                 arrow::field("pnl", arrow::float64()),
+                                 arrow::field("qty", arrow::int64())});
+    return epoch_frame::DataFrame(arrow::Table::Make(schema, arrays));
+}
+
+} // namespace
+
+TEST_CASE("TableFilter: select", "[table_filter]") {
+    auto table = makeTrades().table();
+
+    SECTION("Comparisons over dictionary and numeric columns") {
+        REQUIRE(TableFilter::equal("side", "long").select(table) == std::vector<uint32_t>{0, 2, 4, 6, 8});
+        REQUIRE(TableFilter::less("pnl", 0.0).select(table) == std::vector<uint32_t>{0, 1, 2, 3});
+        // The null pnl never matches, even under negation
+        REQUIRE(TableFilter::notEqual("pnl", 0.0).select(table).size() == 7);
+        REQUIRE(TableFilter::greaterEqual("qty", int64_t{70}).select(table) == std::vector<uint32_t>{0, 1, 2});
+    }
+
+    SECTION("IN, AND and OR") {
+        auto long_losers = TableFilter::allOf({TableFilter::equal("side", "long"), TableFilter::less("pnl", 0.0)});
+        REQUIRE(long_losers.select(table) == std::vector<uint32_t>{0, 2});
+
+        auto symbols = TableFilter::isIn("symbol", {"A", "C"});
+        REQUIRE(symbols.select(table) == std::vector<uint32_t>{0, 2, 3, 5, 6, 8});
+
+        auto either = TableFilter::anyOf({TableFilter::isIn("side", {"short"}), TableFilter::greater("pnl", 3.0)});
+        REQUIRE(either.select(table) == std::vector<uint32_t>{1, 3, 5, 7, 8});
+    }
+
+    SECTION("Canonical keys") {
+        auto filter = TableFilter::allOf({TableFilter::equal("side", "long"), TableFilter::isIn("qty", {int64_t{1}, int64_t{2}})});
+        REQUIRE(filter.key() == R"(("side" = 'long' AND "qty" IN [1, 2]))");
+        REQUIRE(TableFilter::less("pnl", 0.0).key() != TableFilter::less("pnl", int64_t{0}).key());
+    }
+
+    SECTION("Errors") {
+        REQUIRE_THROWS_WITH(TableFilter::equal("fees", 1.0).select(table), ContainsSubstring("missing column 'fees'"));
+        REQUIRE_THROWS_WITH(TableFilter::isIn("symbol", {}), ContainsSubstring("at least one value"));
+        REQUIRE_THROWS_WITH(TableFilter::isIn("symbol", {"A", int64_t{1}}), ContainsSubstring("mixes value types"));
+        REQUIRE_THROWS_WITH(TableFilter::allOf({}), ContainsSubstring("at least one filter"));
+        REQUIRE_THROWS_AS(TableFilter::less("symbol", 1.0).select(table), std::runtime_error);
+    }
+}
+
+TEST_CASE("TableFilterCache: memoizes per filter and frame", "[table_filter]") {
+    TableFilterCache cache(2);
+    auto table = makeTrades().table();
+    auto losers = TableFilter::less("pnl", 0.0);
+
+    auto first = cache.select(losers, table);
+    auto second = cache.select(TableFilter::less("pnl", 0.0), table);
+    REQUIRE(first == second);
+    REQUIRE(cache.hits() == 1);
+    REQUIRE(cache.misses() == 1);
+
+    // Same filter on another frame is a separate entry
+    auto other = makeTrades().table();
+    REQUIRE(*cache.select(losers, other) == *first);
+    REQUIRE(cache.misses() == 2);
+
+    cache.select(TableFilter::equal("side", "long"), table);
+    REQUIRE(cache.size() == 2);
+    cache.select(losers, table);
+    REQUIRE(cache.misses() == 4);
+}
+
+TEST_CASE("TableFilter: pages and tables", "[table_filter]") {
+    auto df = makeTrades();
+    auto shorts = TableFilter::equal("side", "short");
+
+    PagedTable paged(df, {"symbol", "qty"});
+    REQUIRE(paged.rowCount(shorts) == 4);
+    REQUIRE(paged.pageCount(3, shorts) == 2);
+    REQUIRE(paged.pageRows(TablePageQuery{1, 3, std::nullopt, SortDirection::Ascending, shorts}) ==
+            std::vector<uint32_t>{7});
+    // qty falls with the row number, so ascending qty visits short rows 7, 5, 3, 1
+    REQUIRE(paged.pageRows(TablePageQuery{0, 3, "qty", SortDirection::Ascending, shorts}) ==
+            std::vector<uint32_t>{7, 5, 3});
+    REQUIRE(paged.pageRows(TablePageQuery{1, 3, "qty", SortDirection::Descending, shorts}) ==
+            std::vector<uint32_t>{7});
+    // The restricted sort index is reused across pages and directions
+    REQUIRE(paged.pageRows(TablePageQuery{0, 3, "qty", SortDirection::Descending, shorts}) ==
+            std::vector<uint32_t>{1, 3, 5});
+    REQUIRE(paged.pageRows(TablePageQuery{1, 3, "qty", SortDirection::Ascending, shorts}) ==
+            std::vector<uint32_t>{1});
+    REQUIRE(paged.pageRows(TablePageQuery{2, 3, "qty", SortDirection::Ascending, shorts}).empty());
+
+    auto table = TableBuilder()
+        .setType(epoch_proto::WidgetDataTable)
+        .fromDataFrame(df, TableFilter::isIn("symbol", {"B"}), {"symbol", "pnl"})
+        .build();
+    REQUIRE(table.columns_size() == 2);
+    REQUIRE(table.data().rows_size() == 3);
+    REQUIRE(table.data().rows(0).values(1).decimal_value() == -3.0);
+    REQUIRE(table.data().rows(2).values(1).decimal_value() == 3.0);
+}
@@ -0,0 +1,159 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_floating_point.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/instrumentation.h"
+#include "epoch_dashboard/tearsheet/tearsheet_plan.h"
+#include <epoch_frame/dataframe.h>
+#include <epoch_frame/factory/index_factory.h>
+#include <arrow/api.h>
+#include <mutex>
+#include <set>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+using Catch::Matchers::WithinAbs;
+
+namespace {
+
+class RecordingSink : public InstrumentationSink {
+public:
+    void onSpan(const BuildSpan& span) override {
+        std::lock_guard lock(mutex);
+        builders.insert(std::string(span.builder));
+    }
+
+    std::set<std::string> builders;
+    std::mutex mutex;
+};
+
+constexpr int64_t kDayMs = 86400000;
+constexpr int64_t kFirstDayMs = 1577836800000;  // 2020-01-01
+
+template <typename Builder, typename T>
+std::shared_ptr<arrow::Array> finish(Builder& builder, const std::vector<T>& values) {
+    REQUIRE(builder.AppendValues(values).ok());
+    std::shared_ptr<arrow::Array> array;
+    REQUIRE(builder.Finish(&array).ok());
+    return array;
+}
+
+epoch_frame::DataFrame makeStrategy() {
+    std::vector<int64_t> times;
+    for (int64_t i = 0; i < 5; ++i) {
+        times.push_back(kFirstDayMs + i * kDayMs);
+    }
+    arrow::TimestampBuilder time_builder(arrow::timestamp(arrow::TimeUnit::MILLI), arrow::default_memory_pool());
+    arrow::DoubleBuilder equity_builder;
+    arrow::DoubleBuilder benchmark_builder;
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field("equity", arrow::float64()), arrow::field("benchmark", arrow::float64())}),
+        {finish(equity_builder, std::vector<double>{100.0, 110.0, 99.0, 121.0, 110.0}),
+         finish(benchmark_builder, std::vector<double>{100.0, 101.0, 102.0, 103.0, 104.0})});
+    return epoch_frame::DataFrame(
+        epoch_frame::factory::index::make_index(finish(time_builder, times), std::nullopt, "timestamp"), table);
+}
+
+// `pnl` and `rets` are the same derivation under two names; `unused` is never referenced
+constexpr const char* kSpec = R"(
+series:
+  - {name: rets, op: returns, source: equity}
+  - {name: pnl, op: returns, source: equity}
+  - {name: growth, op: cumulative_returns, source: rets}
+  - {name: drawdown, op: drawdown, source: equity}
+  - {name: equity_ma, op: rolling_mean, source: equity, window: 2}
+  - {name: unused, op: returns, source: benchmark}
+categories:
+  - name: Performance
+    widgets:
+      - {type: lines, id: equity, title: Equity, columns: [equity, equity_ma]}
+      - {type: lines, id: growth, title: Growth, columns: [growth]}
+      - {type: histogram, title: Returns, columns: [rets], bins: 4}
+  - name: Risk
+    widgets:
+      - {type: area, id: drawdown, title: Drawdown, columns: [drawdown]}
+      - {type: table, title: Daily PnL, columns: [pnl, equity]}
+)";
+
+} // namespace
+
+TEST_CASE("TearsheetPlan: shared reads and derivations are planned once", "[tearsheet_plan]") {
+    auto plan = TearsheetPlan::compile(TearsheetSpec::fromYaml(kSpec));
+
+    REQUIRE(plan.sourceColumns() == std::vector<std::string>{"equity"});
+    // rets/pnl, growth, drawdown, equity_ma
+    REQUIRE(plan.derivedCount() == 4);
+    REQUIRE(plan.stageCount() == 2);
+}
+
+TEST_CASE("TearsheetPlan: execute builds every category", "[tearsheet_plan]") {
+    auto plan = TearsheetPlan::compile(TearsheetSpec::fromYaml(kSpec));
+    auto full = plan.execute(makeStrategy()).build();
+
+    REQUIRE(full.categories().size() == 2);
+    const auto& performance = full.categories().at("Performance");
+    REQUIRE(performance.charts().charts_size() == 3);
+
+    const auto& equity = performance.charts().charts(0).lines_def();
+    REQUIRE(equity.chart_def().category() == "Performance");
+    REQUIRE(equity.lines_size() == 2);
+    REQUIRE(equity.lines(0).data_size() == 5);
+    // The first rolling mean needs two rows
+    REQUIRE(equity.lines(1).data_size() == 4);
+    REQUIRE(equity.lines(1).data(0).y() == 105.0);
+
+    const auto& growth = performance.charts().charts(1).lines_def().lines(0);
+    REQUIRE(growth.data_size() == 4);
+    REQUIRE_THAT(growth.data(3).y(), WithinAbs(0.1, 1e-12));
+
+    const auto& risk = full.categories().at("Risk");
+    const auto& drawdown = risk.charts().charts(0).area_def().areas(0);
+    REQUIRE(drawdown.data(2).y() == 99.0 / 110.0 - 1.0);
+    REQUIRE(drawdown.data(3).y() == 0.0);
+    REQUIRE(risk.tables().tables(0).data().rows_size() == 5);
+
+    // The compiled plan is reusable across frames
+    REQUIRE(plan.execute(makeStrategy()).build().categories().size() == 2);
+}
+
+TEST_CASE("TearsheetPlan: worker threads report to the caller's sink", "[tearsheet_plan]") {
+    auto plan = TearsheetPlan::compile(TearsheetSpec::fromYaml(kSpec));
+    auto sink = std::make_shared<RecordingSink>();
+    Instrumentation::setGlobalSink(nullptr);
+    {
+        InstrumentationScope scope(sink);
+        plan.execute(makeStrategy());
+    }
+
+#if EPOCH_DASHBOARD_INSTRUMENTATION
+    for (const char* builder : {"TearsheetPlan", "LinesChartBuilder", "HistogramChartBuilder",
+                                "AreaChartBuilder", "TableBuilder"}) {
+        INFO(builder);
+        REQUIRE(sink->builders.count(builder) == 1);
+    }
+#endif
+    REQUIRE(Instrumentation::currentSink() == nullptr);
+}
+
+TEST_CASE("TearsheetPlan: errors", "[tearsheet_plan]") {
+    auto cyclic = TearsheetSpec::fromYaml(R"(
+series:
+  - {name: a, op: returns, source: b}
+  - {name: b, op: drawdown, source: a}
+categories:
+  - {name: A, widgets: [{type: lines, columns: [a]}]}
+)");
+    REQUIRE_THROWS_WITH(TearsheetPlan::compile(cyclic), ContainsSubstring("depends on itself"));
+
+    auto duplicate = TearsheetSpec::fromYaml(R"(
+series:
+  - {name: a, op: returns, source: equity}
+  - {name: a, op: drawdown, source: equity}
+categories:
+  - {name: A, widgets: [{type: lines, columns: [a]}]}
+)");
+    REQUIRE_THROWS_WITH(TearsheetPlan::compile(duplicate), ContainsSubstring("duplicate series 'a'"));
+
+    auto missing = TearsheetPlan::compile(
+        TearsheetSpec::fromYaml("categories: [{name: A, widgets: [{type: lines, columns: [sharpe]}]}]"));
+    REQUIRE_THROWS_WITH(missing.execute(makeStrategy()), ContainsSubstring("missing column 'sharpe'"));
+}
@@ -0,0 +1,184 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/server/mock_provider.h"
+#include "epoch_dashboard/server/tearsheet_service.h"
+#include "epoch_dashboard/tearsheet/line_builder.h"
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include <arrow/api.h>
+#include <arrow/io/memory.h>
+#include <arrow/ipc/reader.h>
+#include <atomic>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+// Ten daily points from day 0; sidecar series "prices" with the same x values
+class FakeProvider final : public TearSheetProvider {
+public:
+    explicit FakeProvider(std::atomic<int>& loads) : loads_(loads) {}
+
+    FullDashboardBuilder load(const ArrowSidecarPtr& sidecar) const override {
+        ++loads_;
+        arrow::Int64Builder x_builder;
+        arrow::DoubleBuilder y_builder;
+        LineBuilder line;
+        line.setName("equity");
+        for (int64_t i = 0; i < 10; ++i) {
+            line.addPoint(i * 1000, static_cast<double>(i));
+            REQUIRE(x_builder.Append(i * 1000).ok());
+            REQUIRE(y_builder.Append(static_cast<double>(i)).ok());
+        }
+        auto table = arrow::Table::Make(
+            arrow::schema({arrow::field(ArrowSidecar::kXColumn, arrow::int64()), arrow::field("price", arrow::float64())}),
+            {x_builder.Finish().ValueOrDie(), y_builder.Finish().ValueOrDie()});
+        sidecar->add("prices", table);
+
+        FullDashboardBuilder dashboard;
+        dashboard.addCategoryBuilder("Strategy", DashboardBuilder().addChart(
+            LinesChartBuilder().setId("equity").setTitle("Equity").addLine(line.build()).build()));
+        dashboard.addCategoryFactory("Risk", [] { return DashboardBuilder(); });
+        return dashboard;
+    }
+
+private:
+    std::atomic<int>& loads_;
+};
+
+ServiceRequest get(const std::string& path, std::map<std::string, std::string> query = {}) {
+    return ServiceRequest{path, std::move(query), ""};
+}
+
+std::shared_ptr<arrow::Table> readIPC(const std::string& body) {
+    auto input = std::make_shared<arrow::io::BufferReader>(arrow::Buffer::FromString(body));
+    return arrow::ipc::RecordBatchStreamReader::Open(input).ValueOrDie()->ToTable().ValueOrDie();
+}
+
+} // namespace
+
+TEST_CASE("TearSheetService: routes", "[tearsheet_service]") {
+    std::atomic<int> loads{0};
+    TearSheetService service;
+    service.registerProvider("fake", std::make_shared<FakeProvider>(loads));
+
+    SECTION("Provider list") {
+        auto response = service.handle(get("/tearsheets"));
+        REQUIRE(response.status == 200);
+        REQUIRE(response.body == "fake\n");
+        REQUIRE(loads == 0);
+    }
+
+    SECTION("Full tearsheet") {
+        auto response = service.handle(get("/tearsheets/fake"));
+        REQUIRE(response.status == 200);
+        REQUIRE(response.content_type == TearSheetService::kProtobufContentType);
+        epoch_proto::FullTearSheet full;
+        REQUIRE(full.ParseFromString(response.body));
+        REQUIRE(full.categories_size() == 2);
+    }
+
+    SECTION("Categories and a single category") {
+        REQUIRE(service.handle(get("/tearsheets/fake/categories")).body == "Risk\nStrategy\n");
+
+        auto response = service.handle(get("/tearsheets/fake/categories/Strategy"));
+        epoch_proto::TearSheet tearsheet;
+        REQUIRE(tearsheet.ParseFromString(response.body));
+        REQUIRE(tearsheet.charts().charts(0).lines_def().chart_def().id() == "equity");
+    }
+
+    SECTION("Chart with an x range") {
+        auto response = service.handle(get("/tearsheets/fake/categories/Strategy/charts/0",
+                                           {{"from", "2000"}, {"to", "4000"}}));
+        REQUIRE(response.status == 200);
+        epoch_proto::Chart chart;
+        REQUIRE(chart.ParseFromString(response.body));
+        const auto& data = chart.lines_def().lines(0).data();
+        REQUIRE(data.size() == 3);
+        REQUIRE(data[0].x() == 2000);
+        REQUIRE(data[2].x() == 4000);
+    }
+
+    SECTION("Arrow series with an x range") {
+        auto response = service.handle(get("/tearsheets/fake/charts/prices/arrow", {{"from", "8500"}}));
+        REQUIRE(response.status == 200);
+        REQUIRE(response.content_type == TearSheetService::kArrowContentType);
+        auto table = readIPC(response.body);
+        REQUIRE(table->num_rows() == 1);
+        REQUIRE(std::static_pointer_cast<arrow::Int64Array>(table->column(0)->chunk(0))->Value(0) == 9000);
+    }
+
+    SECTION("Errors") {
+        REQUIRE(service.handle(get("/tearsheets/missing")).status == 404);
+        REQUIRE(service.handle(get("/tearsheets/fake/categories/Positions")).status == 404);
+        REQUIRE(service.handle(get("/tearsheets/fake/categories/Strategy/charts/3")).status == 404);
+        REQUIRE(service.handle(get("/tearsheets/fake/categories/Strategy/charts/x")).status == 400);
+        REQUIRE(service.handle(get("/tearsheets/fake/charts/nope/arrow")).status == 404);
+        REQUIRE(service.handle(get("/elsewhere")).status == 404);
+
+        auto response = service.handle(get("/tearsheets/fake/charts/prices/arrow", {{"from", "5"}, {"to", "1"}}));
+        REQUIRE(response.status == 400);
+        REQUIRE_THAT(response.body, ContainsSubstring("'from' must not be greater"));
+    }
+
+    REQUIRE(loads <= 1);
+}
+
+TEST_CASE("TearSheetService: ETag and memoization", "[tearsheet_service]") {
+    std::atomic<int> loads{0};
+    TearSheetService service;
+    service.registerProvider("fake", std::make_shared<FakeProvider>(loads));
+
+    auto first = service.handle(get("/tearsheets/fake/categories/Strategy"));
+    REQUIRE(first.etag == TearSheetService::etagFor(first.body));
+    REQUIRE(first.etag.size() == 18);
+
+    auto request = get("/tearsheets/fake/categories/Strategy");
+    request.if_none_match = "\"0000000000000000\", W/" + first.etag;
+    auto cached = service.handle(request);
+    REQUIRE(cached.status == 304);
+    REQUIRE(cached.body.empty());
+    REQUIRE(cached.etag == first.etag);
+
+    service.invalidate("fake");
+    REQUIRE(service.handle(get("/tearsheets/fake/categories/Strategy")).body == first.body);
+    REQUIRE(loads == 2);
+
+    REQUIRE(TearSheetService::etagMatches("*", "\"abc\""));
+    REQUIRE_FALSE(TearSheetService::etagMatches("", "\"abc\""));
+    REQUIRE_THROWS_WITH(service.registerProvider("fake", std::make_shared<FakeProvider>(loads)),
+                        ContainsSubstring("duplicate provider id"));
+}
+
+TEST_CASE("TearSheetService: Prometheus metrics", "[tearsheet_service]") {
+    std::atomic<int> loads{0};
+    TearSheetService service;
+    service.registerProvider("fake", std::make_shared<FakeProvider>(loads));
+
+    service.handle(get("/tearsheets/fake"));
+    service.handle(get("/tearsheets/missing"));
+    REQUIRE(service.metrics().count("tearsheet") == 2);
+
+    auto metrics = service.handle(get("/metrics"));
+    REQUIRE(metrics.content_type == TearSheetService::kMetricsContentType);
+    REQUIRE_THAT(metrics.body, ContainsSubstring(
+        "epoch_dashboard_request_duration_seconds_count{route=\"tearsheet\"} 2"));
+    REQUIRE_THAT(metrics.body, ContainsSubstring(
+        "epoch_dashboard_request_duration_seconds_bucket{route=\"tearsheet\",le=\"+Inf\"} 2"));
+    REQUIRE_THAT(metrics.body, ContainsSubstring("epoch_dashboard_responses_total{route=\"tearsheet\",code=\"404\"} 1"));
+}
+
+TEST_CASE("MockTearSheetProvider: serves protobuf and Arrow charts", "[tearsheet_service]") {
+    TearSheetService service;
+    service.registerProvider("mock", std::make_shared<MockTearSheetProvider>(30));
+
+    auto equity = service.handle(get("/tearsheets/mock/categories/Strategy/charts/0"));
+    REQUIRE(equity.status == 200);
+    epoch_proto::Chart chart;
+    REQUIRE(chart.ParseFromString(equity.body));
+    REQUIRE(chart.lines_def().lines(0).data_size() == 30);
+
+    auto drawdown = service.handle(get("/tearsheets/mock/charts/drawdown/arrow"));
+    REQUIRE(drawdown.status == 200);
+    REQUIRE(readIPC(drawdown.body)->num_rows() == 30);
+}
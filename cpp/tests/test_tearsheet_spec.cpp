@@ -0,0 +1,75 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/tearsheet_spec.h"
+#include <filesystem>
+#include <fstream>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+constexpr const char* kSpec = R"(
+series:
+  - {name: drawdown, op: drawdown, source: equity}
+  - {name: equity_ma, op: rolling_mean, source: equity, window: 20}
+categories:
+  - name: Performance
+    widgets:
+      - {type: lines, id: equity, title: Equity, columns: [equity, equity_ma]}
+      - {type: histogram, title: Returns, columns: [returns], bins: 50}
+  - name: Risk
+    widgets:
+      - {type: area, title: Drawdown, y_label: Drawdown, columns: [drawdown]}
+      - {type: heatmap, title: Monthly, x: year, y: month, value: pnl}
+)";
+
+} // namespace
+
+TEST_CASE("TearsheetSpec: parse categories, widgets and series", "[tearsheet_spec]") {
+    auto spec = TearsheetSpec::fromYaml(kSpec);
+
+    REQUIRE(spec.series.size() == 2);
+    REQUIRE(spec.series[0].op == DerivedOp::Drawdown);
+    REQUIRE(spec.series[1].op == DerivedOp::RollingMean);
+    REQUIRE(spec.series[1].window == 20);
+
+    REQUIRE(spec.categories.size() == 2);
+    const auto& performance = spec.categories[0].widgets;
+    REQUIRE(performance[0].kind == WidgetKind::Lines);
+    REQUIRE(performance[0].columns == std::vector<std::string>{"equity", "equity_ma"});
+    REQUIRE(performance[1].bins == 50);
+
+    const auto& heat_map = spec.categories[1].widgets[1];
+    REQUIRE(heat_map.kind == WidgetKind::HeatMap);
+    REQUIRE(heat_map.inputs() == std::vector<std::string>{"year", "month", "pnl"});
+    REQUIRE(spec.categories[1].widgets[0].y_label == "Drawdown");
+}
+
+TEST_CASE("TearsheetSpec: errors", "[tearsheet_spec]") {
+    REQUIRE_THROWS_WITH(TearsheetSpec::fromYaml("categories: [{name: A, widgets: [{type: donut, columns: [x]}]}]"),
+                        ContainsSubstring("unknown widget type 'donut'"));
+    REQUIRE_THROWS_WITH(TearsheetSpec::fromYaml("categories: [{name: A, widgets: [{type: lines, colums: [x]}]}]"),
+                        ContainsSubstring("unknown key 'colums'"));
+    REQUIRE_THROWS_WITH(TearsheetSpec::fromYaml("categories: [{name: A, widgets: [{type: bar, columns: [x, y]}]}]"),
+                        ContainsSubstring("exactly one column"));
+    REQUIRE_THROWS_WITH(TearsheetSpec::fromYaml("categories: [{name: A, widgets: [{type: pie, name: sector}]}]"),
+                        ContainsSubstring("'name' and 'value'"));
+    REQUIRE_THROWS_WITH(TearsheetSpec::fromYaml(
+                            "series: [{name: ma, op: rolling_mean, source: x}]\ncategories: [{name: A}]"),
+                        ContainsSubstring("positive 'window'"));
+    REQUIRE_THROWS_WITH(TearsheetSpec::fromYaml("series: []"), ContainsSubstring("at least one category"));
+    REQUIRE_THROWS_WITH(TearsheetSpec::fromYaml("categories: [unclosed"), ContainsSubstring("TearsheetSpec"));
+    REQUIRE_THROWS_WITH(TearsheetSpec::fromYamlFile("/nonexistent/spec.yaml"), ContainsSubstring("failed to open"));
+}
+
+TEST_CASE("TearsheetSpec: load from file", "[tearsheet_spec]") {
+    const auto path = (std::filesystem::temp_directory_path() / "epoch_dashboard_tearsheet_spec.yaml").string();
+    std::ofstream(path) << kSpec;
+
+    auto spec = TearsheetSpec::fromYamlFile(path);
+    REQUIRE(spec.categories[0].name == "Performance");
+    REQUIRE(spec.categories[1].widgets.size() == 2);
+
+    std::filesystem::remove(path);
+}
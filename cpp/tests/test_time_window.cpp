@@ -0,0 +1,148 @@
+#include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
+#include "epoch_dashboard/tearsheet/arrow_sidecar.h"
+#include "epoch_dashboard/tearsheet/lines_chart_builder.h"
+#include "epoch_dashboard/tearsheet/time_window.h"
+#include <epoch_frame/dataframe.h>
+#include <epoch_frame/factory/index_factory.h>
+#include <arrow/api.h>
+#include <limits>
+
+using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
+
+namespace {
+
+template <typename Builder, typename T>
+std::shared_ptr<arrow::Array> finish(Builder& builder, const std::vector<T>& values) {
+    REQUIRE(builder.AppendValues(values).ok());
+    std::shared_ptr<arrow::Array> array;
+    REQUIRE(builder.Finish(&array).ok());
+    return array;
+}
+
+std::shared_ptr<arrow::Array> makeTimestamps(const std::vector<int64_t>& values, arrow::TimeUnit::type unit) {
+    arrow::TimestampBuilder builder(arrow::timestamp(unit), arrow::default_memory_pool());
+    return finish(builder, values);
+}
+
+// Ten bars, one per second, as epoch ms: 0, 1000, ..., 9000
+std::vector<int64_t> barTimes(int64_t scale = 1) {
+    std::vector<int64_t> values;
+    for (int64_t i = 0; i < 10; ++i) {
+        values.push_back(i * 1000 * scale);
+    }
+    return values;
+}
+
+TimeWindowQuery range(std::optional<int64_t> from_ms, std::optional<int64_t> to_ms) {
+    TimeWindowQuery query;
+    query.from_ms = from_ms;
+    query.to_ms = to_ms;
+    return query;
+}
+
+} // namespace
+
+TEST_CASE("TimeWindow: locate", "[time_window]") {
+    auto index = makeTimestamps(barTimes(), arrow::TimeUnit::MILLI);
+
+    SECTION("No parameters selects everything") {
+        REQUIRE(TimeWindow::locate(index, {}) == RowRange{0, 10});
+    }
+
+    SECTION("Inclusive from_ms/to_ms") {
+        REQUIRE(TimeWindow::locate(index, range(2000, 4000)) == RowRange{2, 3});
+        REQUIRE(TimeWindow::locate(index, range(1500, 4500)) == RowRange{2, 3});
+        REQUIRE(TimeWindow::locate(index, range(std::nullopt, 500)) == RowRange{0, 1});
+        REQUIRE(TimeWindow::locate(index, range(20000, std::nullopt)).length == 0);
+    }
+
+    SECTION("Padding extends the range and clamps at the edges") {
+        auto query = range(4000, 5000);
+        query.pad_front = 2;
+        query.pad_back = 1;
+        REQUIRE(TimeWindow::locate(index, query) == RowRange{2, 5});
+
+        query.pad_front = 100;
+        query.pad_back = std::numeric_limits<int64_t>::max();
+        REQUIRE(TimeWindow::locate(index, query) == RowRange{0, 10});
+    }
+
+    SECTION("Pivot matches the mock server slice") {
+        TimeWindowQuery query;
+        query.pivot_ms = 4500;
+        query.pad_front = 2;
+        query.pad_back = 3;
+        // First bar at or after the pivot is row 5: rows [3, 8)
+        REQUIRE(TimeWindow::locate(index, query) == RowRange{3, 5});
+
+        query.from_ms = 4000;
+        REQUIRE(TimeWindow::locate(index, query) == RowRange{4, 4});
+    }
+
+    SECTION("Bounds are converted to the index unit") {
+        auto seconds = makeTimestamps({0, 1, 2, 3, 4, 5, 6, 7, 8, 9}, arrow::TimeUnit::SECOND);
+        REQUIRE(TimeWindow::locate(seconds, range(1500, 4500)) == RowRange{2, 3});
+
+        auto nanos = makeTimestamps(barTimes(1000000), arrow::TimeUnit::NANO);
+        REQUIRE(TimeWindow::locate(nanos, range(2000, 4000)) == RowRange{2, 3});
+
+        arrow::Int64Builder int_builder;
+        REQUIRE(TimeWindow::locate(finish(int_builder, barTimes()), range(2000, 4000)) == RowRange{2, 3});
+    }
+
+    SECTION("Slices locate within their own rows") {
+        REQUIRE(TimeWindow::locate(index->Slice(3), range(4000, 5000)) == RowRange{1, 2});
+    }
+
+    SECTION("Errors") {
+        REQUIRE_THROWS_WITH(TimeWindow::locate(index, range(5000, 1000)), ContainsSubstring("from_ms"));
+
+        TimeWindowQuery negative;
+        negative.pad_back = -1;
+        REQUIRE_THROWS_WITH(TimeWindow::locate(index, negative), ContainsSubstring("must not be negative"));
+
+        arrow::StringBuilder strings;
+        REQUIRE_THROWS_WITH(TimeWindow::locate(finish(strings, std::vector<std::string>{"a"}), {}),
+                            ContainsSubstring("unsupported index type"));
+    }
+}
+
+TEST_CASE("TimeWindow: slice DataFrame for builders", "[time_window]") {
+    auto index = makeTimestamps(barTimes(), arrow::TimeUnit::MILLI);
+    arrow::DoubleBuilder close_builder;
+    auto close = finish(close_builder, std::vector<double>{0, 1, 2, 3, 4, 5, 6, 7, 8, 9});
+    auto table = arrow::Table::Make(arrow::schema({arrow::field("close", arrow::float64())}), {close});
+    epoch_frame::DataFrame df(epoch_frame::factory::index::make_index(index, std::nullopt, "timestamp"), table);
+
+    TimeWindowQuery query;
+    query.pivot_ms = 6000;
+    query.pad_front = 2;
+    query.pad_back = 2;
+    auto window = TimeWindow::slice(df, query);
+    REQUIRE(window.table()->num_rows() == 4);
+
+    auto chart = LinesChartBuilder()
+        .setId("candles")
+        .setTitle("Close")
+        .fromDataFrame(window, {"close"})
+        .build();
+    const auto& data = chart.lines_def().lines(0).data();
+    REQUIRE(data.size() == 4);
+    REQUIRE(data[0].x() == 4000);
+    REQUIRE(data[3].x() == 7000);
+}
+
+TEST_CASE("TimeWindow: slice sidecar table", "[time_window]") {
+    arrow::Int64Builder x_builder;
+    arrow::DoubleBuilder y_builder;
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field(ArrowSidecar::kXColumn, arrow::int64()), arrow::field("y", arrow::float64())}),
+        {finish(x_builder, barTimes()), finish(y_builder, std::vector<double>(10, 1.0))});
+
+    auto window = TimeWindow::slice(table, range(7000, std::nullopt));
+    REQUIRE(window->num_rows() == 3);
+    // Zero-copy: the slice shares the original buffers
+    REQUIRE(window->column(1)->chunk(0)->data()->buffers[1] == table->column(1)->chunk(0)->data()->buffers[1]);
+}
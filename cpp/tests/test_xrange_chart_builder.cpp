@@ -1,7 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
+#include <catch2/matchers/catch_matchers_string.hpp>
 #include "epoch_dashboard/tearsheet/xrange_chart_builder.h"
+#include <epoch_frame/dataframe.h>
+#include <arrow/api.h>
 
 using namespace epoch_tearsheet;
+using Catch::Matchers::ContainsSubstring;
 
 TEST_CASE("XRangeChartBuilder: Basic construction", "[xrange]") {
     auto chart = XRangeChartBuilder()
@@ -91,4 +95,102 @@ TEST_CASE("XRangeChartBuilder: Default is_long parameter", "[xrange]") {
 
     REQUIRE(chart.x_range_def().points_size() == 1);
     REQUIRE(chart.x_range_def().points(0).is_long() == false);
-}
\ No newline at end of file
+}
+
+namespace {
+
+constexpr int64_t kHourMs = 3600000;
+
+template <typename Builder, typename T>
+std::shared_ptr<arrow::Array> finish(Builder& builder, const std::vector<T>& values) {
+    REQUIRE(builder.AppendValues(values).ok());
+    std::shared_ptr<arrow::Array> array;
+    REQUIRE(builder.Finish(&array).ok());
+    return array;
+}
+
+// Trades 0-2 overlap pairwise at hour 2; trade 3 starts exactly when trade 0 exits
+epoch_frame::DataFrame makeTrades(std::vector<int64_t> exits = {3, 4, 5, 6}) {
+    for (auto& exit : exits) {
+        exit *= kHourMs;
+    }
+    arrow::TimestampBuilder entry_builder(arrow::timestamp(arrow::TimeUnit::SECOND), arrow::default_memory_pool());
+    arrow::Int64Builder exit_builder;
+    arrow::StringBuilder symbol_builder;
+    arrow::BooleanBuilder long_builder;
+    auto table = arrow::Table::Make(
+        arrow::schema({arrow::field("entry", arrow::timestamp(arrow::TimeUnit::SECOND)),
+                       arrow::field("exit", arrow::int64()),
+                       arrow::field("symbol", arrow::utf8()),
+                       arrow::field("long", arrow::boolean())}),
+        {finish(entry_builder, std::vector<int64_t>{0, 3600, 7200, 10800}),
+         finish(exit_builder, exits),
+         finish(symbol_builder, std::vector<std::string>{"MSFT", "AAPL", "MSFT", "GOOG"}),
+         finish(long_builder, std::vector<bool>{true, false, true, false})});
+    return epoch_frame::DataFrame(table);
+}
+
+std::vector<uint64_t> lanesOf(const epoch_proto::Chart& chart) {
+    std::vector<uint64_t> lanes;
+    for (const auto& point : chart.x_range_def().points()) {
+        lanes.push_back(point.y());
+    }
+    return lanes;
+}
+
+} // namespace
+
+TEST_CASE("XRangeChartBuilder: fromDataFrame", "[xrange]") {
+    SECTION("Automatic lanes use the minimum count") {
+        auto chart = XRangeChartBuilder().fromDataFrame(makeTrades(), "entry", "exit", std::nullopt, "long").build();
+
+        const auto& def = chart.x_range_def();
+        REQUIRE(def.points_size() == 4);
+        REQUIRE(def.points(1).x() == kHourMs);
+        REQUIRE(def.points(1).x2() == 4 * kHourMs);
+        REQUIRE(def.points(0).is_long());
+        REQUIRE_FALSE(def.points(1).is_long());
+        REQUIRE(lanesOf(chart) == std::vector<uint64_t>{0, 1, 2, 0});
+        REQUIRE(def.chart_def().y_axis().categories_size() == 3);
+        REQUIRE(def.chart_def().y_axis().categories(2) == "Lane 3");
+    }
+
+    SECTION("Named lanes") {
+        auto chart = XRangeChartBuilder().fromDataFrame(makeTrades(), "entry", "exit", "symbol").build();
+
+        REQUIRE(lanesOf(chart) == std::vector<uint64_t>{0, 1, 0, 2});
+        const auto& categories = chart.x_range_def().chart_def().y_axis().categories();
+        REQUIRE(std::vector<std::string>(categories.begin(), categories.end()) ==
+                std::vector<std::string>{"MSFT", "AAPL", "GOOG"});
+        REQUIRE_FALSE(chart.x_range_def().points(0).is_long());
+    }
+
+    SECTION("Integer lanes are dense") {
+        arrow::Int64Builder account_builder;
+        auto table = makeTrades().table();
+        auto with_accounts = table->AddColumn(
+            table->num_columns(), arrow::field("account", arrow::int64()),
+            std::make_shared<arrow::ChunkedArray>(
+                finish(account_builder, std::vector<int64_t>{1000000, 5, 1000000, 0})));
+        REQUIRE(with_accounts.ok());
+        auto chart = XRangeChartBuilder()
+                         .fromDataFrame(epoch_frame::DataFrame(*with_accounts), "entry", "exit", "account")
+                         .build();
+
+        REQUIRE(lanesOf(chart) == std::vector<uint64_t>{0, 1, 0, 2});
+        const auto& categories = chart.x_range_def().chart_def().y_axis().categories();
+        REQUIRE(std::vector<std::string>(categories.begin(), categories.end()) ==
+                std::vector<std::string>{"1000000", "5", "0"});
+    }
+
+    SECTION("Errors") {
+        REQUIRE_THROWS_WITH(XRangeChartBuilder().fromDataFrame(makeTrades({3, 1, 5, 3}), "entry", "exit"),
+                            ContainsSubstring("at row 1 (2 invalid rows)"));
+        REQUIRE_THROWS_WITH(XRangeChartBuilder().fromDataFrame(makeTrades(), "entry", "close"),
+                            ContainsSubstring("missing column 'close'"));
+        REQUIRE_THROWS_WITH(XRangeChartBuilder().fromDataFrame(makeTrades(), "symbol", "exit"),
+                            ContainsSubstring("must be timestamp or int64"));
+        REQUIRE_THROWS_WITH(XRangeChartBuilder().fromDataFrame(makeTrades(), "entry", "exit", "long"),
+                            ContainsSubstring("must be string, dictionary or integer"));
+    }
+}